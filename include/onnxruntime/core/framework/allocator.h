@@ -21,16 +21,25 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  thread_cache_max_chunk_bytes(-1),
+                  thread_cache_max_bytes(-1),
+                  huge_pages(-1),
+                  numa_node(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
-              int64_t max_power_of_two_extend_bytes)
+              int64_t max_power_of_two_extend_bytes,
+              int64_t thread_cache_max_chunk_bytes = -1, int64_t thread_cache_max_bytes = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        thread_cache_max_chunk_bytes(thread_cache_max_chunk_bytes),
+        thread_cache_max_bytes(thread_cache_max_bytes),
+        huge_pages(-1),
+        numa_node(-1) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -38,13 +47,23 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int64_t thread_cache_max_chunk_bytes;   // use -1 to allow ORT to choose the default, 0 disables the thread caches
+  int64_t thread_cache_max_bytes;         // use -1 to allow ORT to choose the default
+  // CPU arenas only. use -1 to allow ORT to choose the default (0),
+  // 0 = regular pages, 1 = transparent huge pages, 2 = reserved huge pages with fallback to transparent huge pages
+  int huge_pages;
+  int numa_node;  // CPU arenas only. NUMA node to place the arena regions on, -1 to leave it to the OS
 
   bool IsValid() {
     return arena_extend_strategy >= -1 && arena_extend_strategy <= 1 &&
            initial_chunk_size_bytes >= -1 &&
            max_dead_bytes_per_chunk >= -1 &&
            initial_growth_chunk_size_bytes >= -1 &&
-           max_power_of_two_extend_bytes >= -1;
+           max_power_of_two_extend_bytes >= -1 &&
+           thread_cache_max_chunk_bytes >= -1 &&
+           thread_cache_max_bytes >= -1 &&
+           huge_pages >= -1 && huge_pages <= 2 &&
+           numa_node >= -1;
   }
 
   // config key names that we parse in FromKeyValuePairs
@@ -55,6 +74,10 @@ struct OrtArenaCfg {
     static constexpr const char* InitialGrowthChunkSizeBytes = "arena.initial_growth_chunk_size_bytes";
     static constexpr const char* MaxPowerOfTwoExtendBytes = "arena.max_power_of_two_extend_bytes";
     static constexpr const char* MaxMem = "arena.max_mem";
+    static constexpr const char* ThreadCacheMaxChunkBytes = "arena.thread_cache_max_chunk_bytes";
+    static constexpr const char* ThreadCacheMaxBytes = "arena.thread_cache_max_bytes";
+    static constexpr const char* HugePages = "arena.huge_pages";
+    static constexpr const char* NumaNode = "arena.numa_node";
   };
 
   static onnxruntime::common::Status FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg& cfg);
@@ -130,6 +130,42 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override these two functions to allow the pre-packed weights of this kernel to be stored in the persistent cache
+  // configured with the session option "session.prepacked_weights_cache_dir".
+  // CanRestorePrePackedState() returns whether the pre-packed weights of the input 'input_idx' may be cached. Only
+  // then the session looks up the cache for the input and writes the weights that PrePack() produces to the cache.
+  virtual bool CanRestorePrePackedState(int /*input_idx*/) const {
+    return false;
+  }
+
+  // When the pre-packed weights of a constant initialized tensor are found in the cache, RestorePrePackedState() is
+  // called instead of PrePack() and is followed by a call to UseSharedPrePackedBuffers() with the cached buffers.
+  // It must restore all the state that PrePack() sets apart from the pre-packed buffers, e.g. the shape of the packed
+  // weight, without packing the tensor.
+  //   Status RestorePrePackedState(const Tensor& tensor, int input_idx, const PrePackedWeights& prepacked_weights,
+  //                                /*out*/ bool& is_restored) override {
+  //     is_restored = false;
+  //     if (input_idx == 1 && prepacked_weights.buffer_sizes_[0] == this.PackedSize(tensor.Shape())) {
+  //       this.shape_ = tensor.Shape();
+  //       is_restored = true;
+  //     }
+  //     return Status::OK();
+  //   }
+  // Please refer to MatMul<float> for a complete example
+  // @param tensor: The initialized constant tensor
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_weights: The cached pre-packed weights. Kernels should check that their layout, e.g. the number
+  //                           and sizes of the buffers, matches what PrePack() would produce, as the cache may have been
+  //                           written by a build with different packing routines.
+  // @param is_restored: Set it to true if the kernel can use the cached weights. If it's false the
+  //                     tensor is pre-packed with PrePack() and the cache entry is replaced.
+  virtual Status RestorePrePackedState(const Tensor& /*tensor*/, int /*input_idx*/,
+                                       const PrePackedWeights& /*prepacked_weights*/,
+                                       /*out*/ bool& is_restored) {
+    is_restored = false;
+    return Status::OK();
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
@@ -9,6 +9,8 @@
 
 /* Modifications Copyright (c) Microsoft. */
 
+#include <chrono>
+#include <cmath>
 #include <type_traits>
 
 #pragma once
@@ -77,6 +79,9 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   Alternatively the threads spin for a duration given in the
+//   ThreadOptions, or for a duration each thread adapts to how long
+//   it recently had to wait for work (see AdaptiveSpin).
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -230,6 +235,7 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t) {}
   void LogThreadId(int) {}
   void LogRun(int) {}
+  void LogSpinBudget(int, int) {}
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -256,6 +262,7 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
   void LogRun(int thread_idx);                      // called in child thread to log num of run
+  void LogSpinBudget(int thread_idx, int spin_budget_us);  // called in child thread to log its spin budget
   std::string DumpChildThreadStat();                // return all child statistics collected so far
 
  private:
@@ -285,6 +292,7 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  // core that the child thread is running on
+    int32_t spin_budget_us_ = -1;  // last spin budget of a time based spin policy, -1 if not used
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -338,6 +346,14 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
                              unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling() = 0;
   virtual std::string StopProfiling() = 0;
+
+  // Variant of Schedule for work that is derived from the task the
+  // calling thread is currently running (e.g., a successor node in a
+  // dependency graph).  When called from a worker of this pool the
+  // work is pushed to that worker's own queue, so it is picked up by
+  // the same thread unless an idle worker steals it first.  Calls from
+  // outside the pool behave like Schedule.
+  virtual void ScheduleLocal(std::function<void()> fn) = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -772,6 +788,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
+        spin_duration_us_(allow_spinning ? thread_options.spin_duration_us : 0),
+        max_adaptive_spin_us_(thread_options.spin_duration_us >= 0 ? thread_options.spin_duration_us
+                                                                   : kDefaultMaxAdaptiveSpinUs),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -830,6 +850,20 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  void ScheduleLocal(std::function<void()> fn) override {
+    PerThread* pt = GetPerThread();
+    if (pt->pool != this) {
+      Schedule(std::move(fn));
+      return;
+    }
+    WorkerData& td = worker_data_[pt->thread_id];
+    fn = td.queue.PushBack(std::move(fn));
+    if (fn) {
+      // Our own queue is full, so run the work directly
+      fn();
+    }
+  }
+
   //......................................................................
   //
   // Parallel sections
@@ -1388,11 +1422,54 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 #pragma warning(pop)
 #endif  // _MSC_VER
 
+  // Spin budget of a worker under the adaptive spin policy.
+  //
+  // The worker records how long each of its idle periods lasted, i.e. the time from finding its queue empty until
+  // it got a task, whether it found the task spinning or after blocking.  The budget follows the estimator TCP uses
+  // for retransmission timeouts: a smoothed mean plus four times the smoothed mean deviation of the idle periods, so
+  // that most idle periods of a burst of work end while the worker is still spinning.  If most idle periods are longer
+  // than the maximum budget (e.g. the pool is idle between requests), spinning would rarely find work and the budget
+  // drops to zero, so the worker blocks right away.
+  //
+  // Only accessed by the worker thread itself.
+  struct AdaptiveSpin {
+    void Reset(int max_budget_us) {
+      short_idle_ratio = 1.0f;
+      mean_idle_us = 0.0f;
+      dev_idle_us = max_budget_us / 4.0f;
+      budget_us = max_budget_us;
+    }
+
+    void Update(float idle_us, int max_budget_us) {
+      constexpr float kMeanGain = 1.0f / 8;
+      constexpr float kDevGain = 1.0f / 4;
+      const bool is_short = idle_us <= max_budget_us;
+      short_idle_ratio += kMeanGain * ((is_short ? 1.0f : 0.0f) - short_idle_ratio);
+      if (is_short) {
+        dev_idle_us += kDevGain * (std::abs(idle_us - mean_idle_us) - dev_idle_us);
+        mean_idle_us += kMeanGain * (idle_us - mean_idle_us);
+      }
+
+      if (short_idle_ratio < 0.5f) {
+        budget_us = 0;
+      } else {
+        const float budget = mean_idle_us + 4 * dev_idle_us;
+        budget_us = budget >= max_budget_us ? max_budget_us : static_cast<int>(budget) + 1;
+      }
+    }
+
+    float short_idle_ratio = 1.0f;  // fraction of recent idle periods no longer than the maximum budget
+    float mean_idle_us = 0.0f;      // smoothed length of those idle periods
+    float dev_idle_us = 0.0f;       // smoothed mean deviation of those idle periods
+    int budget_us = 0;
+  };
+
   struct WorkerData {
     constexpr WorkerData() : thread(), queue() {
     }
     std::unique_ptr<Thread> thread;
     Queue queue;
+    AdaptiveSpin adaptive_spin;
 
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
@@ -1495,6 +1572,11 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  // Spin policy, see ThreadOptions: adaptive, for a fixed duration if spin_duration_us_ >= 0, otherwise for the
+  // fixed number of iterations spin_count.
+  const bool adaptive_spinning_;
+  const int spin_duration_us_;
+  const int max_adaptive_spin_us_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
@@ -1524,6 +1606,41 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  using SpinClock = std::chrono::steady_clock;
+
+  // Maximum spin budget of the adaptive spin policy if no spin duration is configured.
+  static constexpr int kDefaultMaxAdaptiveSpinUs = 5000;
+
+  // Spin for up to spin_us microseconds waiting for work pushed to q.  Every kSpinCheckInterval iterations the
+  // worker tries to steal work and checks the clock.
+  Task SpinForWork(Queue& q, int spin_us) {
+    constexpr unsigned kSpinCheckInterval = 256;
+    if (spin_us <= 0) {
+      return Task();
+    }
+
+    const auto deadline = SpinClock::now() + std::chrono::microseconds(spin_us);
+    for (unsigned i = 1; !done_; i++) {
+      Task t;
+      if (i % kSpinCheckInterval == 0) {
+        t = Steal(StealAttemptKind::TRY_ONE);
+        if (!t && SpinClock::now() >= deadline) {
+          break;
+        }
+      } else {
+        t = q.PopFront();
+      }
+      if (t) return t;
+
+      if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
+        break;
+      }
+      onnxruntime::concurrency::SpinPause();
+    }
+
+    return Task();
+  }
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     PerThread* pt = GetPerThread();
@@ -1538,26 +1655,36 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     constexpr int log2_spin = 20;
     const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
     const int steal_count = spin_count / 100;
+    const bool timed_spin = adaptive_spinning_ || spin_duration_us_ >= 0;
 
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
+    td.adaptive_spin.Reset(max_adaptive_spin_us_);
 
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
-        // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
-          if (((i + 1) % steal_count == 0)) {
-            t = Steal(StealAttemptKind::TRY_ONE);
-          } else {
-            t = q.PopFront();
-          }
-          if (t) break;
+        const auto idle_start = adaptive_spinning_ ? SpinClock::now() : SpinClock::time_point{};
 
-          if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
-            break;
+        // Spin waiting for work.
+        if (timed_spin) {
+          const int spin_budget_us = adaptive_spinning_ ? td.adaptive_spin.budget_us : spin_duration_us_;
+          profiler_.LogSpinBudget(thread_id, spin_budget_us);
+          t = SpinForWork(q, spin_budget_us);
+        } else {
+          for (int i = 0; i < spin_count && !done_; i++) {
+            if (((i + 1) % steal_count == 0)) {
+              t = Steal(StealAttemptKind::TRY_ONE);
+            } else {
+              t = q.PopFront();
+            }
+            if (t) break;
+
+            if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
+              break;
+            }
+            onnxruntime::concurrency::SpinPause();
           }
-          onnxruntime::concurrency::SpinPause();
         }
 
         // Attempt to block
@@ -1628,6 +1755,11 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           if (!t) t = q.PopFront();
           if (!t) t = Steal(StealAttemptKind::TRY_ALL);
         }
+
+        if (adaptive_spinning_ && t) {
+          const std::chrono::duration<float, std::micro> idle_time = SpinClock::now() - idle_start;
+          td.adaptive_spin.Update(idle_time.count(), max_adaptive_spin_us_);
+        }
       }
 
       if (t) {
@@ -234,6 +234,18 @@ class ThreadPool {
     }
   }
 
+  // Schedules fn() like Schedule, but when called from one of the pool's worker
+  // threads the work is queued on that worker first so that dependent work stays
+  // on the same core unless another worker is idle and steals it.
+  static void ScheduleLocal(ThreadPool* tp,
+                            std::function<void()> fn) {
+    if (tp) {
+      tp->ScheduleLocal(fn);
+    } else {
+      fn();
+    }
+  }
+
   // ParallelFor shards the "total" units of work assuming each unit of work
   // having roughly "cost_per_unit" cost, in cycles. Each unit of work is
   // indexed 0, 1, ..., total - 1. Each shard contains 1 or more units of work
@@ -411,6 +423,8 @@ class ThreadPool {
 
   void Schedule(std::function<void()> fn);
 
+  void ScheduleLocal(std::function<void()> fn);
+
   void StartProfiling();
 
   std::string StopProfiling();
@@ -368,6 +368,9 @@ typedef struct OrtAllocator {
    * - NumArenaExtensions: Number of arena extensions (Relevant only for arena based allocators)
    * - NumArenaShrinkages: Number of arena shrinkages (Relevant only for arena based allocators)
    * - MaxAllocSize: The max single allocation seen.
+   * - NumThreadCacheHits: Number of allocations served by the thread caches of an arena.
+   * - NumThreadCacheFlushes: Number of times a thread cache of an arena returned chunks to the arena.
+   * - ThreadCacheBytes: Number of bytes held by the thread caches of an arena. Not included in InUse.
    *
    * NOTE: If the allocator does not implement this function, the OrtKeyValuePairs instance will be empty.
    */
@@ -2950,6 +2953,16 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "thread_cache_max_chunk_bytes": Freed chunks of up to this size are kept in per thread caches in front of the
+   *  arena, which serve allocations of the same size without taking the arena lock. Use 0 or -1 to disable the
+   *  thread caches, which is the default.
+   * "thread_cache_max_bytes": Number of bytes a thread cache may hold before it returns chunks to the arena.
+   *  Use -1 to allow ORT to choose the default of 4MB.
+   * "huge_pages": Only used by CPU arenas. 0 = regular pages, 1 = transparent huge pages,
+   *  2 = reserved huge pages, falling back to transparent huge pages if none are available.
+   *  Use -1 to allow ORT to choose the default, which is 0.
+   * "numa_node": Only used by CPU arenas. NUMA node to place the memory of the arena on.
+   *  Use -1 to leave the placement to the operating system, which is the default.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -71,6 +71,12 @@ static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimizati
 // CastElimination with chain elimination has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableCastChainElimination = "optimization.enable_cast_chain_elimination";
 
+// Enable or disable elementwise fusion in graph optimization. "0": disable; "1": enable. The default is "0".
+// ElementwiseFusion rewrites chains of float element-wise operators on the CPU EP (Add, Mul, Sigmoid, ...) to a
+// single FusedElementwise node that makes one pass over the data. Its Exp and Erf may differ from the standalone
+// kernels in the last bits, so it is disabled by default.
+static const char* const kOrtSessionOptionsEnableElementwiseFusion = "optimization.enable_elementwise_fusion";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -146,12 +152,36 @@ static const char* const kOrtSessionOptionsGraphOptimizationsLoopLevel = "sessio
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Enable or disable sharing the memory mapped external data of initializers used on CPU between all sessions in the
+// process. "1": enable; "0": disable. The default is "0".
+// When enabled, an external initializer is mapped from its file once and every session created from the same file
+// uses the same mapping, instead of each session mapping it separately. The mapped data is never modified. No arena memory is reserved for
+// these initializers, also with "session.use_device_allocator_for_initializers". Kernels that need a different layout
+// still pre-pack a copy, after which the mapping is released if no other session uses it.
+static const char* const kOrtSessionOptionsConfigShareMappedExternalInitializers =
+    "session.share_mapped_external_initializers";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure how long the inter_op/intra_op threads spin before blocking, in microseconds.
+// Only used if spinning is allowed.
+// "-1": default, thread will spin a fixed number of times before blocking
+// "n": thread will spin for up to n microseconds before blocking. "0" blocks right away.
+static const char* const kOrtSessionOptionsConfigInterOpSpinDurationUs = "session.inter_op.spin_duration_us";
+static const char* const kOrtSessionOptionsConfigIntraOpSpinDurationUs = "session.intra_op.spin_duration_us";
+
+// Configure whether the inter_op/intra_op threads adapt how long they spin to how long each thread recently had to
+// wait for work. The spin duration above, if set, is the maximum. Only used if spinning is allowed.
+// The chosen spin budget of each thread is reported by the thread pool profiler as "spin_budget_us".
+// "0": default, threads spin as configured above
+// "1": threads spin for an adaptive duration. Threads that mostly wait longer than the maximum block right away.
+static const char* const kOrtSessionOptionsConfigInterOpAdaptiveSpinning = "session.inter_op.adaptive_spinning";
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -229,9 +259,33 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // is used for development purpose.
 static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly = "session.allow_released_opsets_only";
 
+// Maximum number of memory patterns cached per session. Patterns are planned per set of input shapes, so models
+// with dynamic batch or sequence sizes may accumulate many of them. Once the limit is reached the least recently
+// used pattern is evicted. "0" means the cache is not limited. The default is "0".
+// Cache hits, misses and evictions are reported as arguments of the "SequentialExecutor::Execute" profiler event.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Controls how input shapes are bucketed when looking up the memory pattern for a run.
+// "0": one pattern per distinct set of input shapes. The default.
+// "pow2": every input dimension is rounded up to the next power of two.
+// A positive integer N: every input dimension is rounded up to the next multiple of N.
+// Runs whose shapes fall in the same bucket share a single pre-planned allocation, which grows to the largest
+// shapes seen in the bucket. Smaller runs in the bucket place their activations in that allocation.
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBucket = "session.memory_pattern_shape_bucket";
+
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
+// Only applies when the execution mode is ORT_PARALLEL.
+// "1": nodes are scheduled individually on the inter-op thread pool as soon as all of their producers have
+// completed, instead of walking the per-stream execution plan. Successor nodes are queued on the worker that
+// finished their last producer and idle workers steal from each other, so independent branches overlap even
+// when they were assigned to the same logic stream.
+// The setting is ignored for graphs that use device streams (e.g. CUDA), which rely on the per-stream plan to
+// synchronize work between devices.
+// "0": execute the per-stream execution plan. The default.
+static const char* const kOrtSessionOptionsConfigDependencyDrivenExecution = "session.dependency_driven_execution";
+
 // This Option allows setting affinities for intra op threads.
 // Affinity string follows format:
 // logical_processor_id,logical_processor_id;logical_processor_id,logical_processor_id
@@ -249,6 +303,18 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// Partition the intra-op threads of the session by NUMA node.
+// "1": the session creates one intra-op thread pool per NUMA node, with its threads pinned to the processors of the
+// node, and copies the pre-packed weights of the CPU kernels to every node. Each Run uses the thread pool and weight
+// copies of the node its calling thread runs on, or the nodes round robin if that can't be determined, so that the
+// GEMM workers read node local memory.
+// If intra_op_num_threads is set, the threads are divided evenly between the nodes, otherwise every node gets one
+// thread per physical core.
+// Requires per session threads and the sequential execution mode, and can't be combined with
+// session.intra_op_thread_affinities. Pre-packed weights take one more copy per NUMA node.
+// "0": a single intra-op thread pool. The default.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaPartitioning = "session.intra_op_numa_partitioning";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -302,6 +368,40 @@ static const char* const kOrtSessionOptionsModelExternalInitializersFileFolderPa
 static const char* const kOrtSessionOptionsSavePrePackedConstantInitializers =
     "session.save_external_prepacked_constant_initializers";
 
+// Directory of a persistent cache of pre-packed constant initializers.
+// When set, the weights that CPU kernels pre-pack are written to this directory, and later sessions, also in other
+// processes, memory map them from there instead of pre-packing the weights again. The directory is created if it
+// doesn't exist and can be shared by sessions of different models.
+// Entries are keyed by the ORT build, the CPU features, the mlas.* session config entries, the node and a hash of
+// the weight, so entries written by other builds or on other machines are ignored, as are corrupted entries.
+// Only kernels that implement OpKernel::RestorePrePackedState use the cache, e.g. the float MatMul and Gemm kernels.
+// Failures to write the cache are logged and don't fail session creation.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsPrePackedWeightsCacheDir, "/tmp/ort_cache")
+static const char* const kOrtSessionOptionsPrePackedWeightsCacheDir = "session.prepacked_weights_cache_dir";
+
+// Use the intra-op thread pool of the session to initialize the session.
+// When enabled, the initializers deserialized into CPU memory, the kernels of the CPU execution provider and the
+// pre-packing of their constant weights are processed in parallel. The resulting session state is the same as with a
+// serial initialization, and if several items fail the error of the first one in graph order is returned.
+// Kernels of other execution providers are still created and pre-packed serially.
+// "0": disabled (default). "1": enabled.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsParallelInitialization, "1")
+static const char* const kOrtSessionOptionsParallelInitialization = "session.parallel_initialization";
+
+// Directory of a persistent cache of optimized models.
+// When set, the graph produced by the graph optimizations and the partitioning is saved in ORT format to this
+// directory, and later sessions that load the same model with the same options, also in other processes, load it from
+// there instead of optimizing the model again. The directory is created if it doesn't exist and can be shared by
+// sessions of different models.
+// Entries are keyed by the ORT build, the CPU features, the optimization level, the disabled optimizers, the session
+// config entries, the execution providers and their options, and a hash of the model, so changing any of them creates
+// a new entry. Corrupted entries are ignored.
+// Models with nodes compiled by an execution provider are not cached. The cache is not used when
+// optimized_model_filepath is set, with custom op domains, with shared initializers or when an execution provider
+// captures graphs. Failures to write the cache are logged and don't fail session creation.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsOptimizedModelCacheDir, "/tmp/ort_cache")
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // Use this config when you want to collect memory stats for each node in the graph.
 // The file format is a CSV file with the following columns:
 // The file will be created if it does not exist, and will be overwritten if it does.
@@ -399,3 +499,29 @@ static const char* const kOrtEpDynamicOptionsWorkloadType = "ep.dynamic.workload
 // - "0": EP compile is not disabled. [DEFAULT]
 // - "1": EP compile is disabled.
 static const char* const kOrtSessionOptionsDisableModelCompile = "session.disable_model_compile";
+
+// Enables TunableOp for the CPU Execution Provider. The float Gemm and MatMul kernels then run MLAS SGEMM with the
+// block stride and thread partition selected for each GEMM shape in the tuning results, falling back to the MLAS
+// defaults for shapes without a result.
+// Option values:
+// - "0": TunableOp is not enabled for the CPU EP. [DEFAULT]
+// - "1": TunableOp is enabled for the CPU EP.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// Enables tuning for the CPU EP TunableOp. The first run of each GEMM shape that has no tuning result times the
+// candidate configurations and records the fastest one. Requires "session.cpu_tunable_op_enable" to be "1".
+// Option values:
+// - "0": Tuning is not enabled. [DEFAULT]
+// - "1": Tuning is enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Upper bound in milliseconds of the time spent profiling each candidate configuration while tuning.
+// "0" means no limit. [DEFAULT]
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
+// Path of a json file caching the CPU EP tuning results across sessions.
+// If the file exists, its results are loaded when the session is initialized. Results that fail validation, e.g.
+// because they were produced on a different CPU, are ignored. If tuning is enabled, the results, including those
+// produced by this session, are written back to the file when the session is destroyed.
+static const char* const kOrtSessionOptionsCpuTuningResultsFile = "session.cpu_tuning_results_file";
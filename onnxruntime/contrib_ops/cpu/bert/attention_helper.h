@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -175,5 +176,36 @@ T* ConcatStateChunkGQA(const T* past,
   return start;
 }
 
+// Set the block sizes and the per thread buffer of MlasFlashAttention from the L2 cache size.
+inline void SetFlashAttentionBlockSizes(MlasFlashAttentionThreadedArgs& args, int l2_cache_size) {
+  /*
+    q_block_size, kv_block_size correspond to Br, Bc in the FlashAttention paper.
+    Let M = l2_cache_size / sizeof(float)
+    In the FlashAttention kernel, there are 5 big matrices that we need to keep in L2 cache:
+      slice of Q -- [Br, qk_head_size]
+      slice of K -- [Bc, qk_head_size]
+      slice of V -- [Bc, v_head_size]
+      result of QK -- [Br, Bc]
+      temporary output (same shape as QKV) -- [Br, v_head_size]
+    The total size of these matrices is (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+    By taking Bc = M / (4 * (qk_head_size + v_head_size)), and Br = min(Bc, qk_head_size + v_head_size), we have
+      (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+      <= 2 * Bc * (qk_head_size + v_head_size) + Br * Bc
+      <= 2 * Bc * (qk_head_size + v_head_size) + M/4
+      <= 2 * M/4 + M/4 = M * (3/4)
+
+    We leave 1/4 of the L2 cache for
+      1. storing small tensors l and m
+      2. instruction (code)
+  */
+  const int head_sizes = args.qk_head_size + args.v_head_size;
+  args.kv_block_size = l2_cache_size / (static_cast<int>(sizeof(float)) * 4 * head_sizes);
+  args.kv_block_size = std::max(args.kv_block_size, 1);  // avoid kv_block_size = 0
+  args.q_block_size = std::min(args.kv_block_size, head_sizes);
+  args.kv_block_size = std::min(args.kv_block_size, args.kv_sequence_length);  // No point to have kv_block_size > kv_sequence_length
+  args.q_block_size = std::min(args.q_block_size, args.q_sequence_length);     // No point to have q_block_size > q_sequence_length
+  args.buffer_size_per_thread = MlasFlashAttentionGetBufferSizePerThread(&args);
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -11,6 +11,11 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/env.h"
+#include "core/platform/env_var_utils.h"
+
+#include <type_traits>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -35,6 +40,9 @@ class GQAAttentionBase {
     use_smooth_softmax_ = info.GetAttrOrDefault<int64_t>("smooth_softmax", 0) == 1;
 
     local_window_size_ = has_local ? static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1)) : -1;
+
+    l2_cache_size_ = Env::Default().GetL2CacheSize();
+    disable_flash_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableFlashAttention, false);
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -47,6 +55,152 @@ class GQAAttentionBase {
 
   bool use_smooth_softmax_;
 
+  bool disable_flash_;
+  int l2_cache_size_;
+
+  // Whether attention runs through MlasFlashAttention, which reads K and V from the present state only.
+  bool UseFlashAttention(const Tensor* attention_bias, const Tensor* present_key, const Tensor* present_value) const {
+    return attention_bias == nullptr && softcap_ == 0.0f && !use_smooth_softmax_ && !disable_flash_ &&
+           l2_cache_size_ > 0 && present_key != nullptr && present_value != nullptr;
+  }
+
+  // Flash attention on the BSNH inputs of GroupQueryAttention. A single pass over the inputs splits Q, K and V
+  // (packed or not), applies the rotary embedding to Q and K when do_rotary is set, and writes the new K and V rows
+  // straight into the present state, so no transposed or rotated copy of K and V is made. Without position_ids the
+  // rotary position of token s is past_seqlen + s.
+  // Requires UseFlashAttention() to be true.
+  template <typename T>
+  Status ApplyFusedFlashAttention(const T* query,                             // Q (or packed QKV) with shape BxSx(N*H)
+                                  const T* key,                               // K with shape BxSx(N_kv*H), null if packed
+                                  const T* value,                             // V with shape BxSx(N_kv*H), null if packed
+                                  const Tensor* past_key,                     // past K input tensor
+                                  const Tensor* past_value,                   // past V input tensor
+                                  Tensor* output,                             // output tensor
+                                  Tensor* present_key,                        // present K output tensor
+                                  Tensor* present_value,                      // present V output tensor
+                                  const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                  const bool do_rotary,                       // whether to rotate Q and K
+                                  const int64_t* position_ids,                // rotary position ids, null for default
+                                  const int position_ids_format,              // 0: position_ids[0] + s, 1: BxS ids
+                                  const T* cos_cache,                         // rotary cos cache with shape Mx(D/2)
+                                  const T* sin_cache,                         // rotary sin cache with shape Mx(D/2)
+                                  GroupQueryAttentionParameters& parameters,  // attention parameters
+                                  AllocatorPtr allocator,                     // allocator for temporary tensors
+                                  OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t rotary_dim = static_cast<size_t>(parameters.rotary_dim);
+    const bool packed_qkv = parameters.is_packed_qkv;
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const size_t past_buffer_sequence_length =
+        past_key != nullptr && past_value != nullptr ? static_cast<size_t>(past_key->Shape().GetDims()[2]) : 0;
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape().GetDims()[2]);
+
+    const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
+    const T* past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
+    T* present_key_data = present_key->MutableData<T>();
+    T* present_value_data = present_value->MutableData<T>();
+    const bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+    // Heads are numbered in the packed QKV order: N query heads, then N_kv key heads, then N_kv value heads.
+    const size_t total_heads = static_cast<size_t>(num_heads_ + 2 * kv_num_heads_);
+    const size_t q_row_stride = (packed_qkv ? total_heads : static_cast<size_t>(num_heads_)) * head_size;
+    const size_t kv_row_stride = (packed_qkv ? total_heads : static_cast<size_t>(kv_num_heads_)) * head_size;
+    const T* k_input = packed_qkv ? query + num_heads_ * head_size : key;
+    const T* v_input = packed_qkv ? query + (num_heads_ + kv_num_heads_) * head_size : value;
+
+    const size_t q_chunk_length = sequence_length * head_size;                            // S x H
+    const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
+    const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
+
+    auto q_buffer = allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * q_chunk_length * sizeof(T));
+    BufferUniquePtr q_buffer_ptr(q_buffer, BufferDeleter(allocator));
+    T* q_bnsh = static_cast<T*>(q_buffer);
+
+    std::vector<int32_t> total_seqlens(batch_size);
+    int32_t max_total_seqlen = 0;
+    for (size_t b = 0; b < batch_size; b++) {
+      total_seqlens[b] = seqlens_k->Data<int32_t>()[b] + 1;
+      max_total_seqlen = std::max(max_total_seqlen, total_seqlens[b]);
+    }
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = do_rotary ? static_cast<double>(sequence_length * rotary_dim * 32) : 0.0;
+    unit_cost.bytes_loaded = static_cast<double>(present_buff_chunk_length * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>(present_buff_chunk_length * sizeof(T));
+
+    ThreadPool::TryParallelFor(tp, batch_size * total_heads, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / total_heads;
+        const size_t head_index = i % total_heads;
+        const bool is_q = head_index < static_cast<size_t>(num_heads_);
+        const bool is_k = !is_q && head_index < static_cast<size_t>(num_heads_ + kv_num_heads_);
+        const size_t kv_head_index = is_q ? 0 : (head_index - num_heads_) % kv_num_heads_;
+        const size_t past_seqlen =
+            is_prompt ? 0 : static_cast<size_t>(total_seqlens[batch_index]) - sequence_length;
+
+        const T* input;
+        size_t input_row_stride;
+        T* dst;
+        if (is_q) {
+          input = query + (batch_index * sequence_length * q_row_stride) + head_index * head_size;
+          input_row_stride = q_row_stride;
+          dst = q_bnsh + (batch_index * num_heads_ + head_index) * q_chunk_length;
+        } else {
+          input = (is_k ? k_input : v_input) + (batch_index * sequence_length * kv_row_stride) +
+                  kv_head_index * head_size;
+          input_row_stride = kv_row_stride;
+
+          const size_t kv_chunk_index = batch_index * kv_num_heads_ + kv_head_index;
+          T* present = (is_k ? present_key_data : present_value_data) + kv_chunk_index * present_buff_chunk_length;
+          if (!past_present_share_buffer) {
+            const T* past = is_k ? past_key_data : past_value_data;
+            if (past_seqlen > 0) {
+              memcpy(present, past + kv_chunk_index * past_buff_chunk_length, past_seqlen * head_size * sizeof(T));
+            }
+            const size_t valid_length = past_seqlen + sequence_length;
+            if (valid_length < present_buffer_sequence_length) {
+              memset((void*)(present + valid_length * head_size), 0,
+                     (present_buffer_sequence_length - valid_length) * head_size * sizeof(T));
+            }
+          }
+          dst = present + past_seqlen * head_size;
+        }
+
+        const bool rotate = do_rotary && (is_q || is_k);
+        for (size_t s = 0; s < sequence_length; s++) {
+          const T* src_row = input + s * input_row_stride;
+          T* dst_row = dst + s * head_size;
+          if (!rotate) {
+            memcpy(dst_row, src_row, head_size * sizeof(T));
+            continue;
+          }
+
+          // Without position_ids the new tokens follow the past ones.
+          const size_t position_id =
+              position_ids == nullptr    ? past_seqlen + s
+              : position_ids_format == 0 ? static_cast<size_t>(position_ids[0]) + s
+                                         : static_cast<size_t>(position_ids[batch_index * sequence_length + s]);
+          const size_t cache_offset = position_id * (rotary_dim / 2);
+          MlasRotaryEmbedOneRow<T>(src_row, sin_cache + cache_offset, cos_cache + cache_offset, rotary_dim,
+                                   rotary_interleaved_, dst_row);
+          if (rotary_dim < head_size) {
+            memcpy(dst_row + rotary_dim, src_row + rotary_dim, (head_size - rotary_dim) * sizeof(T));
+          }
+        }
+      }
+    });
+
+    RunFlashAttention(output->MutableData<T>(), q_bnsh, 0, total_seqlens, max_total_seqlen, batch_size,
+                      sequence_length, present_buffer_sequence_length, head_size, present_key_data,
+                      present_value_data, tp, allocator);
+    return Status::OK();
+  }
+
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
                         const T* K,                                 // K data with shape BxN_kvxSxH
@@ -76,14 +230,6 @@ class GQAAttentionBase {
     }
     int seqlen_present_kv_cache = static_cast<int>(present_key->Shape().GetDims()[2]);
 
-    // Compute the attention score.
-    bool gqa_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
-                              MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache *
-                   (gqa_mlas_supported ? sizeof(T) : sizeof(float));
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
     const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
     T* present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
     const T* past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
@@ -95,6 +241,15 @@ class GQAAttentionBase {
     bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
 
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    // Compute the attention score.
+    bool gqa_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
+                              MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache *
+                   (gqa_mlas_supported ? sizeof(T) : sizeof(float));
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
     if (gqa_mlas_supported) {
       ComputeAttentionProbs(static_cast<T*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(), attention_bias_data,
@@ -103,7 +258,6 @@ class GQAAttentionBase {
                             tp, allocator);
 
       // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-      const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
       ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs), v,
                               seqlens_k->Data<int32_t>(),
                               batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
@@ -116,7 +270,6 @@ class GQAAttentionBase {
                             tp, allocator);
 
       // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-      const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
       ComputeVxAttentionScore(output->MutableData<T>(), static_cast<float*>(attention_probs), v,
                               seqlens_k->Data<int32_t>(),
                               batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
@@ -128,6 +281,52 @@ class GQAAttentionBase {
   }
 
  private:
+  // Runs MlasFlashAttention over the present state, whose first total_seqlens[b] rows hold the valid K and V.
+  template <typename T>
+  void RunFlashAttention(T* output,                                    // output with shape BxSxNxH
+                         const T* Q,                                   // Q data with shape BxNxSxH
+                         const size_t q_batch_stride,                  // batch stride of Q, 0 if dense BxNxSxH
+                         const std::vector<int32_t>& total_seqlens,    // valid length of the present state per batch
+                         const int32_t max_total_seqlen,               // max of total_seqlens
+                         const size_t batch_size,                      // batch size of self-attention
+                         const size_t sequence_length,                 // sequence length of self-attention (S)
+                         const size_t present_buffer_sequence_length,  // sequence length of present state
+                         const size_t head_size,                       // head size of self-attention
+                         const T* present_key,                         // present key only
+                         const T* present_value,                       // present value only
+                         ThreadPool* tp,                               // thread pool
+                         AllocatorPtr allocator) const {               // allocator for temporary buffer
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = static_cast<int>(batch_size);
+    args.num_heads = num_heads_;
+    args.q_sequence_length = static_cast<int>(sequence_length);
+    // Only the valid part of the present state is read, so size the kv blocks by the longest of them.
+    args.kv_sequence_length = std::min(static_cast<int>(present_buffer_sequence_length), max_total_seqlen);
+    args.qk_head_size = static_cast<int>(head_size);
+    args.v_head_size = static_cast<int>(head_size);
+    args.scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    args.is_fp16 = std::is_same_v<T, MLFloat16>;
+    args.kv_num_heads = kv_num_heads_;
+    args.kv_buffer_sequence_length = static_cast<int>(present_buffer_sequence_length);
+    args.q_batch_stride = q_batch_stride;
+    args.kv_valid_lengths = total_seqlens.data();
+    args.is_causal = true;
+    args.local_window_size = local_window_size_;
+    SetFlashAttentionBlockSizes(args, l2_cache_size_);
+
+    args.thread_count = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    IAllocatorUniquePtr<void> buffer =
+        IAllocator::MakeUniquePtr<void>(allocator, args.buffer_size_per_thread * args.thread_count);
+    args.buffer = reinterpret_cast<float*>(buffer.get());
+
+    args.query = Q;
+    args.key = present_key;
+    args.value = present_value;
+    args.output = output;
+
+    MlasFlashAttention(&args, tp);
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
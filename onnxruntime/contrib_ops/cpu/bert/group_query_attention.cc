@@ -96,6 +96,17 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
+  if (UseFlashAttention(attention_bias, present_k, present_v)) {
+    // Split, rotate and append to the present state in one pass over the inputs.
+    return ApplyFusedFlashAttention<T>(query->Data<T>(), packed_qkv ? nullptr : key->Data<T>(),
+                                       packed_qkv ? nullptr : value->Data<T>(), past_key, past_value, output,
+                                       present_k, present_v, seqlens_k, do_rotary_,
+                                       position_ids != nullptr ? position_ids->Data<int64_t>() : nullptr,
+                                       !parameters.is_first_prompt ? 1 : 0,
+                                       do_rotary_ ? cos_cache->Data<T>() : nullptr,
+                                       do_rotary_ ? sin_cache->Data<T>() : nullptr, parameters, allocator, context);
+  }
+
   auto element_type = DataTypeImpl::GetType<T>();
   OrtValue Q;
   OrtValue K;
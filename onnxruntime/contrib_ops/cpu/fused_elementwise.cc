@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+struct FusedElementwiseOp {
+  const char* name;
+  MLAS_FUSED_ELTWISE_OPCODE opcode;
+  bool is_binary;
+};
+
+constexpr FusedElementwiseOp kFusedElementwiseOps[] = {
+    {"Add", MlasFusedEltwiseAdd, true},
+    {"Sub", MlasFusedEltwiseSub, true},
+    {"Mul", MlasFusedEltwiseMul, true},
+    {"Div", MlasFusedEltwiseDiv, true},
+    {"Max", MlasFusedEltwiseMax, true},
+    {"Min", MlasFusedEltwiseMin, true},
+    {"Relu", MlasFusedEltwiseRelu, false},
+    {"Neg", MlasFusedEltwiseNeg, false},
+    {"Abs", MlasFusedEltwiseAbs, false},
+    {"Sqrt", MlasFusedEltwiseSqrt, false},
+    {"Reciprocal", MlasFusedEltwiseReciprocal, false},
+    {"Sigmoid", MlasFusedEltwiseLogistic, false},
+    {"Tanh", MlasFusedEltwiseTanh, false},
+    {"Exp", MlasFusedEltwiseExp, false},
+    {"Erf", MlasFusedEltwiseErf, false},
+};
+
+// Number of output elements handed to MLAS per unit of parallel work.
+constexpr int64_t kFusedElementwiseBlockSize = 4096;
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  const std::vector<std::string> ops = info.GetAttrsOrDefault<std::string>("ops");
+  const std::vector<int64_t> operands = info.GetAttrsOrDefault<int64_t>("operands");
+  const size_t input_count = info.GetInputCount();
+
+  ORT_ENFORCE(!ops.empty() && ops.size() <= MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS,
+              "FusedElementwise supports 1 to ", MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS, " ops. Got ", ops.size());
+  ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise expects two operands per op. Got ",
+              operands.size(), " operands for ", ops.size(), " ops");
+  ORT_ENFORCE(input_count >= 1 && input_count <= MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS,
+              "FusedElementwise supports 1 to ", MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS, " inputs. Got ", input_count);
+
+  program_.reserve(ops.size());
+  for (size_t k = 0; k < ops.size(); ++k) {
+    const auto* op = std::find_if(std::begin(kFusedElementwiseOps), std::end(kFusedElementwiseOps),
+                                  [&](const FusedElementwiseOp& entry) { return ops[k] == entry.name; });
+    ORT_ENFORCE(op != std::end(kFusedElementwiseOps), "FusedElementwise does not support op ", ops[k]);
+
+    // An instruction reads the inputs and the results of the instructions before it.
+    const int64_t register_count = static_cast<int64_t>(input_count + k);
+    MLAS_FUSED_ELTWISE_INSTRUCTION instruction;
+    instruction.Opcode = op->opcode;
+    for (size_t j = 0; j < 2; ++j) {
+      const int64_t operand = (j == 0 || op->is_binary) ? operands[2 * k + j] : operands[2 * k];
+      ORT_ENFORCE(operand >= 0 && operand < register_count, "FusedElementwise op ", k, " reads register ", operand,
+                  " which is not defined before it");
+      instruction.Operands[j] = static_cast<uint32_t>(operand);
+    }
+    program_.push_back(instruction);
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const size_t input_count = static_cast<size_t>(context->InputCount());
+
+  InlinedVector<const float*, MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS> input_data(input_count);
+  size_t rank = 0;
+  for (size_t i = 0; i < input_count; ++i) {
+    const Tensor* input = context->Input<Tensor>(static_cast<int>(i));
+    input_data[i] = input->Data<float>();
+    rank = std::max(rank, input->Shape().NumDimensions());
+  }
+
+  TensorShapeVector output_dims(rank, 1);
+  for (size_t i = 0; i < input_count; ++i) {
+    const auto& shape = context->Input<Tensor>(static_cast<int>(i))->Shape();
+    const size_t offset = rank - shape.NumDimensions();
+    for (size_t d = 0; d < shape.NumDimensions(); ++d) {
+      int64_t& output_dim = output_dims[offset + d];
+      if (shape[d] != 1) {
+        if (output_dim != 1 && output_dim != shape[d]) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                                 shape, " can not be broadcast to shape ", TensorShape(output_dims));
+        }
+        output_dim = shape[d];
+      }
+    }
+  }
+
+  Tensor* output = context->Output(0, output_dims);
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+  float* output_data = output->MutableData<float>();
+
+  // Collapse the output dimensions into runs along which every input is either read or broadcast. The innermost
+  // run is then contiguous or a single element for each input.
+  InlinedVector<int64_t> dims;
+  InlinedVector<uint32_t> broadcast_masks;
+  for (size_t d = 0; d < rank; ++d) {
+    if (output_dims[d] == 1) {
+      continue;
+    }
+    uint32_t mask = 0;
+    for (size_t i = 0; i < input_count; ++i) {
+      const auto& shape = context->Input<Tensor>(static_cast<int>(i))->Shape();
+      const size_t offset = rank - shape.NumDimensions();
+      if (d < offset || shape[d - offset] == 1) {
+        mask |= 1u << i;
+      }
+    }
+    if (!dims.empty() && broadcast_masks.back() == mask) {
+      dims.back() *= output_dims[d];
+    } else {
+      dims.push_back(output_dims[d]);
+      broadcast_masks.push_back(mask);
+    }
+  }
+  if (dims.empty()) {
+    dims.push_back(1);
+    broadcast_masks.push_back((1u << input_count) - 1);
+  }
+
+  const size_t outer_rank = dims.size() - 1;
+  InlinedVector<int64_t> input_strides(input_count * outer_rank);
+  bool input_is_scalar[MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS];
+  for (size_t i = 0; i < input_count; ++i) {
+    const bool inner_broadcast = (broadcast_masks.back() >> i) & 1;
+    input_is_scalar[i] = inner_broadcast;
+    int64_t stride = inner_broadcast ? 1 : dims.back();
+    for (size_t d = outer_rank; d-- > 0;) {
+      const bool broadcast = (broadcast_masks[d] >> i) & 1;
+      input_strides[i * outer_rank + d] = broadcast ? 0 : stride;
+      if (!broadcast) {
+        stride *= dims[d];
+      }
+    }
+  }
+
+  const int64_t inner = dims.back();
+  const int64_t rows = output->Shape().Size() / inner;
+  const int64_t blocks_per_row = (inner + kFusedElementwiseBlockSize - 1) / kFusedElementwiseBlockSize;
+  const double block_size = static_cast<double>(std::min(inner, kFusedElementwiseBlockSize));
+  const TensorOpCost cost{static_cast<double>(input_count * sizeof(float)) * block_size,
+                          static_cast<double>(sizeof(float)) * block_size,
+                          static_cast<double>(program_.size()) * block_size * 4.0};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(rows * blocks_per_row), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const float* block_inputs[MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS];
+
+        for (std::ptrdiff_t work = first; work < last; ++work) {
+          const int64_t row = work / blocks_per_row;
+          const int64_t start = (work % blocks_per_row) * kFusedElementwiseBlockSize;
+
+          for (size_t i = 0; i < input_count; ++i) {
+            block_inputs[i] = input_data[i] + (input_is_scalar[i] ? 0 : start);
+          }
+          int64_t index = row;
+          for (size_t d = outer_rank; d-- > 0;) {
+            const int64_t coordinate = index % dims[d];
+            index /= dims[d];
+            for (size_t i = 0; i < input_count; ++i) {
+              block_inputs[i] += coordinate * input_strides[i * outer_rank + d];
+            }
+          }
+
+          MlasComputeFusedEltwise(program_.data(), program_.size(), block_inputs, input_is_scalar, input_count,
+                                  output_data + row * inner + start,
+                                  static_cast<size_t>(std::min(kFusedElementwiseBlockSize, inner - start)));
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
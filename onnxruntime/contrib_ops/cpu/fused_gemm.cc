@@ -9,6 +9,31 @@ namespace contrib {
 constexpr const char* ACTIVATION_NAME_PREFIX = "activation_";
 constexpr size_t ACTIVATION_NAME_PREFIX_LEN = 11;
 
+// Maps the activations that MLAS implements to a MLAS_ACTIVATION, so that Gemm<float> applies them in the
+// SGEMM epilogue. Returns false for the remaining activations, which run as a separate pass over the output.
+static bool GetMlasActivation(const std::string& activation, const NodeAttributes& attrs,
+                              MLAS_ACTIVATION& mlas_activation) {
+  if (activation == "Relu") {
+    mlas_activation.ActivationKind = MlasReluActivation;
+  } else if (activation == "Tanh") {
+    mlas_activation.ActivationKind = MlasTanhActivation;
+  } else if (activation == "Sigmoid") {
+    mlas_activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation == "Gelu") {
+    mlas_activation.ActivationKind = MlasGeluActivation;
+  } else if (activation == "LeakyRelu") {
+    mlas_activation.ActivationKind = MlasLeakyReluActivation;
+    return functors::GetFloatParam("alpha", attrs, mlas_activation.Parameters.LeakyRelu.alpha).IsOK();
+  } else if (activation == "HardSigmoid") {
+    mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+    return functors::GetFloatParam("alpha", attrs, mlas_activation.Parameters.HardSigmoid.alpha).IsOK() &&
+           functors::GetFloatParam("beta", attrs, mlas_activation.Parameters.HardSigmoid.beta).IsOK();
+  } else {
+    return false;
+  }
+  return true;
+}
+
 template <typename T>
 class FusedGemm final : public Gemm<T> {
  public:
@@ -20,7 +45,12 @@ class FusedGemm final : public Gemm<T> {
         attrs[p.first.substr(ACTIVATION_NAME_PREFIX_LEN)] = p.second;
       }
     }
-    ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
+    MLAS_ACTIVATION mlas_activation;
+    if (GetMlasActivation(activation, attrs, mlas_activation)) {
+      this->mlas_activation_ = mlas_activation;
+    } else {
+      ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
+    }
   }
 };
 
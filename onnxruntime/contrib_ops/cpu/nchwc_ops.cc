@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "nchwc_ops.h"
+#include <numeric>
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/mlas/inc/mlas.h"
@@ -221,6 +222,386 @@ Status NchwcConv::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+namespace {
+
+// Describes the filter taps along one spatial axis of a ConvTranspose that contribute to the outputs o of a phase,
+// which are the outputs where (o + pad) % stride equals the residue. The phase is the stride one convolution of the
+// input with these taps in reverse order.
+struct ConvTransposeTaps {
+  int64_t first;        // filter index of the first tap
+  int64_t step;         // distance between the filter indices of consecutive taps
+  int64_t count;        // number of taps
+  int64_t dilation;     // distance between the inputs read by consecutive taps
+  int64_t last_offset;  // input offset read by the last tap, as in i = (o + pad) / stride - last_offset
+};
+
+ConvTransposeTaps GetConvTransposeTaps(int64_t kernel, int64_t stride, int64_t dilation, int64_t residue) {
+  const int64_t divisor = std::gcd(stride, dilation);
+  ConvTransposeTaps taps{0, stride / divisor, 0, dilation / divisor, 0};
+
+  // The tap k contributes to the phase when k * dilation == residue (mod stride), which repeats every step taps.
+  for (int64_t k = 0; k < taps.step && k < kernel; k++) {
+    if ((k * dilation) % stride == residue) {
+      taps.first = k;
+      taps.count = (kernel - 1 - k) / taps.step + 1;
+      taps.last_offset = ((k + (taps.count - 1) * taps.step) * dilation - residue) / stride;
+      break;
+    }
+  }
+
+  return taps;
+}
+
+// Describes the outputs of a phase along one spatial axis and the padding of the convolution that computes them.
+// The convolution may compute leading or trailing outputs that fall outside of the ConvTranspose output when the
+// ConvTranspose padding exceeds the filter extent, which are discarded.
+struct ConvTransposePhase {
+  ConvTransposeTaps taps;
+  int64_t residue;
+  int64_t output_start;
+  int64_t output_count;
+  int64_t leading_count;
+  int64_t computed_count;
+  int64_t pads[2];
+};
+
+ConvTransposePhase GetConvTransposePhase(int64_t input_size, int64_t output_size, int64_t kernel, int64_t stride,
+                                         int64_t dilation, int64_t pad, int64_t output_start) {
+  ConvTransposePhase phase{};
+  phase.output_start = output_start;
+  phase.output_count = std::max<int64_t>((output_size - output_start + stride - 1) / stride, 0);
+
+  // The output o = q * stride + residue - pad reads the inputs q - offset, so the first output of the phase sets the
+  // padding before the input.
+  int64_t first_q = (output_start + pad) / stride;
+  if (first_q * stride > output_start + pad) {
+    first_q--;
+  }
+  phase.residue = output_start + pad - first_q * stride;
+  phase.taps = GetConvTransposeTaps(kernel, stride, dilation, phase.residue);
+  if (phase.taps.count == 0) {
+    return phase;
+  }
+
+  int64_t pad_begin = phase.taps.last_offset - first_q;
+  phase.leading_count = std::max<int64_t>(-pad_begin, 0);
+  pad_begin += phase.leading_count;
+
+  const int64_t span = (phase.taps.count - 1) * phase.taps.dilation + 1;
+  const int64_t valid_count = input_size + pad_begin - span + 1;
+  phase.computed_count = std::max(phase.leading_count + phase.output_count, valid_count);
+  phase.pads[0] = pad_begin;
+  phase.pads[1] = phase.computed_count - valid_count;
+  return phase;
+}
+
+// Returns the strides or dilations attribute, which default to one along each spatial axis.
+TensorShapeVector GetStridesOrDilations(const TensorShapeVector& values) {
+  return values.empty() ? TensorShapeVector(2, 1) : values;
+}
+
+// Reorders the ConvTranspose filter {C, M, kH, kW} to one OIHWBiBo convolution filter per phase, ordered by the
+// residues along the height and then the width. The filter of a phase without taps is empty. Returns the number of
+// elements of the reordered filter, which is only computed if packed_filter is nullptr.
+size_t ReorderConvTransposeFilter(const TensorShape& filter_shape,
+                                  const TensorShapeVector& kernel_shape,
+                                  const TensorShapeVector& strides,
+                                  const TensorShapeVector& dilations,
+                                  const float* filter,
+                                  float* packed_filter) {
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t input_channels = filter_shape[0];
+  const int64_t output_channels = filter_shape[1];
+  const int64_t nchwc_input_channels = (input_channels + nchwc_block_size - 1) & ~(nchwc_block_size - 1);
+  const int64_t nchwc_output_channels = (output_channels + nchwc_block_size - 1) & ~(nchwc_block_size - 1);
+
+  size_t packed_size = 0;
+  std::vector<float> phase_filter;
+
+  for (int64_t residue_h = 0; residue_h < strides[0]; residue_h++) {
+    const auto taps_h = GetConvTransposeTaps(kernel_shape[0], strides[0], dilations[0], residue_h);
+    for (int64_t residue_w = 0; residue_w < strides[1]; residue_w++) {
+      const auto taps_w = GetConvTransposeTaps(kernel_shape[1], strides[1], dilations[1], residue_w);
+      const size_t phase_size = SafeInt<size_t>(nchwc_output_channels) * nchwc_input_channels * taps_h.count *
+                                taps_w.count;
+
+      if (packed_filter != nullptr && phase_size != 0) {
+        // Gather the taps of the phase in reverse order as a {M, C, tH, tW} convolution filter.
+        phase_filter.resize(SafeInt<size_t>(output_channels) * input_channels * taps_h.count * taps_w.count);
+        float* phase_filter_data = phase_filter.data();
+        for (int64_t m = 0; m < output_channels; m++) {
+          for (int64_t c = 0; c < input_channels; c++) {
+            const float* filter_channel = filter + (c * output_channels + m) * kernel_shape[0] * kernel_shape[1];
+            for (int64_t th = taps_h.count - 1; th >= 0; th--) {
+              const float* filter_row = filter_channel + (taps_h.first + th * taps_h.step) * kernel_shape[1];
+              for (int64_t tw = taps_w.count - 1; tw >= 0; tw--) {
+                *phase_filter_data++ = filter_row[taps_w.first + tw * taps_w.step];
+              }
+            }
+          }
+        }
+
+        const int64_t phase_filter_shape[] = {output_channels, input_channels, taps_h.count, taps_w.count};
+        MlasReorderFilterOIHWBiBo(phase_filter_shape, phase_filter.data(), packed_filter + packed_size);
+      }
+
+      packed_size += phase_size;
+    }
+  }
+
+  return packed_size;
+}
+
+}  // namespace
+
+Status NchwcConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack filter tensor
+  if (input_idx == 1) {
+    TensorShapeVector kernel_shape;
+    ORT_RETURN_IF_ERROR(conv_transpose_attrs_.ComputeKernelShape(tensor.Shape(), kernel_shape));
+    const auto strides = GetStridesOrDilations(conv_transpose_attrs_.strides);
+    const auto dilations = GetStridesOrDilations(conv_transpose_attrs_.dilations);
+    if (kernel_shape.size() != 2 || strides.size() != 2 || dilations.size() != 2) {
+      return Status::OK();
+    }
+    filter_shape_ = tensor.Shape();
+
+    const size_t packed_filter_size =
+        ReorderConvTransposeFilter(filter_shape_, kernel_shape, strides, dilations, nullptr, nullptr);
+    const size_t packed_filter_data_size = SafeInt<size_t>(packed_filter_size) * sizeof(float);
+    auto* packed_filter_data = static_cast<float*>(alloc->Alloc(packed_filter_data_size));
+    packed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+    ReorderConvTransposeFilter(filter_shape_, kernel_shape, strides, dilations, tensor.Data<float>(),
+                               packed_filter_data);
+
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_filter_));
+      prepacked_weights->buffer_sizes_.push_back(packed_filter_data_size);
+    }
+
+    is_packed = true;
+  }
+  return Status::OK();
+}
+
+Status NchwcConvTranspose::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_filter_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status NchwcConvTranspose::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = packed_filter_ ? nullptr : context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+
+  const auto& X_shape = X->Shape();
+  ORT_ENFORCE(X_shape.NumDimensions() == 4);
+
+  const TensorShape& W_shape = packed_filter_ ? filter_shape_ : W->Shape();
+  ORT_RETURN_IF_NOT(W_shape.NumDimensions() == 4, "X num_dims does not match W num_dims.");
+
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t batch_count = X_shape[0];
+  const int64_t input_channels = W_shape[0];
+  const int64_t output_channels = W_shape[1];
+  const int64_t nchwc_input_channels = (input_channels + nchwc_block_size - 1) & ~(nchwc_block_size - 1);
+  const int64_t nchwc_output_channels = (output_channels + nchwc_block_size - 1) & ~(nchwc_block_size - 1);
+  ORT_RETURN_IF_NOT(X_shape[1] == nchwc_input_channels, "input channels do not match the filter");
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_transpose_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  const auto strides = GetStridesOrDilations(conv_transpose_attrs_.strides);
+  const auto dilations = GetStridesOrDilations(conv_transpose_attrs_.dilations);
+  TensorShapeVector output_padding(conv_transpose_attrs_.output_padding);
+  if (output_padding.empty()) {
+    output_padding.resize(2, 0);
+  }
+  ConvPadVector pads(conv_transpose_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(4, 0);
+  }
+  if (kernel_shape.size() != 2 || strides.size() != 2 || dilations.size() != 2 || output_padding.size() != 2 ||
+      pads.size() != 4) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Unsupported convolution size.");
+  }
+
+  TensorShapeVector Y_dims;
+  conv_transpose_attrs_.ComputePadsAndOutputShape(X_shape.Slice(2), nchwc_output_channels, kernel_shape, strides,
+                                                  dilations, output_padding, batch_count, &pads, &Y_dims);
+  auto* Y = context->Output(0, Y_dims);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Reorder the filter here if it was not packed, such as when it is not a constant initializer.
+  const float* packed_filter = static_cast<const float*>(packed_filter_.get());
+  IAllocatorUniquePtr<float> reordered_filter;
+  if (packed_filter == nullptr) {
+    const size_t reordered_filter_size =
+        ReorderConvTransposeFilter(W_shape, kernel_shape, strides, dilations, nullptr, nullptr);
+    reordered_filter = IAllocator::MakeUniquePtr<float>(alloc, reordered_filter_size);
+    ReorderConvTransposeFilter(W_shape, kernel_shape, strides, dilations, W->Data<float>(),
+                               reordered_filter.get());
+    packed_filter = reordered_filter.get();
+  }
+
+  // Align the optional bias up to the number of NCHWc output channels. The bias is also the output of the phases
+  // that have no filter taps.
+  InlinedVector<float> aligned_bias(narrow<size_t>(nchwc_output_channels));
+  if (B != nullptr) {
+    ORT_RETURN_IF_NOT(B->Shape().Size() == output_channels, "bias size does not match the output channels");
+    std::copy_n(B->Data<float>(), narrow<size_t>(output_channels), aligned_bias.data());
+  }
+
+  // Compute the phases along each spatial axis and the offset of the filter of each phase.
+  const int64_t input_h = X_shape[2];
+  const int64_t input_w = X_shape[3];
+  const int64_t output_h = Y_dims[2];
+  const int64_t output_w = Y_dims[3];
+
+  InlinedVector<ConvTransposePhase> phases_h;
+  InlinedVector<ConvTransposePhase> phases_w;
+  int64_t computed_h = 0;
+  int64_t computed_w = 0;
+  for (int64_t start = 0; start < strides[0]; start++) {
+    phases_h.push_back(GetConvTransposePhase(input_h, output_h, kernel_shape[0], strides[0], dilations[0], pads[0],
+                                             start));
+    computed_h = std::max(computed_h, phases_h.back().computed_count);
+  }
+  for (int64_t start = 0; start < strides[1]; start++) {
+    phases_w.push_back(GetConvTransposePhase(input_w, output_w, kernel_shape[1], strides[1], dilations[1], pads[1],
+                                             start));
+    computed_w = std::max(computed_w, phases_w.back().computed_count);
+  }
+
+  InlinedVector<size_t> filter_offsets(narrow<size_t>(strides[0] * strides[1]) + 1);
+  for (int64_t residue_h = 0, index = 0; residue_h < strides[0]; residue_h++) {
+    const auto taps_h = GetConvTransposeTaps(kernel_shape[0], strides[0], dilations[0], residue_h);
+    for (int64_t residue_w = 0; residue_w < strides[1]; residue_w++, index++) {
+      const auto taps_w = GetConvTransposeTaps(kernel_shape[1], strides[1], dilations[1], residue_w);
+      filter_offsets[narrow<size_t>(index) + 1] =
+          filter_offsets[narrow<size_t>(index)] +
+          SafeInt<size_t>(nchwc_output_channels) * nchwc_input_channels * taps_h.count * taps_w.count;
+    }
+  }
+
+  // A single phase that produces the whole output, as with unit strides and no excess padding, is computed in
+  // place. Otherwise each phase is computed to a buffer and then interleaved into the output.
+  const bool compute_in_place = phases_h.size() == 1 && phases_w.size() == 1 &&
+                                phases_h[0].leading_count == 0 && phases_h[0].computed_count == output_h &&
+                                phases_w[0].leading_count == 0 && phases_w[0].computed_count == output_w;
+
+  IAllocatorUniquePtr<float> phase_buffer;
+  if (!compute_in_place) {
+    phase_buffer = IAllocator::MakeUniquePtr<float>(
+        alloc, SafeInt<size_t>(batch_count) * nchwc_output_channels * computed_h * computed_w);
+  }
+
+  const auto* x_data = X->Data<float>();
+  auto* y_data = Y->MutableData<float>();
+  const int64_t channel_blocks = nchwc_output_channels / nchwc_block_size;
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  for (const auto& phase_h : phases_h) {
+    for (const auto& phase_w : phases_w) {
+      if (phase_h.output_count == 0 || phase_w.output_count == 0) {
+        continue;
+      }
+
+      const bool has_taps = phase_h.taps.count != 0 && phase_w.taps.count != 0;
+      float* phase_output = compute_in_place ? y_data : phase_buffer.get();
+
+      if (has_taps) {
+        const int64_t phase_input_shape[] = {batch_count, nchwc_input_channels, input_h, input_w};
+        const int64_t phase_kernel_shape[] = {phase_h.taps.count, phase_w.taps.count};
+        const int64_t phase_dilations[] = {phase_h.taps.dilation, phase_w.taps.dilation};
+        const int64_t phase_pads[] = {phase_h.pads[0], phase_w.pads[0], phase_h.pads[1], phase_w.pads[1]};
+        const int64_t phase_strides[] = {1, 1};
+        const int64_t phase_output_shape[] = {batch_count, nchwc_output_channels, phase_h.computed_count,
+                                              phase_w.computed_count};
+
+        MlasNchwcConv(
+            phase_input_shape,
+            phase_kernel_shape,
+            phase_dilations,
+            phase_pads,
+            phase_strides,
+            phase_output_shape,
+            1,
+            x_data,
+            packed_filter + filter_offsets[narrow<size_t>(phase_h.residue * strides[1] + phase_w.residue)],
+            aligned_bias.data(),
+            phase_output,
+            &activation,
+            true,
+            thread_pool);
+
+        if (compute_in_place) {
+          continue;
+        }
+      }
+
+      // Interleave the rows of the phase into the output. Each row copies or broadcasts NCHWc blocks with a
+      // stride of the stride width.
+      const int64_t row_count = batch_count * channel_blocks * phase_h.output_count;
+      const double row_bytes = static_cast<double>(phase_w.output_count * nchwc_block_size * sizeof(float));
+
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, narrow<std::ptrdiff_t>(row_count), TensorOpCost{row_bytes, row_bytes, 0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t row = first; row < last; row++) {
+              const int64_t channel_block = row / phase_h.output_count;
+              const int64_t phase_row = row % phase_h.output_count;
+              const int64_t output_row = phase_h.output_start + phase_row * strides[0];
+              float* y_row = y_data + ((channel_block * output_h + output_row) * output_w + phase_w.output_start) *
+                                          nchwc_block_size;
+              const int64_t y_step = strides[1] * nchwc_block_size;
+
+              if (has_taps) {
+                const float* phase_row_data =
+                    phase_output + ((channel_block * phase_h.computed_count + phase_h.leading_count + phase_row) *
+                                        phase_w.computed_count +
+                                    phase_w.leading_count) *
+                                       nchwc_block_size;
+                for (int64_t i = 0; i < phase_w.output_count; i++) {
+                  std::copy_n(phase_row_data + i * nchwc_block_size, nchwc_block_size, y_row + i * y_step);
+                }
+              } else {
+                const float* bias_block = aligned_bias.data() + (channel_block % channel_blocks) * nchwc_block_size;
+                for (int64_t i = 0; i < phase_w.output_count; i++) {
+                  std::copy_n(bias_block, nchwc_block_size, y_row + i * y_step);
+                }
+              }
+            }
+          });
+    }
+  }
+
+  return Status::OK();
+}
+
 Status NchwcPoolBase::NchwcPool(OpKernelContext* context, MLAS_POOLING_KIND kind) const {
   const auto* X = context->Input<Tensor>(0);
   const auto& X_shape = X->Shape();
@@ -405,6 +786,14 @@ ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     NchwcConv);
 
+ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
+    ConvTranspose,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcConvTranspose);
+
 ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
     MaxPool,
     1,
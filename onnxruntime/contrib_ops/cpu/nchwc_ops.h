@@ -6,6 +6,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/providers/cpu/nn/conv_transpose_attributes.h"
 #include "core/providers/cpu/nn/pool.h"
 #include "contrib_ops/cpu/fused_activation.h"
 
@@ -53,6 +54,33 @@ class NchwcConv final : public OpKernel {
   MLAS_ACTIVATION activation_;
 };
 
+// Computes ConvTranspose as one stride one NCHWc convolution per output phase, where a phase is the set of outputs
+// that share the same position modulo the strides. Each phase reads a subset of the filter taps, so PrePack splits
+// the filter into a reordered convolution filter per phase.
+class NchwcConvTranspose final : public OpKernel {
+ public:
+  NchwcConvTranspose(const OpKernelInfo& info) : OpKernel(info), conv_transpose_attrs_(info) {
+    ORT_ENFORCE(conv_transpose_attrs_.group == 1, "grouped NCHWc ConvTranspose is not supported");
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  ConvTransposeAttributes conv_transpose_attrs_;
+
+  // for pre-packing usage
+  TensorShape filter_shape_;
+  BufferUniquePtr packed_filter_;
+};
+
 class NchwcPoolBase : public PoolBase {
  public:
   NchwcPoolBase(const OpKernelInfo& info) : PoolBase(info) {
@@ -142,7 +142,7 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
     params.BIsPacked = bool(packed_b_);
-    params.B = b_tensor ? static_cast<const uint8_t*>(b_tensor->DataRaw()) + helper.RightOffsets()[gemm_idx] : packed_b_.get();
+    params.B = b_tensor ? static_cast<const uint8_t*>(b_tensor->DataRaw()) + helper.RightOffsets()[gemm_idx] : NumaPartitions::GetLocalBuffer(packed_b_.get());
     params.ldb = gemm_shape.N;
     params.ZeroPointB = b_zp_ptr + helper.RightZeroPointOffsets()[gemm_idx];
     params.PerColumnZeroPoints = is_b_zp_per_column;
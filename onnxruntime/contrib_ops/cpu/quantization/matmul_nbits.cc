@@ -112,8 +112,8 @@ class MatMulNBits final : public OpKernel {
       has_unquantized_zero_point_ = type != ONNX_NAMESPACE::TensorProto_DataType_UINT8;
     }
 
-    ORT_ENFORCE(nbits_ == 4 || nbits_ == 8,
-                "Only 4b and 8b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    ORT_ENFORCE(nbits_ == 2 || nbits_ == 3 || nbits_ == 4 || nbits_ == 8,
+                "Only 2b, 3b, 4b and 8b quantization is supported for MatMulNBits op, additional bits support is planned.");
     const Tensor* tensor_zero_point = nullptr;
     has_zp_input_ = info.TryGetConstantInput(InputIndex::zero_points, &tensor_zero_point);
   }
@@ -469,7 +469,17 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
           static_cast<int32_t>(K_),                       // number of rows in quantized input
           static_cast<int32_t>(N_),                       // number of columns in quantized input
           thread_pool);
-    } else {  // If it isn't 4bit, it has to be 8-bit quantization
+    } else if (nbits_ == 2 || nbits_ == 3) {
+      DequantizeLowBitsBlockwise(tmp_b_data_ptr.get(),
+                                 b_data,
+                                 scales_data,
+                                 static_cast<const uint8_t*>(zero_points_data),
+                                 static_cast<int32_t>(nbits_),
+                                 static_cast<int32_t>(block_size_),
+                                 static_cast<int32_t>(K_),
+                                 static_cast<int32_t>(N_),
+                                 thread_pool);
+    } else {  // Otherwise it has to be 8-bit quantization
       ORT_ENFORCE(nbits_ == 8);
       MlasDequantizeBlockwise<float, 8>(
           tmp_b_data_ptr.get(),                           // dequantized output
@@ -606,7 +616,17 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
           static_cast<int32_t>(K_),                       // number of rows in quantized input
           static_cast<int32_t>(N_),                       // number of columns in quantized input
           thread_pool);
-    } else {  // If it isn't 4bit, it has to be 8-bit quantization
+    } else if (nbits_ == 2 || nbits_ == 3) {
+      DequantizeLowBitsBlockwise(tmp_b_data_ptr.get(),
+                                 b_data,
+                                 scales_ptr,
+                                 static_cast<const uint8_t*>(zero_points_data),
+                                 static_cast<int32_t>(nbits_),
+                                 static_cast<int32_t>(block_size_),
+                                 static_cast<int32_t>(K_),
+                                 static_cast<int32_t>(N_),
+                                 thread_pool);
+    } else {  // Otherwise it has to be 8-bit quantization
       ORT_ENFORCE(nbits_ == 8);
       MlasDequantizeBlockwise<float, 8>(
           tmp_b_data_ptr.get(),                           // dequantized output
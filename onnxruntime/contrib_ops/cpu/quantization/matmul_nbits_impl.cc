@@ -117,5 +117,47 @@ template void DequantizeBlockwise<float, MLFloat16>(
     const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t block_size,
     bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
+void DequantizeLowBitsBlockwise(
+    float* output,
+    const uint8_t* quant_data,
+    const float* scales_data,
+    const uint8_t* zero_points,
+    int32_t nbits,
+    int32_t block_size,
+    int32_t K,
+    int32_t N,
+    onnxruntime::concurrency::ThreadPool* pool) {
+  ORT_ENFORCE(nbits == 2 || nbits == 3, "Unsupported bit width: ", nbits);
+
+  const size_t bits = static_cast<size_t>(nbits);
+  const int32_t k_blocks = (K + block_size - 1) / block_size;
+  const size_t column_bytes = static_cast<size_t>(k_blocks) * block_size * bits / 8;
+  const size_t zero_point_column_bytes = (static_cast<size_t>(k_blocks) * bits + 7) / 8;
+  const uint32_t value_mask = (1u << bits) - 1;
+
+  auto extract = [bits, value_mask](const uint8_t* data, size_t index) {
+    const size_t bit = index * bits;
+    uint32_t value = data[bit / 8];
+    if (bit % 8 + bits > 8) {
+      value |= static_cast<uint32_t>(data[bit / 8 + 1]) << 8;
+    }
+    return (value >> (bit % 8)) & value_mask;
+  };
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      pool, static_cast<std::ptrdiff_t>(N),
+      [&](std::ptrdiff_t n) {
+        const uint8_t* column = quant_data + n * column_bytes;
+        const float* scales = scales_data + n * k_blocks;
+        const uint8_t* column_zero_points = zero_points == nullptr ? nullptr : zero_points + n * zero_point_column_bytes;
+        float* dst = output + static_cast<size_t>(n) * K;
+        for (int32_t k = 0; k < K; k++) {
+          const int32_t block = k / block_size;
+          const uint32_t zp = column_zero_points == nullptr ? (1u << (bits - 1)) : extract(column_zero_points, block);
+          dst[k] = (static_cast<float>(extract(column, static_cast<size_t>(k))) - static_cast<float>(zp)) * scales[block];
+        }
+      });
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -19,5 +19,18 @@ void DequantizeBlockwise(
     int32_t N,                   // number of columns in quantized input
     onnxruntime::concurrency::ThreadPool* thread_pool);
 
+// Dequantize B of bit width 2 or 3, whose columns and zero points are LSB first bit streams.
+// The output is N x K.
+void DequantizeLowBitsBlockwise(
+    float* output,               // dequantized output
+    const uint8_t* quant_data,   // quantized input
+    const float* scales_data,    // quantization scales
+    const uint8_t* zero_points,  // quantization zero points
+    int32_t nbits,               // number of bits of each quantized value
+    int32_t block_size,          // quantization block size
+    int32_t K,                   // number of rows in quantized input
+    int32_t N,                   // number of columns in quantized input
+    onnxruntime::concurrency::ThreadPool* thread_pool);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -57,7 +57,7 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
     const uint8_t* b_data = nullptr;
     std::optional<Tensor> b_trans_buffer;
     if (nullptr == b) {
-      b_data = static_cast<const uint8_t*>(packed_b_.get());
+      b_data = static_cast<const uint8_t*>(NumaPartitions::GetLocalBuffer(packed_b_.get()));
       b_is_signed = b_is_signed_;
     } else {
       b_data = static_cast<const uint8_t*>(b->DataRaw());
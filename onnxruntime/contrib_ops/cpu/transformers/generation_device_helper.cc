@@ -4,10 +4,12 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <type_traits>
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "core/providers/cpu/generator/random.h"
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include <gsl/gsl>
 #include "contrib_ops/cpu/transformers/sequences.h"
 #include "contrib_ops/cpu/transformers/beam_search_scorer.h"
@@ -35,6 +37,92 @@ Status TopK(const Tensor* input, const int axis, const unsigned k, bool largest,
                          input->DataType(), " is not supported yet");
 }
 
+namespace {
+
+struct TokenCandidate {
+  float score;
+  int32_t token;
+};
+
+bool CandidateRanksBefore(const TokenCandidate& a, const TokenCandidate& b) {
+  return a.score > b.score || (a.score == b.score && a.token < b.token);
+}
+
+// Selects the best k tokens of each row with one pass of MlasLogSoftmaxTopK over the row, where the score of a token
+// is scale * penalize(log_softmax(logits)) + addends[row] when log_softmax is true, else penalize(logits).
+// penalize() is the repetition penalty of the tokens in the sequence of the row, as in
+// RepetitionPenaltyLogitsProcessor. Since it can move those tokens up or down, they are scored apart from the
+// selection, which takes enough extra candidates to hold k tokens that are not penalized.
+// candidates gets k entries per row, ordered by descending score then ascending token.
+void SelectTopTokens(const float* logits,
+                     int rows,
+                     int vocab_size,
+                     int k,
+                     bool log_softmax,
+                     float scale,
+                     const float* addends,
+                     float repetition_penalty,
+                     const transformers::ISequences* sequences,
+                     onnxruntime::concurrency::ThreadPool* thread_pool,
+                     std::vector<TokenCandidate>& candidates) {
+  std::vector<std::vector<int32_t>> penalized_tokens(rows);
+  size_t max_penalized = 0;
+  if (repetition_penalty != 1.0f) {
+    for (int i = 0; i < rows; i++) {
+      gsl::span<const int32_t> sequence = sequences->GetSequence(i);
+      std::vector<int32_t>& tokens = penalized_tokens[i];
+      tokens.assign(sequence.begin(), sequence.end());
+      std::sort(tokens.begin(), tokens.end());
+      tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+      max_penalized = std::max(max_penalized, tokens.size());
+    }
+  }
+
+  const size_t selected = std::min(static_cast<size_t>(vocab_size), static_cast<size_t>(k) + max_penalized);
+  const size_t rows_selected = SafeInt<size_t>(rows) * selected;
+  std::vector<float> values(log_softmax ? rows_selected : 0);
+  std::vector<int32_t> indices(rows_selected);
+  std::vector<float> log_sum_exp(log_softmax ? rows : 0);
+
+  MLAS_LOG_SOFTMAX_TOPK_PARAMS params;
+  params.Input = logits;
+  params.Rows = static_cast<size_t>(rows);
+  params.N = static_cast<size_t>(vocab_size);
+  params.K = selected;
+  params.Scale = scale;
+  params.Addends = log_softmax ? addends : nullptr;
+  params.Values = log_softmax ? values.data() : nullptr;
+  params.Indices = indices.data();
+  params.LogSumExp = log_softmax ? log_sum_exp.data() : nullptr;
+  MlasLogSoftmaxTopK(params, thread_pool);
+
+  candidates.resize(SafeInt<size_t>(rows) * k);
+  std::vector<TokenCandidate> row_candidates;
+  for (int i = 0; i < rows; i++) {
+    const float* row_logits = logits + SafeInt<size_t>(i) * vocab_size;
+    const std::vector<int32_t>& tokens = penalized_tokens[i];
+    const float addend = (log_softmax && addends != nullptr) ? addends[i] : 0.0f;
+
+    row_candidates.clear();
+    for (size_t j = 0; j < selected; j++) {
+      const int32_t token = indices[i * selected + j];
+      if (!std::binary_search(tokens.begin(), tokens.end(), token)) {
+        row_candidates.push_back({log_softmax ? values[i * selected + j] : row_logits[token], token});
+      }
+    }
+    for (const int32_t token : tokens) {
+      float score = log_softmax ? row_logits[token] - log_sum_exp[i] : row_logits[token];
+      score = (score < 0 ? score * repetition_penalty : score / repetition_penalty);
+      row_candidates.push_back({log_softmax ? scale * score + addend : score, token});
+    }
+
+    std::partial_sort(row_candidates.begin(), row_candidates.begin() + k, row_candidates.end(), CandidateRanksBefore);
+    std::copy(row_candidates.begin(), row_candidates.begin() + k, candidates.begin() + SafeInt<size_t>(i) * k);
+  }
+}
+
+}  // namespace
+
 template <typename T>
 void ExpandInputs(const OrtValue& input, int num_beams, AllocatorPtr allocator, OrtValue& expanded) {
   // Input shape (batch_size, sequence_length). The input is required with data type T.
@@ -335,6 +423,53 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   }
 #endif
 
+  if constexpr (std::is_same_v<T, float>) {
+    float repetition_penalty = 1.0f;
+    float temperature = 1.0f;
+    if (!output_scores && logits_processors->GetInlineProcessors(step, repetition_penalty, temperature)) {
+      // Compute log_softmax, the repetition penalty, the temperature, the beam scores and the top-k candidates of each
+      // beam in one pass over its logits, then keep the best 2 * num_beams candidates of all beams of a batch.
+      // The best candidates of a batch are among the best candidates of its beams.
+      const int top_k = 2 * num_beams;
+      std::vector<TokenCandidate> candidates;
+      SelectTopTokens((input_length == 1 && logits_batch_size == batch_beam_size) ? logits_data
+                                                                                   : next_token_logits.data(),
+                      batch_beam_size, vocab_size, top_k, true, 1.0f / temperature,
+                      beam_state->beam_scores.data(), repetition_penalty, sequences, thread_pool, candidates);
+
+      std::vector<TokenCandidate> batch_candidates(SafeInt<size_t>(num_beams) * top_k);
+      for (int i = 0; i < batch_size; i++) {
+        for (int j = 0; j < num_beams; j++) {
+          for (int t = 0; t < top_k; t++) {
+            const TokenCandidate& candidate = candidates[(SafeInt<size_t>(i) * num_beams + j) * top_k + t];
+            batch_candidates[SafeInt<size_t>(j) * top_k + t] = {candidate.score, j * vocab_size + candidate.token};
+          }
+        }
+        std::partial_sort(batch_candidates.begin(), batch_candidates.begin() + top_k, batch_candidates.end(),
+                          CandidateRanksBefore);
+        for (int t = 0; t < top_k; t++) {
+          const size_t offset = SafeInt<size_t>(i) * top_k + t;
+          beam_state->next_scores[offset] = batch_candidates[t].score;
+          beam_state->next_indices[offset] = batch_candidates[t].token / vocab_size;
+          beam_state->next_tokens[offset] = batch_candidates[t].token % vocab_size;
+        }
+      }
+
+      gsl::span<const float> next_scores(beam_state->next_scores.data(), beam_state->next_scores.size());
+      gsl::span<const int32_t> next_tokens(beam_state->next_tokens.data(), beam_state->next_tokens.size());
+      gsl::span<const int32_t> next_indices(beam_state->next_indices.data(), beam_state->next_indices.size());
+
+#ifdef DEBUG_GENERATION
+      dumper->Print("next_scores before scorer", next_scores.data(), batch_size, top_k);
+      dumper->Print("next_tokens before scorer", next_tokens.data(), batch_size, top_k);
+      dumper->Print("next_indices before scorer", next_indices.data(), batch_size, top_k);
+#endif
+
+      beam_scorer->Process(*sequences, next_scores, next_tokens, next_indices);
+      return Status::OK();
+    }
+  }
+
   // Get scores for candidates of next token: next_token_scores = log_softmax(next_token_logits, dim=-1)
   gsl::span<T>& next_token_scores = beam_state->next_token_scores;
   ORT_RETURN_IF_ERROR(
@@ -463,10 +598,43 @@ Status GreedySearchProcessLogits(
   ORT_ENFORCE(logits_shape.NumDimensions() == 3);
   auto input_length = logits_shape[1];
 
+  // When the logits processors can be applied inline, the next tokens are selected by a single pass over the logits.
+  float repetition_penalty = 1.0f;
+  float temperature = 1.0f;
+  const bool fused_selection = std::is_same_v<T, float> && !do_sampling &&
+                               logits_processors->GetInlineProcessors(step, repetition_penalty, temperature);
+
   // Get logits for the last token:
   //    next_token_logits = logits[:, -1, :], and the result shape is (batch_size, vocab_size)
   // When input_length == 1, use logits directly in SoftmaxCPU below so it only need for input_length > 1.
   gsl::span<T>& next_token_scores = greedy_state->next_token_scores;
+  if constexpr (std::is_same_v<T, float>) {
+    if (fused_selection) {
+      // The temperature does not change the most likely token, so only the repetition penalty is applied.
+      const float* selection_input = logits_data;
+      if (input_length > 1) {
+        const T* last_logits = logits_data + (input_length - 1) * vocab_size;
+        for (int i = 0; i < batch_size; i++) {
+          gsl::copy(gsl::span<const T>(last_logits + SafeInt<size_t>(i) * input_length * vocab_size, vocab_size),
+                    next_token_scores.subspan(SafeInt<gsl::index>(i) * vocab_size, static_cast<gsl::index>(vocab_size)));
+        }
+        selection_input = next_token_scores.data();
+      }
+
+      std::vector<TokenCandidate> candidates;
+      SelectTopTokens(selection_input, batch_size, vocab_size, 1, false, 1.0f, nullptr, repetition_penalty, sequences,
+                      thread_pool, candidates);
+      for (int i = 0; i < batch_size; i++) {
+        greedy_state->next_tokens[i] = candidates[i].token;
+      }
+
+#ifdef DEBUG_GENERATION
+      dumper->Print("next_tokens before scorer", greedy_state->next_tokens.data(), batch_size, 1);
+#endif
+      return Status::OK();
+    }
+  }
+
   const T* current_logits = logits_data + (input_length - 1) * vocab_size;
   for (int i = 0; i < batch_size; i++) {
     gsl::span<const T> source(current_logits, vocab_size);
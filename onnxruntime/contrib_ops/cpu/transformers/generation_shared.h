@@ -106,6 +106,14 @@ struct ISequences {
 struct ILogitsProcessorList {
   virtual ~ILogitsProcessorList() {}
   virtual void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step) = 0;
+
+  // Returns true when the processors applied at this step are at most the repetition penalty and the temperature,
+  // which the fused log softmax and top-k of the CPU search can apply inline. Inactive ones are reported as 1.0f.
+  virtual bool GetInlineProcessors(int /*step*/, float& repetition_penalty, float& temperature) const {
+    repetition_penalty = 1.0f;
+    temperature = 1.0f;
+    return false;
+  }
 };
 
 // Interface for all scorers for beam search or beam sample.
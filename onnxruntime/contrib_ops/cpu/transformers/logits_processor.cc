@@ -213,6 +213,21 @@ void LogitsProcessorList::Process(const ISequences* sequences,
   }
 }
 
+bool LogitsProcessorList::GetInlineProcessors(int step, float& repetition_penalty, float& temperature) const {
+  repetition_penalty = 1.0f;
+  temperature = 1.0f;
+  for (const auto* processor : processor_list_) {
+    if (processor == repetition_penalty_processor_.get()) {
+      repetition_penalty = repetition_penalty_;
+    } else if (processor == temperature_processor_.get()) {
+      temperature = temperature_;
+    } else if (!(step > 1 && processor == prefix_vocab_mask_processor_.get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -300,6 +300,7 @@ class LogitsProcessorList : public ILogitsProcessorList {
   void Init(const GreedySearchParameters& parameters);
   void Init(const SamplingParameters& parameters);
   void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step);
+  bool GetInlineProcessors(int step, float& repetition_penalty, float& temperature) const;
 
  private:
   template <typename GenerationParametersT>
@@ -365,10 +366,14 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
     batch_beam_size_ = parameters.BatchBeamSize();
     vocab_size_ = parameters.vocab_size;
+    repetition_penalty_ = parameters.repetition_penalty;
+    temperature_ = parameters.temperature;
   }
 
   int batch_beam_size_;
   int vocab_size_;
+  float repetition_penalty_;
+  float temperature_;
   InlinedVector<ILogitsProcessor<float>*> processor_list_;
 
   std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
@@ -231,12 +231,19 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogSpinBudget(int thread_idx, int spin_budget_us) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].spin_budget_us_ = spin_budget_us;
+  }
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
-       << "\"core\": " << child_thread_stats_[i].core_ << "}"
+       << "\"core\": " << child_thread_stats_[i].core_ << ", "
+       << "\"spin_budget_us\": " << child_thread_stats_[i].spin_budget_us_ << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
   return ss.str();
@@ -480,6 +487,14 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
+void ThreadPool::ScheduleLocal(std::function<void()> fn) {
+  if (underlying_threadpool_) {
+    underlying_threadpool_->ScheduleLocal(std::move(fn));
+  } else {
+    fn();
+  }
+}
+
 void ThreadPool::StartProfiling() {
   if (underlying_threadpool_) {
     underlying_threadpool_->StartProfiling();
@@ -55,6 +55,22 @@ Status OrtArenaCfg::FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg&
     ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.max_mem));
   }
 
+  if (auto it = kvps.entries.find(ConfigKeyNames::ThreadCacheMaxChunkBytes); it != kvps.entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.thread_cache_max_chunk_bytes));
+  }
+
+  if (auto it = kvps.entries.find(ConfigKeyNames::ThreadCacheMaxBytes); it != kvps.entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.thread_cache_max_bytes));
+  }
+
+  if (auto it = kvps.entries.find(ConfigKeyNames::HugePages); it != kvps.entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.huge_pages));
+  }
+
+  if (auto it = kvps.entries.find(ConfigKeyNames::NumaNode); it != kvps.entries.end()) {
+    ORT_RETURN_IF_ERROR(from_string(it->first, it->second, cfg.numa_node));
+  }
+
   if (!cfg.IsValid()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "Invalid arena configuration. Please check the values provided.");
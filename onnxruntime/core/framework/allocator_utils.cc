@@ -13,6 +13,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/page_allocator.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -21,6 +22,17 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
   auto device_allocator = info.device_alloc_factory(info.device_id);
 
   if (info.use_arena) {
+    // regions of a CPU arena can come straight from the OS to control their page size and NUMA placement.
+    const OrtDevice& device = device_allocator->Info().device;
+    if ((info.arena_cfg.huge_pages > 0 || info.arena_cfg.numa_node >= 0) &&
+        device.Type() == OrtDevice::CPU && device.MemType() == OrtDevice::MemType::DEFAULT) {
+      const auto huge_pages = info.arena_cfg.huge_pages == 2   ? Env::HugePages::kExplicit
+                              : info.arena_cfg.huge_pages == 1 ? Env::HugePages::kTransparent
+                                                               : Env::HugePages::kNone;
+      device_allocator = std::make_unique<CPUPageAllocator>(device_allocator->Info(), huge_pages,
+                                                            info.arena_cfg.numa_node);
+    }
+
     size_t max_mem = info.arena_cfg.max_mem == 0 ? BFCArena::DEFAULT_MAX_MEM : info.arena_cfg.max_mem;
     int initial_chunk_size_bytes = info.arena_cfg.initial_chunk_size_bytes == -1
                                        ? BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES
@@ -34,6 +46,12 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int64_t max_power_of_two_extend_bytes = info.arena_cfg.max_power_of_two_extend_bytes == -1
                                                 ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
                                                 : info.arena_cfg.max_power_of_two_extend_bytes;
+    size_t thread_cache_max_chunk_bytes = info.arena_cfg.thread_cache_max_chunk_bytes == -1
+                                              ? BFCArena::DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES
+                                              : narrow<size_t>(info.arena_cfg.thread_cache_max_chunk_bytes);
+    size_t thread_cache_max_bytes = info.arena_cfg.thread_cache_max_bytes == -1
+                                        ? BFCArena::DEFAULT_THREAD_CACHE_MAX_BYTES
+                                        : narrow<size_t>(info.arena_cfg.thread_cache_max_bytes);
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -70,7 +88,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
                                      initial_growth_chunk_size_bytes,
-                                     max_power_of_two_extend_bytes));
+                                     max_power_of_two_extend_bytes,
+                                     thread_cache_max_chunk_bytes,
+                                     thread_cache_max_bytes));
     }
   } else {
     return device_allocator;
@@ -3,6 +3,8 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <atomic>
+#include <thread>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -12,7 +14,9 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   size_t thread_cache_max_chunk_bytes,
+                   size_t thread_cache_max_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -24,15 +28,27 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      thread_cache_max_chunk_bytes_(thread_cache_max_chunk_bytes),
+      thread_cache_max_bytes_(thread_cache_max_bytes) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " thread_cache_max_chunk_bytes: " << thread_cache_max_chunk_bytes_
+                     << " thread_cache_max_bytes: " << thread_cache_max_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
+  if (ThreadCacheEnabled()) {
+    // one cache per hardware thread. the index of a thread is assigned on first use, so a thread pool with no more
+    // threads than cores gets a cache per thread.
+    num_thread_caches_ = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), 64);
+    thread_caches_ = std::make_unique<ThreadCache[]>(num_thread_caches_);
+    thread_cache_owners_ = std::make_unique<ThreadCacheOwners[]>(kNumThreadCacheOwnerStripes);
+  }
+
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, static_cast<size_t>(initial_chunk_size_bytes_)));
@@ -321,6 +337,12 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  if (stream == nullptr && rounded_bytes <= thread_cache_max_chunk_bytes_) {
+    if (void* cached = AllocateFromThreadCache(rounded_bytes)) {
+      return cached;
+    }
+  }
+
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
@@ -363,6 +385,17 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
     }
   }
 
+  // Chunks held by the thread caches may coalesce into a large enough block once they are returned.
+  if (ThreadCacheEnabled() && FlushThreadCachesLocked() > 0) {
+    chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream, false);
+    if (chunk != nullptr) {
+      if (chunk->stream == nullptr && stream) {
+        chunk->stream = stream;
+      }
+      return chunk->ptr;
+    }
+  }
+
   // We searched all bins for an existing free chunk to use and
   // couldn't find one.  This means we must have run out of memory,
   // Dump the memory log for analysis.
@@ -378,6 +411,17 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+
+  // chunks in the thread caches are in use as far as the arena is concerned, but not for the caller.
+  for (size_t i = 0; i < num_thread_caches_; ++i) {
+    ThreadCache& cache = thread_caches_[i];
+    std::lock_guard<std::mutex> cache_lock(cache.mutex);
+    stats->num_allocs += cache.num_hits;
+    stats->num_thread_cache_hits += cache.num_hits;
+    stats->num_thread_cache_flushes += cache.num_flushes;
+    stats->thread_cache_bytes += static_cast<int64_t>(cache.cached_bytes);
+    stats->bytes_in_use -= static_cast<int64_t>(cache.cached_bytes);
+  }
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -495,20 +539,48 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
-  std::lock_guard<std::mutex> lock(lock_);
-  auto it = reserved_chunks_.find(p);
-  if (it != reserved_chunks_.end()) {
-    device_allocator_->Free(it->first);
-    stats_.bytes_in_use -= it->second;
-    stats_.total_allocated_bytes -= it->second;
-    reserved_chunks_.erase(it);
-  } else {
-    DeallocateRawInternal(p);
+  if (ThreadCacheEnabled() && FreeToThreadCache(p)) {
+    return;
+  }
+
+  size_t cacheable_chunk_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = reserved_chunks_.find(p);
+    if (it != reserved_chunks_.end()) {
+      device_allocator_->Free(it->first);
+      stats_.bytes_in_use -= it->second;
+      stats_.total_allocated_bytes -= it->second;
+      reserved_chunks_.erase(it);
+    } else {
+      // a chunk handed over to a thread cache stays in use.
+      if (ThreadCacheEnabled()) {
+        cacheable_chunk_size = ThreadCacheableChunkSize(p);
+      }
+
+      if (cacheable_chunk_size == 0) {
+        DeallocateRawInternal(p);
+      }
+    }
+  }
+
+  if (cacheable_chunk_size != 0) {
+    {
+      ThreadCacheOwners& owners = ThreadCacheOwnersFor(p);
+      std::lock_guard<std::mutex> owners_lock(owners.mutex);
+      owners.chunk_sizes[p] = cacheable_chunk_size;
+    }
+
+    PushToThreadCache(p, cacheable_chunk_size);
   }
 }
 
 Status BFCArena::Shrink() {
   std::lock_guard<std::mutex> lock(lock_);
+  if (ThreadCacheEnabled()) {
+    FlushThreadCachesLocked();
+  }
+
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
@@ -581,6 +653,140 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
   FreeAndMaybeCoalesce(h);
 }
 
+namespace {
+// Index of the calling thread, assigned on first use.
+size_t CurrentThreadIndex() {
+  static std::atomic<size_t> next_thread_index{0};
+  thread_local const size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index;
+}
+}  // namespace
+
+BFCArena::ThreadCache& BFCArena::CurrentThreadCache() {
+  return thread_caches_[CurrentThreadIndex() % num_thread_caches_];
+}
+
+BFCArena::ThreadCacheOwners& BFCArena::ThreadCacheOwnersFor(const void* p) {
+  // chunks are kMinAllocationSize aligned, so the low bits carry no information.
+  const auto p_int = reinterpret_cast<std::uintptr_t>(p) >> kMinAllocationBits;
+  return thread_cache_owners_[p_int % kNumThreadCacheOwnerStripes];
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t rounded_bytes) {
+  ThreadCache& cache = CurrentThreadCache();
+  std::lock_guard<std::mutex> cache_lock(cache.mutex);
+  auto it = cache.free_chunks.find(rounded_bytes);
+  if (it == cache.free_chunks.end() || it->second.empty()) {
+    return nullptr;
+  }
+
+  void* p = it->second.back();
+  it->second.pop_back();
+  cache.cached_bytes -= rounded_bytes;
+  ++cache.num_hits;
+  return p;
+}
+
+bool BFCArena::FreeToThreadCache(void* p) {
+  size_t chunk_size = 0;
+  {
+    ThreadCacheOwners& owners = ThreadCacheOwnersFor(p);
+    std::lock_guard<std::mutex> owners_lock(owners.mutex);
+    auto it = owners.chunk_sizes.find(p);
+    if (it == owners.chunk_sizes.end()) {
+      return false;
+    }
+    chunk_size = it->second;
+  }
+
+  PushToThreadCache(p, chunk_size);
+  return true;
+}
+
+size_t BFCArena::ThreadCacheableChunkSize(const void* p) {
+  BFCArena::ChunkHandle h = region_manager_.get_handle(p);
+  ORT_ENFORCE(h != kInvalidChunkHandle);
+  const Chunk* c = ChunkFromHandle(h);
+  ORT_ENFORCE(c->in_use());
+  if (c->stream != nullptr || c->size > thread_cache_max_chunk_bytes_) {
+    return 0;
+  }
+
+  return c->size;
+}
+
+void BFCArena::PushToThreadCache(void* p, size_t chunk_size) {
+  std::vector<void*> chunks_to_release;
+  {
+    ThreadCache& cache = CurrentThreadCache();
+    std::lock_guard<std::mutex> cache_lock(cache.mutex);
+    cache.free_chunks[chunk_size].push_back(p);
+    cache.cached_bytes += chunk_size;
+
+    if (cache.cached_bytes > thread_cache_max_bytes_) {
+      ++cache.num_flushes;
+      const size_t target_bytes = thread_cache_max_bytes_ / 2;
+      for (auto& [size, chunk_ptrs] : cache.free_chunks) {
+        // the front of each list holds the least recently freed chunks
+        size_t num_to_release = 0;
+        while (num_to_release < chunk_ptrs.size() && cache.cached_bytes > target_bytes) {
+          cache.cached_bytes -= size;
+          ++num_to_release;
+        }
+
+        chunks_to_release.insert(chunks_to_release.end(), chunk_ptrs.begin(), chunk_ptrs.begin() + num_to_release);
+        chunk_ptrs.erase(chunk_ptrs.begin(), chunk_ptrs.begin() + num_to_release);
+        if (cache.cached_bytes <= target_bytes) {
+          break;
+        }
+      }
+    }
+  }
+
+  if (!chunks_to_release.empty()) {
+    ReleaseThreadCacheChunks(chunks_to_release);
+  }
+}
+
+void BFCArena::ReleaseThreadCacheChunks(const std::vector<void*>& chunk_ptrs) {
+  for (void* p : chunk_ptrs) {
+    ThreadCacheOwners& owners = ThreadCacheOwnersFor(p);
+    std::lock_guard<std::mutex> owners_lock(owners.mutex);
+    owners.chunk_sizes.erase(p);
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (void* p : chunk_ptrs) {
+    DeallocateRawInternal(p);
+  }
+}
+
+size_t BFCArena::FlushThreadCachesLocked() {
+  // lock_ is always taken before a cache or owners mutex, never while holding one.
+  std::vector<void*> chunk_ptrs;
+  for (size_t i = 0; i < num_thread_caches_; ++i) {
+    ThreadCache& cache = thread_caches_[i];
+    std::lock_guard<std::mutex> cache_lock(cache.mutex);
+    for (auto& [size, cached_ptrs] : cache.free_chunks) {
+      chunk_ptrs.insert(chunk_ptrs.end(), cached_ptrs.begin(), cached_ptrs.end());
+    }
+    cache.free_chunks.clear();
+    cache.cached_bytes = 0;
+  }
+
+  for (void* p : chunk_ptrs) {
+    ThreadCacheOwners& owners = ThreadCacheOwnersFor(p);
+    std::lock_guard<std::mutex> owners_lock(owners.mutex);
+    owners.chunk_sizes.erase(p);
+  }
+
+  for (void* p : chunk_ptrs) {
+    DeallocateRawInternal(p);
+  }
+
+  return chunk_ptrs.size();
+}
+
 // Merges h1 and h2 when Chunk(h1)->next is h2 and Chunk(h2)->prev is c1.
 // We merge Chunk(h2) into Chunk(h1).
 void BFCArena::Merge(BFCArena::ChunkHandle h1,
@@ -19,10 +19,12 @@ limitations under the License.
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/logging/severity.h"
 #include "core/common/safeint.h"
@@ -61,6 +63,9 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  // the thread caches are disabled by default
+  static const size_t DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES = 0;
+  static const size_t DEFAULT_THREAD_CACHE_MAX_BYTES = 4 * 1024 * 1024;
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +78,9 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           size_t thread_cache_max_chunk_bytes = DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES,
+           size_t thread_cache_max_bytes = DEFAULT_THREAD_CACHE_MAX_BYTES);
 
   ~BFCArena() override;
 
@@ -86,6 +93,7 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // Chunks held by the thread caches are returned to the arena first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -97,6 +105,8 @@ class BFCArena : public IAllocator {
 
   void GetStats(AllocatorStats* stats) override;
 
+  // Note that a chunk served from a thread cache reports the requested size of the allocation that first
+  // returned it to the cache, which is less than kMinAllocationSize away from the current one.
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
@@ -429,6 +439,58 @@ class BFCArena : public IAllocator {
   // Computes and returns a BinDebugInfo for each Bin.
   std::array<BinDebugInfo, kNumBins> get_bin_debug_info();
 
+  // Thread caches.
+  //
+  // Freed chunks of at most thread_cache_max_chunk_bytes_ are kept in a cache in front of the arena and serve later
+  // allocations of exactly the same rounded size without taking lock_. A chunk in a thread cache stays in use from
+  // the point of view of the arena until it is flushed back. Every thread is mapped to one of the caches, so
+  // threads only contend on a cache if there are more threads than caches. Chunks associated with a stream are
+  // never cached.
+  struct alignas(64) ThreadCache {
+    std::mutex mutex;
+    // pointers of the free chunks by chunk size, most recently freed last
+    InlinedHashMap<size_t, std::vector<void*>> free_chunks;
+    size_t cached_bytes = 0;
+    int64_t num_hits = 0;
+    int64_t num_flushes = 0;
+  };
+
+  // Sizes of the chunks owned by the thread caches, striped by address so that Free() can tell whether a pointer
+  // belongs to a thread cache without taking lock_.
+  struct alignas(64) ThreadCacheOwners {
+    std::mutex mutex;
+    InlinedHashMap<const void*, size_t> chunk_sizes;
+  };
+
+  static const size_t kNumThreadCacheOwnerStripes = 32;
+
+  bool ThreadCacheEnabled() const { return thread_cache_max_chunk_bytes_ != 0; }
+
+  ThreadCache& CurrentThreadCache();
+
+  ThreadCacheOwners& ThreadCacheOwnersFor(const void* p);
+
+  // Returns nullptr if the cache of the current thread has no chunk of exactly 'rounded_bytes'.
+  void* AllocateFromThreadCache(size_t rounded_bytes);
+
+  // Returns false if 'p' is not owned by a thread cache.
+  bool FreeToThreadCache(void* p);
+
+  // Returns the size of the chunk 'p' if it should be handed over to a thread cache instead of being freed.
+  // Requires lock_.
+  size_t ThreadCacheableChunkSize(const void* p);
+
+  // Add the chunk 'p' to the cache of the current thread. Once the cache holds more than thread_cache_max_bytes_
+  // the oldest chunks are flushed back to the arena until it is at half of the limit.
+  void PushToThreadCache(void* p, size_t chunk_size);
+
+  // Return chunks taken out of a thread cache to the arena. Takes lock_.
+  void ReleaseThreadCacheChunks(const std::vector<void*>& chunk_ptrs);
+
+  // Return the chunks of all thread caches to the arena. Requires lock_.
+  // Returns the number of chunks that were returned.
+  size_t FlushThreadCachesLocked();
+
   // Structures immutable after construction
   size_t memory_limit_ = 0;
   ArenaExtendStrategy arena_extend_strategy_ = ArenaExtendStrategy::kNextPowerOfTwo;
@@ -509,6 +571,12 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  const size_t thread_cache_max_chunk_bytes_;
+  const size_t thread_cache_max_bytes_;
+  std::unique_ptr<ThreadCache[]> thread_caches_;
+  size_t num_thread_caches_ = 0;
+  std::unique_ptr<ThreadCacheOwners[]> thread_cache_owners_;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cache_key_utils.h"
+
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+namespace cache_key_utils {
+
+std::string GetBuildDescription() {
+  std::ostringstream ss;
+#ifdef ORT_VERSION
+  ss << "ort=" << ORT_VERSION;
+#endif
+#ifdef ORT_BUILD_INFO
+  // includes the git commit, so that changes between builds of the same version invalidate the entries
+  ss << "\nbuild=" << ORT_BUILD_INFO;
+#endif
+#if defined(_MSC_FULL_VER)
+  ss << "\ncompiler=msvc " << _MSC_FULL_VER;
+#elif defined(__VERSION__)
+  ss << "\ncompiler=" << __VERSION__;
+#endif
+  return ss.str();
+}
+
+std::string GetCpuDescription() {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream ss;
+#if defined(_M_AMD64) || defined(__x86_64__)
+  ss << "x86_64";
+#elif defined(_M_IX86) || defined(__i386__)
+  ss << "x86";
+#elif defined(_M_ARM64) || defined(__aarch64__)
+  ss << "arm64";
+#elif defined(_M_ARM) || defined(__arm__)
+  ss << "arm";
+#else
+  ss << "other";
+#endif
+  ss << "," << cpu_info.GetCPUVendor()
+     << ",sse3=" << cpu_info.HasSSE3() << ",sse4_1=" << cpu_info.HasSSE4_1()
+     << ",avx=" << cpu_info.HasAVX() << ",avx2=" << cpu_info.HasAVX2() << ",f16c=" << cpu_info.HasF16C()
+     << ",avx512f=" << cpu_info.HasAVX512f() << ",avx512skx=" << cpu_info.HasAVX512Skylake()
+     << ",avx512bf16=" << cpu_info.HasAVX512_BF16() << ",amxbf16=" << cpu_info.HasAMX_BF16()
+     << ",neondot=" << cpu_info.HasArmNeonDot() << ",neoni8mm=" << cpu_info.HasArmNeon_I8MM()
+     << ",svei8mm=" << cpu_info.HasArmSVE_I8MM() << ",neonbf16=" << cpu_info.HasArmNeon_BF16()
+     << ",fp16=" << cpu_info.HasFp16VectorAcceleration();
+  return ss.str();
+}
+
+std::string HashToHex(const void* data, size_t length) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(data, length, 0, hash);
+
+  std::ostringstream ss;
+  ss << std::hex;
+  for (uint32_t h : hash) {
+    ss.width(8);
+    ss.fill('0');
+    ss << h;
+  }
+  return ss.str();
+}
+
+}  // namespace cache_key_utils
+}  // namespace onnxruntime
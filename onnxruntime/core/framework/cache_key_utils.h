@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+namespace onnxruntime {
+namespace cache_key_utils {
+
+// Describes the ORT build: the version, the build info including the git commit, and the compiler.
+// Part of the keys of on-disk caches whose content may change between builds.
+std::string GetBuildDescription();
+
+// Describes the CPU architecture and the CPU features that MLAS and the graph optimizers dispatch on.
+std::string GetCpuDescription();
+
+// Returns the 128-bit MurmurHash3 of 'data' as a hex string.
+std::string HashToHex(const void* data, size_t length);
+
+}  // namespace cache_key_utils
+}  // namespace onnxruntime
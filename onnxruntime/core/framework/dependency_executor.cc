@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/dependency_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/sequential_executor.h"
+#include "core/framework/stream_execution_context.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+NodeDependencyPlan CreateNodeDependencyPlan(const GraphViewer& graph_viewer,
+                                            const SequentialExecutionPlan& execution_plan,
+                                            ExecutionOrder execution_order) {
+  constexpr size_t kNotInGraph = std::numeric_limits<size_t>::max();
+
+  const auto& topo_order = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  std::vector<size_t> node_to_position(graph_viewer.MaxNodeIndex(), kNotInGraph);
+  for (size_t i = 0; i < topo_order.size(); ++i) {
+    node_to_position[topo_order[i]] = i;
+  }
+
+  NodeDependencyPlan plan;
+  plan.nodes.resize(topo_order.size());
+  for (size_t i = 0; i < topo_order.size(); ++i) {
+    auto& info = plan.nodes[i];
+    info.node_index = topo_order[i];
+    info.stream_idx = execution_plan.node_stream_map_[info.node_index];
+    info.num_producers = 0;
+  }
+
+  // a node may consume several outputs of the same producer, so count each producer/consumer pair once.
+  // output edges include control edges.
+  for (size_t i = 0; i < topo_order.size(); ++i) {
+    const Node* node = graph_viewer.GetNode(topo_order[i]);
+    auto& consumers = plan.nodes[i].consumers;
+    for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+      const NodeIndex consumer_index = it->Index();
+      if (consumer_index >= node_to_position.size() || node_to_position[consumer_index] == kNotInGraph) {
+        continue;
+      }
+
+      const size_t consumer_position = node_to_position[consumer_index];
+      if (std::find(consumers.begin(), consumers.end(), consumer_position) == consumers.end()) {
+        consumers.push_back(consumer_position);
+        ++plan.nodes[consumer_position].num_producers;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < plan.nodes.size(); ++i) {
+    if (plan.nodes[i].num_producers == 0) {
+      plan.roots.push_back(i);
+    }
+  }
+
+  return plan;
+}
+
+namespace {
+
+struct DependencyRunState {
+  DependencyRunState(const NodeDependencyPlan& dependency_plan_in,
+                     StreamExecutionContext& ctx_in,
+                     SessionScope& session_scope_in,
+                     const bool& terminate_flag_in,
+                     concurrency::ThreadPool* tp_in)
+      : dependency_plan(dependency_plan_in),
+        ctx(ctx_in),
+        session_scope(session_scope_in),
+        terminate_flag(terminate_flag_in),
+        tp(tp_in),
+        pending_producers(std::make_unique<std::atomic_int32_t[]>(dependency_plan_in.nodes.size())) {
+    for (size_t i = 0; i < dependency_plan.nodes.size(); ++i) {
+      pending_producers[i].store(dependency_plan.nodes[i].num_producers, std::memory_order_relaxed);
+    }
+  }
+
+  const NodeDependencyPlan& dependency_plan;
+  StreamExecutionContext& ctx;
+  SessionScope& session_scope;
+  const bool& terminate_flag;
+  concurrency::ThreadPool* tp;
+  std::unique_ptr<std::atomic_int32_t[]> pending_producers;
+};
+
+// Run the node at 'position' and then keep running one ready consumer at a time on the current thread.
+// Every call completes exactly one task of the execution context.
+void RunFromNode(DependencyRunState& state, size_t position) {
+  constexpr size_t kNoNode = std::numeric_limits<size_t>::max();
+  auto& ctx = state.ctx;
+
+  while (position != kNoNode) {
+    if (!ctx.TaskStatus().IsOK()) {
+      break;
+    }
+
+    if (state.terminate_flag) {
+      Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      ctx.SetStatus(status_made);
+      break;
+    }
+
+    const auto& node_info = state.dependency_plan.nodes[position];
+    Status status;
+    ORT_TRY {
+      status = ExecuteKernel(ctx, node_info.node_index, node_info.stream_idx, state.terminate_flag,
+                             state.session_scope);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+      break;
+    }
+
+    // keep the first consumer that became ready on this thread, as its inputs are most likely still in cache.
+    // the decrement needs acquire/release semantics as the consumer may run on the thread that completed its
+    // last producer and must observe the outputs written by the other producers.
+    position = kNoNode;
+    for (size_t consumer : node_info.consumers) {
+      if (state.pending_producers[consumer].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        continue;
+      }
+
+      if (position == kNoNode) {
+        position = consumer;
+      } else {
+        ctx.AddTask();
+        concurrency::ThreadPool::ScheduleLocal(state.tp, [&state, consumer]() {
+          RunFromNode(state, consumer);
+        });
+      }
+    }
+  }
+
+  ctx.CompleteTask();
+}
+
+}  // namespace
+
+void ExecuteByDependency(const NodeDependencyPlan& dependency_plan,
+                         StreamExecutionContext& ctx,
+                         SessionScope& session_scope,
+                         const bool& terminate_flag,
+                         concurrency::ThreadPool* tp) {
+  DependencyRunState state(dependency_plan, ctx, session_scope, terminate_flag, tp);
+
+  for (size_t root : dependency_plan.roots) {
+    concurrency::ThreadPool::Schedule(tp, [&state, root]() {
+      RunFromNode(state, root);
+    });
+  }
+
+  ctx.WaitAll();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/session_options.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class SessionScope;
+class StreamExecutionContext;
+struct SequentialExecutionPlan;
+
+namespace concurrency {
+class ThreadPool;
+}
+
+// Node level dependency graph used to execute a session without following the per-stream execution plan.
+// Every node keeps the number of distinct producer nodes it waits for and the positions of its consumers,
+// so that at run time a node can be launched as soon as its last producer finished.
+struct NodeDependencyPlan {
+  struct NodeInfo {
+    NodeIndex node_index;
+    // logic stream the node was assigned to by the execution plan. used for logging and the device stream lookup.
+    size_t stream_idx;
+    int32_t num_producers;
+    // positions in 'nodes' of the nodes consuming an output of this node
+    InlinedVector<size_t> consumers;
+  };
+
+  // nodes in topological order
+  std::vector<NodeInfo> nodes;
+
+  // positions in 'nodes' of the nodes without producers
+  InlinedVector<size_t> roots;
+};
+
+// Create the dependency graph for the nodes in 'graph_viewer'.
+NodeDependencyPlan CreateNodeDependencyPlan(const GraphViewer& graph_viewer,
+                                            const SequentialExecutionPlan& execution_plan,
+                                            ExecutionOrder execution_order);
+
+// Execute all nodes of 'dependency_plan' on the thread pool 'tp' and wait for them to complete.
+// 'ctx' must have been created with the number of root nodes as its number of tasks.
+// Each root is scheduled as one task. A worker that completes a node keeps running the first consumer that became
+// ready and queues the others on its own queue, from which idle workers steal.
+// Errors are reported through the status of 'ctx'.
+void ExecuteByDependency(const NodeDependencyPlan& dependency_plan,
+                         StreamExecutionContext& ctx,
+                         SessionScope& session_scope,
+                         const bool& terminate_flag,
+                         concurrency::ThreadPool* tp);
+
+}  // namespace onnxruntime
@@ -406,11 +406,22 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+      mem_patterns_entry_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs);
+      if (mem_patterns_entry_) {
+        mem_patterns_ = &mem_patterns_entry_->patterns;
+        inferred_shapes_ = &mem_patterns_entry_->inferred_shapes;
+      }
+
       // if no existing patterns, generate one in this execution frame
       if (!mem_patterns_) {
         planner_.emplace(*session_state.GetExecutionPlan());
       } else {
+        // with bucketed input shapes the pattern may have been planned for smaller inputs of the same bucket.
+        // keep tracing so that it can be replaced if some block turns out to be too small for this run.
+        if (session_state.IsMemoryPatternBucketed()) {
+          planner_.emplace(*session_state.GetExecutionPlan());
+        }
+
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         buffers_.reserve(mem_patterns_->locations.size());
@@ -551,18 +562,22 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // a block planned for a larger tensor of the same bucket can hold this one. the buffer only lives for the
+          // duration of this run, so this does not raise the memory high water mark beyond the pattern's peak.
+          // if the block is too small, log message then fall back to default behavior
+          if (block->size_ >= size) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (status.IsOK()) {
+              TraceAllocate(ort_value_index, size);
+            }
             return status;
           } else {
+            mem_pattern_outgrown_ = true;
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
             // fed in, so use VERBOSE as the log level as it's expected.
-            // TODO: Should we reuse the block if the size is large enough? Would probably need to allow it
-            // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
             LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actual size is: " << size
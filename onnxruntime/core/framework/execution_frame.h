@@ -10,6 +10,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -168,6 +169,12 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_.has_value();
   }
 
+  // Whether the allocations traced in this frame should update the memory pattern cache of the session:
+  // either there was no pattern for the input shapes, or a block of the pattern was too small for this run.
+  bool ShouldUpdateMemoryPatterns() const {
+    return planner_.has_value() && (mem_patterns_ == nullptr || mem_pattern_outgrown_);
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   std::optional<size_t> GetOrtValueDynamicAllocation(int ort_value_index) const {
     auto it = ort_value_to_dynamic_allocations_size_.find(ort_value_index);
@@ -245,6 +252,12 @@ class ExecutionFrame final : public IExecutionFrame {
   // kernel's input/output tensors.
   const MemoryPatternGroup* mem_patterns_;
 
+  // Keeps the cache entry holding mem_patterns_ and inferred_shapes_ alive while this frame runs.
+  MemoryPatternCache::EntryPtr mem_patterns_entry_;
+
+  // Set if a tensor did not fit in the block mem_patterns_ planned for it.
+  bool mem_pattern_outgrown_{false};
+
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
   std::optional<OrtValuePatternPlanner> planner_;
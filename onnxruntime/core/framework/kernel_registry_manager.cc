@@ -104,6 +104,17 @@ Status KernelRegistryManager::SearchKernelRegistry(const Node& node, const loggi
   return Status(ONNXRUNTIME, NOT_IMPLEMENTED, create_error_message("Failed to find kernel for "));
 }
 
+bool KernelRegistryManager::IsCustomKernel(const KernelCreateInfo& kernel_create_info) const {
+  for (const auto& registry : custom_kernel_registries_) {
+    for (const auto& entry : registry->GetKernelCreateMap()) {
+      if (&entry.second == &kernel_create_info) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool KernelRegistryManager::HasImplementationOf(const KernelRegistryManager& r,
                                                 const Node& node,
                                                 const std::string& provider_type,
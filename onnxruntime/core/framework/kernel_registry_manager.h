@@ -76,6 +76,12 @@ class KernelRegistryManager {
   static bool HasImplementationOf(const KernelRegistryManager& r, const Node& node, const std::string& provider_type,
                                   const logging::Logger& logger);
 
+  /**
+   * Whether the kernel comes from a registry added by RegisterKernelRegistry(), e.g. one with custom op kernels,
+   * rather than from the registry of its execution provider.
+   */
+  bool IsCustomKernel(const KernelCreateInfo& kernel_create_info) const;
+
   Status CreateKernel(const Node& node,
                       const IExecutionProvider& execution_provider,
                       SessionState& session_state,
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include "core/common/parse_string.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+Status MemoryPatternBucketPolicy::Parse(const std::string& value, MemoryPatternBucketPolicy& policy) {
+  if (value.empty() || value == "0") {
+    policy = MemoryPatternBucketPolicy{};
+    return Status::OK();
+  }
+
+  if (value == "pow2") {
+    policy = MemoryPatternBucketPolicy{Kind::kPowerOfTwo, 1};
+    return Status::OK();
+  }
+
+  int64_t granularity = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(value, granularity) && granularity > 0,
+                    "Invalid memory pattern shape bucket '", value,
+                    "'. Expected '0', 'pow2' or a positive integer.");
+  policy = granularity == 1 ? MemoryPatternBucketPolicy{} : MemoryPatternBucketPolicy{Kind::kMultiple, granularity};
+  return Status::OK();
+}
+
+int64_t MemoryPatternBucketPolicy::Bucket(int64_t dim) const {
+  if (dim <= 1) {
+    return dim;
+  }
+
+  switch (kind_) {
+    case Kind::kPowerOfTwo: {
+      int64_t bucket = 1;
+      while (bucket < dim) {
+        bucket <<= 1;
+      }
+      return bucket;
+    }
+    case Kind::kMultiple:
+      return ((dim + granularity_ - 1) / granularity_) * granularity_;
+    default:
+      return dim;
+  }
+}
+
+int64_t MemoryPatternBucketPolicy::CalculateKey(gsl::span<const OrtValue> tensor_inputs) const {
+  // combine the rank and the bucketed dims of every input so that e.g. {2, 3} and {3, 2} get different keys.
+  uint64_t key = 0;
+  auto combine = [&key](int64_t v) {
+    key ^= static_cast<uint64_t>(v) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+  };
+
+  for (const auto& input : tensor_inputs) {
+    const auto& shape = input.Get<Tensor>().Shape();
+    combine(static_cast<int64_t>(shape.NumDimensions()));
+    for (auto dim : shape.GetDims()) {
+      combine(Bucket(dim));
+    }
+  }
+
+  return static_cast<int64_t>(key);
+}
+
+namespace {
+// true if every block in 'smaller' has a block of at least the same size in 'larger'.
+bool CoversPatterns(const MemoryPatternGroup& larger, const MemoryPatternGroup& smaller) {
+  for (size_t i = 0; i < smaller.locations.size(); ++i) {
+    const MemoryPattern* larger_pattern = larger.GetPatterns(smaller.locations[i]);
+    if (larger_pattern == nullptr) {
+      if (!smaller.patterns[i].GetPatternsMap().empty()) {
+        return false;
+      }
+      continue;
+    }
+
+    for (const auto& [ort_value_idx, block] : smaller.patterns[i].GetPatternsMap()) {
+      const MemoryBlock* larger_block = larger_pattern->GetBlock(ort_value_idx);
+      if (larger_block == nullptr || larger_block->size_ < block.size_) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+void MemoryPatternCache::SetCapacity(size_t capacity) {
+  capacity_ = capacity;
+  EvictIfNeeded();
+}
+
+MemoryPatternCache::EntryPtr MemoryPatternCache::Find(int64_t key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  ++stats_.hits;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->second;
+}
+
+MemoryPatternCache::EntryPtr MemoryPatternCache::Insert(int64_t key, MemoryPatternCacheEntry&& entry) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    auto& cached = it->second->second;
+    if (CoversPatterns(entry.patterns, cached->patterns)) {
+      cached = std::make_shared<const MemoryPatternCacheEntry>(std::move(entry));
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return cached;
+  }
+
+  lru_.emplace_front(key, std::make_shared<const MemoryPatternCacheEntry>(std::move(entry)));
+  index_.emplace(key, lru_.begin());
+  EntryPtr result = lru_.front().second;
+  EvictIfNeeded();
+  return result;
+}
+
+void MemoryPatternCache::EvictIfNeeded() {
+  while (capacity_ != 0 && index_.size() > capacity_) {
+    index_.erase(lru_.back().first);
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+// How input dimensions are rounded before they are used to look up a memory pattern.
+// Inputs whose shapes round to the same values share one cached pattern, which is planned for the largest shapes
+// seen in that bucket.
+class MemoryPatternBucketPolicy {
+ public:
+  enum class Kind {
+    kExact,       // every distinct set of input shapes gets its own pattern. the default.
+    kPowerOfTwo,  // dimensions are rounded up to the next power of two.
+    kMultiple,    // dimensions are rounded up to the next multiple of 'granularity'.
+  };
+
+  MemoryPatternBucketPolicy() = default;
+
+  // Parse the value of kOrtSessionOptionsConfigMemoryPatternShapeBucket:
+  // "" or "0" for exact, "pow2" for power of two, or a positive integer for multiples of that integer.
+  static Status Parse(const std::string& value, MemoryPatternBucketPolicy& policy);
+
+  bool IsExact() const { return kind_ == Kind::kExact; }
+
+  int64_t Bucket(int64_t dim) const;
+
+  // Key of the bucket the shapes of 'tensor_inputs' fall into. All inputs must be tensors.
+  int64_t CalculateKey(gsl::span<const OrtValue> tensor_inputs) const;
+
+ private:
+  MemoryPatternBucketPolicy(Kind kind, int64_t granularity) : kind_(kind), granularity_(granularity) {}
+
+  Kind kind_{Kind::kExact};
+  int64_t granularity_{1};
+};
+
+struct MemoryPatternCacheEntry {
+  MemoryPatternGroup patterns;
+  // shapes of activations resolved from the input shapes. only populated in training builds.
+  InlinedHashMap<int, TensorShape> inferred_shapes;
+};
+
+// Cache of memory patterns keyed by MemoryPatternBucketPolicy::CalculateKey, evicting the least recently used entry
+// once the capacity is exceeded. Entries are handed out as shared pointers so that an execution frame can keep using
+// an entry that got evicted or replaced while it was running.
+// Not thread safe, callers must serialize access.
+class MemoryPatternCache {
+ public:
+  using EntryPtr = std::shared_ptr<const MemoryPatternCacheEntry>;
+
+  struct Stats {
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+  };
+
+  // 0 means the number of entries is not limited.
+  explicit MemoryPatternCache(size_t capacity = 0) : capacity_(capacity) {}
+
+  void SetCapacity(size_t capacity);
+
+  // Returns nullptr if no entry exists for 'key'. Updates the hit/miss counters.
+  EntryPtr Find(int64_t key);
+
+  // Add an entry for 'key'. An existing entry is only replaced if every block of it is covered by a block of at
+  // least the same size in the new entry, so a bucket converges to the pattern of its largest shapes.
+  // Returns the entry cached for 'key' after the call.
+  EntryPtr Insert(int64_t key, MemoryPatternCacheEntry&& entry);
+
+  size_t Size() const { return index_.size(); }
+
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  using LruList = std::list<std::pair<int64_t, EntryPtr>>;
+
+  void EvictIfNeeded();
+
+  size_t capacity_;
+  // most recently used entry first
+  LruList lru_;
+  InlinedHashMap<int64_t, LruList::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace onnxruntime
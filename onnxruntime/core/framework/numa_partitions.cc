@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_partitions.h"
+
+#include <cstring>
+
+#include "core/framework/page_allocator.h"
+
+namespace onnxruntime {
+
+namespace {
+// partitions of the Run executing on this thread and the index of its partition
+thread_local const NumaPartitions* current_partitions = nullptr;
+thread_local size_t current_partition = 0;
+}  // namespace
+
+NumaPartitions::NumaPartitions(const std::vector<NumaNode>& numa_nodes,
+                               std::vector<std::unique_ptr<concurrency::ThreadPool>> thread_pools) {
+  ORT_ENFORCE(!numa_nodes.empty() && numa_nodes.size() == thread_pools.size(),
+              "Expected one thread pool per NUMA node. Got ", numa_nodes.size(), " NUMA nodes and ",
+              thread_pools.size(), " thread pools.");
+
+  partitions_.reserve(numa_nodes.size());
+  for (size_t i = 0; i < numa_nodes.size(); ++i) {
+    const auto& node = numa_nodes[i];
+    OrtMemoryInfo memory_info(CPU, OrtAllocatorType::OrtDeviceAllocator);
+    partitions_.push_back(Partition{node.id, std::move(thread_pools[i]),
+                                    std::make_shared<CPUPageAllocator>(memory_info, Env::HugePages::kNone, node.id),
+                                    {}});
+
+    for (int processor : node.processors) {
+      if (processor < 0) {
+        continue;
+      }
+
+      if (static_cast<size_t>(processor) >= processor_to_partition_.size()) {
+        processor_to_partition_.resize(static_cast<size_t>(processor) + 1, -1);
+      }
+
+      if (processor_to_partition_[processor] == -1) {
+        processor_to_partition_[processor] = static_cast<int>(i);
+      }
+    }
+  }
+}
+
+size_t NumaPartitions::SelectPartition() {
+  const int processor = DeviceDiscovery::GetCurrentProcessor();
+  if (processor >= 0 && static_cast<size_t>(processor) < processor_to_partition_.size() &&
+      processor_to_partition_[processor] != -1) {
+    return static_cast<size_t>(processor_to_partition_[processor]);
+  }
+
+  return next_partition_.fetch_add(1, std::memory_order_relaxed) % partitions_.size();
+}
+
+void NumaPartitions::ReplicatePrepackedWeights(const PrePackedWeights& weights) {
+  for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+    const void* buffer = weights.buffers_[i].get();
+    const size_t size = weights.buffer_sizes_[i];
+    if (buffer == nullptr || size == 0) {
+      continue;
+    }
+
+    for (auto& partition : partitions_) {
+      if (partition.replicas.count(buffer) != 0) {
+        continue;
+      }
+
+      auto replica = IAllocator::MakeUniquePtr<void>(partition.allocator, size, true);
+      std::memcpy(replica.get(), buffer, size);
+      partition.replicas.emplace(buffer, std::move(replica));
+    }
+  }
+}
+
+concurrency::ThreadPool* NumaPartitions::GetThreadPoolForCurrentRun() const {
+  return GetThreadPool(current_partitions == this ? current_partition : 0);
+}
+
+const void* NumaPartitions::GetLocalBuffer(const void* buffer) {
+  if (current_partitions == nullptr || buffer == nullptr) {
+    return buffer;
+  }
+
+  const auto& replicas = current_partitions->partitions_[current_partition].replicas;
+  auto it = replicas.find(buffer);
+  return it != replicas.end() ? it->second.get() : buffer;
+}
+
+NumaPartitions::RunScope::RunScope(const NumaPartitions& partitions, size_t partition)
+    : prev_partitions_(current_partitions), prev_partition_(current_partition) {
+  ORT_ENFORCE(partition < partitions.NumPartitions(), "Invalid NUMA partition ", partition);
+  current_partitions = &partitions;
+  current_partition = partition;
+}
+
+NumaPartitions::RunScope::~RunScope() {
+  current_partitions = prev_partitions_;
+  current_partition = prev_partition_;
+}
+
+}  // namespace onnxruntime
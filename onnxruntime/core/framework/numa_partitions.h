@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/device_discovery.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Intra-op thread pools of a session that runs one pool per NUMA node, together with copies of the pre-packed
+// weights on every node.
+// Each Run executes on one partition: kernels get the thread pool of that partition and read their pre-packed
+// weights from the copy on its node, so GEMM workers only touch node local memory.
+// The partition of a Run is recorded in a thread local RunScope, so it applies to the kernels executed on the thread
+// that called Run, i.e. to the sequential executor.
+class NumaPartitions {
+ public:
+  // thread_pools[i] has its threads on numa_nodes[i]. A thread pool may be nullptr if the partition has a single
+  // thread.
+  NumaPartitions(const std::vector<NumaNode>& numa_nodes,
+                 std::vector<std::unique_ptr<concurrency::ThreadPool>> thread_pools);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NumaPartitions);
+
+  size_t NumPartitions() const { return partitions_.size(); }
+
+  int GetNumaNode(size_t partition) const { return partitions_[partition].numa_node; }
+
+  concurrency::ThreadPool* GetThreadPool(size_t partition) const { return partitions_[partition].thread_pool.get(); }
+
+  // Partition for a Run started on the calling thread. This is the partition on the node the thread currently runs
+  // on, so that the Run's activations, which the thread allocates, stay local. If the thread is not on one of the
+  // nodes the partitions are used round robin.
+  size_t SelectPartition();
+
+  // Copy the buffers of 'weights' to the node of every partition. Buffers that were copied before are skipped.
+  // Not thread safe. Called while the session state is finalized, before any Run.
+  void ReplicatePrepackedWeights(const PrePackedWeights& weights);
+
+  // Thread pool of the partition of the Run executing on the calling thread, or of the first partition if the
+  // thread is not running a Run on these partitions.
+  concurrency::ThreadPool* GetThreadPoolForCurrentRun() const;
+
+  // Copy of the pre-packed buffer 'buffer' on the node of the partition of the Run executing on the calling thread.
+  // Returns 'buffer' if the thread is not running a partitioned Run or the buffer was not replicated.
+  static const void* GetLocalBuffer(const void* buffer);
+
+  // Makes 'partition' the partition of the Run executing on the calling thread for the lifetime of the scope.
+  class RunScope {
+   public:
+    RunScope(const NumaPartitions& partitions, size_t partition);
+    ~RunScope();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunScope);
+
+   private:
+    const NumaPartitions* const prev_partitions_;
+    const size_t prev_partition_;
+  };
+
+ private:
+  struct Partition {
+    int numa_node;
+    std::unique_ptr<concurrency::ThreadPool> thread_pool;
+    // places the copies on 'numa_node'. must outlive 'replicas'.
+    AllocatorPtr allocator;
+    InlinedHashMap<const void*, IAllocatorUniquePtr<void>> replicas;
+  };
+
+  std::vector<Partition> partitions_;
+  // owning partition of each logical processor, -1 for processors that are not in a partition.
+  std::vector<int> processor_to_partition_;
+  std::atomic<size_t> next_partition_{0};
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/page_allocator.h"
+
+#include "core/common/logging/logging.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+CPUPageAllocator::CPUPageAllocator(const OrtMemoryInfo& memory_info, Env::HugePages huge_pages, int numa_node)
+    : IAllocator(memory_info), huge_pages_(huge_pages), numa_node_(numa_node) {
+}
+
+void* CPUPageAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  // same overrun as the default CPU allocator, see AllocatorDefaultAllocAligned.
+  Env::MappedMemoryPtr memory;
+  auto status = Env::Default().AllocatePages(size + MLAS_SYMM_QGEMM_BUF_OVERRUN, huge_pages_, numa_node_, memory);
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "CPUPageAllocator failed to allocate " << size << " bytes: " << status.ErrorMessage();
+    ORT_THROW_EX(std::bad_alloc);
+  }
+
+  void* p = memory.get();
+  std::lock_guard<std::mutex> lock(mutex_);
+  allocations_.emplace(p, std::move(memory));
+  return p;
+}
+
+void CPUPageAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  Env::MappedMemoryPtr memory;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = allocations_.find(p);
+    ORT_ENFORCE(it != allocations_.end(), "CPUPageAllocator::Free called with a pointer it did not allocate.");
+    memory = std::move(it->second);
+    allocations_.erase(it);
+  }
+  // the pages are released when 'memory' goes out of scope, outside of the lock.
+}
+
+}  // namespace onnxruntime
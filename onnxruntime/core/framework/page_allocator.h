@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+// CPU allocator that gets whole pages from the operating system through Env::AllocatePages, optionally backed by
+// huge pages and placed on a NUMA node.
+// Every allocation is rounded up to at least a page, so it is meant as the device allocator of an arena, which only
+// requests large regions.
+class CPUPageAllocator : public IAllocator {
+ public:
+  CPUPageAllocator(const OrtMemoryInfo& memory_info, Env::HugePages huge_pages, int numa_node);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  const Env::HugePages huge_pages_;
+  const int numa_node_;
+
+  std::mutex mutex_;
+  InlinedHashMap<void*, Env::MappedMemoryPtr> allocations_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,281 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_disk_cache.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <system_error>
+
+#include "core/common/narrow.h"
+#include "core/common/path_string.h"
+#include "core/common/safeint.h"
+#include "core/framework/cache_key_utils.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Bump when the entry layout or the content of the keys changes.
+constexpr uint32_t kFormatVersion = 1;
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', 'C', '\0'};
+// Offset alignment of the buffers in an entry file. MLAS packed buffers are read with aligned vector loads.
+constexpr size_t kBufferAlignment = 64;
+// Offset of the null buffers that some kernels store as place holders.
+constexpr uint64_t kNullBufferOffset = ~uint64_t{0};
+
+template <typename T>
+void WriteValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Reads entry fields from a memory mapped entry file, failing instead of reading past its end.
+class EntryReader {
+ public:
+  EntryReader(const char* data, size_t length) : data_(data), length_(length) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (length_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool Read(size_t length, std::string_view& value) {
+    if (length_ - offset_ < length) {
+      return false;
+    }
+    value = std::string_view(data_ + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t length_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
+PrePackedWeightsDiskCache::PrePackedWeightsDiskCache(std::filesystem::path cache_dir,
+                                                     const ConfigOptions& config_options)
+    : cache_dir_(std::move(cache_dir)) {
+  std::ostringstream ss;
+  ss << "format=" << kFormatVersion
+     << "\n" << cache_key_utils::GetBuildDescription()
+     << "\ncpu=" << cache_key_utils::GetCpuDescription();
+
+  // MLAS options change which kernels, and so which packing format, are used
+  std::map<std::string, std::string> mlas_options;
+  for (const auto& [config_key, value] : config_options.GetConfigOptionsMap()) {
+    if (config_key.rfind("mlas.", 0) == 0) {
+      mlas_options.emplace(config_key, value);
+    }
+  }
+  for (const auto& [config_key, value] : mlas_options) {
+    ss << "\n" << config_key << "=" << value;
+  }
+
+  key_prefix_ = ss.str();
+}
+
+std::string PrePackedWeightsDiskCache::GetKey(const Node& node, int input_idx, const Tensor& weight) const {
+  if (weight.IsDataTypeString()) {
+    return {};
+  }
+
+  std::ostringstream ss;
+  ss << key_prefix_
+     << "\nep=" << node.GetExecutionProviderType()
+     << "\nop=" << node.Domain() << ":" << node.OpType() << ":" << node.SinceVersion()
+     << "\ninput=" << input_idx
+     << "\ntype=" << weight.GetElementType()
+     << "\nshape=" << weight.Shape().ToString();
+
+  // attributes are hashed in name order as the order of NodeAttributes is unspecified
+  std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+  for (const auto& [name, attribute] : node.GetAttributes()) {
+    attributes.emplace(name, &attribute);
+  }
+  for (const auto& [name, attribute] : attributes) {
+    const std::string serialized = attribute->SerializeAsString();
+    ss << "\nattr." << name << "=" << cache_key_utils::HashToHex(serialized.data(), serialized.size());
+  }
+
+  ss << "\ndata=" << cache_key_utils::HashToHex(weight.DataRaw(), weight.SizeInBytes());
+  return ss.str();
+}
+
+std::filesystem::path PrePackedWeightsDiskCache::GetEntryPath(const std::string& key) const {
+  return cache_dir_ / (cache_key_utils::HashToHex(key.data(), key.size()) + ".ortpp");
+}
+
+// Entry file layout, in native byte order:
+//   magic, format version (uint32), key length (uint64), key,
+//   hash of the buffers (HashValue), number of buffers (uint64), then the size and offset (uint64) of every buffer,
+//   followed by the buffers at kBufferAlignment aligned offsets. Null buffers have the offset kNullBufferOffset.
+std::optional<PrePackedWeights> PrePackedWeightsDiskCache::Load(const std::string& key,
+                                                                const logging::Logger& logger) const {
+  const auto entry_path = GetEntryPath(key);
+
+  std::error_code ec;
+  const auto file_length = std::filesystem::file_size(entry_path, ec);
+  if (ec || file_length == 0) {
+    return std::nullopt;
+  }
+
+  Env::MappedMemoryPtr mapped_memory;
+  auto status = Env::Default().MapFileIntoMemory(entry_path.native().c_str(), 0, narrow<size_t>(file_length),
+                                                  mapped_memory);
+  if (!status.IsOK() || !mapped_memory) {
+    LOGS(logger, WARNING) << "Failed to map pre-packed weights cache entry " << entry_path.string() << ": "
+                          << status.ErrorMessage();
+    return std::nullopt;
+  }
+
+  char* data = mapped_memory.get();
+  // shared by all the buffers of the entry. unmaps the file once the last of them is released.
+  std::shared_ptr<char> mapping(mapped_memory.release(), mapped_memory.get_deleter());
+
+  EntryReader reader(data, narrow<size_t>(file_length));
+  auto invalid_entry = [&logger, &entry_path](const char* reason) {
+    LOGS(logger, INFO) << "Ignoring pre-packed weights cache entry " << entry_path.string() << ": " << reason;
+    return std::nullopt;
+  };
+
+  std::string_view magic;
+  uint32_t format_version = 0;
+  uint64_t key_length = 0;
+  std::string_view entry_key;
+  if (!reader.Read(sizeof(kMagic), magic) || magic != std::string_view(kMagic, sizeof(kMagic)) ||
+      !reader.Read(format_version) || format_version != kFormatVersion) {
+    return invalid_entry("unknown format");
+  }
+
+  if (!reader.Read(key_length) || !reader.Read(narrow<size_t>(key_length), entry_key) || entry_key != key) {
+    // a different build, CPU or weight with the same key hash
+    return invalid_entry("key mismatch");
+  }
+
+  HashValue hash = 0;
+  uint64_t num_buffers = 0;
+  if (!reader.Read(hash) || !reader.Read(num_buffers) || num_buffers > file_length / (2 * sizeof(uint64_t))) {
+    return invalid_entry("truncated header");
+  }
+
+  PrePackedWeights weights;
+  weights.buffers_.reserve(narrow<size_t>(num_buffers));
+  weights.buffer_sizes_.reserve(narrow<size_t>(num_buffers));
+  for (uint64_t i = 0; i < num_buffers; ++i) {
+    uint64_t size = 0;
+    uint64_t offset = 0;
+    if (!reader.Read(size) || !reader.Read(offset) ||
+        (offset != kNullBufferOffset && (offset > file_length || size > file_length - offset))) {
+      return invalid_entry("buffer out of bounds");
+    }
+
+    void* buffer = offset == kNullBufferOffset ? nullptr : data + offset;
+    weights.buffers_.push_back(IAllocatorUniquePtr<void>(buffer, [mapping](void*) {}));
+    weights.buffer_sizes_.push_back(narrow<size_t>(size));
+  }
+
+  // detects files that were corrupted on disk
+  if (weights.GetHash() != hash) {
+    return invalid_entry("content hash mismatch");
+  }
+
+  return weights;
+}
+
+Status PrePackedWeightsDiskCache::Save(const std::string& key, const PrePackedWeights& weights) const {
+  ORT_RETURN_IF(key.empty(), "Pre-packed weights without a cache key can't be saved.");
+  ORT_RETURN_IF_NOT(weights.buffers_.size() == weights.buffer_sizes_.size(),
+                    "Pre-packed weights have ", weights.buffers_.size(), " buffers but ",
+                    weights.buffer_sizes_.size(), " buffer sizes.");
+
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  ORT_RETURN_IF(ec, "Failed to create the pre-packed weights cache directory ", cache_dir_.string(), ": ",
+                ec.message());
+
+  const auto entry_path = GetEntryPath(key);
+  static std::atomic<uint64_t> temp_file_counter{0};
+  auto temp_path = entry_path;
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                            std::to_string(temp_file_counter++) + ".tmp");
+
+  const uint64_t num_buffers = weights.buffers_.size();
+  SafeInt<uint64_t> header_length = sizeof(kMagic);
+  header_length += sizeof(uint32_t) + sizeof(uint64_t) + key.size() + sizeof(HashValue) + sizeof(uint64_t);
+  header_length += SafeInt<uint64_t>(num_buffers) * 2 * sizeof(uint64_t);
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(weights.buffers_.size());
+  SafeInt<uint64_t> offset = header_length;
+  for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+    if (!weights.buffers_[i]) {
+      offsets.push_back(kNullBufferOffset);
+      continue;
+    }
+    offset = (offset + (kBufferAlignment - 1)) / kBufferAlignment * kBufferAlignment;
+    offsets.push_back(offset);
+    offset += weights.buffer_sizes_[i];
+  }
+
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to create the pre-packed weights cache entry ", temp_path.string());
+
+    out.write(kMagic, sizeof(kMagic));
+    WriteValue(out, kFormatVersion);
+    WriteValue(out, static_cast<uint64_t>(key.size()));
+    out.write(key.data(), key.size());
+    WriteValue(out, weights.GetHash());
+    WriteValue(out, num_buffers);
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      WriteValue(out, static_cast<uint64_t>(weights.buffer_sizes_[i]));
+      WriteValue(out, offsets[i]);
+    }
+
+    uint64_t written = header_length;
+    static constexpr char kPadding[kBufferAlignment] = {};
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      if (offsets[i] == kNullBufferOffset) {
+        continue;
+      }
+      const size_t size = weights.buffer_sizes_[i];
+      out.write(kPadding, static_cast<std::streamsize>(offsets[i] - written));
+      out.write(static_cast<const char*>(weights.buffers_[i].get()), static_cast<std::streamsize>(size));
+      written = offsets[i] + size;
+    }
+
+    out.close();
+    if (!out) {
+      std::filesystem::remove(temp_path, ec);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the pre-packed weights cache entry ",
+                             temp_path.string());
+    }
+  }
+
+  std::filesystem::rename(temp_path, entry_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the pre-packed weights cache entry ",
+                           entry_path.string());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
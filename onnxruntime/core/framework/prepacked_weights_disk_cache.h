@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/config_options.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+
+class Node;
+class Tensor;
+
+// Persists the pre-packed weights produced by OpKernel::PrePack() in a directory, so that later sessions, also in
+// other processes, can memory map them instead of pre-packing the weights again.
+//
+// An entry is keyed by everything that determines the content of the pre-packed buffers: the ORT build, the CPU
+// features MLAS dispatches on, the mlas.* session config entries, the node's op, attributes and execution provider,
+// the input index and the type, shape and content hash of the weight. Each entry file stores its full key and the
+// hash of its buffers, and a file whose key, layout or hash doesn't match is ignored and overwritten.
+// Kernels opt in with OpKernel::CanRestorePrePackedState(). OpKernel::RestorePrePackedState() also lets them reject
+// entries whose layout doesn't match the current MLAS packing routines.
+class PrePackedWeightsDiskCache {
+ public:
+  // 'config_options' are the session config options. The mlas.* entries are part of every key.
+  PrePackedWeightsDiskCache(std::filesystem::path cache_dir, const ConfigOptions& config_options);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrePackedWeightsDiskCache);
+
+  // Key of the pre-packed weights of input 'input_idx' of 'node' when the input is the constant 'weight'.
+  // Returns an empty string if the weight can't be cached.
+  std::string GetKey(const Node& node, int input_idx, const Tensor& weight) const;
+
+  // Memory maps the entry for 'key'. Returns std::nullopt if there is no valid entry.
+  // The buffers of the returned weights keep the mapping alive and must not be modified.
+  std::optional<PrePackedWeights> Load(const std::string& key, const logging::Logger& logger) const;
+
+  // Writes the entry for 'key'. The entry is written to a temporary file that is renamed, so concurrent readers
+  // and writers of the same entry never see a partial file.
+  Status Save(const std::string& key, const PrePackedWeights& weights) const;
+
+  const std::filesystem::path& CacheDir() const noexcept { return cache_dir_; }
+
+ private:
+  std::filesystem::path GetEntryPath(const std::string& key) const;
+
+  std::filesystem::path cache_dir_;
+  // build, CPU and MLAS configuration part of every key
+  std::string key_prefix_;
+};
+
+}  // namespace onnxruntime
@@ -10,6 +10,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/dependency_executor.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/resource_accountant.h"
 #include "core/framework/stream_execution_context.h"
@@ -226,7 +227,18 @@ class SessionScope {
 #endif
 
     if (session_state_.Profiler().IsEnabled()) {
-      session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
+      if (session_state_.GetEnableMemoryPattern()) {
+        // cumulative counters of the session, so the bucket policy can be tuned from the last event of a profile.
+        const auto mem_pattern_stats = session_state_.GetMemoryPatternCacheStats();
+        session_state_.Profiler().EndTimeAndRecordEvent(
+            profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_,
+            {{"mem_pattern_cache_hits", std::to_string(mem_pattern_stats.hits)},
+             {"mem_pattern_cache_misses", std::to_string(mem_pattern_stats.misses)},
+             {"mem_pattern_cache_evictions", std::to_string(mem_pattern_stats.evictions)}});
+      } else {
+        session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute",
+                                                        session_start_);
+      }
     }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     auto& logger = session_state_.Logger();
@@ -597,10 +609,32 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
       valid_streams++;
   }
 
+  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+
+  // the dependency driven executor replaces the per-stream walk when there is a thread pool to schedule nodes on
+  // and no device streams that need the synchronization steps of the plan.
+  const NodeDependencyPlan* dependency_plan = tp ? session_state.GetNodeDependencyPlan() : nullptr;
+#ifdef ORT_ENABLE_STREAM
+  if (dependency_plan && device_streams) {
+    for (size_t i = 0; i < device_streams->NumStreams(); ++i) {
+      if (device_streams->GetStream(i) != nullptr) {
+        dependency_plan = nullptr;
+        break;
+      }
+    }
+  }
+#endif
+#ifdef ENABLE_TRAINING
+  if (only_execute_path_to_fetches) {
+    dependency_plan = nullptr;
+  }
+#endif
+  const int32_t num_tasks = dependency_plan ? narrow<int32_t>(dependency_plan->roots.size()) : valid_streams;
+
   // prepare the execution context, notifications got initialized.
 #ifdef ORT_ENABLE_STREAM
   StreamExecutionContext ctx(session_state,
-                             valid_streams,
+                             num_tasks,
                              execution_plan->notification_owners,
                              execution_plan->num_barriers,
                              device_streams,
@@ -613,7 +647,7 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                              single_thread_mode);
 #else
   StreamExecutionContext ctx(session_state,
-                             valid_streams,
+                             num_tasks,
                              feed_mlvalue_idxs,
                              feeds,
                              fetch_mlvalue_idxs,
@@ -633,25 +667,27 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
-  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
-
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
-      });
+  if (dependency_plan) {
+    ExecuteByDependency(*dependency_plan, ctx, session_scope, terminate_flag, tp);
+  } else {
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
     }
-  }
 
-  ctx.WaitAll();
+    ctx.WaitAll();
+  }
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
-  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
+  if (ctx.GetExecutionFrame().ShouldUpdateMemoryPatterns()) {
     bool all_tensors = true;
     for (const auto& feed : feeds) {
       if (!(feed.IsTensor())) {
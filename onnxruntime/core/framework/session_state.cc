@@ -5,15 +5,20 @@
 
 #include <sstream>
 
+#include <map>
 #include <mutex>
+#include <optional>
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/numa_partitions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_disk_cache.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
@@ -103,6 +108,17 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  if (enable_mem_pattern_) {
+    ORT_THROW_IF_ERROR(MemoryPatternBucketPolicy::Parse(
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternShapeBucket, "0"),
+        mem_pattern_bucket_policy_));
+    size_t cache_size = 0;
+    const auto cache_size_str =
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheSize, "0");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(cache_size_str, cache_size),
+                "Invalid memory pattern cache size: ", cache_size_str);
+    mem_patterns_.SetCapacity(cache_size);
+  }
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -120,6 +136,10 @@ SessionState::SessionState(Graph& graph,
   }
 }
 
+concurrency::ThreadPool* SessionState::GetThreadPoolForCurrentRun() const {
+  return numa_partitions_ != nullptr ? numa_partitions_->GetThreadPoolForCurrentRun() : thread_pool_;
+}
+
 AllocatorPtr SessionState::GetAllocator(const OrtMemoryInfo& location) const noexcept {
   return GetAllocator(location.device);
 }
@@ -231,6 +251,12 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
+concurrency::ThreadPool* SessionState::GetInitializationThreadPool() const {
+  const bool parallel_initialization =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelInitialization, "0") == "1";
+  return parallel_initialization ? thread_pool_ : nullptr;
+}
+
 Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
@@ -240,7 +266,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -249,7 +276,44 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // The built-in kernels of the CPU EP only read the session state while they are constructed, so they can be
+    // created in parallel. Kernels of other EPs may use the FuncManager or state of the creating thread, e.g. the
+    // current device, and custom op kernels may run arbitrary code that isn't thread safe, so these are created
+    // serially. The statuses are checked in graph order so that the error returned is the one a serial creation
+    // would return.
+    concurrency::ThreadPool* thread_pool = GetInitializationThreadPool();
+    std::vector<bool> create_in_parallel;
+    std::vector<Status> parallel_statuses;
+    if (thread_pool != nullptr) {
+      create_in_parallel.resize(max_nodeid + 1);
+      InlinedVector<const Node*> parallel_nodes;
+      for (const auto& node : nodes) {
+        if (node.GetExecutionProviderType() == kCpuExecutionProvider &&
+            !kernel_registry_manager.IsCustomKernel(GetNodeKernelCreateInfo(node.Index()))) {
+          create_in_parallel[node.Index()] = true;
+          parallel_nodes.push_back(&node);
+        }
+      }
+
+      parallel_statuses.resize(max_nodeid + 1);
+      ORT_RETURN_IF_ERROR(session_state_utils::ParallelForEach(
+          thread_pool, parallel_nodes.size(),
+          [&parallel_nodes, &parallel_statuses, &create_kernel](size_t i) -> Status {
+            const Node& node = *parallel_nodes[i];
+            parallel_statuses[node.Index()] = create_kernel(node);
+            return Status::OK();
+          }));
+    }
+
+    for (const auto& node : nodes) {
+      if (thread_pool != nullptr && create_in_parallel[node.Index()]) {
+        ORT_RETURN_IF_ERROR(parallel_statuses[node.Index()]);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -380,7 +444,12 @@ void SessionState::CleanInitializedTensorsFromGraph() {
 
 static Status KernelUseSharedPrePackedBuffers(OpKernel& kernel, int input_idx,
                                               const PrePackedWeights& prepacked_weights,
-                                              const std::string& node_name) {
+                                              const std::string& node_name,
+                                              NumaPartitions* numa_partitions) {
+  if (numa_partitions != nullptr && kernel.Node().GetExecutionProviderType() == kCpuExecutionProvider) {
+    numa_partitions->ReplicatePrepackedWeights(prepacked_weights);
+  }
+
   std::vector<BufferUniquePtr> shared_prepacked_buffers;
   shared_prepacked_buffers.reserve(4);  // Unlikely to see more than 4 prepacked buffers per initializer
 
@@ -415,7 +484,103 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
     const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+  std::optional<PrePackedWeightsDiskCache> disk_cache;
+  const std::string disk_cache_dir =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPrePackedWeightsCacheDir, "");
+  if (!disk_cache_dir.empty()) {
+    disk_cache.emplace(ToPathString(disk_cache_dir), sess_options_.config_options);
+  }
+
+  // Pre-packs 'tensor' into 'weights', unless the pre-packed weights of the kernel can be loaded from the disk cache.
+  // Weights pre-packed by kernels that can restore their state from the cache are written to it.
+  auto pre_pack = [this, &disk_cache](OpKernel& kernel, const Node& node, const Tensor& tensor, int input_idx,
+                                      AllocatorPtr alloc, bool& is_packed, PrePackedWeights& weights) -> Status {
+    std::string cache_key;
+    if (disk_cache.has_value() && kernel.CanRestorePrePackedState(input_idx)) {
+      cache_key = disk_cache->GetKey(node, input_idx, tensor);
+      std::optional<PrePackedWeights> cached_weights;
+      if (!cache_key.empty()) {
+        cached_weights = disk_cache->Load(cache_key, logger_);
+      }
+
+      if (cached_weights.has_value()) {
+        bool is_restored = false;
+        ORT_RETURN_IF_ERROR(kernel.RestorePrePackedState(tensor, input_idx, *cached_weights, is_restored));
+        if (is_restored) {
+          weights = std::move(*cached_weights);
+          is_packed = true;
+          ++prepacked_weights_cache_hits_counter_;
+          return Status::OK();
+        }
+      }
+    }
+
+    ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, alloc, is_packed, &weights));
+
+    if (is_packed && !cache_key.empty() && !weights.buffers_.empty()) {
+      auto status = disk_cache->Save(cache_key, weights);
+      if (!status.IsOK()) {
+        LOGS(logger_, WARNING) << "Failed to cache the pre-packed weight of node " << node.Name() << ": "
+                               << status.ErrorMessage();
+      }
+    }
+
+    return Status::OK();
+  };
+
+  // With a thread pool, the weights of the CPU EP kernels are pre-packed in parallel before the serial pass below,
+  // which then takes the result of each (kernel, input) instead of calling pre_pack. Everything that updates shared
+  // state (the containers, the counters and the release of the initializers) stays in the serial pass, so the
+  // resulting session state doesn't depend on the scheduling. A first serial pass over the graph with
+  // 'collecting_parallel_tasks' set only records the pre-packs to run. It has no other effect since all the pre-packs
+  // report is_packed = false in that pass.
+  struct ParallelPrePackTask {
+    OpKernel* kernel;
+    const Node* node;
+    const Tensor* tensor;
+    int input_idx;
+    AllocatorPtr alloc;
+    bool done = false;
+    bool consumed = false;
+    bool is_packed = false;
+    PrePackedWeights weights;
+  };
+
+  concurrency::ThreadPool* thread_pool = GetInitializationThreadPool();
+  std::vector<ParallelPrePackTask> parallel_tasks;
+  // The tasks are looked up by kernel and input rather than by position, so a serial pass that skips or reorders
+  // pre-packs, e.g. after an initializer was released, still takes each result once and never packs an input twice.
+  std::map<std::pair<const OpKernel*, int>, size_t> parallel_task_index;
+  bool collecting_parallel_tasks = false;
+
+  auto pre_pack_or_collect = [&pre_pack, &parallel_tasks, &parallel_task_index, &collecting_parallel_tasks](
+                                 OpKernel& kernel, const Node& node, const Tensor& tensor, int input_idx,
+                                 AllocatorPtr alloc, bool& is_packed, PrePackedWeights& weights) -> Status {
+    if (collecting_parallel_tasks) {
+      if (node.GetExecutionProviderType() == kCpuExecutionProvider &&
+          parallel_task_index.emplace(std::make_pair(&kernel, input_idx), parallel_tasks.size()).second) {
+        parallel_tasks.push_back({&kernel, &node, &tensor, input_idx, std::move(alloc)});
+      }
+      is_packed = false;
+      return Status::OK();
+    }
+
+    auto it = parallel_task_index.find(std::make_pair(&kernel, input_idx));
+    if (it != parallel_task_index.end()) {
+      auto& task = parallel_tasks[it->second];
+      if (task.done && !task.consumed) {
+        task.consumed = true;
+        is_packed = task.is_packed;
+        weights = std::move(task.weights);
+        return Status::OK();
+      }
+    }
+
+    return pre_pack(kernel, node, tensor, input_idx, std::move(alloc), is_packed, weights);
+  };
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     &pre_pack_or_collect](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
     for (auto& node : GetGraphViewer().Nodes()) {
       if (sess_options_.IsLoadCancellationFlagSet()) {
@@ -458,9 +623,8 @@ Status SessionState::PrepackConstantInitializedTensors(
                   // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
                   // because other static properties of the node like node attributes could play a role in the
                   // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+                  ORT_RETURN_IF_ERROR(pre_pack_or_collect(*kernel, node, const_initialized_tensor, input_idx,
+                                                          allocator_for_caching, is_packed, weights_to_be_filled_in));
 
                   if (is_packed) {
                     // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
@@ -495,7 +659,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                           prepacked_weights_container_key);
                       ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
                                                                           prepacked_shared,
-                                                                          node.Name()));
+                                                                          node.Name(), numa_partitions_));
 
                       ++used_shared_pre_packed_weights_counter_;
 
@@ -538,7 +702,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                           prepacked_weights_container_key);
                       ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
                                                                           shared_prepacked,
-                                                                          node.Name()));
+                                                                          node.Name(), numa_partitions_));
                     }
                   }
 
@@ -556,9 +720,8 @@ Status SessionState::PrepackConstantInitializedTensors(
                   // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
                   // other static properties of the node like node attributes could play a role in the pre-packed
                   // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+                  ORT_RETURN_IF_ERROR(pre_pack_or_collect(*kernel, node, const_initialized_tensor, input_idx,
+                                                          session_cpu_alloc, is_packed, weights_to_be_filled_in));
 
                   // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
                   // even though they set is_packed = true so we leave it up to them.
@@ -585,7 +748,7 @@ Status SessionState::PrepackConstantInitializedTensors(
 
                     ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
                                                                         *weights_to_use,
-                                                                        node.Name()));
+                                                                        node.Name(), numa_partitions_));
                   }
                 }
 
@@ -617,27 +780,61 @@ Status SessionState::PrepackConstantInitializedTensors(
     return Status::OK();
   };
 
+  auto prepack_constant_weights_maybe_in_parallel =
+      [&](bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    if (thread_pool != nullptr) {
+      collecting_parallel_tasks = true;
+      ORT_RETURN_IF_ERROR(prepacked_constant_weights(should_cache_prepacked_weights_for_shared_initializers));
+      collecting_parallel_tasks = false;
+
+      // the inputs of a node are pre-packed in order by the same thread as kernels may depend on it.
+      // a kernel may also depend on the shared buffers of an input that the serial pass passes to
+      // UseSharedPrePackedBuffers() before the next input is pre-packed, so the inputs after one that produced
+      // buffers are left to the serial pass.
+      InlinedVector<size_t> node_task_begins;
+      for (size_t i = 0; i < parallel_tasks.size(); ++i) {
+        if (i == 0 || parallel_tasks[i].kernel != parallel_tasks[i - 1].kernel) {
+          node_task_begins.push_back(i);
+        }
+      }
+
+      ORT_RETURN_IF_ERROR(session_state_utils::ParallelForEach(
+          thread_pool, node_task_begins.size(),
+          [&](size_t i) -> Status {
+            if (sess_options_.IsLoadCancellationFlagSet()) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                                     "Weight pre-packing was canceled due to user request.");
+            }
+
+            const size_t end = i + 1 < node_task_begins.size() ? node_task_begins[i + 1] : parallel_tasks.size();
+            for (size_t t = node_task_begins[i]; t < end; ++t) {
+              auto& task = parallel_tasks[t];
+              ORT_RETURN_IF_ERROR(pre_pack(*task.kernel, *task.node, *task.tensor, task.input_idx, task.alloc,
+                                           task.is_packed, task.weights));
+              task.done = true;
+              if (task.is_packed && !task.weights.buffers_.empty()) {
+                break;
+              }
+            }
+            return Status::OK();
+          }));
+    }
+
+    return prepacked_constant_weights(should_cache_prepacked_weights_for_shared_initializers);
+  };
+
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    return prepack_constant_weights_maybe_in_parallel(true);
   } else {
-    return prepacked_constant_weights(false);
+    return prepack_constant_weights_maybe_in_parallel(false);
   }
 }
 
-static int64_t
-CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
-  }
-  return key;
-}
-
 #ifdef ENABLE_TRAINING
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
@@ -872,26 +1069,19 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+MemoryPatternCache::EntryPtr SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
-    gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
-  out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+    gsl::span<const int> feed_mlvalue_idxs) const {
+  int64_t key = mem_pattern_bucket_policy_.CalculateKey(tensor_inputs);
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  auto entry = mem_patterns_.Find(key);
+  if (!entry) {
 #ifdef ENABLE_TRAINING
-    MemoryPatternGroup mem_patterns;
-    InlinedHashMap<int, TensorShape> inferred_shapes;
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+    MemoryPatternCacheEntry new_entry;
+    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, new_entry.patterns,
+                                  new_entry.inferred_shapes)
+            .IsOK()) {
+      return mem_patterns_.Insert(key, std::move(new_entry));
     }
 #else
     ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
@@ -899,11 +1089,7 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     return nullptr;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
-  }
-  return &it->second;
+  return entry;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -954,14 +1140,22 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  int64_t key = mem_pattern_bucket_policy_.CalculateKey(tensor_inputs);
+
+  MemoryPatternCacheEntry entry;
+  entry.patterns = std::move(mem_patterns);
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  // an existing pattern is only replaced if the new one has room for all of its blocks
+  mem_patterns_.Insert(key, std::move(entry));
   return Status::OK();
 }
 
+MemoryPatternCache::Stats SessionState::GetMemoryPatternCacheStats() const {
+  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+  return mem_patterns_.GetStats();
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -1158,6 +1352,7 @@ Status SessionState::CreateSubgraphSessionState() {
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
+      subgraph_session_state->numa_partitions_ = numa_partitions_;
 
       // recurse
       ORT_RETURN_IF_ERROR(subgraph_session_state->CreateSubgraphSessionState());
@@ -1541,6 +1736,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                               p_seq_exec_plan_);
   ORT_RETURN_IF_ERROR(status);
 
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDependencyDrivenExecution,
+                                                        "0") == "1") {
+    node_dependency_plan_ = CreateNodeDependencyPlan(*graph_viewer_, *p_seq_exec_plan_,
+                                                     session_options.execution_order);
+  }
+
   if (session_options.IsLoadCancellationFlagSet()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                            "SessionState finalize is canceled due to user request");
@@ -1612,6 +1814,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  concurrency::ThreadPool* initialization_thread_pool = GetInitializationThreadPool();
+
+  TimePoint tp;
+  if (profiler_.IsEnabled()) {
+    tp = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
       Env::Default(), graph_location, *graph_viewer_,
       GetAllocator(OrtDevice()),
@@ -1625,7 +1834,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, graph_.GetPrepacked()));
+      memory_profile_func, graph_.GetPrepacked(), initialization_thread_pool));
+
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_save_initialized_tensors", tp);
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1639,11 +1852,27 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
+  if (profiler_.IsEnabled()) {
+    tp = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_create_kernels", tp);
+  }
+
   if (!disable_prepacking) {
+    if (profiler_.IsEnabled()) {
+      tp = profiler_.Start();
+    }
+
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
+
+    if (profiler_.IsEnabled()) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_prepack", tp);
+    }
   }
 
   ORT_RETURN_IF_ERROR(
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -19,6 +20,7 @@
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/dependency_executor.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/stream_execution_context.h"
@@ -28,6 +30,7 @@
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
@@ -56,6 +59,7 @@ class ExecutionProviders;
 class KernelDef;
 class OpKernel;
 class NodeIndexInfo;
+class NumaPartitions;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 class DeviceStreamCollection;
@@ -189,6 +193,12 @@ class SessionState {
   // execution plan. nullptr until FinalizeSessionState is called
   const SequentialExecutionPlan* GetExecutionPlan() const;
 
+  // node dependency plan used by the dependency driven executor.
+  // nullptr unless the session runs in parallel mode with kOrtSessionOptionsConfigDependencyDrivenExecution enabled.
+  const NodeDependencyPlan* GetNodeDependencyPlan() const {
+    return node_dependency_plan_.has_value() ? &*node_dependency_plan_ : nullptr;
+  }
+
   const std::vector<AllocPlanPerValue>& GetPerValueAllocPlan() const;
 
   /**
@@ -214,16 +224,14 @@ class SessionState {
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
-  In training scenarios, the cache may be updated so
-  the callers would receive a copy of inferred shapes
-  made under mutex being held. In inference scenarios,
-  it is not mutable, we do not obtain a lock and simply get a pointer
-  w/o copying a hashtable
+  Returns nullptr if there is no pattern for the bucket of the input shapes.
+  In training scenarios, a missing pattern is generated from the input shapes
+  and the returned entry also holds the inferred activation shapes.
+  The caller keeps the entry alive for as long as it uses it.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  MemoryPatternCache::EntryPtr GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
-      gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      gsl::span<const int> feed_mlvalue_idxs) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -233,6 +241,17 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get the hit/miss/eviction counters of the memory pattern cache.
+  */
+  MemoryPatternCache::Stats GetMemoryPatternCacheStats() const;
+
+  /**
+  Whether input shapes are bucketed for the memory pattern cache lookup.
+  If so, a pattern may be used for inputs smaller than the ones it was planned for.
+  */
+  bool IsMemoryPatternBucketed() const { return !mem_pattern_bucket_policy_.IsExact(); }
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -290,6 +309,14 @@ class SessionState {
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
+  // Intra-op thread pool for the kernels of the Run executing on the calling thread.
+  // Differs from GetThreadPool() if the session runs one intra-op thread pool per NUMA node.
+  concurrency::ThreadPool* GetThreadPoolForCurrentRun() const;
+
+  // Use one intra-op thread pool per NUMA node and replicate pre-packed weights to every node.
+  // Must be called before FinalizeSessionState. Subgraph session states inherit the partitions.
+  void SetNumaPartitions(NumaPartitions* numa_partitions) noexcept { numa_partitions_ = numa_partitions; }
+
   const FuncManager& GetFuncMgr() const noexcept { return fused_funcs_mgr_; }
   FuncManager& GetMutableFuncMgr() noexcept { return fused_funcs_mgr_; }
 
@@ -326,6 +353,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetPrePackedWeightsCacheHitsCounter() const {
+    return prepacked_weights_cache_hits_counter_.load();
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -390,6 +421,10 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo(bool save_prepacked_on);
 
+  // The thread pool used to initialize the session state, or nullptr if it's initialized serially.
+  // See kOrtSessionOptionsParallelInitialization.
+  concurrency::ThreadPool* GetInitializationThreadPool() const;
+
   // create kernels using info in kernel_create_info_map_
   Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
 
@@ -495,6 +530,7 @@ class SessionState {
   // munmap memory region and close file descriptor
   InlinedVector<BufferUniquePtr> weights_buffers_;
   std::optional<SequentialExecutionPlan> p_seq_exec_plan_;
+  std::optional<NodeDependencyPlan> node_dependency_plan_;
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
@@ -512,16 +548,10 @@ class SessionState {
 
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  // cache for the generated mem_patterns. key is calculated based on the bucketed input shapes.
+  // entries are shared with the execution frames using them, so they may be evicted during a run.
+  mutable MemoryPatternCache mem_patterns_;
+  MemoryPatternBucketPolicy mem_pattern_bucket_policy_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -532,6 +562,9 @@ class SessionState {
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
 
+  // owned by the InferenceSession. nullptr unless the session partitions its intra-op threads by NUMA node.
+  NumaPartitions* numa_partitions_{};
+
   const DataTransferManager& data_transfer_mgr_;
 
   const ExternalDataLoaderManager& external_data_loader_mgr_;
@@ -576,6 +609,11 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times the pre-packed weights of a kernel were loaded from the persistent cache
+  // (kOrtSessionOptionsPrePackedWeightsCacheDir) instead of pre-packing the weight.
+  // Kernels may be pre-packed in parallel (kOrtSessionOptionsParallelInitialization).
+  std::atomic<size_t> prepacked_weights_cache_hits_counter_{0};
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
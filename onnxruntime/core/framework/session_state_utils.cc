@@ -1,11 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <exception>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <core/common/status.h>
 
@@ -28,6 +31,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -70,6 +74,8 @@ static common::Status AllocateBufferUsingDeviceAllocatorFromShapeAndType(const T
  * @param prepacked_for_graph Reference to an object managing prepacked weights for the graph.
  * @param use_device_allocator_for_initializers A flag indicating whether to use the device-specific allocator
  *                                              directly for initializers, potentially bypassing arenas.
+ * @param share_mapped_external_data A flag indicating whether external data used on CPU is mapped once for all
+ *                                   sessions in the process.
  * @return common::Status indicating success or failure of the deserialization process.
  *         Returns an error status if both `memory_buffer` and `alloc` are provided or if both are null (unless external data on CPU allows mmap),
  *         if string tensors are attempted to be copied to non-CPU devices, or if any underlying
@@ -81,7 +87,8 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                                              OrtValue& ort_value, const DataTransferManager& data_transfer_mgr,
                                              const ExternalDataLoaderManager& external_data_loader_mgr,
                                              PrepackedWeightsForGraph& prepacked_for_graph,
-                                             bool use_device_allocator_for_initializers = false) {
+                                             bool use_device_allocator_for_initializers = false,
+                                             bool share_mapped_external_data = false) {
   if (bool(alloc) == (memory_buffer != nullptr)) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
@@ -113,7 +120,8 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       // utilize the mmap'd buffer directly.
       ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path, tensor_proto,
                                                            ort_value,
-                                                           &prepacked_for_graph));
+                                                           &prepacked_for_graph,
+                                                           share_mapped_external_data));
       return common::Status::OK();
     } else {  // non-cpu tensor or tensor in a cpu accessible memory
       if (utils::HasString(tensor_proto)) {
@@ -222,6 +230,41 @@ common::Status CopyTensorFromCPUToDevice(
   }
 }
 
+common::Status ParallelForEach(concurrency::ThreadPool* thread_pool, size_t n,
+                               const std::function<common::Status(size_t i)>& fn) {
+  if (n == 0) {
+    return Status::OK();
+  }
+
+  std::vector<Status> statuses(n);
+#ifndef ORT_NO_EXCEPTIONS
+  std::vector<std::exception_ptr> exceptions(n);
+#endif
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(n),
+      [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = fn(static_cast<size_t>(i));
+        }
+        ORT_CATCH(...) {
+          // the thread pool doesn't propagate exceptions thrown by its workers
+          ORT_HANDLE_EXCEPTION([&]() { exceptions[i] = std::current_exception(); });
+        }
+      });
+
+  for (size_t i = 0; i < n; ++i) {
+#ifndef ORT_NO_EXCEPTIONS
+    if (exceptions[i]) {
+      std::rethrow_exception(exceptions[i]);
+    }
+#endif
+    ORT_RETURN_IF_ERROR(statuses[i]);
+  }
+
+  return Status::OK();
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -235,7 +278,8 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -315,6 +359,10 @@ common::Status SaveInitializedTensors(
     initialized_tensors_to_allocate.erase(entry);
   }
 
+  const bool share_mapped_external_data =
+      session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsConfigShareMappedExternalInitializers, "0") == "1";
+
   for (const auto& entry : initialized_tensors_to_allocate) {
     // We don't want to trace shared initializers since their memory is provided by the user
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
@@ -324,6 +372,11 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    if (share_mapped_external_data && utils::HasExternalData(*entry.second) &&
+        exec_plan.GetLocation(entry.first) == default_cpu_device) {
+      // the data is mapped from disk, a planned buffer for it would never be used
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
 
@@ -343,6 +396,25 @@ common::Status SaveInitializedTensors(
   }
 
   // 3. create weight tensors based on weights buffer
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> memory_buffer;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+    bool user_supplied = false;
+    bool deserialize_in_parallel = false;
+  };
+
+  std::vector<InitializerToSave> initializers_to_save;
+  initializers_to_save.reserve(id_to_initialized_tensor.size());
+  std::vector<size_t> parallel_deserialization_indices;
+
+  // 3a. get the buffers of the weights. the planner isn't thread safe so this is always serial.
   for (const auto& entry : id_to_initialized_tensor) {
     // We check for cancellation for every initializer since mapping from disk can be costly
     if (session_options.IsLoadCancellationFlagSet()) {
@@ -358,55 +430,107 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
+    auto& initializer = initializers_to_save.emplace_back();
+    initializer.ort_value_index = ort_value_index;
+    initializer.tensor_proto = entry.second;
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.user_supplied = true;
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
-    } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
+      continue;
+    }
 
-      std::optional<MemBuffer> memory_buffer;
-      AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, memory_buffer, alloc));
-      const bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(
-              kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+    // TODO: if the tensor need be copied, does it have enough room?
+    ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.memory_buffer,
+                                                      initializer.alloc));
+
+    // internal initializers deserialized into CPU memory only read their TensorProto and write their own buffer.
+    // external initializers may share mappings and the pre-packed weights container, and copies to other devices
+    // use the data transfer of the EP, so those are processed serially.
+    const auto& memory_info = (initializer.alloc != nullptr) ? initializer.alloc->Info()
+                                                             : initializer.memory_buffer->GetAllocInfo();
+    if (OrtValue ort_value_from_graph;
+        thread_pool != nullptr && memory_info.device == default_cpu_device &&
+        !utils::HasExternalData(*entry.second) && !graph.GetOrtValueInitializer(name, ort_value_from_graph)) {
+      initializer.deserialize_in_parallel = true;
+      parallel_deserialization_indices.push_back(initializers_to_save.size() - 1);
+    }
+  }
 
-      // Check if we already have an OrtValue for this initializer on CPU
-      if (OrtValue ort_value_from_graph;
-          graph.GetOrtValueInitializer(name, ort_value_from_graph)) {
-        const auto& memory_info = (alloc != nullptr) ? alloc->Info() : memory_buffer->GetAllocInfo();
-        if (memory_info.device == default_cpu_device) {
-          // This is on CPU use directly from the graph
-          ort_value = std::move(ort_value_from_graph);
-        } else {
-          TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
-          const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(
-                                               tensor_proto.data_type())
-                                               ->GetElementType();
-          Tensor tensor;
-          ORT_RETURN_IF_ERROR(AllocateTensor((memory_buffer) ? &*memory_buffer : nullptr, tensor, type,
-                                             tensor_shape, use_device_allocator_for_initializers,
-                                             alloc));
-          ORT_RETURN_IF_ERROR(CopyTensorFromCPUToDevice(data_transfer_mgr,
-                                                        ort_value_from_graph.Get<Tensor>(),
-                                                        std::move(tensor), ort_value));
+  // 3b. deserialize the internal CPU initializers in parallel
+  ORT_RETURN_IF_ERROR(ParallelForEach(
+      thread_pool, parallel_deserialization_indices.size(),
+      [&](size_t i) -> Status {
+        if (session_options.IsLoadCancellationFlagSet()) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                                 "Saving session state weights is canceled due to user request.");
         }
-      } else {
-        // We need to deserialize the tensor proto into an OrtValue
-        // using the preallocated buffer or allocator.
 
-        Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (memory_buffer.has_value()) ? &*memory_buffer : nullptr, alloc,
-                                           default_cpu_alloc, ort_value, data_transfer_mgr, external_data_loader_mgr,
-                                           prepacked_for_graph,
+        auto& initializer = initializers_to_save[parallel_deserialization_indices[i]];
+        Status st = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto,
+                                           (initializer.memory_buffer.has_value()) ? &*initializer.memory_buffer
+                                                                                   : nullptr,
+                                           initializer.alloc, default_cpu_alloc, initializer.ort_value,
+                                           data_transfer_mgr, external_data_loader_mgr, prepacked_for_graph,
                                            use_device_allocator_for_initializers);
         if (!st.IsOK()) {
           std::ostringstream oss;
-          oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+          oss << "Deserialize tensor " << initializer.tensor_proto->name() << " failed." << st.ErrorMessage();
           return Status(st.Category(), st.Code(), oss.str());
         }
+        return Status::OK();
+      }));
+
+  // 3c. create the remaining weight tensors and save all of them in order
+  for (auto& initializer : initializers_to_save) {
+    if (session_options.IsLoadCancellationFlagSet()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                             "Saving session state weights is canceled due to user request.");
+    }
+
+    const int ort_value_index = initializer.ort_value_index;
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *initializer.tensor_proto;
+    const std::string& name = tensor_proto.name();
+    OrtValue& ort_value = initializer.ort_value;
+    const std::optional<MemBuffer>& memory_buffer = initializer.memory_buffer;
+    const AllocatorPtr& alloc = initializer.alloc;
+
+    if (initializer.user_supplied || initializer.deserialize_in_parallel) {
+      // nothing to do
+    } else if (OrtValue ort_value_from_graph;
+               graph.GetOrtValueInitializer(name, ort_value_from_graph)) {
+      // Check if we already have an OrtValue for this initializer on CPU
+      const auto& memory_info = (alloc != nullptr) ? alloc->Info() : memory_buffer->GetAllocInfo();
+      if (memory_info.device == default_cpu_device) {
+        // This is on CPU use directly from the graph
+        ort_value = std::move(ort_value_from_graph);
+      } else {
+        TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+        const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(
+                                             tensor_proto.data_type())
+                                             ->GetElementType();
+        Tensor tensor;
+        ORT_RETURN_IF_ERROR(AllocateTensor((memory_buffer) ? &*memory_buffer : nullptr, tensor, type,
+                                           tensor_shape, use_device_allocator_for_initializers,
+                                           alloc));
+        ORT_RETURN_IF_ERROR(CopyTensorFromCPUToDevice(data_transfer_mgr,
+                                                      ort_value_from_graph.Get<Tensor>(),
+                                                      std::move(tensor), ort_value));
+      }
+    } else {
+      // We need to deserialize the tensor proto into an OrtValue
+      // using the preallocated buffer or allocator.
+
+      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (memory_buffer.has_value()) ? &*memory_buffer : nullptr, alloc,
+                                         default_cpu_alloc, ort_value, data_transfer_mgr, external_data_loader_mgr,
+                                         prepacked_for_graph,
+                                         use_device_allocator_for_initializers,
+                                         share_mapped_external_data);
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
       }
     }
 
@@ -34,11 +34,23 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+// Runs fn(i) for every i in [0, n) on 'thread_pool', or on the calling thread if 'thread_pool' is nullptr.
+// Every index runs even if others fail. The failure returned (or exception rethrown) is the one of the lowest
+// failing index, so the result doesn't depend on how the work was scheduled.
+common::Status ParallelForEach(concurrency::ThreadPool* thread_pool, size_t n,
+                               const std::function<common::Status(size_t i)>& fn);
+
+// If 'thread_pool' is not nullptr, the initializers deserialized into CPU memory are deserialized in parallel.
+// save_tensor_func is always called on the calling thread and in the same order.
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -51,7 +63,8 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool = nullptr);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* memory_buffer,
@@ -6,8 +6,11 @@
 #include <memory>
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <string>
 #include <filesystem>
+#include <tuple>
 #if defined(__wasm__)
 #include <emscripten.h>
 #endif
@@ -1041,12 +1044,58 @@ static Status GetFileContent(const Env& env, const std::filesystem::path& file_p
   external_data.swap(raw_buffer);
   return Status::OK();
 }
+
+// Same as GetFileContent, but the content is shared by all callers in the process that request the same range of the
+// same file, e.g. the sessions created from the same model. The process only keeps weak references to the content,
+// so it is unmapped once the last buffer referencing it is released, e.g. after all consumers pre-packed it.
+// The content must not be modified.
+static Status GetSharedFileContent(const Env& env, const std::filesystem::path& file_path, FileOffsetType offset,
+                                   size_t length, IAllocatorUniquePtr<void>& external_data) {
+  // the file is identified by its canonical path and last modification time, so a file replaced on disk is mapped
+  // again.
+  using Key = std::tuple<std::filesystem::path::string_type, int64_t, FileOffsetType, size_t>;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<void>> shared_content;
+
+  std::error_code ec;
+  std::filesystem::path canonical_path = std::filesystem::weakly_canonical(file_path, ec);
+  if (ec) {
+    canonical_path = file_path;
+  }
+  const auto last_write_time = std::filesystem::last_write_time(file_path, ec);
+  const Key key{canonical_path.native(), ec ? 0 : static_cast<int64_t>(last_write_time.time_since_epoch().count()),
+                offset, length};
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<void> content;
+  if (auto it = shared_content.find(key); it != shared_content.end()) {
+    content = it->second.lock();
+  }
+
+  if (!content) {
+    IAllocatorUniquePtr<void> data;
+    ORT_RETURN_IF_ERROR(GetFileContent(env, file_path, offset, length, data));
+    auto deleter = data.get_deleter();
+    content = std::shared_ptr<void>(data.release(), std::move(deleter));
+
+    for (auto it = shared_content.begin(); it != shared_content.end();) {
+      it = it->second.expired() ? shared_content.erase(it) : std::next(it);
+    }
+    shared_content[key] = content;
+  }
+
+  void* data = content.get();
+  IAllocatorUniquePtr<void> shared_buffer(data, [content = std::move(content)](void*) mutable { content.reset(); });
+  external_data.swap(shared_buffer);
+  return Status::OK();
+}
 #endif
 
 Status GetExtDataFromTensorProto(const Env& env,
                                  const std::filesystem::path& model_path,
                                  const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                 OrtValue& ort_value, PrepackedWeightsForGraph* prepacked_info) {
+                                 OrtValue& ort_value, PrepackedWeightsForGraph* prepacked_info,
+                                 bool share_mapped_data) {
   ORT_ENFORCE(HasExternalData(tensor_proto), "TensorProto for: ",
               tensor_proto.name(), "Expected to have external data");
 
@@ -1118,9 +1167,13 @@ Status GetExtDataFromTensorProto(const Env& env,
                   " size to read: ", static_cast<size_t>(raw_data_safe_len), " given file_length: ", file_length,
                   " are out of bounds or can not be read in full.");
 
+    // shared data can't be swapped in place below
+    const auto get_file_content = (share_mapped_data && endian::native == endian::little) ? GetSharedFileContent
+                                                                                          : GetFileContent;
+
     IAllocatorUniquePtr<void> ext_data_buf;
-    ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, file_offset, raw_data_safe_len,
-                                       ext_data_buf));
+    ORT_RETURN_IF_ERROR(get_file_content(env, external_data_file_path, file_offset, raw_data_safe_len,
+                                         ext_data_buf));
 
     // Data on disk is little endian
     if constexpr (endian::native != endian::little) {
@@ -1162,8 +1215,8 @@ Status GetExtDataFromTensorProto(const Env& env,
                         " is out of bounds and can not read in full");
 
           IAllocatorUniquePtr<void> data_ptr;
-          ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, blob_offset, blob_length,
-                                             data_ptr));
+          ORT_RETURN_IF_ERROR(get_file_content(env, external_data_file_path, blob_offset, blob_length,
+                                               data_ptr));
           prepacked_weights.buffers_.push_back(std::move(data_ptr));
           prepacked_weights.buffer_sizes_.push_back(blob_length);
         }
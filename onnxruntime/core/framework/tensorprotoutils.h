@@ -215,10 +215,13 @@ constexpr const ORTCHAR_T* kTensorProtoMemoryAddressTag = ORT_TSTR("*/_ORT_MEM_A
 /// <param name="tensor_proto">tensor proto containing external data</param>
 /// <param name="ort_value">output ort value</param>
 /// <param name="prepacked_info">optional pre-packed weight data output container</param>
+/// <param name="share_mapped_data">share the data read from the external file with all other callers in the process
+/// that read the same data with this flag set. The data must not be modified.</param>
 /// <returns>Status</returns>
 common::Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& model_path,
                                          const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                         OrtValue& ort_value, PrepackedWeightsForGraph* prepacked_info = nullptr);
+                                         OrtValue& ort_value, PrepackedWeightsForGraph* prepacked_info = nullptr,
+                                         bool share_mapped_data = false);
 
 // Given a tensor proto with external data obtain a tensor using the specified custom external data loader.
 common::Status LoadExtDataToTensorFromTensorProto(const Env& env, const std::filesystem::path& model_path,
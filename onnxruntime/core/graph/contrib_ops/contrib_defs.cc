@@ -631,6 +631,41 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Computes a chain of element-wise operators in a single pass over the data.
+
+The operators are given as a program: instruction i applies ops[i] to the registers operands[2*i] and
+operands[2*i+1], where the first registers hold the inputs, followed by the result of each instruction. The second
+operand of a unary operator is ignored. The output is the result of the last instruction, broadcast to the shape of
+all the inputs.
+
+Supported operators are Add, Sub, Mul, Div, Max, Min, Relu, Neg, Abs, Sqrt, Reciprocal, Sigmoid, Tanh, Exp and Erf,
+with the semantics of the ONNX operators of the same name.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops", "Operator of each instruction.", AttributeProto::STRINGS)
+        .Attr("operands", "Two registers per instruction, read by its operator.", AttributeProto::INTS)
+        .Input(0, "inputs", "Inputs of the program, which must be broadcastable to a common shape.", "T",
+               OpSchema::Variadic)
+        .Output(0, "Y", "Result of the last instruction.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+          for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+            if (!hasInputShape(ctx, i)) {
+              return;
+            }
+            shapes.push_back(&ctx.getInputType(i)->tensor_type().shape());
+          }
+          multidirectionalBroadcastShapeInference(
+              shapes, *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -169,6 +169,83 @@ void RegisterNchwcSchemas() {
         ONNX_NAMESPACE::convPoolShapeInference(ctx, true, false, 0, 1);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ConvTranspose)
+      .SetDomain(kMSNchwcDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(For internal use.)DOC")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("dilations", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("output_padding", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("output_shape", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
+      .Input(0, "X", "", "T")
+      .Input(1, "W", "", "T")
+      .Input(2, "B", "", "T", OpSchema::Optional)
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+
+        const auto& input_shape = ctx.getInputType(0)->tensor_type().shape();
+        const auto& weight_shape = ctx.getInputType(1)->tensor_type().shape();
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+
+        if (input_shape.dim_size() != 4 || weight_shape.dim_size() != 4) {
+          fail_shape_inference("tensor rank must be 4");
+        }
+
+        // Copy the batch dimension.
+        *output_shape->add_dim() = input_shape.dim(0);
+
+        // Block align the channel dimension.
+        auto* output_channel_dim = output_shape->add_dim();
+        if (weight_shape.dim(1).has_dim_value()) {
+          const int64_t channels = weight_shape.dim(1).dim_value();
+          const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+          int64_t nchwc_channels = (channels + nchwc_block_size - 1) & ~(nchwc_block_size - 1);
+          output_channel_dim->set_dim_value(nchwc_channels);
+        }
+
+        // Compute the spatial dimensions for explicit padding. The implicit padding of
+        // auto_pad and output_shape is left to the kernel.
+        std::vector<int64_t> pads;
+        std::vector<int64_t> strides;
+        std::vector<int64_t> dilations;
+        std::vector<int64_t> output_padding;
+        std::vector<int64_t> output_shape_attr;
+        const bool explicit_padding = getAttribute(ctx, "auto_pad", "NOTSET") == "NOTSET" &&
+                                      !getRepeatedAttribute(ctx, "output_shape", output_shape_attr);
+        if (!getRepeatedAttribute(ctx, "pads", pads)) {
+          pads.assign(4, 0);
+        }
+        if (!getRepeatedAttribute(ctx, "strides", strides)) {
+          strides.assign(2, 1);
+        }
+        if (!getRepeatedAttribute(ctx, "dilations", dilations)) {
+          dilations.assign(2, 1);
+        }
+        if (!getRepeatedAttribute(ctx, "output_padding", output_padding)) {
+          output_padding.assign(2, 0);
+        }
+
+        for (int i = 0; i < 2; i++) {
+          auto* output_dim = output_shape->add_dim();
+          const auto& input_dim = input_shape.dim(2 + i);
+          const auto& kernel_dim = weight_shape.dim(2 + i);
+          if (explicit_padding && pads.size() == 4 && strides.size() == 2 && dilations.size() == 2 &&
+              output_padding.size() == 2 && input_dim.has_dim_value() && kernel_dim.has_dim_value()) {
+            output_dim->set_dim_value((input_dim.dim_value() - 1) * strides[i] + output_padding[i] +
+                                      (kernel_dim.dim_value() - 1) * dilations[i] + 1 - pads[i] - pads[i + 2]);
+          }
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(MaxPool)
       .FillUsing(NchwcPoolOpSchemaGenerator)
       .Attr("storage_order", "", AttributeProto::INT, static_cast<int64_t>(0));
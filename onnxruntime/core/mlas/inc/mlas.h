@@ -84,6 +84,10 @@ Abstract:
 #define MLAS_SUPPORTS_GEMM_DOUBLE
 #endif
 
+#if (defined(__aarch64__) && defined(__linux__)) || defined(MLAS_TARGET_AMD64)
+#define MLAS_SUPPORTS_SBGEMM
+#endif
+
 #if (!defined(_MSC_VER)) || (_MSC_VER >= 1930)
 #if defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_ARM64EC)
 #if !defined(__APPLE__)
@@ -165,6 +169,8 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluActivation,
+    MlasSiluActivation,
     MlasActivationKindCount,
 };
 
@@ -203,6 +209,33 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+/**
+ * @brief Supply an epilogue that single precision gemm functions apply to each
+ *        block of matrix C while the block is still resident in the cache:
+ *
+ *        C := Activation(C * Scale + Bias + Addend)
+ *
+ *        Scale and Bias are per column vectors of N elements, Addend is a
+ *        M x N matrix. Each of them is optional.
+ */
+struct MLAS_SGEMM_EPILOGUE {
+    const float* Scale = nullptr;  /**< Supplies the optional per column scale */
+    const float* Bias = nullptr;   /**< Supplies the optional per column bias */
+    const float* Addend = nullptr; /**< Supplies the optional matrix added to C */
+    size_t ldAddend = 0;           /**< Supplies the first dimension of matrix Addend */
+    MLAS_ACTIVATION Activation = {MlasIdentityActivation, {}}; /**< Supplies the activation */
+};
+
+/**
+ * @brief Supply blocking and threading parameters that override the defaults
+ *        of single precision gemm functions. These are chosen by timing the
+ *        candidates for a given shape; a zero field selects the default.
+ */
+struct MLAS_SGEMM_TUNING_PARAMS {
+    size_t StrideN = 0;          /**< Supplies the number of columns of matrix B per slice */
+    size_t ThreadComplexity = 0; /**< Supplies the number of multiply-adds per thread */
+};
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -216,6 +249,8 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr; /**< Supplies the optional epilogue */
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning = nullptr; /**< Supplies the optional tuning parameters */
 };
 
 /**
@@ -758,6 +793,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -790,6 +826,9 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileRowsPerBlock;
+        } Winograd;
     } u;
 };
 
@@ -811,18 +850,79 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 float Beta,
                 MLAS_THREADPOOL* ThreadPool);
 
+void MLASCALL
+MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
+                size_t Dimensions,
+                size_t BatchCount,
+                size_t GroupCount,
+                size_t InputChannels,
+                const int64_t* InputShape,
+                const int64_t* KernelShape,
+                const int64_t* DilationShape,
+                const int64_t* Padding,
+                const int64_t* StrideShape,
+                const int64_t* OutputShape,
+                size_t FilterCount,
+                const MLAS_ACTIVATION* Activation,
+                size_t* WorkingBufferSize,
+                float Beta,
+                MLAS_THREADPOOL* ThreadPool,
+                bool UsePackedFilter);
+
+void
+MLASCALL
+MlasConv(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConv(
     const MLAS_CONV_PARAMETERS* Parameters,
     const float* Input,
     const float* Filter,
+    const void* PackedFilter,
     const float* Bias,
     float* WorkingBuffer,
     float* Output,
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Packs the filter of a convolution for which MlasConvPackFilterSize returns a
+// non-zero size, so that MlasConvPrepare with UsePackedFilter set can select an
+// algorithm that transforms the filter once. The packed filter buffer must be
+// aligned to MlasGetPreferredBufferAlignment().
+//
+
+size_t
+MLASCALL
+MlasConvPackFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    void* PackedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1461,6 +1561,159 @@ MlasRotaryEmbedOneRow(
     T* output
 );
 
+/**
+ * @brief Parameters of MlasLayerNormalization.
+ *
+ * Each row of the output is computed from x = Input + Skip + SkipBias as
+ *   Output = (x - mean(x)) * InvStdDev * Scale + Bias          (LayerNorm)
+ *   Output = x * InvStdDev * Scale + Bias                      (Simplified, RMSNorm)
+ * where InvStdDev is 1 / sqrt(var(x) + Epsilon), or 1 / sqrt(mean(x * x) + Epsilon) when Simplified.
+ * Rows are computed in fp32 for both float and MLAS_FP16 T. Per column vectors are always fp32.
+ *
+ * @tparam T: data type of the rows, float or MLAS_FP16.
+ */
+template <typename T>
+struct MLAS_LAYER_NORM_PARAMS {
+    const T* Input = nullptr;          /**< Input rows, of shape [Rows, N] */
+    const T* Skip = nullptr;           /**< Optional residual rows, of shape [SkipRows, N]. Row r adds Skip row r % SkipRows */
+    size_t SkipRows = 1;               /**< Number of rows in Skip */
+    const float* SkipBias = nullptr;   /**< Optional bias added together with Skip, of shape [N] */
+    const float* Scale = nullptr;      /**< Scale rows, of shape [ScaleRows, N] */
+    const float* Bias = nullptr;       /**< Optional bias rows, of shape [ScaleRows, N] */
+    size_t ScaleRows = 1;              /**< Number of rows in Scale and Bias */
+    size_t ScaleRowRepeat = 1;         /**< Row r uses Scale/Bias row (r / ScaleRowRepeat) % ScaleRows */
+    T* Output = nullptr;               /**< Output rows, of shape [Rows, N] */
+    T* SkipSumOutput = nullptr;        /**< Optional output of x, of shape [Rows, N] */
+    float* Mean = nullptr;             /**< Optional output of the mean of each row, of shape [Rows] */
+    float* InvStdDev = nullptr;        /**< Optional output of the inverse standard deviation of each row, of shape [Rows] */
+    size_t Rows = 0;                   /**< Number of rows */
+    size_t N = 0;                      /**< Number of elements per row */
+    float Epsilon = 0.0f;
+    bool Simplified = false;           /**< RMS normalization, without mean subtraction */
+};
+
+/**
+ * @brief Layer normalization with an optional fused residual add, multithreaded over rows.
+ *
+ * @tparam T: data type of the rows, float or MLAS_FP16.
+ * @param Params:      the normalization parameters
+ * @param ThreadPool:  the thread pool to use, or nullptr
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+/**
+ * @brief Parameters of MlasLogSoftmaxTopK.
+ *
+ * The K largest entries of each row are selected and scored as
+ *     Values[r, k] = Scale * LogSoftmax(Input[r, :])[Indices[r, k]] + Addends[r]
+ * Log softmax is monotonic, so the entries are selected on the input while
+ * the log-sum-exp of the row is accumulated online, in a single pass over the
+ * row. Each row of results is sorted in descending order, with ties ordered
+ * by ascending index.
+ */
+struct MLAS_LOG_SOFTMAX_TOPK_PARAMS {
+    const float* Input = nullptr;      /**< Input rows, of shape [Rows, N] */
+    size_t Rows = 0;                   /**< Number of rows */
+    size_t N = 0;                      /**< Number of elements per row */
+    size_t K = 0;                      /**< Number of entries to select per row, at most N */
+    float Scale = 1.0f;                /**< Positive scale of the log softmax, e.g. 1 / temperature */
+    const float* Addends = nullptr;    /**< Optional value added to the scores of each row, of shape [Rows] */
+    float* Values = nullptr;           /**< Optional output of the scores, of shape [Rows, K] */
+    int32_t* Indices = nullptr;        /**< Output of the selected indices, of shape [Rows, K] */
+    float* LogSumExp = nullptr;        /**< Optional output of the log-sum-exp of each row, of shape [Rows] */
+};
+
+/**
+ * @brief Fused log softmax and top-k selection, multithreaded over rows and,
+ *        when there are fewer rows than threads, over segments of a row.
+ *
+ * When both Values and LogSumExp are null, only the selection is done and no
+ * exponentials are computed.
+ *
+ * @param Params:      the log softmax and top-k parameters
+ * @param ThreadPool:  the thread pool to use, or nullptr
+ */
+void
+MLASCALL
+MlasLogSoftmaxTopK(
+    const MLAS_LOG_SOFTMAX_TOPK_PARAMS& Params,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+/**
+ * @brief Operations of a fused element-wise program
+ */
+enum MLAS_FUSED_ELTWISE_OPCODE {
+    MlasFusedEltwiseAdd,
+    MlasFusedEltwiseSub,
+    MlasFusedEltwiseMul,
+    MlasFusedEltwiseDiv,
+    MlasFusedEltwiseMax,
+    MlasFusedEltwiseMin,
+    MlasFusedEltwiseRelu,
+    MlasFusedEltwiseNeg,
+    MlasFusedEltwiseAbs,
+    MlasFusedEltwiseSqrt,
+    MlasFusedEltwiseReciprocal,
+    MlasFusedEltwiseLogistic,
+    MlasFusedEltwiseTanh,
+    MlasFusedEltwiseExp,
+    MlasFusedEltwiseErf,
+};
+
+/**
+ * @brief Maximum number of inputs and of instructions of a fused element-wise program
+ */
+constexpr size_t MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS = 16;
+constexpr size_t MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS = 16;
+
+/**
+ * @brief Instruction of a fused element-wise program
+ *
+ * Operands name registers: the first registers hold the inputs of the program,
+ * followed by the result of each instruction. An instruction may only read the
+ * inputs and the results of the instructions before it.
+ */
+struct MLAS_FUSED_ELTWISE_INSTRUCTION {
+    MLAS_FUSED_ELTWISE_OPCODE Opcode;
+    uint32_t Operands[2];              /**< Registers of the operands, the second is unused by unary opcodes */
+};
+
+/**
+ * @brief Evaluates a program of element-wise operations over N elements in a
+ *        single pass, keeping the intermediate results in blocks small enough
+ *        to stay in the L1 cache. The result of the last instruction is
+ *        written to Output.
+ *
+ * Each input either supplies N elements or a single element broadcast to all
+ * N elements.
+ *
+ * @param Program:           the instructions of the program
+ * @param InstructionCount:  the number of instructions, from 1 to MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS
+ * @param Inputs:            the inputs of the program
+ * @param InputIsScalar:     for each input, whether it is a single element
+ * @param InputCount:        the number of inputs, at most MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS
+ * @param Output:            the output of N elements
+ * @param N:                 the number of elements
+ */
+void
+MLASCALL
+MlasComputeFusedEltwise(
+    const MLAS_FUSED_ELTWISE_INSTRUCTION* Program,
+    size_t InstructionCount,
+    const float* const* Inputs,
+    const bool* InputIsScalar,
+    size_t InputCount,
+    float* Output,
+    size_t N
+);
+
 /**
  * @brief Supply matrices data information to half precision gemm functions
  */
@@ -1578,6 +1831,14 @@ MlasGemm(
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether MlasHalfGemmBatch has optimized kernels on the current CPU.
+ *        On x86_64, the kernels compute in fp32 with F16C conversions on
+ *        AVX2 and AVX512 capable CPUs.
+*/
+bool MLASCALL
+MlasHalfGemmAccelerationSupported();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -1780,9 +2041,11 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
+ *        On x86_64, this is true with AVX512-BF16, or with AVX2 where the
+ *        bf16 matrix B is widened to fp32 in registers.
  */
 bool MLASCALL
 MlasBf16AccelerationSupported();
@@ -1977,6 +2240,19 @@ MlasNhwcAvgPool(
 
 #endif
 
+/**
+ * @brief Arguments of flash attention.
+ *
+ * Q is (B, N, S_q, H_qk) with a batch stride of q_batch_stride elements. K and V are
+ * (B, N_kv, S_buf, H) where the first kv_valid_lengths[b] rows of each head are valid,
+ * so a KV cache can be read in place. Query head n reads K/V head n / (N / N_kv).
+ * The output is (B, S_q, N, H_v).
+ *
+ * With is_causal, query row s of batch b sits at position past + s, with
+ * past = max(kv_valid_lengths[b] - S_q, 0), and attends to the keys at or before
+ * that position. A non-negative local_window_size further limits it to the last
+ * local_window_size + 1 keys.
+ */
 struct MlasFlashAttentionThreadedArgs {
     int batch_size;
     int num_heads;
@@ -1990,16 +2266,33 @@ struct MlasFlashAttentionThreadedArgs {
     int thread_count;
     float* buffer;
     size_t buffer_size_per_thread;
-    const float* query;
-    const float* key;
-    const float* value;
-    float* output;
+    const void* query;                           /**< float, or MLAS_FP16 when is_fp16 */
+    const void* key;                             /**< float, or MLAS_FP16 when is_fp16 */
+    const void* value;                           /**< float, or MLAS_FP16 when is_fp16 */
+    void* output;                                /**< float, or MLAS_FP16 when is_fp16 */
+    bool is_fp16 = false;
+    int kv_num_heads = 0;                        /**< # of K/V heads, 0 means num_heads */
+    int kv_buffer_sequence_length = 0;           /**< # of rows of each K/V head, 0 means kv_sequence_length */
+    size_t q_batch_stride = 0;                   /**< elements between batches of Q, 0 means N * S_q * H_qk */
+    const int32_t* kv_valid_lengths = nullptr;   /**< per batch # of valid K/V rows, nullptr means kv_sequence_length */
+    bool is_causal = false;
+    int local_window_size = -1;                  /**< -1 means no sliding window */
 };
 
 /**
- * @brief Per-thread worker function for fp32 Flash Attention
- * @param thread_id    Thread index
+ * @brief Returns the size in bytes of the scratch buffer each thread of flash attention needs.
+ *        The block sizes, head sizes and is_fp16 of args must be set.
+ */
+size_t
+MLASCALL
+MlasFlashAttentionGetBufferSizePerThread(
+    const MlasFlashAttentionThreadedArgs* args
+);
+
+/**
+ * @brief Flash Attention on fp32 or fp16 inputs, accumulating in fp32
  * @param args         Arguments
+ * @param ThreadPool   Thread pool
  * @return
 */
 void
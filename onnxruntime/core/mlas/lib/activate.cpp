@@ -406,6 +406,77 @@ Return Value:
     }
 }
 
+void
+MlasTransformedActivationKernel(
+    MLAS_ACTIVATION_KIND ActivationKind,
+    float* Buffer,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the activations of the form x * F(x), where F(x) is
+    the standard normal cumulative distribution 0.5 * (1 + erf(x / sqrt(2)))
+    for GELU or the logistic function for SiLU.
+
+Arguments:
+
+    ActivationKind - Supplies MlasGeluActivation or MlasSiluActivation.
+
+    Buffer - Supplies the output matrix.
+
+    M - Supplies the number of rows in the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 256;
+
+    float Transformed[BlockSize];
+
+    while (M-- > 0) {
+
+        for (size_t n = 0; n < N; n += BlockSize) {
+
+            const size_t CountN = std::min(N - n, BlockSize);
+            float* x = Buffer + n;
+
+            if (ActivationKind == MlasGeluActivation) {
+
+                for (size_t i = 0; i < CountN; i++) {
+                    Transformed[i] = x[i] * 0.70710678118654752f;
+                }
+
+                MlasComputeErf(Transformed, Transformed, CountN);
+
+                for (size_t i = 0; i < CountN; i++) {
+                    x[i] = 0.5f * x[i] * (1.0f + Transformed[i]);
+                }
+
+            } else {
+
+                MlasComputeLogistic(x, Transformed, CountN);
+
+                for (size_t i = 0; i < CountN; i++) {
+                    x[i] = x[i] * Transformed[i];
+                }
+            }
+        }
+
+        Buffer += ldc;
+    }
+}
+
 void
 MLASCALL
 MlasActivation(
@@ -512,6 +583,17 @@ Return Value:
             break;
         }
 
+        case MlasGeluActivation:
+        case MlasSiluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            MlasTransformedActivationKernel(Activation->ActivationKind, Buffer, M, N, ldc);
+            break;
+        }
+
         case MlasActivationKindCount:
         {
             MLAS_THROW_EX(std::runtime_error, "bad mlas activation kind");
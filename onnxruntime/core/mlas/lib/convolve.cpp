@@ -859,6 +859,56 @@ Return Value:
 
     None.
 
+--*/
+{
+    MlasConv(Parameters, Input, Filter, nullptr, Bias, WorkingBuffer, Output, ThreadPool);
+}
+
+void
+MLASCALL
+MlasConv(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    PackedFilter - Optionally supplies the filter packed by MlasConvPackFilter,
+        which is used instead of transforming the filter on every call by the
+        algorithms that transform the filter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
 --*/
 {
     const size_t FilterCount = Parameters->FilterCount;
@@ -874,6 +924,9 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    const size_t PackedFilterGroupSize = (Algorithm == MlasConvAlgorithmWinograd) ?
+        MlasConvWinogradPackedFilterSize(Parameters->InputChannels, FilterCount) : 0;
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -919,6 +972,7 @@ Return Value:
     for (size_t batch = 0; batch < BatchCount; batch++) {
 
         const float* filter = Filter;
+        const uint8_t* packed_filter = static_cast<const uint8_t*>(PackedFilter);
         const float* bias = Bias;
 
         for (size_t group = 0; group < GroupCount; group++) {
@@ -976,6 +1030,13 @@ Return Value:
                     break;
                 }
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    MlasConvWinograd(Parameters, Input, filter, packed_filter, bias, WorkingBuffer,
+                        Output, ThreadPool);
+                    break;
+                }
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
                 case MlasConvAlgorithmDepthwise:
@@ -1012,6 +1073,10 @@ Return Value:
                 bias += FilterCount;
             }
 
+            if (packed_filter != nullptr) {
+                packed_filter += PackedFilterGroupSize;
+            }
+
             filter += FilterGroupSize;
             Input += InputGroupSize;
             Output += OutputGroupSize;
@@ -1092,6 +1157,88 @@ Return Value:
 
     None.
 
+--*/
+{
+    MlasConvPrepare(Parameters, Dimensions, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+        DilationShape, Padding, StrideShape, OutputShape, FilterCount, Activation, WorkingBufferSize, Beta,
+        ThreadPool, false);
+}
+
+void
+MLASCALL
+MlasConvPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize,
+    float Beta,
+    MLAS_THREADPOOL* ThreadPool,
+    bool UsePackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a convolution operation by computing required
+    parameters including the required working buffer size for intermediate
+    results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    Dimensions - Supplies the number of dimensions (must be between 1 and 3).
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of zero padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    FilterCount - Supplies the number of rows of the filter matrix per group.
+
+    Activation - Supplies the parameters for the activation to apply to the
+        convolution output.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+    UsePackedFilter - Supplies true if the caller passes the filter packed by
+        MlasConvPackFilter to MlasConv. The algorithms that transform the
+        filter are only selected in this case, as transforming the filter on
+        every call costs more than these algorithms save.
+
+Return Value:
+
+    None.
+
 --*/
 {
     //
@@ -1211,6 +1358,15 @@ Return Value:
         }
     }
 
+    //
+    // Detect a 3x3 convolution with unit strides and dilations that can use
+    // the Winograd algorithm with a packed filter.
+    //
+
+    if (UsePackedFilter && MlasConvWinogradPrepare(Parameters, WorkingBufferSize)) {
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
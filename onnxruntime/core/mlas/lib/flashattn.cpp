@@ -2,6 +2,26 @@
 
 #include "mlasi.h"
 
+size_t
+MLASCALL
+MlasFlashAttentionGetBufferSizePerThread(
+    const MlasFlashAttentionThreadedArgs* args
+)
+{
+    const size_t q_block_size = static_cast<size_t>(args->q_block_size);
+    const size_t kv_block_size = static_cast<size_t>(args->kv_block_size);
+    const size_t qk_head_size = static_cast<size_t>(args->qk_head_size);
+    const size_t v_head_size = static_cast<size_t>(args->v_head_size);
+
+    // l, m, the block of Q*K' and the unnormalized output.
+    size_t elements = q_block_size * 2 + q_block_size * kv_block_size + q_block_size * v_head_size;
+    if (args->is_fp16) {
+        // fp32 copies of the blocks of Q, K and V.
+        elements += q_block_size * qk_head_size + kv_block_size * (qk_head_size + v_head_size);
+    }
+    return elements * sizeof(float);
+}
+
 void
 MlasFlashAttentionThreaded(
     void* argptr,
@@ -20,10 +40,18 @@ MlasFlashAttentionThreaded(
     float* buffer = args->buffer;
     ptrdiff_t buffer_size_per_thread = static_cast<ptrdiff_t>(args->buffer_size_per_thread);
     ptrdiff_t thread_count = static_cast<ptrdiff_t>(args->thread_count);
-    const float* query = args->query;
-    const float* key = args->key;
-    const float* value = args->value;
-    float* output = args->output;
+    const bool is_fp16 = args->is_fp16;
+    const bool is_causal = args->is_causal;
+    ptrdiff_t local_window_size = static_cast<ptrdiff_t>(args->local_window_size);
+
+    ptrdiff_t kv_num_heads = args->kv_num_heads > 0 ? static_cast<ptrdiff_t>(args->kv_num_heads) : num_heads;
+    ptrdiff_t kv_buffer_sequence_length = args->kv_buffer_sequence_length > 0
+                                              ? static_cast<ptrdiff_t>(args->kv_buffer_sequence_length)
+                                              : kv_sequence_length;
+    ptrdiff_t q_batch_stride = args->q_batch_stride > 0
+                                   ? static_cast<ptrdiff_t>(args->q_batch_stride)
+                                   : num_heads * q_sequence_length * qk_head_size;
+    ptrdiff_t heads_per_kv_head = num_heads / kv_num_heads;
 
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
     auto&& mlas_platform = GetMlasPlatform();
@@ -55,29 +83,82 @@ MlasFlashAttentionThreaded(
         float* l = reinterpret_cast<float*>(buffer_current_thread);
         float* m = l + q_block_size;
         for (ptrdiff_t t = 0; t < q_block_size; ++t) {
+            l[t] = 0.0f;
             m[t] = std::numeric_limits<float>::lowest();
         }
         float* intermediate = m + q_block_size;
         float* temp_output = intermediate + q_block_size * kv_block_size;
+        float* q_fp32 = temp_output + q_block_size * v_head_size;
+        float* k_fp32 = q_fp32 + q_block_size * qk_head_size;
+        float* v_fp32 = k_fp32 + kv_block_size * qk_head_size;
         float negmax = 0;
 
-        for (ptrdiff_t ir = 0; ir < kv_sequence_length; ir += kv_block_size) {
+        ptrdiff_t row_size_q_valid = std::min(q_block_size, q_sequence_length - q_idx);
+        size_t row_size_q_capped = static_cast<size_t>(row_size_q_valid);
+
+        //
+        // Find the keys visible to the block of queries. With a causal mask, query row s
+        // sits at position past + s, aligning the last query with the last valid key.
+        //
+        ptrdiff_t kv_valid_length = kv_sequence_length;
+        if (args->kv_valid_lengths != nullptr) {
+            kv_valid_length = std::min(static_cast<ptrdiff_t>(args->kv_valid_lengths[batch_idx]), kv_buffer_sequence_length);
+        }
+        ptrdiff_t past_length = std::max(kv_valid_length - q_sequence_length, ptrdiff_t{0});
+        ptrdiff_t kv_begin = 0;
+        ptrdiff_t kv_end = kv_valid_length;
+        if (is_causal) {
+            kv_end = std::min(kv_valid_length, past_length + q_idx + row_size_q_valid);
+            if (local_window_size >= 0) {
+                kv_begin = std::max(past_length + q_idx - local_window_size, ptrdiff_t{0});
+            }
+        }
+
+        ptrdiff_t kv_h = batch_idx * kv_num_heads + head_idx / heads_per_kv_head;
+        ptrdiff_t q_offset = batch_idx * q_batch_stride + (head_idx * q_sequence_length + q_idx) * qk_head_size;
+        ptrdiff_t k_offset = kv_h * kv_buffer_sequence_length * qk_head_size;
+        ptrdiff_t v_offset = kv_h * kv_buffer_sequence_length * v_head_size;
+
+        const float* inputQ;
+        if (is_fp16) {
+            MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(args->query) + q_offset,
+                                         q_fp32,
+                                         row_size_q_capped * static_cast<size_t>(qk_head_size));
+            inputQ = q_fp32;
+        } else {
+            inputQ = reinterpret_cast<const float*>(args->query) + q_offset;
+        }
+
+        bool first_block = true;
+
+        for (ptrdiff_t ir = kv_begin; ir < kv_end; ir += kv_block_size) {
             /*
-                S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, head_idx, ir:ir+kv_block_size, :]).T
+                S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, kv_head_idx, ir:ir+kv_block_size, :]).T
                 old_m = m
                 m = max(m, rowmax(S))
                 diff = old_m - m
                 S = exp(S - m)
                 l = exp(diff) * l + rowsum(S)
-                O = diag(exp(diff)) * O + S * V[batch_idx, head_idx, ir:ir+kv_block_size, :]
+                O = diag(exp(diff)) * O + S * V[batch_idx, kv_head_idx, ir:ir+kv_block_size, :]
             */
-            ptrdiff_t h = batch_idx * num_heads + head_idx;
-            const float* inputQ = query + (h * q_sequence_length + q_idx) * qk_head_size;
-            const float* inputK = key + (h * kv_sequence_length + ir) * qk_head_size;
-            const float* inputV = value + (h * kv_sequence_length + ir) * v_head_size;
+            ptrdiff_t row_size_kv_valid = std::min(kv_block_size, kv_end - ir);
+            size_t row_size_kv_capped = static_cast<size_t>(row_size_kv_valid);
 
-            size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
-            size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_sequence_length - ir));
+            const float* inputK;
+            const float* inputV;
+            if (is_fp16) {
+                MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(args->key) + k_offset + ir * qk_head_size,
+                                             k_fp32,
+                                             row_size_kv_capped * static_cast<size_t>(qk_head_size));
+                MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(args->value) + v_offset + ir * v_head_size,
+                                             v_fp32,
+                                             row_size_kv_capped * static_cast<size_t>(v_head_size));
+                inputK = k_fp32;
+                inputV = v_fp32;
+            } else {
+                inputK = reinterpret_cast<const float*>(args->key) + k_offset + ir * qk_head_size;
+                inputV = reinterpret_cast<const float*>(args->value) + v_offset + ir * v_head_size;
+            }
 
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
                      CBLAS_TRANSPOSE::CblasTrans,
@@ -93,13 +174,33 @@ MlasFlashAttentionThreaded(
                      intermediate,
                      row_size_kv_capped);
 
-            for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
+            for (ptrdiff_t irow = 0; irow < row_size_q_valid; ++irow) {
                 float* p = intermediate + irow * row_size_kv_capped;
 
+                // Columns [col_begin, col_end) of this block are visible to the row.
+                ptrdiff_t col_begin = 0;
+                ptrdiff_t col_end = row_size_kv_valid;
+                if (is_causal) {
+                    ptrdiff_t position = past_length + q_idx + irow;
+                    col_end = std::clamp(position + 1 - ir, ptrdiff_t{0}, row_size_kv_valid);
+                    if (local_window_size >= 0) {
+                        col_begin = std::clamp(position - local_window_size - ir, ptrdiff_t{0}, row_size_kv_valid);
+                    }
+                }
+
+                if (col_begin >= col_end) {
+                    // Nothing is visible, so the row adds nothing to the output.
+                    std::fill_n(p, row_size_kv_capped, 0.0f);
+                    continue;
+                }
+
+                float* p_visible = p + col_begin;
+                size_t visible_count = static_cast<size_t>(col_end - col_begin);
+
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p_visible, visible_count);
 #else
-                float rowmax = MlasReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = MlasReduceMaximumF32Kernel(p_visible, visible_count);
 #endif
                 float m_diff = m[irow];
                 m[irow] = std::max(m[irow], rowmax);  // new m
@@ -107,13 +208,15 @@ MlasFlashAttentionThreaded(
                 m_diff -= m[irow];  // old - new (less than 0)
 
 #if defined(MLAS_TARGET_AMD64)
-                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p_visible, p_visible, visible_count, &negmax);
 #else
-                float rowsum = MlasComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = MlasComputeSumExpF32Kernel(p_visible, p_visible, visible_count, &negmax);
 #endif
+                std::fill(p, p_visible, 0.0f);
+                std::fill(p + col_end, p + row_size_kv_valid, 0.0f);
 
-                // Note: for ir == 0, there is actually no need to calculate exp_diff
-                if (ir != 0) {
+                // Note: for the first block, there is actually no need to calculate exp_diff
+                if (!first_block) {
                     float exp_diff = std::exp(m_diff);
                     l[irow] = exp_diff * l[irow] + rowsum;
 
@@ -122,7 +225,7 @@ MlasFlashAttentionThreaded(
                     }
                 } else {
                     l[irow] = rowsum;
-                    // When ir == 0, there is no need to scale the old result because it is zero.
+                    // For the first block, there is no need to scale the old result because it is zero.
                 }
             }
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
@@ -135,19 +238,34 @@ MlasFlashAttentionThreaded(
                      row_size_kv_capped,
                      inputV,
                      static_cast<size_t>(v_head_size),
-                     ir == 0 ? 0.0f : 1.0f,
+                     first_block ? 0.0f : 1.0f,
                      temp_output,
                      static_cast<size_t>(v_head_size));
+
+            first_block = false;
         }
 
-        float* output_row = output + ((batch_idx * q_sequence_length + q_idx) * num_heads + head_idx) * v_head_size;
-        ptrdiff_t row_size_q_valid = std::min(q_block_size, q_sequence_length - q_idx);
+        ptrdiff_t output_offset = ((batch_idx * q_sequence_length + q_idx) * num_heads + head_idx) * v_head_size;
         // TODO: leverage advanced instruction sets
         for (ptrdiff_t irow = 0; irow < row_size_q_valid; ++irow) {
-            for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
-                output_row[icol] = temp_output[irow * v_head_size + icol] / l[irow];
+            // A row that sees no keys, such as padding, is written as zeros.
+            float* row = temp_output + irow * v_head_size;
+            if (first_block || l[irow] == 0.0f) {
+                std::fill_n(row, v_head_size, 0.0f);
+            } else {
+                for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
+                    row[icol] /= l[irow];
+                }
+            }
+
+            if (is_fp16) {
+                MlasConvertFloatToHalfBuffer(row,
+                                             reinterpret_cast<MLAS_FP16*>(args->output) + output_offset,
+                                             static_cast<size_t>(v_head_size));
+            } else {
+                std::copy_n(row, v_head_size, reinterpret_cast<float*>(args->output) + output_offset);
             }
-            output_row += num_heads * v_head_size;
+            output_offset += num_heads * v_head_size;
         }
     }
 }
@@ -0,0 +1,311 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    fused_eltwise.cpp
+
+Abstract:
+
+    This module implements the evaluation of a program of element-wise
+    operations, as produced by fusing chains of unary and binary operators.
+
+    The elements are processed in blocks small enough that the intermediate
+    results of all instructions stay in the L1 cache, so the inputs are read
+    and the output is written once. Binary operations are specialized on
+    whether each operand is a block of elements or a broadcast scalar.
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+//
+// Number of elements processed by each instruction at a time.
+//
+
+constexpr size_t FusedEltwiseBlockSize = 256;
+
+struct MLAS_FUSED_ELTWISE_REGISTER {
+    const float* Data;
+    bool IsScalar;
+};
+
+struct MLAS_FUSED_ELTWISE_ADD {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasAddFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return a + b; }
+};
+
+struct MLAS_FUSED_ELTWISE_SUB {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasSubtractFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return a - b; }
+};
+
+struct MLAS_FUSED_ELTWISE_MUL {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMultiplyFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return a * b; }
+};
+
+struct MLAS_FUSED_ELTWISE_DIV {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasDivideFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return a / b; }
+};
+
+struct MLAS_FUSED_ELTWISE_MAX {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMaximumFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return std::max(a, b); }
+};
+
+struct MLAS_FUSED_ELTWISE_MIN {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMinimumFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Apply(float a, float b) { return std::min(a, b); }
+};
+
+struct MLAS_FUSED_ELTWISE_RELU {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a) { return MlasMaximumFloat32x4(a, MlasZeroFloat32x4()); }
+    static MLAS_FORCEINLINE float Apply(float a) { return std::max(a, 0.0f); }
+};
+
+struct MLAS_FUSED_ELTWISE_NEG {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a) { return MlasXorFloat32x4(a, MlasBroadcastFloat32x4(-0.0f)); }
+    static MLAS_FORCEINLINE float Apply(float a) { return -a; }
+};
+
+struct MLAS_FUSED_ELTWISE_ABS {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a) { return MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), a); }
+    static MLAS_FORCEINLINE float Apply(float a) { return std::fabs(a); }
+};
+
+struct MLAS_FUSED_ELTWISE_RECIPROCAL {
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a) { return MlasDivideFloat32x4(MlasBroadcastFloat32x4(1.0f), a); }
+    static MLAS_FORCEINLINE float Apply(float a) { return 1.0f / a; }
+};
+
+template <typename Op, bool LeftIsScalar, bool RightIsScalar>
+void
+MlasFusedEltwiseBinary(
+    const float* Left,
+    const float* Right,
+    float* Output,
+    size_t N
+    )
+{
+    const MLAS_FLOAT32X4 LeftBroadcast = MlasBroadcastFloat32x4(Left);
+    const MLAS_FLOAT32X4 RightBroadcast = MlasBroadcastFloat32x4(Right);
+
+    size_t i = 0;
+
+    for (; i + 4 <= N; i += 4) {
+        MLAS_FLOAT32X4 a = LeftIsScalar ? LeftBroadcast : MlasLoadFloat32x4(Left + i);
+        MLAS_FLOAT32X4 b = RightIsScalar ? RightBroadcast : MlasLoadFloat32x4(Right + i);
+        MlasStoreFloat32x4(Output + i, Op::Apply(a, b));
+    }
+
+    for (; i < N; i++) {
+        Output[i] = Op::Apply(Left[LeftIsScalar ? 0 : i], Right[RightIsScalar ? 0 : i]);
+    }
+}
+
+template <typename Op>
+bool
+MlasFusedEltwiseBinary(
+    const MLAS_FUSED_ELTWISE_REGISTER& Left,
+    const MLAS_FUSED_ELTWISE_REGISTER& Right,
+    float* Output,
+    size_t N
+    )
+{
+    if (Left.IsScalar && Right.IsScalar) {
+        Output[0] = Op::Apply(Left.Data[0], Right.Data[0]);
+        return true;
+    }
+
+    if (Left.IsScalar) {
+        MlasFusedEltwiseBinary<Op, true, false>(Left.Data, Right.Data, Output, N);
+    } else if (Right.IsScalar) {
+        MlasFusedEltwiseBinary<Op, false, true>(Left.Data, Right.Data, Output, N);
+    } else {
+        MlasFusedEltwiseBinary<Op, false, false>(Left.Data, Right.Data, Output, N);
+    }
+
+    return false;
+}
+
+template <typename Op>
+void
+MlasFusedEltwiseUnary(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    size_t i = 0;
+
+    for (; i + 4 <= N; i += 4) {
+        MlasStoreFloat32x4(Output + i, Op::Apply(MlasLoadFloat32x4(Input + i)));
+    }
+
+    for (; i < N; i++) {
+        Output[i] = Op::Apply(Input[i]);
+    }
+}
+
+void
+MlasFusedEltwiseSquareRoot(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    for (size_t i = 0; i < N; i++) {
+        Output[i] = std::sqrt(Input[i]);
+    }
+}
+
+//
+// Executes an instruction over N elements, or over a single element if all of
+// its operands are scalars. Returns whether the result is a scalar.
+//
+
+bool
+MlasFusedEltwiseExecute(
+    const MLAS_FUSED_ELTWISE_INSTRUCTION& Instruction,
+    const MLAS_FUSED_ELTWISE_REGISTER* Registers,
+    float* Output,
+    size_t N
+    )
+{
+    const MLAS_FUSED_ELTWISE_REGISTER& Left = Registers[Instruction.Operands[0]];
+
+    switch (Instruction.Opcode) {
+        case MlasFusedEltwiseAdd:
+            return MlasFusedEltwiseBinary<MLAS_FUSED_ELTWISE_ADD>(Left, Registers[Instruction.Operands[1]], Output, N);
+        case MlasFusedEltwiseSub:
+            return MlasFusedEltwiseBinary<MLAS_FUSED_ELTWISE_SUB>(Left, Registers[Instruction.Operands[1]], Output, N);
+        case MlasFusedEltwiseMul:
+            return MlasFusedEltwiseBinary<MLAS_FUSED_ELTWISE_MUL>(Left, Registers[Instruction.Operands[1]], Output, N);
+        case MlasFusedEltwiseDiv:
+            return MlasFusedEltwiseBinary<MLAS_FUSED_ELTWISE_DIV>(Left, Registers[Instruction.Operands[1]], Output, N);
+        case MlasFusedEltwiseMax:
+            return MlasFusedEltwiseBinary<MLAS_FUSED_ELTWISE_MAX>(Left, Registers[Instruction.Operands[1]], Output, N);
+        case MlasFusedEltwiseMin:
+            return MlasFusedEltwiseBinary<MLAS_FUSED_ELTWISE_MIN>(Left, Registers[Instruction.Operands[1]], Output, N);
+        default:
+            break;
+    }
+
+    const size_t Count = Left.IsScalar ? 1 : N;
+
+    switch (Instruction.Opcode) {
+        case MlasFusedEltwiseRelu:
+            MlasFusedEltwiseUnary<MLAS_FUSED_ELTWISE_RELU>(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseNeg:
+            MlasFusedEltwiseUnary<MLAS_FUSED_ELTWISE_NEG>(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseAbs:
+            MlasFusedEltwiseUnary<MLAS_FUSED_ELTWISE_ABS>(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseSqrt:
+            MlasFusedEltwiseSquareRoot(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseReciprocal:
+            MlasFusedEltwiseUnary<MLAS_FUSED_ELTWISE_RECIPROCAL>(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseLogistic:
+            MlasComputeLogistic(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseTanh:
+            MlasComputeTanh<float>(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseExp:
+            MlasComputeExp<float>(Left.Data, Output, Count);
+            break;
+        case MlasFusedEltwiseErf:
+            MlasComputeErf(Left.Data, Output, Count);
+            break;
+        default:
+            MLAS_THROW_EX(std::runtime_error, "Unsupported fused element-wise opcode.");
+    }
+
+    return Left.IsScalar;
+}
+
+}  // namespace
+
+void
+MLASCALL
+MlasComputeFusedEltwise(
+    const MLAS_FUSED_ELTWISE_INSTRUCTION* Program,
+    size_t InstructionCount,
+    const float* const* Inputs,
+    const bool* InputIsScalar,
+    size_t InputCount,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine evaluates a program of element-wise operations.
+
+Arguments:
+
+    Program - Supplies the instructions of the program.
+
+    InstructionCount - Supplies the number of instructions.
+
+    Inputs - Supplies the inputs of the program.
+
+    InputIsScalar - Supplies, for each input, whether it is a single element
+        broadcast to all N elements.
+
+    InputCount - Supplies the number of inputs.
+
+    Output - Supplies the output of N elements.
+
+    N - Supplies the number of elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Scratch[MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS][FusedEltwiseBlockSize], 64);
+    MLAS_FUSED_ELTWISE_REGISTER Registers[MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS + MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS];
+
+    for (size_t b = 0; b < N; b += FusedEltwiseBlockSize) {
+        const size_t n = std::min(FusedEltwiseBlockSize, N - b);
+
+        for (size_t i = 0; i < InputCount; i++) {
+            Registers[i].Data = InputIsScalar[i] ? Inputs[i] : Inputs[i] + b;
+            Registers[i].IsScalar = InputIsScalar[i];
+        }
+
+        //
+        // The last instruction writes the output directly.
+        //
+
+        bool IsScalar = false;
+
+        for (size_t k = 0; k < InstructionCount; k++) {
+            float* Result = (k + 1 == InstructionCount) ? Output + b : Scratch[k];
+            IsScalar = MlasFusedEltwiseExecute(Program[k], Registers, Result, n);
+            Registers[InputCount + k].Data = Result;
+            Registers[InputCount + k].IsScalar = IsScalar;
+        }
+
+        if (IsScalar) {
+            std::fill_n(Output + b + 1, n - 1, Output[b]);
+        }
+    }
+}
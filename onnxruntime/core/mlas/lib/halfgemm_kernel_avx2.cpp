@@ -0,0 +1,318 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for AVX2.
+
+    Matrices A, B and C stay in fp16. The elements are converted with F16C
+    and multiplied and accumulated in fp32 with FMA3.
+
+--*/
+
+#include <cstring>
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{32, 128, 512};
+};
+
+/**
+ * @brief Convert Count fp32 values to fp16.
+ */
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertFloatToHalfAvx2(
+    _mlas_fp16_* D,
+    const float* S,
+    size_t Count
+)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= Count; i += 8) {
+        const __m128i Half = _mm256_cvtps_ph(_mm256_loadu_ps(S + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(D + i), Half);
+    }
+
+    for (; i < Count; i++) {
+        D[i] = _cvtss_sh(S[i], _MM_FROUND_TO_NEAREST_INT);
+    }
+}
+
+template <>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    for (size_t m = 0; m < CountM; m++) {
+        MlasHalfGemmConvertFloatToHalfAvx2(D, A, CountK);
+        A += lda;
+        D += CountK;
+    }
+}
+
+template <>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    for (size_t k = 0; k < CountK; k++) {
+        MlasHalfGemmConvertFloatToHalfAvx2(D, B, CountN);
+        B += ldb;
+        D += CountN;
+    }
+}
+
+/**
+ * @brief Load up to 8 fp16 values as fp32, the rest of the vector is zero.
+ */
+MLAS_FORCEINLINE
+__m256
+MlasHalfGemmLoadPartialAvx2(
+    const _mlas_fp16_* S,
+    size_t Count
+)
+{
+    _mlas_fp16_ Buffer[8] = {};
+    std::memcpy(Buffer, S, Count * sizeof(_mlas_fp16_));
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer)));
+}
+
+/**
+ * @brief Store up to 8 fp32 values as fp16.
+ */
+MLAS_FORCEINLINE
+void
+MlasHalfGemmStorePartialAvx2(
+    _mlas_fp16_* D,
+    __m256 Vector,
+    size_t Count
+)
+{
+    _mlas_fp16_ Buffer[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(Buffer), _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT));
+    std::memcpy(D, Buffer, Count * sizeof(_mlas_fp16_));
+}
+
+/**
+ * @brief Load a row of a 16 column panel as two vectors of fp32.
+ */
+template <bool IsPartial>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmLoadPanelRowAvx2(
+    const _mlas_fp16_* S,
+    size_t CountN,
+    __m256& Vector0,
+    __m256& Vector1
+)
+{
+    if (IsPartial) {
+        Vector0 = MlasHalfGemmLoadPartialAvx2(S, std::min(CountN, size_t(8)));
+        Vector1 = CountN > 8 ? MlasHalfGemmLoadPartialAvx2(S + 8, CountN - 8) : _mm256_setzero_ps();
+    } else {
+        Vector0 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S)));
+        Vector1 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + 8)));
+    }
+}
+
+/**
+ * @brief Compute RowCount rows of a 16 column panel of matrix C.
+ *
+ * @tparam RowCount   # of rows to process, 1 to 4
+ * @tparam IsPartial  Whether the panel has less than 16 columns
+ * @param A           Address of matrix A
+ * @param lda         Leading dimension of A
+ * @param B           Address of the panel of matrix B, row major
+ * @param ldb         Leading dimension of B
+ * @param C           Address of matrix C
+ * @param ldc         Leading dimension of C
+ * @param CountK      # of columns of A and rows of B
+ * @param CountN      # of columns of the panel
+ * @param Bias        Address of the bias of the panel, or nullptr
+ * @param ZeroMode    Whether to overwrite C instead of accumulating onto it
+ */
+template <size_t RowCount, bool IsPartial>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx2Panel(
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    _mlas_fp16_* C,
+    size_t ldc,
+    size_t CountK,
+    size_t CountN,
+    const _mlas_fp16_* Bias,
+    bool ZeroMode
+)
+{
+    __m256 Accumulators[RowCount][2];
+
+    MlasUnrolledLoop<RowCount>([&](size_t r) {
+        Accumulators[r][0] = _mm256_setzero_ps();
+        Accumulators[r][1] = _mm256_setzero_ps();
+    });
+
+    size_t k = 0;
+
+    for (; k + 8 <= CountK; k += 8) {
+        //
+        // Convert 8 elements of each row of A, then broadcast them from memory.
+        //
+        MLAS_DECLSPEC_ALIGN(float ABlock[RowCount][8], 32);
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            const __m128i AHalf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(A + r * lda + k));
+            _mm256_store_ps(ABlock[r], _mm256_cvtph_ps(AHalf));
+        });
+
+        MlasUnrolledLoop<8>([&](size_t kk) {
+            __m256 B0, B1;
+            MlasHalfGemmLoadPanelRowAvx2<IsPartial>(B + (k + kk) * ldb, CountN, B0, B1);
+
+            MlasUnrolledLoop<RowCount>([&](size_t r) {
+                const __m256 AElement = _mm256_broadcast_ss(&ABlock[r][kk]);
+                Accumulators[r][0] = _mm256_fmadd_ps(AElement, B0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(AElement, B1, Accumulators[r][1]);
+            });
+        });
+    }
+
+    for (; k < CountK; k++) {
+        __m256 B0, B1;
+        MlasHalfGemmLoadPanelRowAvx2<IsPartial>(B + k * ldb, CountN, B0, B1);
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            const __m256 AElement = _mm256_set1_ps(_cvtsh_ss(A[r * lda + k]));
+            Accumulators[r][0] = _mm256_fmadd_ps(AElement, B0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(AElement, B1, Accumulators[r][1]);
+        });
+    }
+
+    __m256 Bias0 = _mm256_setzero_ps();
+    __m256 Bias1 = _mm256_setzero_ps();
+    if (ZeroMode && Bias != nullptr) {
+        MlasHalfGemmLoadPanelRowAvx2<IsPartial>(Bias, CountN, Bias0, Bias1);
+    }
+
+    MlasUnrolledLoop<RowCount>([&](size_t r) {
+        _mlas_fp16_* c = C + r * ldc;
+
+        __m256 C0 = Bias0;
+        __m256 C1 = Bias1;
+        if (!ZeroMode) {
+            MlasHalfGemmLoadPanelRowAvx2<IsPartial>(c, CountN, C0, C1);
+        }
+
+        C0 = _mm256_add_ps(Accumulators[r][0], C0);
+        C1 = _mm256_add_ps(Accumulators[r][1], C1);
+
+        if (IsPartial) {
+            MlasHalfGemmStorePartialAvx2(c, C0, std::min(CountN, size_t(8)));
+            if (CountN > 8) {
+                MlasHalfGemmStorePartialAvx2(c + 8, C1, CountN - 8);
+            }
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c), _mm256_cvtps_ph(C0, _MM_FROUND_TO_NEAREST_INT));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c + 8), _mm256_cvtps_ph(C1, _MM_FROUND_TO_NEAREST_INT));
+        }
+    });
+}
+
+template <size_t RowCount>
+void
+MlasHalfGemmKernelAvx2Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+)
+{
+    size_t n = 0;
+
+    for (; n + 16 <= CountN; n += 16) {
+        MlasHalfGemmKernelAvx2Panel<RowCount, false>(
+            A, lda, B + n, ldb, C + n, ldc, CountK, 16, Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+    }
+
+    if (n < CountN) {
+        MlasHalfGemmKernelAvx2Panel<RowCount, true>(
+            A, lda, B + n, ldb, C + n, ldc, CountK, CountN - n, Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+    }
+}
+
+template <>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode
+)
+{
+    //
+    // The driver advances by the number of rows processed, up to KernelMaxM.
+    //
+    if (CountM >= 4) {
+        MlasHalfGemmKernelAvx2Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountM == 3) {
+        MlasHalfGemmKernelAvx2Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountM == 2) {
+        MlasHalfGemmKernelAvx2Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else {
+        MlasHalfGemmKernelAvx2Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
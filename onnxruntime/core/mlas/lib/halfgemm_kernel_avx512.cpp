@@ -0,0 +1,278 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for AVX512 core
+    (AVX512F/AVX512BW/AVX512DQ/AVX512VL).
+
+    Matrices A, B and C stay in fp16. The elements are converted to fp32 by
+    vcvtph2ps, and multiplied and accumulated in fp32. Partial panels use
+    masked loads and stores.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{32, 128, 512};
+};
+
+/**
+ * @brief Mask of the first Count lanes of a 16 lane vector, Count may exceed 16.
+ */
+MLAS_FORCEINLINE
+__mmask16
+MlasHalfGemmTailMaskAvx512(size_t Count)
+{
+    return __mmask16(Count >= 16 ? 0xFFFF : (1u << Count) - 1);
+}
+
+/**
+ * @brief Convert Count fp32 values to fp16.
+ */
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertFloatToHalfAvx512(
+    _mlas_fp16_* D,
+    const float* S,
+    size_t Count
+)
+{
+    for (size_t i = 0; i < Count; i += 16) {
+        const __mmask16 Mask = MlasHalfGemmTailMaskAvx512(Count - i);
+        const __m256i Half = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, S + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_mask_storeu_epi16(D + i, Mask, Half);
+    }
+}
+
+template <>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    for (size_t m = 0; m < CountM; m++) {
+        MlasHalfGemmConvertFloatToHalfAvx512(D, A, CountK);
+        A += lda;
+        D += CountK;
+    }
+}
+
+template <>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    for (size_t k = 0; k < CountK; k++) {
+        MlasHalfGemmConvertFloatToHalfAvx512(D, B, CountN);
+        B += ldb;
+        D += CountN;
+    }
+}
+
+/**
+ * @brief Load the elements of S selected by Mask as fp32, the others are zero.
+ */
+MLAS_FORCEINLINE
+__m512
+MlasHalfGemmLoadAvx512(const _mlas_fp16_* S, __mmask16 Mask)
+{
+    return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(Mask, S));
+}
+
+/**
+ * @brief Compute RowCount rows of VectorCount 16 column vectors of matrix C.
+ *
+ * @tparam RowCount     # of rows to process, 1 to 4
+ * @tparam VectorCount  # of 16 column vectors to process
+ * @param A             Address of matrix A
+ * @param lda           Leading dimension of A
+ * @param B             Address of the panel of matrix B, row major
+ * @param ldb           Leading dimension of B
+ * @param C             Address of matrix C
+ * @param ldc           Leading dimension of C
+ * @param CountK        # of columns of A and rows of B
+ * @param CountN        # of columns to process, up to 16 * VectorCount
+ * @param Bias          Address of the bias of the panel, or nullptr
+ * @param ZeroMode      Whether to overwrite C instead of accumulating onto it
+ */
+template <size_t RowCount, size_t VectorCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512Panel(
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    _mlas_fp16_* C,
+    size_t ldc,
+    size_t CountK,
+    size_t CountN,
+    const _mlas_fp16_* Bias,
+    bool ZeroMode
+)
+{
+    __m512 Accumulators[RowCount][VectorCount];
+    __mmask16 Masks[VectorCount];
+
+    MlasUnrolledLoop<VectorCount>([&](size_t v) {
+        Masks[v] = MlasHalfGemmTailMaskAvx512(CountN > v * 16 ? CountN - v * 16 : 0);
+    });
+
+    MlasUnrolledLoop<RowCount>([&](size_t r) {
+        MlasUnrolledLoop<VectorCount>([&](size_t v) {
+            Accumulators[r][v] = _mm512_setzero_ps();
+        });
+    });
+
+    for (size_t k = 0; k < CountK; k += 16) {
+        //
+        // Convert up to 16 elements of each row of A, then broadcast them
+        // from memory.
+        //
+        const size_t CountBlockK = std::min(CountK - k, size_t(16));
+        const __mmask16 MaskK = MlasHalfGemmTailMaskAvx512(CountBlockK);
+        MLAS_DECLSPEC_ALIGN(float ABlock[RowCount][16], 64);
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            _mm512_store_ps(ABlock[r], MlasHalfGemmLoadAvx512(A + r * lda + k, MaskK));
+        });
+
+        auto ComputeRow = [&](size_t kk) {
+            const _mlas_fp16_* b = B + (k + kk) * ldb;
+            __m512 BRow[VectorCount];
+
+            MlasUnrolledLoop<VectorCount>([&](size_t v) {
+                BRow[v] = MlasHalfGemmLoadAvx512(b + v * 16, Masks[v]);
+            });
+
+            MlasUnrolledLoop<RowCount>([&](size_t r) {
+                const __m512 AElement = _mm512_set1_ps(ABlock[r][kk]);
+                MlasUnrolledLoop<VectorCount>([&](size_t v) {
+                    Accumulators[r][v] = _mm512_fmadd_ps(AElement, BRow[v], Accumulators[r][v]);
+                });
+            });
+        };
+
+        if (CountBlockK == 16) {
+            MlasUnrolledLoop<16>(ComputeRow);
+        } else {
+            for (size_t kk = 0; kk < CountBlockK; kk++) {
+                ComputeRow(kk);
+            }
+        }
+    }
+
+    MlasUnrolledLoop<VectorCount>([&](size_t v) {
+        __m512 BiasVector = _mm512_setzero_ps();
+        if (ZeroMode && Bias != nullptr) {
+            BiasVector = MlasHalfGemmLoadAvx512(Bias + v * 16, Masks[v]);
+        }
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            _mlas_fp16_* c = C + r * ldc + v * 16;
+            __m512 Result = Accumulators[r][v];
+            if (ZeroMode) {
+                Result = _mm512_add_ps(Result, BiasVector);
+            } else {
+                Result = _mm512_add_ps(Result, MlasHalfGemmLoadAvx512(c, Masks[v]));
+            }
+            _mm256_mask_storeu_epi16(c, Masks[v], _mm512_cvtps_ph(Result, _MM_FROUND_TO_NEAREST_INT));
+        });
+    });
+}
+
+template <size_t RowCount>
+void
+MlasHalfGemmKernelAvx512Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+)
+{
+    size_t n = 0;
+
+    for (; n + 64 <= CountN; n += 64) {
+        MlasHalfGemmKernelAvx512Panel<RowCount, 4>(
+            A, lda, B + n, ldb, C + n, ldc, CountK, 64, Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+    }
+
+    for (; n < CountN; n += 16) {
+        MlasHalfGemmKernelAvx512Panel<RowCount, 1>(
+            A, lda, B + n, ldb, C + n, ldc, CountK, std::min(CountN - n, size_t(16)),
+            Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+    }
+}
+
+template <>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode
+)
+{
+    //
+    // The driver advances by the number of rows processed, up to KernelMaxM.
+    //
+    if (CountM >= 4) {
+        MlasHalfGemmKernelAvx512Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountM == 3) {
+        MlasHalfGemmKernelAvx512Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountM == 2) {
+        MlasHalfGemmKernelAvx512Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else {
+        MlasHalfGemmKernelAvx512Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512>,
+    MLAS_HALF_GEMM_KERNEL_AVX512::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512::KernelMaxM,
+    0
+};
@@ -0,0 +1,379 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements layer normalization and RMS normalization with an
+    optional fused residual add, for fp32 and fp16 rows.
+
+    The portable row kernels use the MLAS_FLOAT32X4 intrinsics, which map to
+    NEON on ARM64 and to SSE2 on x86. Platforms may supply faster row kernels
+    through MLAS_LAYER_NORM_DISPATCH.
+
+--*/
+
+#include "layernorm.h"
+
+namespace {
+
+//
+// Number of fp16 elements converted to fp32 at a time by the portable fp16
+// kernel.
+//
+
+constexpr size_t LayerNormChunkSize = 256;
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasLayerNormLoadSum(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    size_t n
+)
+{
+    MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+    if (Skip != nullptr) {
+        Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip + n));
+    }
+    if (SkipBias != nullptr) {
+        Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(SkipBias + n));
+    }
+    return Vector;
+}
+
+MLAS_FORCEINLINE
+float
+MlasLayerNormLoadSumScalar(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    size_t n
+)
+{
+    float Value = Input[n];
+    if (Skip != nullptr) {
+        Value += Skip[n];
+    }
+    if (SkipBias != nullptr) {
+        Value += SkipBias[n];
+    }
+    return Value;
+}
+
+//
+// Accumulates the sum and the sum of squares of x = Input + Skip + SkipBias,
+// and writes x to SkipSumOutput when it is not null.
+//
+
+void
+MlasLayerNormAccumulate(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* SkipSumOutput,
+    size_t N,
+    float& Sum,
+    float& SumSquare
+)
+{
+    MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector = MlasZeroFloat32x4();
+
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        MLAS_FLOAT32X4 Vector = MlasLayerNormLoadSum(Input, Skip, SkipBias, n);
+        if (SkipSumOutput != nullptr) {
+            MlasStoreFloat32x4(SkipSumOutput + n, Vector);
+        }
+        SumVector = MlasAddFloat32x4(SumVector, Vector);
+        SumSquareVector = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquareVector);
+    }
+
+    float SumValue = MlasReduceAddFloat32x4(SumVector);
+    float SumSquareValue = MlasReduceAddFloat32x4(SumSquareVector);
+
+    for (; n < N; n++) {
+        const float Value = MlasLayerNormLoadSumScalar(Input, Skip, SkipBias, n);
+        if (SkipSumOutput != nullptr) {
+            SkipSumOutput[n] = Value;
+        }
+        SumValue += Value;
+        SumSquareValue += Value * Value;
+    }
+
+    Sum += SumValue;
+    SumSquare += SumSquareValue;
+}
+
+//
+// Writes (x - Mean) * InvStdDev * Scale + Bias for x = Input + Skip + SkipBias.
+// Output may alias Input.
+//
+
+void
+MlasLayerNormNormalize(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+)
+{
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    const MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        MLAS_FLOAT32X4 Vector = MlasLayerNormLoadSum(Input, Skip, SkipBias, n);
+        Vector = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector, MeanVector), InvStdDevVector);
+        if (Bias != nullptr) {
+            Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Scale + n), MlasLoadFloat32x4(Bias + n));
+        } else {
+            Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Scale + n));
+        }
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    for (; n < N; n++) {
+        float Value = MlasLayerNormLoadSumScalar(Input, Skip, SkipBias, n);
+        Value = (Value - Mean) * InvStdDev * Scale[n];
+        if (Bias != nullptr) {
+            Value += Bias[n];
+        }
+        Output[n] = Value;
+    }
+}
+
+void
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    float* SkipSumOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& Mean,
+    float& InvStdDev
+)
+{
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+    MlasLayerNormAccumulate(Input, Skip, SkipBias, SkipSumOutput, N, Sum, SumSquare);
+    MlasLayerNormStatistics(Sum, SumSquare, N, Epsilon, Simplified, Mean, InvStdDev);
+
+    //
+    // Read x back from SkipSumOutput instead of adding the inputs again.
+    //
+
+    if (SkipSumOutput != nullptr) {
+        Input = SkipSumOutput;
+        Skip = nullptr;
+        SkipBias = nullptr;
+    }
+
+    MlasLayerNormNormalize(Input, Skip, SkipBias, Scale, Bias, Output, N,
+                           Simplified ? 0.0f : Mean, InvStdDev);
+}
+
+void
+MlasLayerNormF16Kernel(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Skip,
+    const float* SkipBias,
+    const float* Scale,
+    const float* Bias,
+    MLAS_FP16* Output,
+    MLAS_FP16* SkipSumOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& Mean,
+    float& InvStdDev
+)
+{
+    float InputBuffer[LayerNormChunkSize];
+    float SkipBuffer[LayerNormChunkSize];
+
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+
+    for (size_t n = 0; n < N; n += LayerNormChunkSize) {
+        const size_t Count = std::min(N - n, LayerNormChunkSize);
+        MlasConvertHalfToFloatBuffer(Input + n, InputBuffer, Count);
+        if (Skip != nullptr) {
+            MlasConvertHalfToFloatBuffer(Skip + n, SkipBuffer, Count);
+        }
+        MlasLayerNormAccumulate(InputBuffer, Skip != nullptr ? SkipBuffer : nullptr,
+                                SkipBias != nullptr ? SkipBias + n : nullptr,
+                                SkipSumOutput != nullptr ? InputBuffer : nullptr, Count, Sum, SumSquare);
+        if (SkipSumOutput != nullptr) {
+            MlasConvertFloatToHalfBuffer(InputBuffer, SkipSumOutput + n, Count);
+        }
+    }
+
+    MlasLayerNormStatistics(Sum, SumSquare, N, Epsilon, Simplified, Mean, InvStdDev);
+
+    //
+    // Recompute x from the inputs, SkipSumOutput is rounded to fp16.
+    //
+
+    for (size_t n = 0; n < N; n += LayerNormChunkSize) {
+        const size_t Count = std::min(N - n, LayerNormChunkSize);
+        MlasConvertHalfToFloatBuffer(Input + n, InputBuffer, Count);
+        if (Skip != nullptr) {
+            MlasConvertHalfToFloatBuffer(Skip + n, SkipBuffer, Count);
+        }
+        MlasLayerNormNormalize(InputBuffer, Skip != nullptr ? SkipBuffer : nullptr,
+                               SkipBias != nullptr ? SkipBias + n : nullptr, Scale + n,
+                               Bias != nullptr ? Bias + n : nullptr, InputBuffer, Count,
+                               Simplified ? 0.0f : Mean, InvStdDev);
+        MlasConvertFloatToHalfBuffer(InputBuffer, Output + n, Count);
+    }
+}
+
+template <typename T>
+struct MLAS_LAYER_NORM_KERNEL;
+
+template <>
+struct MLAS_LAYER_NORM_KERNEL<float> {
+    static MLAS_LAYER_NORM_DISPATCH::SLayerNorm_Fn* Get()
+    {
+        const auto* Dispatch = GetMlasPlatform().LayerNormDispatch;
+        if (Dispatch == nullptr || Dispatch->SLayerNorm == nullptr) {
+            return MlasLayerNormF32Kernel;
+        }
+        return Dispatch->SLayerNorm;
+    }
+};
+
+template <>
+struct MLAS_LAYER_NORM_KERNEL<MLAS_FP16> {
+    static MLAS_LAYER_NORM_DISPATCH::HLayerNorm_Fn* Get()
+    {
+        const auto* Dispatch = GetMlasPlatform().LayerNormDispatch;
+        if (Dispatch == nullptr || Dispatch->HLayerNorm == nullptr) {
+            return MlasLayerNormF16Kernel;
+        }
+        return Dispatch->HLayerNorm;
+    }
+};
+
+}  // namespace
+
+template <typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    MLAS_THREADPOOL* ThreadPool
+)
+/*++
+
+Routine Description:
+
+    This routine computes layer normalization or RMS normalization of each
+    row, with an optional fused residual add.
+
+Arguments:
+
+    Params - Supplies the normalization parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Rows = Params.Rows;
+    const size_t N = Params.N;
+
+    if (Rows == 0 || N == 0) {
+        return;
+    }
+
+    const auto Kernel = MLAS_LAYER_NORM_KERNEL<T>::Get();
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > Rows) {
+        ThreadCount = ptrdiff_t(Rows);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    const size_t BlockCount = ((Rows * N) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t RowStart;
+        size_t RowCount;
+        MlasPartitionWork(tid, ThreadCount, Rows, &RowStart, &RowCount);
+
+        for (size_t r = RowStart; r < RowStart + RowCount; r++) {
+            const size_t ScaleOffset = ((r / Params.ScaleRowRepeat) % Params.ScaleRows) * N;
+            const T* Skip = Params.Skip != nullptr ? Params.Skip + (r % Params.SkipRows) * N : nullptr;
+            const float* Bias = Params.Bias != nullptr ? Params.Bias + ScaleOffset : nullptr;
+            T* SkipSumOutput = Params.SkipSumOutput != nullptr ? Params.SkipSumOutput + r * N : nullptr;
+
+            float Mean;
+            float InvStdDev;
+            Kernel(Params.Input + r * N, Skip, Params.SkipBias, Params.Scale + ScaleOffset, Bias,
+                   Params.Output + r * N, SkipSumOutput, N, Params.Epsilon, Params.Simplified,
+                   Mean, InvStdDev);
+
+            if (Params.Mean != nullptr) {
+                Params.Mean[r] = Mean;
+            }
+            if (Params.InvStdDev != nullptr) {
+                Params.InvStdDev[r] = InvStdDev;
+            }
+        }
+    });
+}
+
+template
+void
+MLASCALL
+MlasLayerNormalization<float>(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+template
+void
+MLASCALL
+MlasLayerNormalization<MLAS_FP16>(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    MLAS_THREADPOOL* ThreadPool
+);
@@ -0,0 +1,84 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module includes kernel function prototypes and helper functions for
+    implementing layer normalization with a fused residual add.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+struct MLAS_LAYER_NORM_DISPATCH {
+    //
+    // Normalizes one row. x = Input + Skip + SkipBias is written to SkipSumOutput
+    // when it is not null. Skip, SkipBias, Bias and SkipSumOutput are optional.
+    //
+
+    typedef void(SLayerNorm_Fn)(
+        const float* Input,
+        const float* Skip,
+        const float* SkipBias,
+        const float* Scale,
+        const float* Bias,
+        float* Output,
+        float* SkipSumOutput,
+        size_t N,
+        float Epsilon,
+        bool Simplified,
+        float& Mean,
+        float& InvStdDev
+    );
+
+    SLayerNorm_Fn* SLayerNorm = nullptr;
+
+    typedef void(HLayerNorm_Fn)(
+        const MLAS_FP16* Input,
+        const MLAS_FP16* Skip,
+        const float* SkipBias,
+        const float* Scale,
+        const float* Bias,
+        MLAS_FP16* Output,
+        MLAS_FP16* SkipSumOutput,
+        size_t N,
+        float Epsilon,
+        bool Simplified,
+        float& Mean,
+        float& InvStdDev
+    );
+
+    HLayerNorm_Fn* HLayerNorm = nullptr;
+};
+
+//
+// Computes the mean and the inverse standard deviation from the sum and the
+// sum of squares of a row.
+//
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormStatistics(
+    float Sum,
+    float SumSquare,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& Mean,
+    float& InvStdDev
+)
+{
+    Mean = Sum / float(N);
+    const float MeanSquare = SumSquare / float(N);
+    const float Variance = Simplified ? MeanSquare : std::max(MeanSquare - Mean * Mean, 0.0f);
+    InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+}
@@ -0,0 +1,209 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization row kernels for AVX2
+    (AVX2/FMA3/F16C).
+
+    fp16 rows are converted to fp32 by vcvtph2ps and normalized in fp32.
+
+--*/
+
+#include <cstring>
+
+#include "layernorm.h"
+
+namespace {
+
+constexpr size_t VectorLength = 8;
+
+MLAS_FORCEINLINE
+__m256
+LoadFloat8(const float* Buffer)
+{
+    return _mm256_loadu_ps(Buffer);
+}
+
+MLAS_FORCEINLINE
+__m256
+LoadFloat8(const MLAS_FP16* Buffer)
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer)));
+}
+
+MLAS_FORCEINLINE
+void
+StoreFloat8(float* Buffer, __m256 Vector)
+{
+    _mm256_storeu_ps(Buffer, Vector);
+}
+
+MLAS_FORCEINLINE
+void
+StoreFloat8(MLAS_FP16* Buffer, __m256 Vector)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(Buffer), _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT));
+}
+
+//
+// Loads Count < 8 elements, the remaining lanes are zero.
+//
+
+template <typename T>
+MLAS_FORCEINLINE
+__m256
+LoadPartialFloat8(const T* Buffer, size_t Count)
+{
+    T Values[VectorLength] = {};
+    std::memcpy(Values, Buffer, Count * sizeof(T));
+    return LoadFloat8(Values);
+}
+
+template <typename T>
+MLAS_FORCEINLINE
+void
+StorePartialFloat8(T* Buffer, __m256 Vector, size_t Count)
+{
+    T Values[VectorLength];
+    StoreFloat8(Values, Vector);
+    std::memcpy(Buffer, Values, Count * sizeof(T));
+}
+
+template <typename T, bool IsPartial>
+MLAS_FORCEINLINE
+__m256
+LoadSum(const T* Input, const T* Skip, const float* SkipBias, size_t n, size_t Count)
+{
+    if constexpr (IsPartial) {
+        __m256 Vector = LoadPartialFloat8(Input + n, Count);
+        if (Skip != nullptr) {
+            Vector = _mm256_add_ps(Vector, LoadPartialFloat8(Skip + n, Count));
+        }
+        if (SkipBias != nullptr) {
+            Vector = _mm256_add_ps(Vector, LoadPartialFloat8(SkipBias + n, Count));
+        }
+        return Vector;
+    } else {
+        MLAS_UNREFERENCED_PARAMETER(Count);
+        __m256 Vector = LoadFloat8(Input + n);
+        if (Skip != nullptr) {
+            Vector = _mm256_add_ps(Vector, LoadFloat8(Skip + n));
+        }
+        if (SkipBias != nullptr) {
+            Vector = _mm256_add_ps(Vector, LoadFloat8(SkipBias + n));
+        }
+        return Vector;
+    }
+}
+
+MLAS_FORCEINLINE
+float
+ReduceAdd(__m256 Vector)
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+template <typename T>
+void
+LayerNormKernelAvx2(
+    const T* Input,
+    const T* Skip,
+    const float* SkipBias,
+    const float* Scale,
+    const float* Bias,
+    T* Output,
+    T* SkipSumOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& Mean,
+    float& InvStdDev
+)
+{
+    __m256 SumVector = _mm256_setzero_ps();
+    __m256 SumSquareVector = _mm256_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + VectorLength <= N; n += VectorLength) {
+        const __m256 Vector = LoadSum<T, false>(Input, Skip, SkipBias, n, VectorLength);
+        if (SkipSumOutput != nullptr) {
+            StoreFloat8(SkipSumOutput + n, Vector);
+        }
+        SumVector = _mm256_add_ps(SumVector, Vector);
+        SumSquareVector = _mm256_fmadd_ps(Vector, Vector, SumSquareVector);
+    }
+
+    if (n < N) {
+        const __m256 Vector = LoadSum<T, true>(Input, Skip, SkipBias, n, N - n);
+        if (SkipSumOutput != nullptr) {
+            StorePartialFloat8(SkipSumOutput + n, Vector, N - n);
+        }
+        SumVector = _mm256_add_ps(SumVector, Vector);
+        SumSquareVector = _mm256_fmadd_ps(Vector, Vector, SumSquareVector);
+    }
+
+    MlasLayerNormStatistics(ReduceAdd(SumVector), ReduceAdd(SumSquareVector), N, Epsilon, Simplified,
+                            Mean, InvStdDev);
+
+    //
+    // For fp32 rows, read x back from SkipSumOutput instead of adding the
+    // inputs again. fp16 rows recompute x, SkipSumOutput is rounded to fp16.
+    //
+
+    if constexpr (std::is_same_v<T, float>) {
+        if (SkipSumOutput != nullptr) {
+            Input = SkipSumOutput;
+            Skip = nullptr;
+            SkipBias = nullptr;
+        }
+    }
+
+    const __m256 MeanVector = _mm256_set1_ps(Simplified ? 0.0f : Mean);
+    const __m256 InvStdDevVector = _mm256_set1_ps(InvStdDev);
+
+    for (n = 0; n + VectorLength <= N; n += VectorLength) {
+        __m256 Vector = LoadSum<T, false>(Input, Skip, SkipBias, n, VectorLength);
+        Vector = _mm256_mul_ps(_mm256_sub_ps(Vector, MeanVector), InvStdDevVector);
+        if (Bias != nullptr) {
+            Vector = _mm256_fmadd_ps(Vector, _mm256_loadu_ps(Scale + n), _mm256_loadu_ps(Bias + n));
+        } else {
+            Vector = _mm256_mul_ps(Vector, _mm256_loadu_ps(Scale + n));
+        }
+        StoreFloat8(Output + n, Vector);
+    }
+
+    if (n < N) {
+        const size_t Count = N - n;
+        __m256 Vector = LoadSum<T, true>(Input, Skip, SkipBias, n, Count);
+        Vector = _mm256_mul_ps(_mm256_sub_ps(Vector, MeanVector), InvStdDevVector);
+        Vector = _mm256_mul_ps(Vector, LoadPartialFloat8(Scale + n, Count));
+        if (Bias != nullptr) {
+            Vector = _mm256_add_ps(Vector, LoadPartialFloat8(Bias + n, Count));
+        }
+        StorePartialFloat8(Output + n, Vector, Count);
+    }
+}
+
+}  // namespace
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx2 = []() {
+    MLAS_LAYER_NORM_DISPATCH d;
+    d.SLayerNorm = LayerNormKernelAvx2<float>;
+    d.HLayerNorm = LayerNormKernelAvx2<MLAS_FP16>;
+    return d;
+}();
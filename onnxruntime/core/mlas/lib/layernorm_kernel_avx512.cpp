@@ -0,0 +1,211 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx512.cpp
+
+Abstract:
+
+    This module implements the layer normalization row kernels for AVX512F.
+
+    fp16 rows are converted to fp32 by vcvtph2ps and normalized in fp32.
+    Partial vectors of fp32 rows use masked loads and stores.
+
+--*/
+
+#include <cstring>
+
+#include "layernorm.h"
+
+namespace {
+
+constexpr size_t VectorLength = 16;
+
+MLAS_FORCEINLINE
+__m512
+LoadFloat16(const float* Buffer)
+{
+    return _mm512_loadu_ps(Buffer);
+}
+
+MLAS_FORCEINLINE
+__m512
+LoadFloat16(const MLAS_FP16* Buffer)
+{
+    return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Buffer)));
+}
+
+MLAS_FORCEINLINE
+void
+StoreFloat16(float* Buffer, __m512 Vector)
+{
+    _mm512_storeu_ps(Buffer, Vector);
+}
+
+MLAS_FORCEINLINE
+void
+StoreFloat16(MLAS_FP16* Buffer, __m512 Vector)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(Buffer), _mm512_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT));
+}
+
+//
+// Loads Count < 16 elements, the remaining lanes are zero.
+//
+
+MLAS_FORCEINLINE
+__m512
+LoadPartialFloat16(const float* Buffer, size_t Count)
+{
+    return _mm512_maskz_loadu_ps(__mmask16((1u << Count) - 1), Buffer);
+}
+
+MLAS_FORCEINLINE
+__m512
+LoadPartialFloat16(const MLAS_FP16* Buffer, size_t Count)
+{
+    MLAS_FP16 Values[VectorLength] = {};
+    std::memcpy(Values, Buffer, Count * sizeof(MLAS_FP16));
+    return LoadFloat16(Values);
+}
+
+MLAS_FORCEINLINE
+void
+StorePartialFloat16(float* Buffer, __m512 Vector, size_t Count)
+{
+    _mm512_mask_storeu_ps(Buffer, __mmask16((1u << Count) - 1), Vector);
+}
+
+MLAS_FORCEINLINE
+void
+StorePartialFloat16(MLAS_FP16* Buffer, __m512 Vector, size_t Count)
+{
+    MLAS_FP16 Values[VectorLength];
+    StoreFloat16(Values, Vector);
+    std::memcpy(Buffer, Values, Count * sizeof(MLAS_FP16));
+}
+
+template <typename T, bool IsPartial>
+MLAS_FORCEINLINE
+__m512
+LoadSum(const T* Input, const T* Skip, const float* SkipBias, size_t n, size_t Count)
+{
+    if constexpr (IsPartial) {
+        __m512 Vector = LoadPartialFloat16(Input + n, Count);
+        if (Skip != nullptr) {
+            Vector = _mm512_add_ps(Vector, LoadPartialFloat16(Skip + n, Count));
+        }
+        if (SkipBias != nullptr) {
+            Vector = _mm512_add_ps(Vector, LoadPartialFloat16(SkipBias + n, Count));
+        }
+        return Vector;
+    } else {
+        MLAS_UNREFERENCED_PARAMETER(Count);
+        __m512 Vector = LoadFloat16(Input + n);
+        if (Skip != nullptr) {
+            Vector = _mm512_add_ps(Vector, LoadFloat16(Skip + n));
+        }
+        if (SkipBias != nullptr) {
+            Vector = _mm512_add_ps(Vector, LoadFloat16(SkipBias + n));
+        }
+        return Vector;
+    }
+}
+
+template <typename T>
+void
+LayerNormKernelAvx512F(
+    const T* Input,
+    const T* Skip,
+    const float* SkipBias,
+    const float* Scale,
+    const float* Bias,
+    T* Output,
+    T* SkipSumOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& Mean,
+    float& InvStdDev
+)
+{
+    __m512 SumVector = _mm512_setzero_ps();
+    __m512 SumSquareVector = _mm512_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + VectorLength <= N; n += VectorLength) {
+        const __m512 Vector = LoadSum<T, false>(Input, Skip, SkipBias, n, VectorLength);
+        if (SkipSumOutput != nullptr) {
+            StoreFloat16(SkipSumOutput + n, Vector);
+        }
+        SumVector = _mm512_add_ps(SumVector, Vector);
+        SumSquareVector = _mm512_fmadd_ps(Vector, Vector, SumSquareVector);
+    }
+
+    if (n < N) {
+        const __m512 Vector = LoadSum<T, true>(Input, Skip, SkipBias, n, N - n);
+        if (SkipSumOutput != nullptr) {
+            StorePartialFloat16(SkipSumOutput + n, Vector, N - n);
+        }
+        SumVector = _mm512_add_ps(SumVector, Vector);
+        SumSquareVector = _mm512_fmadd_ps(Vector, Vector, SumSquareVector);
+    }
+
+    MlasLayerNormStatistics(_mm512_reduce_add_ps(SumVector), _mm512_reduce_add_ps(SumSquareVector), N, Epsilon,
+                            Simplified, Mean, InvStdDev);
+
+    //
+    // For fp32 rows, read x back from SkipSumOutput instead of adding the
+    // inputs again. fp16 rows recompute x, SkipSumOutput is rounded to fp16.
+    //
+
+    if constexpr (std::is_same_v<T, float>) {
+        if (SkipSumOutput != nullptr) {
+            Input = SkipSumOutput;
+            Skip = nullptr;
+            SkipBias = nullptr;
+        }
+    }
+
+    const __m512 MeanVector = _mm512_set1_ps(Simplified ? 0.0f : Mean);
+    const __m512 InvStdDevVector = _mm512_set1_ps(InvStdDev);
+
+    for (n = 0; n + VectorLength <= N; n += VectorLength) {
+        __m512 Vector = LoadSum<T, false>(Input, Skip, SkipBias, n, VectorLength);
+        Vector = _mm512_mul_ps(_mm512_sub_ps(Vector, MeanVector), InvStdDevVector);
+        if (Bias != nullptr) {
+            Vector = _mm512_fmadd_ps(Vector, _mm512_loadu_ps(Scale + n), _mm512_loadu_ps(Bias + n));
+        } else {
+            Vector = _mm512_mul_ps(Vector, _mm512_loadu_ps(Scale + n));
+        }
+        StoreFloat16(Output + n, Vector);
+    }
+
+    if (n < N) {
+        const size_t Count = N - n;
+        __m512 Vector = LoadSum<T, true>(Input, Skip, SkipBias, n, Count);
+        Vector = _mm512_mul_ps(_mm512_sub_ps(Vector, MeanVector), InvStdDevVector);
+        Vector = _mm512_mul_ps(Vector, LoadPartialFloat16(Scale + n, Count));
+        if (Bias != nullptr) {
+            Vector = _mm512_add_ps(Vector, LoadPartialFloat16(Bias + n, Count));
+        }
+        StorePartialFloat16(Output + n, Vector, Count);
+    }
+}
+
+}  // namespace
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx512F = []() {
+    MLAS_LAYER_NORM_DISPATCH d;
+    d.SLayerNorm = LayerNormKernelAvx512F<float>;
+    d.HLayerNorm = LayerNormKernelAvx512F<MLAS_FP16>;
+    return d;
+}();
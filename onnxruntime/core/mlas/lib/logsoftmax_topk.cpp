@@ -0,0 +1,290 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    logsoftmax_topk.cpp
+
+Abstract:
+
+    This module implements a fused log softmax and top-k selection, as used to
+    pick the next tokens of beam and greedy search from the logits of the
+    vocabulary projection.
+
+    Each row is read once in blocks small enough to stay in the L1 cache. The
+    maximum of a block updates the running maximum and the running sum of
+    exponentials, and blocks whose maximum cannot enter the current top-k are
+    skipped without being scanned.
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+
+//
+// Number of elements of a row processed at a time.
+//
+
+constexpr size_t LogSoftmaxTopKBlockSize = 1024;
+
+//
+// Minimum number of elements of a row processed by a thread before the row is
+// split across threads.
+//
+
+constexpr size_t LogSoftmaxTopKMinimumElementsPerThread = 16384;
+
+struct MLAS_TOPK_ENTRY {
+    float Value;
+    int32_t Index;
+};
+
+//
+// Returns true if entry a ranks before entry b: a larger value, or the same
+// value at a lower index.
+//
+
+MLAS_FORCEINLINE
+bool
+MlasTopKRanksBefore(
+    const MLAS_TOPK_ENTRY& a,
+    const MLAS_TOPK_ENTRY& b
+)
+{
+    return a.Value > b.Value || (a.Value == b.Value && a.Index < b.Index);
+}
+
+//
+// State of a segment of a row: the running maximum, the sum of exponentials
+// relative to the running maximum, and the best entries, kept as a heap whose
+// front is the lowest ranked entry.
+//
+
+struct MLAS_LOG_SOFTMAX_TOPK_SEGMENT {
+    float Maximum;
+    float SumExp;
+    size_t Count;
+};
+
+void
+MlasLogSoftmaxTopKSegment(
+    const float* Input,
+    size_t Begin,
+    size_t End,
+    size_t K,
+    bool ComputeSumExp,
+    MLAS_LOG_SOFTMAX_TOPK_SEGMENT& Segment,
+    MLAS_TOPK_ENTRY* Entries
+)
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+    float SumExp = 0.0f;
+    size_t Count = 0;
+
+    for (size_t b = Begin; b < End; b += LogSoftmaxTopKBlockSize) {
+        const size_t n = std::min(LogSoftmaxTopKBlockSize, End - b);
+        const float* Block = Input + b;
+
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+        const float BlockMaximum = GetMlasPlatform().ReduceMaximumF32Kernel(Block, n);
+#else
+        const float BlockMaximum = MlasReduceMaximumF32Kernel(Block, n);
+#endif
+
+        if (ComputeSumExp) {
+            if (BlockMaximum > Maximum) {
+                SumExp *= std::exp(Maximum - BlockMaximum);
+                Maximum = BlockMaximum;
+            }
+            const float NegativeMaximum = -Maximum;
+#if defined(MLAS_TARGET_AMD64)
+            SumExp += GetMlasPlatform().ComputeSumExpF32Kernel(Block, nullptr, n, &NegativeMaximum);
+#else
+            SumExp += MlasComputeSumExpF32Kernel(Block, nullptr, n, &NegativeMaximum);
+#endif
+        }
+
+        //
+        // Indices only increase within the segment, so an element enters a
+        // full heap only if its value is strictly larger than the front.
+        //
+
+        if (Count == K && !(BlockMaximum > Entries[0].Value)) {
+            continue;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            const float Value = Block[i];
+            if (Count < K) {
+                Entries[Count++] = {Value, static_cast<int32_t>(b + i)};
+                std::push_heap(Entries, Entries + Count, MlasTopKRanksBefore);
+            } else if (Value > Entries[0].Value) {
+                std::pop_heap(Entries, Entries + K, MlasTopKRanksBefore);
+                Entries[K - 1] = {Value, static_cast<int32_t>(b + i)};
+                std::push_heap(Entries, Entries + K, MlasTopKRanksBefore);
+            }
+        }
+    }
+
+    Segment.Maximum = Maximum;
+    Segment.SumExp = SumExp;
+    Segment.Count = Count;
+}
+
+//
+// Writes the results of a row from its sorted best entries.
+//
+
+void
+MlasLogSoftmaxTopKOutput(
+    const MLAS_LOG_SOFTMAX_TOPK_PARAMS& Params,
+    size_t Row,
+    float Maximum,
+    float SumExp,
+    const MLAS_TOPK_ENTRY* Entries
+)
+{
+    const size_t K = Params.K;
+    const float LogSum = std::log(SumExp);
+    const float Addend = Params.Addends != nullptr ? Params.Addends[Row] : 0.0f;
+
+    for (size_t k = 0; k < K; k++) {
+        Params.Indices[Row * K + k] = Entries[k].Index;
+        if (Params.Values != nullptr) {
+            Params.Values[Row * K + k] = Params.Scale * ((Entries[k].Value - Maximum) - LogSum) + Addend;
+        }
+    }
+
+    if (Params.LogSumExp != nullptr) {
+        Params.LogSumExp[Row] = Maximum + LogSum;
+    }
+}
+
+}  // namespace
+
+void
+MLASCALL
+MlasLogSoftmaxTopK(
+    const MLAS_LOG_SOFTMAX_TOPK_PARAMS& Params,
+    MLAS_THREADPOOL* ThreadPool
+)
+/*++
+
+Routine Description:
+
+    This routine computes the log softmax of each row and selects its K
+    largest entries in a single pass over the row.
+
+Arguments:
+
+    Params - Supplies the log softmax and top-k parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Rows = Params.Rows;
+    const size_t N = Params.N;
+    const size_t K = Params.K;
+
+    if (Rows == 0 || K == 0) {
+        return;
+    }
+
+    const bool ComputeSumExp = Params.Values != nullptr || Params.LogSumExp != nullptr;
+
+    //
+    // Split the rows into segments when there are fewer rows than threads, as
+    // is typical of the last step of generation. Each segment must hold at
+    // least K entries so that the best K of a row are among the best K of its
+    // segments.
+    //
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    size_t SegmentsPerRow = 1;
+    if (size_t(ThreadCount) > Rows) {
+        const size_t MinimumSegmentLength = std::max(K, LogSoftmaxTopKMinimumElementsPerThread);
+        SegmentsPerRow = std::max<size_t>(1, std::min((size_t(ThreadCount) + Rows - 1) / Rows, N / MinimumSegmentLength));
+    }
+
+    const size_t WorkCount = Rows * SegmentsPerRow;
+    const size_t BlockCount = ((Rows * N) / LogSoftmaxTopKMinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > WorkCount) {
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    std::vector<MLAS_LOG_SOFTMAX_TOPK_SEGMENT> Segments(SegmentsPerRow > 1 ? WorkCount : 0);
+    std::vector<MLAS_TOPK_ENTRY> Entries(K * (SegmentsPerRow > 1 ? WorkCount : size_t(ThreadCount)));
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkStart;
+        size_t WorkItems;
+        MlasPartitionWork(tid, ThreadCount, WorkCount, &WorkStart, &WorkItems);
+
+        for (size_t w = WorkStart; w < WorkStart + WorkItems; w++) {
+            const size_t Row = w / SegmentsPerRow;
+            const size_t s = w % SegmentsPerRow;
+            const float* Input = Params.Input + Row * N;
+
+            if (SegmentsPerRow == 1) {
+                MLAS_LOG_SOFTMAX_TOPK_SEGMENT Segment;
+                MLAS_TOPK_ENTRY* RowEntries = Entries.data() + tid * K;
+                MlasLogSoftmaxTopKSegment(Input, 0, N, K, ComputeSumExp, Segment, RowEntries);
+                std::sort_heap(RowEntries, RowEntries + Segment.Count, MlasTopKRanksBefore);
+                MlasLogSoftmaxTopKOutput(Params, Row, Segment.Maximum, Segment.SumExp, RowEntries);
+            } else {
+                size_t Begin;
+                size_t Length;
+                MlasPartitionWork(ptrdiff_t(s), ptrdiff_t(SegmentsPerRow), N, &Begin, &Length);
+                MlasLogSoftmaxTopKSegment(Input, Begin, Begin + Length, K, ComputeSumExp, Segments[w],
+                                          Entries.data() + w * K);
+            }
+        }
+    });
+
+    if (SegmentsPerRow == 1) {
+        return;
+    }
+
+    //
+    // Merge the segments of each row.
+    //
+
+    for (size_t Row = 0; Row < Rows; Row++) {
+        const MLAS_LOG_SOFTMAX_TOPK_SEGMENT* RowSegments = Segments.data() + Row * SegmentsPerRow;
+        MLAS_TOPK_ENTRY* RowEntries = Entries.data() + Row * SegmentsPerRow * K;
+
+        float Maximum = std::numeric_limits<float>::lowest();
+        for (size_t s = 0; s < SegmentsPerRow; s++) {
+            Maximum = std::max(Maximum, RowSegments[s].Maximum);
+        }
+
+        float SumExp = 0.0f;
+        if (ComputeSumExp) {
+            for (size_t s = 0; s < SegmentsPerRow; s++) {
+                SumExp += RowSegments[s].SumExp * std::exp(RowSegments[s].Maximum - Maximum);
+            }
+        }
+
+        std::partial_sort(RowEntries, RowEntries + K, RowEntries + SegmentsPerRow * K, MlasTopKRanksBefore);
+        MlasLogSoftmaxTopKOutput(Params, Row, Maximum, SumExp, RowEntries);
+    }
+}
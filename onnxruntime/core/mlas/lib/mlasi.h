@@ -26,6 +26,7 @@ Abstract:
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 #ifdef MLAS_NO_EXCEPTION
 #if defined(__ANDROID__)
@@ -966,7 +967,7 @@ extern "C" {
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 #define MLAS_HGEMM_THREAD_COMPLEXITY                65536
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
 #define MLAS_SBGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
 #endif
 
@@ -988,7 +989,9 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning = nullptr
     );
 
 //
@@ -1091,6 +1094,20 @@ extern const MLAS_ROPE_DISPATCH MlasRopeDispatchAvx2;
 struct MLAS_HGEMM_DISPATCH;
 extern const MLAS_HGEMM_DISPATCH MlasHGemmDispatchNeon;
 
+//
+// half precision gemm (MlasHalfGemmBatch) dispatch structure
+//
+struct MLAS_HALFGEMM_DISPATCH;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512;
+
+//
+// bfloat16 gemm dispatch structure
+//
+struct MLAS_SBGEMM_DISPATCH;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx2;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+
 // softmax dispatch structure
 struct MLAS_SOFTMAX_DISPATCH;
 extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
@@ -1099,6 +1116,11 @@ extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
 struct MLAS_ELTWISE_DISPATCH;
 extern const MLAS_ELTWISE_DISPATCH MlasEltwiseDispatchNeon;
 
+// layer normalization dispatch structure
+struct MLAS_LAYER_NORM_DISPATCH;
+extern const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx2;
+extern const MLAS_LAYER_NORM_DISPATCH MlasLayerNormDispatchAvx512F;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -1265,8 +1287,11 @@ struct MLAS_PLATFORM {
 
     const MLAS_ROPE_DISPATCH* RopeDispatch{nullptr};
     const MLAS_HGEMM_DISPATCH* HGemmDispatch{nullptr};
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{nullptr};
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
     const MLAS_SOFTMAX_DISPATCH* SoftmaxDispatch{nullptr};
     const MLAS_ELTWISE_DISPATCH* EltwiseDispatch{nullptr};
+    const MLAS_LAYER_NORM_DISPATCH* LayerNormDispatch{nullptr};
 };
 
 inline
@@ -1301,6 +1326,24 @@ MlasDivRoundup(size_t up, size_t down)
     return (up + down - 1) / down;
 }
 
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+MlasUnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+//
+// Calls f(0) .. f(N - 1), so that arrays of vectors indexed by the loop
+// variable are kept in registers.
+//
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+MlasUnrolledLoop(IterationFn&& f)
+{
+    MlasUnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
 /**
  * @brief Distribute multiple iterations of work over a thread pool if supported
  *
@@ -1417,6 +1460,34 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
+//
+// Winograd convolution support.
+//
+
+size_t
+MlasConvWinogradPackedFilterSize(
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+bool
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
@@ -404,7 +404,9 @@ Return Value:
                 this->CastF16ToF32Kernel = &MlasCastF16ToF32KernelAvx2;
                 this->CastF32ToF16Kernel = &MlasCastF32ToF16KernelAvx2;
                 this->RopeDispatch = &MlasRopeDispatchAvx2;
-
+                this->SBGemmDispatch = &MlasSBGemmDispatchAvx2;
+                this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx2;
+                this->LayerNormDispatch = &MlasLayerNormDispatchAvx2;
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -457,6 +459,7 @@ Return Value:
                     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->LayerNormDispatch = &MlasLayerNormDispatchAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -475,6 +478,7 @@ Return Value:
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
                         this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchAvx512;
                         this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512;
+                        this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512;
 
                         //
                         // Check if the processor supports AVX512VNNI.
@@ -489,6 +493,15 @@ Return Value:
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
                     }
                 }
 
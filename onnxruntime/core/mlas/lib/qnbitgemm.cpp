@@ -33,6 +33,8 @@ enum QNBitGemmVariant {
     HQ4BitGemmVariant_CompFp16,
     HQ4BitGemmVariant_CompInt8,
     SQ8BitGemmVariant_CompInt8,
+    SQ2BitGemmVariant_CompFp32,
+    SQ3BitGemmVariant_CompFp32,
 
     // End of valid variants
 
@@ -63,6 +65,10 @@ GetQNBitGemmVariant(
             if (ComputeType == SQNBIT_CompInt8) {
                 return SQ8BitGemmVariant_CompInt8;
             }
+        } else if (BlkBitWidth == 2 || BlkBitWidth == 3) {
+            if (ComputeType == SQNBIT_CompFp32) {
+                return BlkBitWidth == 2 ? SQ2BitGemmVariant_CompFp32 : SQ3BitGemmVariant_CompFp32;
+            }
         }
     }
 
@@ -106,6 +112,11 @@ MlasIsQNBitGemmAvailable(
                    Dispatch->SQ8BitGemmKernel_BlkSum_CompInt8 != nullptr &&
                    Dispatch->QuantizeARowComputeBlkSum_CompInt8 != nullptr;
         }
+        case SQ2BitGemmVariant_CompFp32:
+        case SQ3BitGemmVariant_CompFp32: {
+            // B is dequantized by SQLowBitBlkDequantBForSgemm_CompFp32 or its portable fallback.
+            return true;
+        }
         default: {
             return false;
         }
@@ -223,6 +234,10 @@ MlasQNBitGemmPackQuantBDataSize(
         return Dispatch->Q8BitGemmPackQuantBDataSize(
             N, K, BlkLen, HasZeroPoint, ComputeType
         );
+    } else if ((BlkBitWidth == 2 || BlkBitWidth == 3) && ComputeType == SQNBIT_CompFp32) {
+        // 2-bit and 3-bit B keeps its original layout.
+        const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+        return N * BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
     }
 
     return 0;
@@ -321,6 +336,15 @@ MlasQNBitGemmPackQuantBData(
                 ThreadPool
             );
         }
+    } else if (BlkBitWidth == 2 || BlkBitWidth == 3) {
+        if (ComputeType == SQNBIT_CompFp32 && QuantBData != nullptr) {
+            const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+            std::copy_n(
+                static_cast<const std::byte*>(QuantBData),
+                N * BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen),
+                static_cast<std::byte*>(PackedQuantBDataAndOrBlkSumWorkspace)
+            );
+        }
     }
 }
 
@@ -376,9 +400,54 @@ AddBiasForGemm(const float* Bias, float* C, size_t CountM, size_t CountN, size_t
     }
 }
 
+//
+// Rows up to which a multiplication is handled as a GEMV: each slice of B is
+// decoded by the M1 kernels while it is resident in cache, once per row of A,
+// and N is split across threads in cache line aligned ranges. This applies to
+// the M of the whole multiplication, not to the rows of one tile, so the last
+// tile of a large GEMM still uses the GEMM kernels.
+//
+constexpr size_t QNBitGemmGemvMaxM = 4;
+
+constexpr size_t QNBitGemmCacheLineSize = 64;
+
+/**
+ * @brief Prefetch the first cache lines of the scales and zero points of the
+ *        next slice of B, which the kernels touch before the packed data.
+ */
+MLAS_FORCEINLINE void
+QNBitGemmPrefetchBlkParams(const void* Scales, size_t ScaleBytes, const void* ZeroPoints, size_t ZeroPointBytes)
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    for (size_t i = 0; i < ScaleBytes; i += QNBitGemmCacheLineSize) {
+        _mm_prefetch(static_cast<const char*>(Scales) + i, _MM_HINT_T0);
+    }
+    if (ZeroPoints != nullptr) {
+        for (size_t i = 0; i < ZeroPointBytes; i += QNBitGemmCacheLineSize) {
+            _mm_prefetch(static_cast<const char*>(ZeroPoints) + i, _MM_HINT_T0);
+        }
+    }
+#elif defined(__GNUC__)
+    for (size_t i = 0; i < ScaleBytes; i += QNBitGemmCacheLineSize) {
+        __builtin_prefetch(static_cast<const char*>(Scales) + i);
+    }
+    if (ZeroPoints != nullptr) {
+        for (size_t i = 0; i < ZeroPointBytes; i += QNBitGemmCacheLineSize) {
+            __builtin_prefetch(static_cast<const char*>(ZeroPoints) + i);
+        }
+    }
+#else
+    MLAS_UNREFERENCED_PARAMETER(Scales);
+    MLAS_UNREFERENCED_PARAMETER(ScaleBytes);
+    MLAS_UNREFERENCED_PARAMETER(ZeroPoints);
+    MLAS_UNREFERENCED_PARAMETER(ZeroPointBytes);
+#endif
+}
+
 void
 SQ4BitGemm_CompFp32(
     const size_t BlkLen,
+    const size_t M,
     const size_t K,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* const DataParams,
     void* const PerGemmWorkspace,
@@ -412,23 +481,34 @@ SQ4BitGemm_CompFp32(
 
     const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
 
-    if (RangeCountM == 1) {
+    if (M <= QNBitGemmGemvMaxM) {
+        //
+        // Keep a slice of B in cache while each row of A is multiplied with it,
+        // with the bias added by the kernel.
+        //
         size_t CountN;
         for (size_t n = 0; n < RangeCountN; n += CountN) {
             CountN = std::min(RangeCountN - n, size_t{128});
 
-            const float* a_row = A;
             const std::byte* b_col = QuantBData + n * ldb;
             const float* b_col_scale = QuantBScale + n * k_blks;
             const std::byte* b_col_zp =
                 (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
-            float* c_blk = C + n;
             const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-            GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32(
-                BlkLen,
-                a_row, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
-            );
+            if (n + CountN < RangeCountN) {
+                QNBitGemmPrefetchBlkParams(
+                    b_col_scale + CountN * k_blks, k_blks * sizeof(float),
+                    b_col_zp == nullptr ? nullptr : b_col_zp + CountN * k_blks_zp_bytes, k_blks_zp_bytes
+                );
+            }
+
+            for (size_t m = 0; m < RangeCountM; m++) {
+                GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32(
+                    BlkLen,
+                    A + m * lda, b_col, b_col_scale, b_col_zp, C + m * ldc + n, CountN, K, k_blks, bias
+                );
+            }
 
             if (DataParams->PostProcessor != nullptr) {
                 DataParams->PostProcessor->Process(
@@ -495,9 +575,209 @@ SQ4BitGemm_CompFp32(
     }
 }
 
+/**
+ * @brief Extract the Index-th BlkBitWidth-bit value of an LSB first bit stream.
+ */
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE uint32_t
+QLowBitExtract(const std::byte* Data, size_t Index)
+{
+    const size_t Bit = Index * BlkBitWidth;
+    const size_t Shift = Bit % 8;
+    uint32_t Value = std::to_integer<uint32_t>(Data[Bit / 8]);
+    if (Shift + BlkBitWidth > 8) {
+        Value |= std::to_integer<uint32_t>(Data[Bit / 8 + 1]) << 8;
+    }
+    return (Value >> Shift) & ((1u << BlkBitWidth) - 1);
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitBlkDequantBForSgemm_CompFp32_Portable(
+    const size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    const size_t CountN,
+    const size_t CountK,
+    const size_t BlockStrideQuantB
+)
+{
+    const size_t StrideQuantBData = BlockStrideQuantB * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockStrideQuantB);
+    constexpr uint32_t DefaultZeroPoint = 1u << (BlkBitWidth - 1);
+
+    //
+    // Each 16 column panel holds CountK rows of 16 values, padded with zeros.
+    //
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t CountNN = std::min(CountN - n, size_t{16});
+        float* Dst = FpData + n * CountK;
+
+        for (size_t nn = 0; nn < 16; nn++) {
+            if (nn >= CountNN) {
+                for (size_t k = 0; k < CountK; k++) {
+                    Dst[k * 16 + nn] = 0.0f;
+                }
+                continue;
+            }
+
+            const std::byte* Data = QuantBData + (n + nn) * StrideQuantBData;
+            const float* Scale = QuantBScale + (n + nn) * BlockStrideQuantB;
+            const std::byte* ZeroPoint =
+                (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + (n + nn) * StrideQuantBZeroPoint;
+
+            for (size_t k = 0; k < CountK; k++) {
+                const size_t k_blk = k / BlkLen;
+                const uint32_t zp = (ZeroPoint == nullptr) ? DefaultZeroPoint : QLowBitExtract<BlkBitWidth>(ZeroPoint, k_blk);
+                const int32_t q = static_cast<int32_t>(QLowBitExtract<BlkBitWidth>(Data, k)) - static_cast<int32_t>(zp);
+                Dst[k * 16 + nn] = static_cast<float>(q) * Scale[k_blk];
+            }
+        }
+    }
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemm_CompFp32(
+    const size_t BlkLen,
+    const size_t M,
+    const size_t K,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* const DataParams,
+    void* const PerGemmWorkspace,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+)
+{
+    MLAS_UNREFERENCED_PARAMETER(PerGemmWorkspace);
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+    const size_t ldb = k_blks * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t k_blks_zp_bytes = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(k_blks);
+
+    const float* A = DataParams->A + RangeStartM * lda;
+
+    const std::byte* QuantBData = static_cast<const std::byte*>(DataParams->PackedQuantBData) + RangeStartN * ldb;
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * k_blks;
+    const std::byte* QuantBZeroPoint =
+        (DataParams->QuantBZeroPoint == nullptr)
+            ? nullptr
+            : static_cast<const std::byte*>(DataParams->QuantBZeroPoint) + RangeStartN * k_blks_zp_bytes;
+
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
+
+    const auto GemmM1Kernel = GetMlasPlatform().QNBitGemmDispatch->SQLowBitGemmM1Kernel_CompFp32;
+    if (M <= QNBitGemmGemvMaxM && GemmM1Kernel != nullptr) {
+        //
+        // Keep a slice of B in cache while each row of A is multiplied with it,
+        // with the bias added by the kernel.
+        //
+        size_t CountN;
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
+            CountN = std::min(RangeCountN - n, size_t{128});
+
+            const std::byte* b_col = QuantBData + n * ldb;
+            const float* b_col_scale = QuantBScale + n * k_blks;
+            const std::byte* b_col_zp =
+                (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
+            const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+            if (n + CountN < RangeCountN) {
+                QNBitGemmPrefetchBlkParams(
+                    b_col_scale + CountN * k_blks, k_blks * sizeof(float),
+                    b_col_zp == nullptr ? nullptr : b_col_zp + CountN * k_blks_zp_bytes, k_blks_zp_bytes
+                );
+            }
+
+            for (size_t m = 0; m < RangeCountM; m++) {
+                GemmM1Kernel(
+                    BlkBitWidth, BlkLen,
+                    A + m * lda, b_col, b_col_scale, b_col_zp, C + m * ldc + n, CountN, K, k_blks, bias
+                );
+            }
+
+            if (DataParams->PostProcessor != nullptr) {
+                DataParams->PostProcessor->Process(
+                    DataParams->C, RangeStartM, RangeStartN + n,
+                    RangeCountM, CountN, ldc
+                );
+            }
+        }
+        return;
+    }
+
+    const auto DequantB = GetMlasPlatform().QNBitGemmDispatch->SQLowBitBlkDequantBForSgemm_CompFp32;
+
+    constexpr size_t StrideN = 32;
+    size_t bufsize = K * StrideN * sizeof(float);
+    MlasThreadedBufAlloc(bufsize);
+    auto* dequant_b = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, StrideN);
+
+        const float* a_row = A;
+        const std::byte* b_col = QuantBData + n * ldb;
+        const float* b_col_scale = QuantBScale + n * k_blks;
+        const std::byte* b_col_zp =
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
+        float* c_blk = C + n;
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+        if (DequantB != nullptr) {
+            DequantB(BlkBitWidth, BlkLen, dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks);
+        } else {
+            SQLowBitBlkDequantBForSgemm_CompFp32_Portable<BlkBitWidth>(
+                BlkLen, dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks
+            );
+        }
+
+        //
+        // Step through each slice of matrix A along the M dimension.
+        //
+        size_t RowsRemaining = RangeCountM;
+        while (RowsRemaining > 0) {
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER) || defined(MLAS_TARGET_LARCH64)
+            auto RowsHandled = GetMlasPlatform().GemmFloatKernel(
+                a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f, true
+            );
+#else
+            auto RowsHandled = MlasSgemmKernelZero(a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f);
+#endif
+
+            if (bias) {
+                AddBiasForGemm(bias, c_blk, RowsHandled, CountN, ldc);
+            }
+            if (DataParams->PostProcessor != nullptr) {
+                DataParams->PostProcessor->Process(
+                    DataParams->C, RangeStartM + RangeCountM - RowsRemaining, RangeStartN + n,
+                    RowsHandled, CountN, ldc
+                );
+            }
+
+            c_blk += ldc * RowsHandled;
+            a_row += lda * RowsHandled;
+            RowsRemaining -= RowsHandled;
+        }
+    }
+}
+
 void
 HQ4BitGemm_CompFp16(
     const size_t BlkLen,
+    const size_t M,
     const size_t K,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<MLAS_FP16>* const DataParams,
     void* const PerGemmWorkspace,
@@ -508,6 +788,7 @@ HQ4BitGemm_CompFp16(
 )
 {
     constexpr size_t BlkBitWidth = 4;
+    MLAS_UNREFERENCED_PARAMETER(M);
     MLAS_UNREFERENCED_PARAMETER(PerGemmWorkspace);
 
     const size_t lda = DataParams->lda;
@@ -571,6 +852,7 @@ HQ4BitGemm_CompFp16(
 void
 SQ4BitGemm_CompInt8(
     const size_t BlkLen,
+    const size_t M,
     const size_t K,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* const DataParams,
     void* const PerGemmWorkspace,
@@ -653,6 +935,13 @@ SQ4BitGemm_CompInt8(
         float* c_blk = C + n;
         const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
+        if (M <= QNBitGemmGemvMaxM && n + CountN < RangeCountN) {
+            QNBitGemmPrefetchBlkParams(
+                b_col_scale + CountN * k_blks, k_blks * sizeof(float),
+                b_col_zp == nullptr ? nullptr : b_col_zp + CountN * k_blks_zp_bytes, k_blks_zp_bytes
+            );
+        }
+
         if (GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmKernel_CompInt8 != nullptr) {
             size_t RowsRemaining = RangeCountM;
             while (RowsRemaining > 0) {
@@ -710,6 +999,7 @@ SQ4BitGemm_CompInt8(
 void
 SQ8BitGemm_CompInt8(
     const size_t BlkLen,
+    const size_t M,
     const size_t K,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* const DataParams,
     void* const PerGemmWorkspace,
@@ -757,6 +1047,13 @@ SQ8BitGemm_CompInt8(
         float* c_blk = C + n;
         const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
+        if (M <= QNBitGemmGemvMaxM && n + CountN < RangeCountN) {
+            QNBitGemmPrefetchBlkParams(
+                b_col_scale + CountN * k_blks, k_blks * sizeof(float),
+                b_col_zp == nullptr ? nullptr : b_col_zp + CountN * k_blks_zp_bytes, k_blks_zp_bytes
+            );
+        }
+
         if (GetMlasPlatform().QNBitGemmDispatch->SQ8BitGemmKernel_BlkSum_CompInt8 != nullptr) {
             const float* b_blk_sum = QuantBBlkSum + n * k_blks;
             GetMlasPlatform().QNBitGemmDispatch->SQ8BitGemmKernel_BlkSum_CompInt8(
@@ -937,6 +1234,7 @@ GetInitializeWorkspace(QNBitGemmVariant variant)
 template <typename T>
 using QNBitGemmFn = std::function<void(
     const size_t BlkLen,
+    const size_t M,
     const size_t K,
     const MLAS_QNBIT_GEMM_DATA_PARAMS<T>* const DataParams,
     void* const PerGemmWorkspace,
@@ -961,6 +1259,10 @@ GetQNBitGemm(QNBitGemmVariant variant)
             return SQ4BitGemm_CompInt8;
         case SQ8BitGemmVariant_CompInt8:
             return SQ8BitGemm_CompInt8;
+        case SQ2BitGemmVariant_CompFp32:
+            return SQLowBitGemm_CompFp32<2>;
+        case SQ3BitGemmVariant_CompFp32:
+            return SQLowBitGemm_CompFp32<3>;
         default:
             return nullptr;
     }
@@ -1023,28 +1325,35 @@ MlasQNBitGemmBatch(
 
     const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
 
+    const auto ComputeRange = [&](size_t gemm_i, size_t RangeStartM, size_t RangeCountM, size_t RangeStartN,
+                                  size_t RangeCountN) {
+        const auto* Data = &DataParams[gemm_i];
+        void* PerGemmWorkspace =
+            reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride;
+        if (Variant == SQ4BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmKernel_BlkSum_CompInt8 != nullptr) {
+            PackedQuantBDataStruct<T, 4> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
+            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
+            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
+            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
+
+            PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
+            ComputeOperation(BlkLen, M, K, Data, &per_gemm_quant_a_workspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        } else if (Variant == SQ8BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ8BitGemmKernel_BlkSum_CompInt8 != nullptr) {
+            PackedQuantBDataStruct<T, 8> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
+            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
+            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
+            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
+
+            PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
+            ComputeOperation(BlkLen, M, K, Data, &per_gemm_quant_a_workspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        } else {
+            ComputeOperation(BlkLen, M, K, Data, PerGemmWorkspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        }
+    };
+
     if (ThreadPool == nullptr) {
         for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
-            const auto* Data = &DataParams[gemm_i];
-            void* PerGemmWorkspace =
-                reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride;
-            if (Variant == SQ4BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmKernel_BlkSum_CompInt8 != nullptr) {
-                PackedQuantBDataStruct<T, 4> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
-                const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
-                const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
-                const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
-                PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
-                ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, 0, M, 0, N);
-            } else if (Variant == SQ8BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ8BitGemmKernel_BlkSum_CompInt8 != nullptr) {
-                PackedQuantBDataStruct<T, 8> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
-                const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
-                const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
-                const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
-                PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
-                ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, 0, M, 0, N);
-            } else {
-                ComputeOperation(BlkLen, K, Data, PerGemmWorkspace, 0, M, 0, N);
-            }
+            ComputeRange(gemm_i, 0, M, 0, N);
         }
         return;
     }
@@ -1058,6 +1367,30 @@ MlasQNBitGemmBatch(
 
     ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
 
+    if (M <= QNBitGemmGemvMaxM) {
+        //
+        // Decoding is bound by reading B, so give each thread one contiguous
+        // range of N instead of many small tiles. The ranges are multiples of
+        // a cache line of C so that no two threads write to the same line.
+        //
+        constexpr size_t StrideNAlign =
+            std::max(QNBitGemmCacheLineSize / sizeof(T), size_t{MLAS_QGEMM_STRIDEN_THREAD_ALIGN});
+
+        TargetThreadCount = std::min(TargetThreadCount, ptrdiff_t(MlasGetMaximumThreadCount(ThreadPool)));
+
+        const size_t ThreadsPerGemm = std::max(size_t(TargetThreadCount) / BatchN, size_t{1});
+        const size_t StrideN = MlasDivRoundup(MlasDivRoundup(N, ThreadsPerGemm), StrideNAlign) * StrideNAlign;
+        const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+
+        MlasTrySimpleParallel(ThreadPool, ThreadCountN * BatchN, [&](ptrdiff_t tid) {
+            const size_t RangeStartN = (tid % ThreadCountN) * StrideN;
+            const size_t RangeCountN = std::min(N - RangeStartN, StrideN);
+
+            ComputeRange(tid / ThreadCountN, 0, M, RangeStartN, RangeCountN);
+        });
+        return;
+    }
+
     ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool) * 8;
 
     if (TargetThreadCount >= MaximumThreadCount) {
@@ -1093,7 +1426,6 @@ MlasQNBitGemmBatch(
     MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
         const auto gemm_i = tid / ThreadsPerGemm;
         const auto blk_i = tid % ThreadsPerGemm;
-        const auto* Data = &DataParams[gemm_i];
 
         const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
         const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
@@ -1104,27 +1436,7 @@ MlasQNBitGemmBatch(
         const size_t RangeStartN = ThreadIdN * StrideN;
         const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
 
-        void* PerGemmWorkspace =
-            reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride;
-        if (Variant == SQ4BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmKernel_BlkSum_CompInt8 != nullptr) {
-            PackedQuantBDataStruct<T, 4> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
-            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
-            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
-            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
-
-            PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
-            ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
-        } else if (Variant == SQ8BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ8BitGemmKernel_BlkSum_CompInt8 != nullptr) {
-            PackedQuantBDataStruct<T, 8> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
-            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
-            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBBlkSum = packed_quant_b.QuantBBlkSum;
-            const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->QuantBScale = packed_quant_b.PackedQuantBScale;
-
-            PerGemmQuantAWorkspace per_gemm_quant_a_workspace(PerGemmWorkspace, M, BlockCountK, BlkLen);
-            ComputeOperation(BlkLen, K, Data, &per_gemm_quant_a_workspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
-        } else {
-            ComputeOperation(BlkLen, K, Data, PerGemmWorkspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
-        }
+        ComputeRange(gemm_i, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
     });
 }
 
@@ -75,8 +75,10 @@ template <size_t BlkBitWidth>
 constexpr MLAS_FORCEINLINE size_t
 MlasQNBitZeroPointsForBlksSizeInBytes(size_t BlkCount)
 {
-    if constexpr (BlkBitWidth <= 4) {
+    if constexpr (BlkBitWidth == 4) {
         return MlasDivRoundup(BlkCount, 2);  // 2 blocks per byte
+    } else if constexpr (BlkBitWidth < 8) {
+        return MlasDivRoundup(BlkCount * BlkBitWidth, 8);  // bit packed like the block data
     } else {
         return BlkCount;
     }
@@ -262,6 +264,76 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
 
     Q4BitBlkDequantBForSgemm_CompFp32_Fn* SQ4BitBlkDequantBForSgemm_CompFp32 = nullptr;
 
+    /**
+     * @brief Multiply float matrix A with quantized 2-bit or 3-bit integer matrix B.
+     *        B is block quantized and column major, in the layout described for
+     *        SQLowBitBlkDequantBForSgemm_CompFp32.
+     *        This kernel handles the special case where M, the number of rows of A and C, is 1.
+     *        Optional, B is dequantized and multiplied by the Sgemm kernel if this is not set.
+     *
+     * @param       BlkBitWidth         Number of bits of each quantized value, 2 or 3.
+     * @param       BlkLen              Number of values in a block.
+     * @param       A                   Supplies the A matrix.
+     * @param       QuantBData          Supplies the quantized B matrix block data.
+     * @param       QuantBScale         Supplies the quantized B matrix block scale values.
+     * @param       QuantBZeroPoint     Supplies the quantized B matrix block zero point values. Optional.
+     * @param[out]  C                   Supplies the output C matrix.
+     * @param       CountN              Number of columns of B and C.
+     * @param       CountK              Number of columns of A and rows of B.
+     * @param       BlockStrideQuantB   Number of blocks between adjacent columns of the quantized B matrix.
+     * @param       Bias                Bias vector of length N.
+     */
+    typedef void(SQLowBitGemmM1Kernel_CompFp32_Fn)(
+        size_t BlkBitWidth,
+        size_t BlkLen,
+        const float* A,
+        const std::byte* QuantBData,
+        const float* QuantBScale,
+        const std::byte* QuantBZeroPoint,
+        float* C,
+        size_t CountN,
+        size_t CountK,
+        size_t BlockStrideQuantB,
+        const float* Bias
+    );
+
+    SQLowBitGemmM1Kernel_CompFp32_Fn* SQLowBitGemmM1Kernel_CompFp32 = nullptr;
+
+    /**
+     * @brief Dequantize B into the format expected by the Sgemm kernel.
+     *        B is a quantized 2-bit or 3-bit integer matrix that is block quantized and column major.
+     *        The values of each column are a continuous LSB first bit stream, and the zero points of
+     *        each column are packed the same way.
+     *        This is equivalent to dequantizing B and then running MlasSgemmCopyPackB.
+     *        Optional, a portable implementation is used if this is not set.
+     *
+     * @param       BlkBitWidth         Number of bits of each quantized value, 2 or 3.
+     * @param       BlkLen              Number of values in a block.
+     * @param[out]  FpData              Supplies the output buffer for the dequantized B float data.
+     *                                  It should have enough space for
+     *                                      (CountN + 16 - 1) / 16 * 16 * CountK
+     *                                  elements.
+     * @param       QuantBData          Supplies the quantized B matrix block data.
+     * @param       QuantBScale         Supplies the quantized B matrix block scale values.
+     * @param       QuantBZeroPoint     Supplies the quantized B matrix block zero point values. Optional.
+     * @param       CountN              Number of columns of B.
+     * @param       CountK              Number of rows of B.
+     * @param       BlockStrideQuantB   Number of blocks between adjacent columns of the quantized B matrix.
+     */
+    typedef void(QLowBitBlkDequantBForSgemm_CompFp32_Fn)(
+        size_t BlkBitWidth,
+        size_t BlkLen,
+        float* FpData,
+        const std::byte* QuantBData,
+        const float* QuantBScale,
+        const std::byte* QuantBZeroPoint,
+        size_t CountN,
+        size_t CountK,
+        size_t BlockStrideQuantB
+    );
+
+    QLowBitBlkDequantBForSgemm_CompFp32_Fn* SQLowBitBlkDequantBForSgemm_CompFp32 = nullptr;
+
     /**
      * @brief Dequantize B into the format expected by the Sgemm kernel.
      *        B is a quantized 4-bit integer matrix that is block quantized and column major.
@@ -30,15 +30,24 @@ Abstract:
         MLAS_SBGEMM_STRIDES Strides{128, 128, 256};
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 
 #include "mlasi.h"
 
+#if defined(MLAS_SUPPORTS_SBGEMM)
+
+#if defined(MLAS_TARGET_AMD64)
+//
+// Raw bfloat16 bits. The x86 kernels only move bf16 values between the packed
+// buffer and registers, so no arithmetic type is needed.
+//
+typedef uint16_t bfloat16_t;
+#endif
+
 /**
  * @brief Define the default striding parameters for
  *        the bfloat16 precision gemm operation
@@ -134,7 +143,11 @@ MlasSBGemmPackedOperation(size_t M, size_t RangeStartN, size_t RangeCountN, size
             bool ZeroMode = (k == 0);
             CountK = std::min(K - k, PackedStrideK);
 
-            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + CountK * SliceStartN;
+            //
+            // The packed B columns of a K slice are padded to PackedK rows.
+            //
+            const size_t AlignedCountK = (CountK + KernelType::PackedK - 1) & ~(KernelType::PackedK - 1);
+            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + AlignedCountK * SliceStartN;
             float* c = C + n;
             const float* pbias = ((nullptr == Bias) ? nullptr : Bias + RangeStartN + n);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, pb, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -153,24 +166,18 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
     //
     // Compute the strides to step through slices of the input matrices.
     //
-    // Expand the N stride if K is small or expand the K stride if N is small
-    // for better utilization of the B panel. Avoid changing the K stride if
-    // the A panel needs to be used for transposing.
+    // Expand the N stride if K is small for better utilization of the B
+    // panel. The K stride is not expanded: MlasSBGemmConvertPackB packs
+    // slices of at most Strides.K rows, which is the layout the kernels
+    // expect for a single K slice.
     //
     constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
     size_t StrideN = Strides.N;
     size_t StrideK = Strides.K;
 
-    if (N >= K) {
-        while (StrideK / 2 >= K) {
-            StrideN *= 2;
-            StrideK /= 2;
-        }
-    } else {
-        while (StrideN > 16 && StrideN / 2 >= N) {
-            StrideK *= 2;
-            StrideN /= 2;
-        }
+    while (StrideK / 2 >= K && StrideK / 2 >= KernelType::PackedK) {
+        StrideN *= 2;
+        StrideK /= 2;
     }
 
     constexpr size_t packBSize = UpAlignSize(Strides.N * Strides.K * sizeof(bfloat16_t));
@@ -198,8 +205,7 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
             MlasSBGemmConvertPackB<KernelType>(PanelB, B + n + k * ldb, ldb, CountN, CountK);
 
             auto* c = C + n;
-            const float* pbias =
-                ((nullptr == Bias) ? nullptr : Bias + n);  // TODO: check the SliceNStart
+            const float* pbias = ((nullptr == Bias) ? nullptr : Bias + n);
 
             bool ZeroMode = (k == 0);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, PanelB, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -258,6 +264,9 @@ MlasSBGemmOperation(const ptrdiff_t ThreadCountM, const ptrdiff_t ThreadCountN,
     } else {
         const size_t ldb = DataParams->ldb;
         const float* B = (const float*)DataParams->B + RangeStartN;
+        if (bias != nullptr) {
+            bias += RangeStartN;
+        }
         MlasSBGemmNonPackedOperation<KernelType>(RangeCountM, RangeCountN, K, A, lda, B, ldb, C, ldc, bias, (void*)DataParams->OutputProcessor);
     }
 }
@@ -291,109 +300,118 @@ MlasSBGemmGetDispatch()
 {
 #if defined(MLAS_TARGET_ARM64)
     return &MlasSBGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().SBGemmDispatch;
 #else
-    std::cerr << "SBGemm Kernel is supported only on ARM64 platform.";
+    std::cerr << "SBGemm Kernel is supported only on ARM64 and AMD64 platforms.";
     exit(1);
 #endif
 }
 
-size_t MLASCALL
-MlasSBGemmPackBSize(size_t N, size_t K)
-{
-    //
-    // Compute the number of bytes required to hold the packed buffer.
-    //
-    const auto* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return 0;
-
-    const auto padding = dispatch->BufOverRead;
-    const auto PackedK = dispatch->PackedK;
-    const auto PackedN = dispatch->PackedN;
+#if defined(MLAS_TARGET_AMD64)
 
-    const size_t AlignedK = (K + PackedK - 1) & ~(PackedK - 1);
-    const size_t AlignedN = (N + PackedN - 1) & ~(PackedN - 1);
-    const size_t BytesRequired = AlignedN * AlignedK * sizeof(bfloat16_t) + padding;
-    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
-    const size_t AlignedBytesRequired =
-        (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
-
-    return AlignedBytesRequired;
-}
-
-void MLASCALL
-MlasSBGemmConvertPackB(size_t N, size_t K, const float* B, size_t ldb, void* PackedB)
+/**
+ * @brief Convert a fp32 value to bf16 with round to nearest even.
+ *        NaN values stay NaN.
+ */
+MLAS_FORCEINLINE
+uint16_t
+MlasSBGemmFp32ToBf16(float Value)
 {
-    const auto* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return;
-
-    dispatch->ConvertPackBRoutine((bfloat16_t*)PackedB, B, ldb, N, K);
-}
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
 
-void MLASCALL
-MlasSBGemmBatch(const size_t M, const size_t N, const size_t K, const size_t BatchN, const MLAS_SBGEMM_DATA_PARAMS* Data, MLAS_THREADPOOL* ThreadPool)
-{
-    const MLAS_SBGEMM_DISPATCH* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return;
+    if ((Bits & 0x7fffffff) > 0x7f800000) {
+        return static_cast<uint16_t>((Bits >> 16) | 0x40);
+    }
 
-    MLAS_SBGEMM_OPERATION* operation = dispatch->Operation;
+    Bits += 0x7fff + ((Bits >> 16) & 1);
+    return static_cast<uint16_t>(Bits >> 16);
+}
 
-    //
-    // Compute the number of target threads given the complexity of the SGEMM
-    // operation. Small requests should run using the single threaded path.
-    //
+/*
+    The x86 kernels share a packed B format: 16 columns wide panels, each
+    holding pairs of consecutive rows of B interleaved so that every 32-bit
+    element holds the bf16 values B[k][n] (low half) and B[k+1][n] (high half).
 
-    const double Complexity = double(M) * double(N) * double(K);
+        panel 0: {B[0][0],B[1][0]}, {B[0][1],B[1][1]}, .. {B[0][15],B[1][15]},
+                 {B[2][0],B[3][0]}, ..
+        panel 1: {B[0][16],B[1][16]}, ..
 
-    ptrdiff_t TargetThreadCount;
+    This is the operand layout of vdpbf16ps, and lets the AVX2 kernel widen both
+    rows of a pair to fp32 with a shift and a mask. The columns and the rows are
+    padded with zeros to 16 and 2.
+*/
 
-    if (Complexity < double(MLAS_SBGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
-        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-    } else {
-        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+/**
+ * @brief Pack one 16 column panel of fp32 matrix B
+ *
+ * @param[out] D         Address of the panel in the packing buffer
+ * @param[in]  B         Address of the first column of the panel in matrix B
+ * @param[in]  ldb       Leading dimension of B
+ * @param[in]  CountN    # of columns in the panel, up to 16
+ * @param[in]  CountK    # of rows to pack
+ */
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertPackBPanelX86(uint32_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK)
+{
+    for (size_t k = 0; k < CountK; k += 2) {
+        const float* b0 = B + k * ldb;
+        const float* b1 = (k + 1 < CountK) ? b0 + ldb : nullptr;
+
+        size_t n = 0;
+        for (; n < CountN; n++) {
+            const uint32_t lo = MlasSBGemmFp32ToBf16(b0[n]);
+            const uint32_t hi = (b1 != nullptr) ? MlasSBGemmFp32ToBf16(b1[n]) : 0;
+            D[n] = lo | (hi << 16);
+        }
+        for (; n < 16; n++) {
+            D[n] = 0;
+        }
+        D += 16;
     }
+}
 
-    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+/**
+ * @brief Convert and pack fp32 matrix B in the x86 packed format
+ *
+ * @tparam KernelType
+ * @param[out] PackedB   Address of packing buffer
+ * @param[in]  B         Address of source matrix B in fp32
+ * @param[in]  ldb       Leading dimension of B
+ * @param[in]  CountN    # of column to pack
+ * @param[in]  CountK    # of rows to pack
+ */
+template <typename KernelType>
+void
+MlasSBGemmConvertPackBX86(bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK)
+{
+    static_assert(KernelType::PackedK == 2 && KernelType::PackedN == 16, "unexpected packed format");
 
-    if (TargetThreadCount >= MaximumThreadCount) {
-        TargetThreadCount = MaximumThreadCount;
-    }
+    const size_t AlignedN = (CountN + KernelType::PackedN - 1) & ~(KernelType::PackedN - 1);
 
     //
-    // Segment the operation across multiple threads.
-    //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
+    // Step through each slice of matrix B along the K dimension. Each slice
+    // is packed as a separate buffer, see MlasSBGemmPackedOperation.
     //
-    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchN - 1) / BatchN;
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
-
-    if (N > M) {
-        const size_t BlockedN =
-            (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) / MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
-
-        if (size_t(ThreadsPerGemm) > BlockedN) {
-            ThreadsPerGemm = ptrdiff_t(BlockedN);
-        }
+    size_t K_block_size;
+    constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
 
-        ThreadCountM = 1;
-        ThreadCountN = ThreadsPerGemm;
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+        const size_t AlignedK = (K_block_size + 1) & ~size_t(1);
 
-    } else {
-        if (size_t(ThreadsPerGemm) > M) {
-            ThreadsPerGemm = ptrdiff_t(M);
+        uint32_t* D = reinterpret_cast<uint32_t*>(PackedB);
+        for (size_t n = 0; n < CountN; n += 16) {
+            MlasSBGemmConvertPackBPanelX86(D, B + k * ldb + n, ldb, std::min(CountN - n, size_t(16)), K_block_size);
+            D += 8 * AlignedK;
         }
 
-        ThreadCountM = ThreadsPerGemm;
-        ThreadCountN = 1;
+        PackedB += AlignedN * AlignedK;
     }
-
-    MlasTrySimpleParallel(
-        ThreadPool, ThreadsPerGemm * static_cast<ptrdiff_t>(BatchN), [=](ptrdiff_t tid) {
-            ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
-            ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
-            operation(ThreadCountM, ThreadCountN, M, N, K, &(Data[GemmIdx]), ThreadIdx);
-        }
-    );
 }
-#endif  // defined(__aarch64__) && defined(__linux__)
+
+#endif  // defined(MLAS_TARGET_AMD64)
+
+#endif  // defined(MLAS_SUPPORTS_SBGEMM)
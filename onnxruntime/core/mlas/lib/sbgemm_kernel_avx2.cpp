@@ -0,0 +1,234 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the bfloat16 precision GEMM kernel for AVX2.
+
+    Matrix B is packed as bf16 and widened to fp32 in registers, so the
+    kernel reads half of the bytes of the single precision GEMM for the
+    weights. Matrix A stays in fp32.
+
+--*/
+
+#include "mlasi.h"
+#include "sbgemm.h"
+
+struct MLAS_SBGEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = 16;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX2>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackBX86<MLAS_SBGEMM_KERNEL_AVX2>(PackedB, B, ldb, CountN, CountK);
+}
+
+/**
+ * @brief Mask of the first Count lanes of a 8 lane vector.
+ */
+MLAS_FORCEINLINE
+__m256i
+MlasSBGemmTailMaskAvx2(size_t Count)
+{
+    static const int32_t MaskTable[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&MaskTable[8 - Count]));
+}
+
+/**
+ * @brief Compute up to RowCount rows of a 16 column panel of matrix C.
+ *
+ * @tparam RowCount  # of rows to process, 1 to 4
+ * @param A          Address of matrix A
+ * @param lda        Leading dimension of A
+ * @param B          Address of the packed panel of matrix B
+ * @param C          Address of matrix C
+ * @param ldc        Leading dimension of C
+ * @param CountK     # of columns of A and rows of B
+ * @param CountN     # of columns of the panel to store, 1 to 16
+ * @param Bias       Address of the bias of the panel, or nullptr
+ * @param ZeroMode   Whether to overwrite C instead of accumulating onto it
+ */
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelAvx2Panel(
+    const float* A,
+    size_t lda,
+    const uint32_t* B,
+    float* C,
+    size_t ldc,
+    size_t CountK,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    __m256 Accumulators[RowCount][2];
+
+    MlasUnrolledLoop<RowCount>([&](size_t r) {
+        Accumulators[r][0] = _mm256_setzero_ps();
+        Accumulators[r][1] = _mm256_setzero_ps();
+    });
+
+    const __m256i HighMask = _mm256_set1_epi32(int32_t(0xFFFF0000));
+
+    size_t k = 0;
+
+    for (; k + 2 <= CountK; k += 2) {
+        const __m256i BPair0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B));
+        const __m256i BPair1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B + 8));
+
+        const __m256 B00 = _mm256_castsi256_ps(_mm256_slli_epi32(BPair0, 16));
+        const __m256 B01 = _mm256_castsi256_ps(_mm256_slli_epi32(BPair1, 16));
+        const __m256 B10 = _mm256_castsi256_ps(_mm256_and_si256(BPair0, HighMask));
+        const __m256 B11 = _mm256_castsi256_ps(_mm256_and_si256(BPair1, HighMask));
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            const __m256 A0 = _mm256_broadcast_ss(A + r * lda + k);
+            const __m256 A1 = _mm256_broadcast_ss(A + r * lda + k + 1);
+            Accumulators[r][0] = _mm256_fmadd_ps(A0, B00, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(A0, B01, Accumulators[r][1]);
+            Accumulators[r][0] = _mm256_fmadd_ps(A1, B10, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(A1, B11, Accumulators[r][1]);
+        });
+
+        B += 16;
+    }
+
+    if (k < CountK) {
+        //
+        // The last row of B is paired with a padding row of zeros.
+        //
+        const __m256i BPair0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B));
+        const __m256i BPair1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B + 8));
+
+        const __m256 B00 = _mm256_castsi256_ps(_mm256_slli_epi32(BPair0, 16));
+        const __m256 B01 = _mm256_castsi256_ps(_mm256_slli_epi32(BPair1, 16));
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            const __m256 A0 = _mm256_broadcast_ss(A + r * lda + k);
+            Accumulators[r][0] = _mm256_fmadd_ps(A0, B00, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(A0, B01, Accumulators[r][1]);
+        });
+    }
+
+    if (CountN == 16) {
+        __m256 Bias0 = _mm256_setzero_ps();
+        __m256 Bias1 = _mm256_setzero_ps();
+        if (Bias != nullptr) {
+            Bias0 = _mm256_loadu_ps(Bias);
+            Bias1 = _mm256_loadu_ps(Bias + 8);
+        }
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            float* c = C + r * ldc;
+            if (ZeroMode) {
+                _mm256_storeu_ps(c, _mm256_add_ps(Accumulators[r][0], Bias0));
+                _mm256_storeu_ps(c + 8, _mm256_add_ps(Accumulators[r][1], Bias1));
+            } else {
+                _mm256_storeu_ps(c, _mm256_add_ps(Accumulators[r][0], _mm256_loadu_ps(c)));
+                _mm256_storeu_ps(c + 8, _mm256_add_ps(Accumulators[r][1], _mm256_loadu_ps(c + 8)));
+            }
+        });
+        return;
+    }
+
+    //
+    // Store a partial panel with masked loads and stores.
+    //
+    const __m256i Mask0 = MlasSBGemmTailMaskAvx2(std::min(CountN, size_t(8)));
+    const __m256i Mask1 = MlasSBGemmTailMaskAvx2(CountN > 8 ? CountN - 8 : 0);
+
+    __m256 Bias0 = _mm256_setzero_ps();
+    __m256 Bias1 = _mm256_setzero_ps();
+    if (Bias != nullptr) {
+        Bias0 = _mm256_maskload_ps(Bias, Mask0);
+        Bias1 = _mm256_maskload_ps(Bias + 8, Mask1);
+    }
+
+    MlasUnrolledLoop<RowCount>([&](size_t r) {
+        float* c = C + r * ldc;
+        if (ZeroMode) {
+            _mm256_maskstore_ps(c, Mask0, _mm256_add_ps(Accumulators[r][0], Bias0));
+            _mm256_maskstore_ps(c + 8, Mask1, _mm256_add_ps(Accumulators[r][1], Bias1));
+        } else {
+            _mm256_maskstore_ps(c, Mask0, _mm256_add_ps(Accumulators[r][0], _mm256_maskload_ps(c, Mask0)));
+            _mm256_maskstore_ps(c + 8, Mask1, _mm256_add_ps(Accumulators[r][1], _mm256_maskload_ps(c + 8, Mask1)));
+        }
+    });
+}
+
+template <size_t RowCount>
+void
+MlasSBGemmKernelAvx2Rows(
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    const size_t AlignedK = (CountK + 1) & ~size_t(1);
+    const uint32_t* b = reinterpret_cast<const uint32_t*>(B);
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        MlasSBGemmKernelAvx2Panel<RowCount>(
+            A, lda, b, C + n, ldc, CountK, std::min(CountN - n, size_t(16)),
+            Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+        b += 8 * AlignedK;
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX2>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    while (CountM > 0) {
+        size_t RowsHandled;
+        if (CountM >= 4) {
+            MlasSBGemmKernelAvx2Rows<4>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 4;
+        } else if (CountM == 3) {
+            MlasSBGemmKernelAvx2Rows<3>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 3;
+        } else if (CountM == 2) {
+            MlasSBGemmKernelAvx2Rows<2>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 2;
+        } else {
+            MlasSBGemmKernelAvx2Rows<1>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 1;
+        }
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx2 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX2>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX2>,
+    MLAS_SBGEMM_KERNEL_AVX2::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX2::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
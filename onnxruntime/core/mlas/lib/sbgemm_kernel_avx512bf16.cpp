@@ -0,0 +1,243 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 precision GEMM kernel for AVX512-BF16.
+
+    Rows of matrix A are converted to bf16 pairs and multiplied with the
+    packed bf16 matrix B by vdpbf16ps, accumulating in fp32.
+
+--*/
+
+#include "mlasi.h"
+#include "sbgemm.h"
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = 16;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+//
+// Largest K slice passed to the kernel.
+//
+constexpr size_t MlasSBGemmAvx512Bf16MaxK = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K;
+
+//
+// MSVC defines the bf16 vector types as the integer vector types, other
+// compilers as distinct vector types of the same size.
+//
+#if defined(_MSC_VER) && !defined(__clang__)
+#define MlasSBGemmCastToSi512(v) (v)
+#define MlasSBGemmCastToBh512(v) (v)
+#else
+#define MlasSBGemmCastToSi512(v) ((__m512i)(v))
+#define MlasSBGemmCastToBh512(v) ((__m512bh)(v))
+#endif
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackBX86<MLAS_SBGEMM_KERNEL_AVX512BF16>(PackedB, B, ldb, CountN, CountK);
+}
+
+/**
+ * @brief Convert a row of matrix A to bf16, padded with zeros to an even
+ *        number of elements. Element pairs are then read as 32-bit values.
+ */
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertRowAvx512Bf16(const float* A, size_t CountK, uint16_t* D)
+{
+    size_t k = 0;
+
+    for (; k + 32 <= CountK; k += 32) {
+        const __m512 a0 = _mm512_loadu_ps(A + k);
+        const __m512 a1 = _mm512_loadu_ps(A + k + 16);
+        _mm512_storeu_si512(D + k, MlasSBGemmCastToSi512(_mm512_cvtne2ps_pbh(a1, a0)));
+    }
+
+    if (k < CountK) {
+        const size_t Remaining = CountK - k;
+        const __mmask16 Mask0 = __mmask16(Remaining >= 16 ? 0xFFFF : (1u << Remaining) - 1);
+        const __mmask16 Mask1 = __mmask16(Remaining > 16 ? (1u << (Remaining - 16)) - 1 : 0);
+        const __m512 a0 = _mm512_maskz_loadu_ps(Mask0, A + k);
+        const __m512 a1 = _mm512_maskz_loadu_ps(Mask1, A + k + 16);
+        const size_t AlignedRemaining = (Remaining + 1) & ~size_t(1);
+        const __mmask32 StoreMask = __mmask32((uint64_t(1) << AlignedRemaining) - 1);
+        _mm512_mask_storeu_epi16(D + k, StoreMask, MlasSBGemmCastToSi512(_mm512_cvtne2ps_pbh(a1, a0)));
+    }
+}
+
+/**
+ * @brief Compute RowCount rows of PanelCount 16 column panels of matrix C.
+ *
+ * @tparam RowCount    # of rows to process, 1 to 4
+ * @tparam PanelCount  # of panels to process
+ * @param A            Rows of matrix A as bf16 pairs
+ * @param lda          Leading dimension of A, in pairs
+ * @param B            Address of the first packed panel of matrix B
+ * @param PanelStride  Distance between the packed panels of B, in pairs
+ * @param C            Address of matrix C
+ * @param ldc          Leading dimension of C
+ * @param CountPairs   # of row pairs of B
+ * @param CountN       # of columns to store, up to 16 * PanelCount
+ * @param Bias         Address of the bias of the panels, or nullptr
+ * @param ZeroMode     Whether to overwrite C instead of accumulating onto it
+ */
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelAvx512Bf16Panels(
+    const uint32_t* A,
+    size_t lda,
+    const uint32_t* B,
+    size_t PanelStride,
+    float* C,
+    size_t ldc,
+    size_t CountPairs,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    MlasUnrolledLoop<RowCount>([&](size_t r) {
+        MlasUnrolledLoop<PanelCount>([&](size_t p) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        });
+    });
+
+    for (size_t k = 0; k < CountPairs; k++) {
+        __m512i BPairs[PanelCount];
+        MlasUnrolledLoop<PanelCount>([&](size_t p) {
+            BPairs[p] = _mm512_loadu_si512(B + p * PanelStride + k * 16);
+        });
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            const __m512i APair = _mm512_set1_epi32(int32_t(A[r * lda + k]));
+            MlasUnrolledLoop<PanelCount>([&](size_t p) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(
+                    Accumulators[r][p], MlasSBGemmCastToBh512(APair), MlasSBGemmCastToBh512(BPairs[p])
+                );
+            });
+        });
+    }
+
+    MlasUnrolledLoop<PanelCount>([&](size_t p) {
+        const size_t n = p * 16;
+        const size_t Count = std::min(CountN - n, size_t(16));
+        const __mmask16 Mask = __mmask16(Count == 16 ? 0xFFFF : (1u << Count) - 1);
+
+        __m512 BiasVector = _mm512_setzero_ps();
+        if (Bias != nullptr) {
+            BiasVector = _mm512_maskz_loadu_ps(Mask, Bias + n);
+        }
+
+        MlasUnrolledLoop<RowCount>([&](size_t r) {
+            float* c = C + r * ldc + n;
+            __m512 Result = Accumulators[r][p];
+            if (ZeroMode) {
+                Result = _mm512_add_ps(Result, BiasVector);
+            } else {
+                Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+            }
+            _mm512_mask_storeu_ps(c, Mask, Result);
+        });
+    });
+}
+
+template <size_t RowCount>
+void
+MlasSBGemmKernelAvx512Bf16Rows(
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    MLAS_DECLSPEC_ALIGN(uint16_t APairs[RowCount][MlasSBGemmAvx512Bf16MaxK], 64);
+
+    for (size_t r = 0; r < RowCount; r++) {
+        MlasSBGemmConvertRowAvx512Bf16(A + r * lda, CountK, APairs[r]);
+    }
+
+    const size_t CountPairs = (CountK + 1) / 2;
+    const size_t PanelStride = 16 * CountPairs;
+    const uint32_t* a = reinterpret_cast<const uint32_t*>(APairs);
+    const uint32_t* b = reinterpret_cast<const uint32_t*>(B);
+    constexpr size_t ldaPairs = MlasSBGemmAvx512Bf16MaxK / 2;
+
+    size_t n = 0;
+
+    for (; n + 64 <= CountN; n += 64) {
+        MlasSBGemmKernelAvx512Bf16Panels<RowCount, 4>(
+            a, ldaPairs, b, PanelStride, C + n, ldc, CountPairs, 64,
+            Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+        b += 4 * PanelStride;
+    }
+
+    for (; n < CountN; n += 16) {
+        MlasSBGemmKernelAvx512Bf16Panels<RowCount, 1>(
+            a, ldaPairs, b, PanelStride, C + n, ldc, CountPairs, std::min(CountN - n, size_t(16)),
+            Bias == nullptr ? nullptr : Bias + n, ZeroMode
+        );
+        b += PanelStride;
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    assert(CountK <= MlasSBGemmAvx512Bf16MaxK);
+
+    while (CountM > 0) {
+        size_t RowsHandled;
+        if (CountM >= 4) {
+            MlasSBGemmKernelAvx512Bf16Rows<4>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 4;
+        } else if (CountM == 3) {
+            MlasSBGemmKernelAvx512Bf16Rows<3>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 3;
+        } else if (CountM == 2) {
+            MlasSBGemmKernelAvx512Bf16Rows<2>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 2;
+        } else {
+            MlasSBGemmKernelAvx512Bf16Rows<1>(CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+            RowsHandled = 1;
+        }
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0
+};
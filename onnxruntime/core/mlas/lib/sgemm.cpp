@@ -1003,6 +1003,108 @@ Return Value:
 
 #endif
 
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue to a block of the output matrix.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue parameters.
+
+    C - Supplies the address of the block of matrix C.
+
+    StartM - Supplies the row of the block relative to the epilogue.
+
+    StartN - Supplies the column of the block relative to the epilogue.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* Scale = (Epilogue->Scale != nullptr) ? Epilogue->Scale + StartN : nullptr;
+    const float* Bias = (Epilogue->Bias != nullptr) ? Epilogue->Bias + StartN : nullptr;
+    const float* Addend = (Epilogue->Addend != nullptr) ?
+        Epilogue->Addend + StartM * Epilogue->ldAddend + StartN : nullptr;
+
+    if (Scale != nullptr || Bias != nullptr || Addend != nullptr) {
+
+        float* c = C;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(c + n);
+
+                if (Scale != nullptr) {
+                    Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Scale + n));
+                }
+
+                if (Bias != nullptr) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+                }
+
+                if (Addend != nullptr) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Addend + n));
+                }
+
+                MlasStoreFloat32x4(c + n, Vector);
+            }
+
+            for (; n < CountN; n++) {
+
+                float Value = c[n];
+
+                if (Scale != nullptr) {
+                    Value *= Scale[n];
+                }
+
+                if (Bias != nullptr) {
+                    Value += Bias[n];
+                }
+
+                if (Addend != nullptr) {
+                    Value += Addend[n];
+                }
+
+                c[n] = Value;
+            }
+
+            c += ldc;
+
+            if (Addend != nullptr) {
+                Addend += Epilogue->ldAddend;
+            }
+        }
+    }
+
+    if (Epilogue->Activation.ActivationKind != MlasIdentityActivation) {
+        MlasActivation(&Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+    }
+}
+
 MLAS_FORCEINLINE
 float*
 MlasSgemmKernelLoop(
@@ -1015,7 +1117,10 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr,
+    size_t StartM = 0,
+    size_t StartN = 0
     )
 /*++
 
@@ -1051,6 +1156,14 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    Epilogue - Optionally supplies the epilogue to apply to the rows of the
+        output matrix as they are completed. This is only supplied for the
+        last slice along the K dimension.
+
+    StartM - Supplies the row of matrix C relative to the epilogue.
+
+    StartN - Supplies the column of matrix C relative to the epilogue.
+
 Return Value:
 
     Returns the next address of matrix C.
@@ -1071,6 +1184,15 @@ Return Value:
         }
 #endif
 
+        //
+        // Apply the epilogue while the rows are still resident in the cache.
+        //
+
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, StartM, StartN, RowsHandled, CountN, ldc);
+            StartM += RowsHandled;
+        }
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
@@ -1093,7 +1215,9 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning
     )
 /*++
 
@@ -1131,6 +1255,10 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the epilogue to apply to matrix C.
+
+    Tuning - Optionally supplies the tuning parameters.
+
 Return Value:
 
     None.
@@ -1147,6 +1275,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, 0, 0, M, N, ldc);
+        }
         return;
     }
 
@@ -1171,6 +1302,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, 0, M, N, ldc);
+            }
             return;
         }
 
@@ -1178,6 +1312,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, 0, M, N, ldc);
+            }
             return;
         }
 
@@ -1207,6 +1344,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, 0, M, N, ldc);
+            }
             return;
         }
 
@@ -1225,7 +1365,23 @@ Return Value:
     size_t StrideN = MLAS_SGEMM_STRIDEN;
     size_t StrideK = MLAS_SGEMM_STRIDEK;
 
-    if (N >= K) {
+    if (Tuning != nullptr && Tuning->StrideN != 0) {
+
+        //
+        // Use the tuned N stride, rounded to the packing alignment, and size
+        // the K stride to fill the B panel. The A panel limits the K stride
+        // if matrix A is transposed.
+        //
+
+        StrideN = std::min(std::max(Tuning->StrideN & ~size_t(15), size_t(16)),
+            size_t(MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK) / 16);
+        StrideK = (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK) / StrideN;
+
+        if (TransA != CblasNoTrans) {
+            StrideK = std::min(StrideK, size_t(MLAS_SGEMM_STRIDEK));
+        }
+
+    } else if (N >= K) {
 
         while (StrideK / 2 >= K) {
             StrideN *= 2;
@@ -1269,6 +1425,8 @@ Return Value:
 
             CountK = std::min(K - k, StrideK);
 
+            const MLAS_SGEMM_EPILOGUE* SliceEpilogue = (k + CountK == K) ? Epilogue : nullptr;
+
             //
             // Copy or transpose a panel of matrix B to a local packed buffer.
             //
@@ -1287,7 +1445,8 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    SliceEpilogue, 0, n);
 
             } else {
 
@@ -1301,6 +1460,7 @@ Return Value:
                     //
 
                     size_t RowsTransposed = std::min(RowsRemaining, size_t(MLAS_SGEMM_TRANSA_ROWS));
+                    size_t StartM = M - RowsRemaining;
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
@@ -1311,7 +1471,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        SliceEpilogue, StartM, n);
                 }
             }
 
@@ -1334,7 +1495,9 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    const MLAS_SGEMM_TUNING_PARAMS* Tuning
     )
 /*++
 
@@ -1374,6 +1537,10 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the epilogue to apply to matrix C.
+
+    Tuning - Optionally supplies the tuning parameters.
+
 Return Value:
 
     None.
@@ -1382,6 +1549,17 @@ Return Value:
 {
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
+    //
+    // The packed K stride is fixed by the layout of packed matrix B, while
+    // the N stride only needs to preserve the packing alignment.
+    //
+
+    size_t StrideN = MLAS_SGEMM_PACKED_STRIDEN;
+
+    if (Tuning != nullptr && Tuning->StrideN != 0) {
+        StrideN = std::max(Tuning->StrideN & ~size_t(15), size_t(16));
+    }
+
     //
     // Step through each slice of matrix B along the N dimension.
     //
@@ -1392,7 +1570,7 @@ Return Value:
 
         const size_t SliceStartN = RangeStartN + n;
 
-        CountN = std::min(RangeCountN - n, size_t(MLAS_SGEMM_PACKED_STRIDEN));
+        CountN = std::min(RangeCountN - n, StrideN);
 
         //
         // Multiply the output matrix by beta as needed.
@@ -1413,6 +1591,8 @@ Return Value:
 
             CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
 
+            const MLAS_SGEMM_EPILOGUE* SliceEpilogue = (k + CountK == K) ? Epilogue : nullptr;
+
             //
             // Step through each slice of matrix A along the M dimension.
             //
@@ -1422,7 +1602,8 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    SliceEpilogue, 0, n);
 
             } else {
 
@@ -1436,6 +1617,7 @@ Return Value:
                     //
 
                     size_t RowsTransposed = std::min(RowsRemaining, size_t(MLAS_SGEMM_TRANSA_ROWS));
+                    size_t StartM = M - RowsRemaining;
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
@@ -1446,7 +1628,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        SliceEpilogue, StartM, n);
                 }
             }
 
@@ -1538,11 +1721,38 @@ Return Value:
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    //
+    // Offset the epilogue to the partitioned block of the output matrix.
+    //
+
+    MLAS_SGEMM_EPILOGUE PartitionEpilogue;
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr;
+
+    if (DataParams->Epilogue != nullptr) {
+
+        PartitionEpilogue = *DataParams->Epilogue;
+
+        if (PartitionEpilogue.Scale != nullptr) {
+            PartitionEpilogue.Scale += RangeStartN;
+        }
+
+        if (PartitionEpilogue.Bias != nullptr) {
+            PartitionEpilogue.Bias += RangeStartN;
+        }
+
+        if (PartitionEpilogue.Addend != nullptr) {
+            PartitionEpilogue.Addend += RangeStartM * PartitionEpilogue.ldAddend + RangeStartN;
+        }
+
+        Epilogue = &PartitionEpilogue;
+    }
+
     if (DataParams->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc, Epilogue,
+            DataParams->Tuning);
 
     } else {
 
@@ -1551,7 +1761,8 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, Epilogue,
+            DataParams->Tuning);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1580,7 +1791,13 @@ MlasGemmBatch(
 
     const double Complexity = double(M) * double(N) * double(K);
 
-    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    size_t ThreadComplexity = MLAS_SGEMM_THREAD_COMPLEXITY;
+
+    if (Data->Tuning != nullptr && Data->Tuning->ThreadComplexity != 0) {
+        ThreadComplexity = Data->Tuning->ThreadComplexity;
+    }
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(ThreadComplexity)) + 1;
     ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
 
     if (TargetThreadCount >= MaximumThreadCount) {
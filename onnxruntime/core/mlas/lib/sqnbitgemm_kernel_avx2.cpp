@@ -17,6 +17,7 @@ Abstract:
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <utility>
 
 #include "qnbitgemm.h"
@@ -1436,6 +1437,519 @@ SQ8BitGemmPackQuantBDataAndBlkSum(
         HasZeroPoint, QuantBZPBegin, PackedQuantB, ThreadPool);
 }
 
+//
+// 2-bit and 3-bit B dequantization for the SQNBIT_CompFp32 Sgemm path.
+//
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE uint32_t
+LoadLowBitGroup(const std::byte* Data)
+{
+    // A group of 8 values is 2 or 3 whole bytes.
+    uint32_t Group = std::to_integer<uint32_t>(Data[0]) | (std::to_integer<uint32_t>(Data[1]) << 8);
+    if constexpr (BlkBitWidth == 3) {
+        Group |= std::to_integer<uint32_t>(Data[2]) << 16;
+    }
+    return Group;
+}
+
+/**
+ * @brief Load the zero point of block BlkIndex from the LSB first bit stream of the zero points of a column.
+ */
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE uint32_t
+LoadLowBitZeroPoint(const std::byte* ZeroPoint, size_t BlkIndex)
+{
+    const size_t Bit = BlkIndex * BlkBitWidth;
+    uint32_t Bits = std::to_integer<uint32_t>(ZeroPoint[Bit / 8]);
+    if (Bit % 8 + BlkBitWidth > 8) {
+        Bits |= std::to_integer<uint32_t>(ZeroPoint[Bit / 8 + 1]) << 8;
+    }
+    return (Bits >> (Bit % 8)) & ((1u << BlkBitWidth) - 1);
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitBlkDequantBForSgemm_CompFp32_avx2_Impl(
+    const size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    const size_t CountN,
+    const size_t CountK,
+    const size_t BlockCountK
+)
+{
+    constexpr size_t GroupLen = 8;
+    constexpr size_t GroupBytes = GroupLen * BlkBitWidth / 8;
+    constexpr uint32_t DefaultZeroPoint = 1u << (BlkBitWidth - 1);
+
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBData = BlockCountK * BlkDataSize;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    // Stands in for the data of the padding columns of a partial panel.
+    static const std::byte ZeroBlkData[256 * 3 / 8] = {};
+    assert(BlkDataSize <= sizeof(ZeroBlkData));
+
+    const __m256i ValueMask = _mm256_set1_epi32((1 << BlkBitWidth) - 1);
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t CountNN = std::min(CountN - n, size_t{16});
+        float* Dst = FpData + n * CountK;
+
+        for (size_t k = 0, k_blk = 0; k < CountK; k += BlkLen, k_blk++) {
+            const size_t kklen = std::min(CountK - k, BlkLen);
+
+            //
+            // Each half of the 16 column panel is decoded 8 columns wide: a
+            // group of 8 values of every column is loaded into a lane, and
+            // row kk of the group is the kk-th field of each lane.
+            //
+            for (size_t half = 0; half < 16; half += 8) {
+                MLAS_DECLSPEC_ALIGN(float Scale[8], 32);
+                MLAS_DECLSPEC_ALIGN(float NegZeroPointScale[8], 32);
+                const std::byte* ColData[8];
+
+                for (size_t c = 0; c < 8; c++) {
+                    const size_t nn = half + c;
+                    if (nn < CountNN) {
+                        const uint32_t zp =
+                            (QuantBZeroPoint == nullptr)
+                                ? DefaultZeroPoint
+                                : LoadLowBitZeroPoint<BlkBitWidth>(
+                                      QuantBZeroPoint + (n + nn) * StrideQuantBZeroPoint, k_blk
+                                  );
+                        Scale[c] = QuantBScale[(n + nn) * BlockCountK + k_blk];
+                        NegZeroPointScale[c] = -static_cast<float>(zp) * Scale[c];
+                        ColData[c] = QuantBData + (n + nn) * StrideQuantBData + k_blk * BlkDataSize;
+                    } else {
+                        Scale[c] = 0.0f;
+                        NegZeroPointScale[c] = 0.0f;
+                        ColData[c] = ZeroBlkData;
+                    }
+                }
+
+                const __m256 ScaleV = _mm256_load_ps(Scale);
+                const __m256 NegZeroPointScaleV = _mm256_load_ps(NegZeroPointScale);
+
+                for (size_t kk = 0; kk < kklen; kk += GroupLen) {
+                    const size_t GroupOffset = (kk / GroupLen) * GroupBytes;
+                    const __m256i Groups = _mm256_setr_epi32(
+                        LoadLowBitGroup<BlkBitWidth>(ColData[0] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[1] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[2] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[3] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[4] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[5] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[6] + GroupOffset),
+                        LoadLowBitGroup<BlkBitWidth>(ColData[7] + GroupOffset)
+                    );
+
+                    const size_t Rows = std::min(kklen - kk, GroupLen);
+                    float* DstRow = Dst + (k + kk) * 16 + half;
+                    for (size_t r = 0; r < Rows; r++) {
+                        const __m128i Shift = _mm_cvtsi32_si128(static_cast<int>(r * BlkBitWidth));
+                        const __m256i Values = _mm256_and_si256(_mm256_srl_epi32(Groups, Shift), ValueMask);
+                        const __m256 FpValues = _mm256_fmadd_ps(_mm256_cvtepi32_ps(Values), ScaleV, NegZeroPointScaleV);
+                        _mm256_storeu_ps(DstRow, FpValues);
+                        DstRow += 16;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+SQLowBitBlkDequantBForSgemm_CompFp32_avx2(
+    const size_t BlkBitWidth,
+    const size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    const size_t CountN,
+    const size_t CountK,
+    const size_t BlockStrideQuantB
+)
+{
+    if (BlkBitWidth == 2) {
+        SQLowBitBlkDequantBForSgemm_CompFp32_avx2_Impl<2>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockStrideQuantB
+        );
+    } else {
+        assert(BlkBitWidth == 3);
+        SQLowBitBlkDequantBForSgemm_CompFp32_avx2_Impl<3>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockStrideQuantB
+        );
+    }
+}
+
+//
+// 2-bit and 3-bit B GEMV for the SQNBIT_CompFp32 path, used for M <= QNBitGemmGemvMaxM.
+//
+// K is processed in chunks of 64 values. Lane i of a B vector holds the 8 values of group i of the chunk, an
+// 8 * BlkBitWidth bit field in the low bits of the 32-bit lane, so value s of every group is isolated with one mask
+// and converted in place as q << (s * BlkBitWidth). A is transposed to the same layout once per call and scaled by 2^-(s * BlkBitWidth),
+// which keeps each product equal to q * a. The zero points are subtracted per group with the sums of A.
+//
+
+constexpr size_t LowBitGemvChunkLen = 64;
+
+// Floats per chunk of the transposed A: value s of each of the 8 groups for s = 0..7, then the sum of each group.
+constexpr size_t LowBitGemvChunkStride = 9 * 8;
+
+template <size_t BlkBitWidth>
+void
+TransposeALowBitGemv_avx2(const float* A, size_t CountK, float* ATrans)
+{
+    for (size_t k = 0; k < CountK; k += LowBitGemvChunkLen, ATrans += LowBitGemvChunkStride) {
+        __m256 v[8];
+        if (CountK - k >= LowBitGemvChunkLen) {
+            UnrolledLoop<8>([&](size_t i) {
+                v[i] = _mm256_loadu_ps(A + k + i * 8);
+            });
+        } else {
+            const int ck = static_cast<int>(CountK - k);
+            UnrolledLoop<8>([&](size_t i) {
+                v[i] = load_float_n_avx2(A + k + i * 8, std::min(ck - static_cast<int>(i * 8), 8));
+            });
+        }
+
+        const __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]);
+        const __m256 t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        const __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]);
+        const __m256 t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        const __m256 t4 = _mm256_unpacklo_ps(v[4], v[5]);
+        const __m256 t5 = _mm256_unpackhi_ps(v[4], v[5]);
+        const __m256 t6 = _mm256_unpacklo_ps(v[6], v[7]);
+        const __m256 t7 = _mm256_unpackhi_ps(v[6], v[7]);
+
+        const __m256 u0 = _mm256_shuffle_ps(t0, t2, 0x44);
+        const __m256 u1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+        const __m256 u2 = _mm256_shuffle_ps(t1, t3, 0x44);
+        const __m256 u3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+        const __m256 u4 = _mm256_shuffle_ps(t4, t6, 0x44);
+        const __m256 u5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+        const __m256 u6 = _mm256_shuffle_ps(t5, t7, 0x44);
+        const __m256 u7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+
+        // lane i of r[s] is value s of group i
+        __m256 r[8];
+        r[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+        r[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+        r[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+        r[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+        r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+        r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+        r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+        r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+
+        __m256 sum = _mm256_setzero_ps();
+        UnrolledLoop<8>([&](size_t s) {
+            sum = _mm256_add_ps(sum, r[s]);
+            const __m256 s_scale = _mm256_set1_ps(1.0f / static_cast<float>(1u << (s * BlkBitWidth)));
+            _mm256_storeu_ps(ATrans + s * 8, _mm256_mul_ps(r[s], s_scale));
+        });
+        _mm256_storeu_ps(ATrans + 64, sum);
+    }
+}
+
+/**
+ * @brief Load a chunk of 64 values of an LSB first bit stream with group i of 8 values in lane i.
+ *        Only the 8 * BlkBitWidth bytes of the chunk are read.
+ */
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE __m256i
+LoadLowBitChunk(const std::byte* Data)
+{
+    static_assert(BlkBitWidth == 2 || BlkBitWidth == 3);
+
+    if constexpr (BlkBitWidth == 2) {
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data)));
+    } else {
+        // bytes 0-15 hold groups 0-3 and bytes 8-23 hold groups 4-7
+        const __m256i bytes = _mm256_set_m128i(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 8)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data))
+        );
+        const __m256i shuffle = _mm256_setr_epi8(
+            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+            4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15, -1
+        );
+        return _mm256_shuffle_epi8(bytes, shuffle);
+    }
+}
+
+template <size_t BlkBitWidth, size_t NCols, bool HasZeroPoint>
+MLAS_FORCEINLINE void
+ComputeDotProducts_LowBit_CompFp32_avx2(
+    size_t BlkLen,
+    const float* ATrans,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const std::byte* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    constexpr size_t ChunkBytes = LowBitGemvChunkLen * BlkBitWidth / 8;
+    constexpr float DefaultZeroPoint = static_cast<float>(1 << (BlkBitWidth - 1));
+
+    // Blocks of a chunk when BlkLen is less than the chunk, and the block of each group in the chunk.
+    const size_t ChunkBlks = LowBitGemvChunkLen / std::min(BlkLen, LowBitGemvChunkLen);
+    const __m256i GroupBlk = _mm256_setr_epi32(
+        0, static_cast<int>(8 / BlkLen), static_cast<int>(16 / BlkLen), static_cast<int>(24 / BlkLen),
+        static_cast<int>(32 / BlkLen), static_cast<int>(40 / BlkLen), static_cast<int>(48 / BlkLen),
+        static_cast<int>(56 / BlkLen)
+    );
+
+    __m256 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) {
+        acc[i] = _mm256_setzero_ps();
+    });
+
+    const size_t ColBytes = StrideQuantBData;
+
+    for (size_t k = 0; k < CountK; k += LowBitGemvChunkLen, ATrans += LowBitGemvChunkStride) {
+        const size_t ChunkOffset = k / LowBitGemvChunkLen * ChunkBytes;
+
+        __m256i bv[NCols];
+        UnrolledLoop<NCols>([&](size_t i) {
+            const std::byte* b_chunk_ptr = QuantBDataColPtr + i * StrideQuantBData + ChunkOffset;
+            if (ChunkOffset + ChunkBytes <= ColBytes) {
+                bv[i] = LoadLowBitChunk<BlkBitWidth>(b_chunk_ptr);
+            } else {
+                // the last chunk of a column with fewer blocks than a chunk holds
+                std::byte buf[ChunkBytes] = {};
+                std::memcpy(buf, b_chunk_ptr, ColBytes - ChunkOffset);
+                bv[i] = LoadLowBitChunk<BlkBitWidth>(buf);
+            }
+        });
+
+        __m256 dot0[NCols];
+        __m256 dot1[NCols];
+        UnrolledLoop<NCols>([&](size_t i) {
+            dot0[i] = _mm256_setzero_ps();
+            dot1[i] = _mm256_setzero_ps();
+        });
+
+        UnrolledLoop<8>([&](size_t s) {
+            const __m256 av_8_ps = _mm256_loadu_ps(ATrans + s * 8);
+            const __m256i mask = _mm256_set1_epi32(((1 << BlkBitWidth) - 1) << (s * BlkBitWidth));
+            UnrolledLoop<NCols>([&](size_t i) {
+                const __m256 bv_8_ps = _mm256_cvtepi32_ps(_mm256_and_si256(bv[i], mask));
+                if (s % 2 == 0) {
+                    dot0[i] = _mm256_fmadd_ps(bv_8_ps, av_8_ps, dot0[i]);
+                } else {
+                    dot1[i] = _mm256_fmadd_ps(bv_8_ps, av_8_ps, dot1[i]);
+                }
+            });
+        });
+
+        const __m256 asum_8_ps = _mm256_loadu_ps(ATrans + 64);
+        const size_t k_blk = k / BlkLen;
+
+        UnrolledLoop<NCols>([&](size_t i) {
+            const float* scale_ptr = QuantBScaleColPtr + i * StrideQuantBScale + k_blk;
+
+            __m256 scale_8_ps;
+            __m256 zp_8_ps;
+            if (ChunkBlks == 1) {
+                scale_8_ps = _mm256_set1_ps(*scale_ptr);
+                float ZeroPoint = DefaultZeroPoint;
+                if constexpr (HasZeroPoint) {
+                    ZeroPoint = static_cast<float>(
+                        LoadLowBitZeroPoint<BlkBitWidth>(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk)
+                    );
+                }
+                zp_8_ps = _mm256_set1_ps(ZeroPoint);
+            } else {
+                // Blocks past BlockCountK only meet groups past CountK, where A and its sums are zero.
+                const size_t blks = std::min(ChunkBlks, BlockCountK - k_blk);
+                __m256 scales;
+                if (blks == 4) {
+                    scales = _mm256_castps128_ps256(_mm_loadu_ps(scale_ptr));
+                } else if (blks == 2) {
+                    scales = _mm256_castps128_ps256(
+                        _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(scale_ptr)))
+                    );
+                } else {
+                    scales = load_float_n_avx2(scale_ptr, static_cast<int>(blks));
+                }
+                scale_8_ps = _mm256_permutevar8x32_ps(scales, GroupBlk);
+                if constexpr (HasZeroPoint) {
+                    float ZeroPoints[4] = {};
+                    for (size_t j = 0; j < blks; j++) {
+                        ZeroPoints[j] = static_cast<float>(LoadLowBitZeroPoint<BlkBitWidth>(
+                            QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk + j
+                        ));
+                    }
+                    zp_8_ps = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(ZeroPoints)), GroupBlk);
+                } else {
+                    zp_8_ps = _mm256_set1_ps(DefaultZeroPoint);
+                }
+            }
+
+            const __m256 dot_8_ps = _mm256_fnmadd_ps(zp_8_ps, asum_8_ps, _mm256_add_ps(dot0[i], dot1[i]));
+            acc[i] = _mm256_fmadd_ps(dot_8_ps, scale_8_ps, acc[i]);
+        });
+    }
+
+    if constexpr (NCols == 4) {
+        __m128 acc_x = FoldAccumulators(acc[0], acc[1], acc[2], acc[3]);
+        if (BiasPtr != nullptr) {
+            acc_x = _mm_add_ps(acc_x, _mm_loadu_ps(BiasPtr));
+        }
+        _mm_storeu_ps(SumPtr, acc_x);
+    } else {
+        UnrolledLoop<NCols>([&](size_t i) {
+            SumPtr[i] = hsum_float_8(acc[i]) + (BiasPtr == nullptr ? 0.0f : BiasPtr[i]);
+        });
+    }
+}
+
+template <size_t BlkBitWidth, bool HasZeroPoint>
+void
+SQLowBitGemmM1Kernel_CompFp32_avx2_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    constexpr size_t NCols4 = 4;
+
+    const size_t BlockCountK = BlockStrideQuantB;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    MlasThreadedBufAlloc(MlasDivRoundup(CountK, LowBitGemvChunkLen) * LowBitGemvChunkStride * sizeof(float));
+    float* ATrans = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    TransposeALowBitGemv_avx2<BlkBitWidth>(A, CountK, ATrans);
+
+    const float* BiasPtr = Bias;
+
+    const std::byte* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols4;
+    while (nblk >= 0) {
+        ComputeDotProducts_LowBit_CompFp32_avx2<BlkBitWidth, NCols4, HasZeroPoint>(
+            BlkLen,
+            ATrans, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK, BlockCountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols4 * StrideQuantBData;
+        QuantBScaleColPtr += NCols4 * StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += NCols4 * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols4 : 0;
+        SumPtr += NCols4;
+
+        nblk -= NCols4;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols4;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProducts_LowBit_CompFp32_avx2<BlkBitWidth, 1, HasZeroPoint>(
+            BlkLen,
+            ATrans, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK, BlockCountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemmM1Kernel_CompFp32_avx2_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    if (QuantBZeroPoint != nullptr) {
+        SQLowBitGemmM1Kernel_CompFp32_avx2_Impl<BlkBitWidth, true>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockStrideQuantB, Bias
+        );
+    } else {
+        SQLowBitGemmM1Kernel_CompFp32_avx2_Impl<BlkBitWidth, false>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockStrideQuantB, Bias
+        );
+    }
+}
+
+void
+SQLowBitGemmM1Kernel_CompFp32_avx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    if (BlkBitWidth == 2) {
+        SQLowBitGemmM1Kernel_CompFp32_avx2_Impl<2>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockStrideQuantB, Bias
+        );
+    } else {
+        assert(BlkBitWidth == 3);
+        SQLowBitGemmM1Kernel_CompFp32_avx2_Impl<3>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockStrideQuantB, Bias
+        );
+    }
+}
+
 //
 // Kernel dispatch structure definition.
 //
@@ -1453,6 +1967,8 @@ const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx2 = []() {
 
     d.SQ4BitGemmM1Kernel_CompFp32 = SQ4BitGemmM1Kernel_CompFp32_avx2;
     d.SQ4BitBlkDequantBForSgemm_CompFp32 = Q4BitBlkDequantBForSgemm_CompFp32_avx2;
+    d.SQLowBitGemmM1Kernel_CompFp32 = SQLowBitGemmM1Kernel_CompFp32_avx2;
+    d.SQLowBitBlkDequantBForSgemm_CompFp32 = SQLowBitBlkDequantBForSgemm_CompFp32_avx2;
 
     d.SQ4BitGemmKernel_BlkSum_CompInt8 = SQ4BitGemmKernel_BlkSum_CompInt8_avx2;
     d.SQ8BitGemmKernel_BlkSum_CompInt8 = SQ8BitGemmKernel_BlkSum_CompInt8_avx2<false>;
@@ -1475,6 +1991,8 @@ const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx2vnni = []() {
 
     d.SQ4BitGemmM1Kernel_CompFp32 = SQ4BitGemmM1Kernel_CompFp32_avx2;
     d.SQ4BitBlkDequantBForSgemm_CompFp32 = Q4BitBlkDequantBForSgemm_CompFp32_avx2;
+    d.SQLowBitGemmM1Kernel_CompFp32 = SQLowBitGemmM1Kernel_CompFp32_avx2;
+    d.SQLowBitBlkDequantBForSgemm_CompFp32 = SQLowBitBlkDequantBForSgemm_CompFp32_avx2;
 
     d.SQ4BitGemmKernel_BlkSum_CompInt8 = SQ4BitGemmKernel_BlkSum_CompInt8_avx2vnni;
     d.SQ8BitGemmKernel_BlkSum_CompInt8 = SQ8BitGemmKernel_BlkSum_CompInt8_avx2<true>;
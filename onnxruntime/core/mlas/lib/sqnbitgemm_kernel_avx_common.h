@@ -518,6 +518,34 @@ Q4BitBlkDequantBForSgemm_CompFp32_avx2(
     const size_t BlockStrideQuantB
 );
 
+void
+SQLowBitGemmM1Kernel_CompFp32_avx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+);
+
+void
+SQLowBitBlkDequantBForSgemm_CompFp32_avx2(
+    const size_t BlkBitWidth,
+    const size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    const size_t CountN,
+    const size_t CountK,
+    const size_t BlockStrideQuantB
+);
+
 size_t
 SQ4BitGemmKernel_CompInt8_avx2(
     size_t BlkLen,
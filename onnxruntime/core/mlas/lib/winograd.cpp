@@ -0,0 +1,1017 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(4x4, 3x3) convolution algorithm for
+    3x3 convolutions with unit strides and dilations.
+
+    The input image is split into 6x6 tiles that overlap by two pixels, each
+    producing a 4x4 tile of the output image. For a filter g and an input tile
+    d, the output tile is:
+
+        Y = AT * [(G * g * GT) . (BT * d * B)] * A
+
+    where . is the element-wise product. Summed over the input channels, the
+    element-wise product becomes 36 independent matrix multiplications of the
+    transformed input tiles by the transformed filters. These execute 36
+    multiply-adds per 16 output pixels instead of the 144 of the direct
+    convolution.
+
+    The transformed filter of each of the 36 matrix multiplications is stored
+    as a packed SGEMM B matrix, so that constant filters are transformed once
+    by MlasConvPackFilter.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the dimensions of the input and output tiles.
+//
+
+constexpr size_t MLAS_WINOGRAD_INPUT_TILE = 6;
+constexpr size_t MLAS_WINOGRAD_OUTPUT_TILE = 4;
+constexpr size_t MLAS_WINOGRAD_TRANSFORM_COUNT = MLAS_WINOGRAD_INPUT_TILE * MLAS_WINOGRAD_INPUT_TILE;
+
+//
+// Define the minimum number of input and output channels for the Winograd
+// algorithm. The input and output transforms cost about as much as the
+// matrix multiplications of a few dozen channels, so smaller convolutions are
+// faster with the direct algorithms.
+//
+
+constexpr size_t MLAS_WINOGRAD_MINIMUM_CHANNELS = 64;
+
+//
+// Define the number of elements of the transformed input and output tiles
+// processed at a time, which bounds the size of the working buffer.
+//
+
+constexpr size_t MLAS_WINOGRAD_TRANSFORM_BUFFER_SIZE = 1024 * 1024;
+
+//
+// Define the filter transform matrix G.
+//
+
+static const float MlasWinogradFilterTransform[MLAS_WINOGRAD_INPUT_TILE][3] = {
+    { 1.0f / 4.0f, 0.0f, 0.0f },
+    { -1.0f / 6.0f, -1.0f / 6.0f, -1.0f / 6.0f },
+    { -1.0f / 6.0f, 1.0f / 6.0f, -1.0f / 6.0f },
+    { 1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f },
+    { 1.0f / 24.0f, -1.0f / 12.0f, 1.0f / 6.0f },
+    { 0.0f, 0.0f, 1.0f },
+};
+
+//
+// Define the parameters to execute a block of tiles on worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Bias;
+    float* TransformedInput;
+    float* TransformedOutput;
+    float* Output;
+    size_t TileStart;
+    size_t TileCount;
+    ptrdiff_t ThreadCount;
+};
+
+MLAS_FORCEINLINE
+void
+MlasWinogradTransposeFloat32x4(
+    MLAS_FLOAT32X4& Vector0,
+    MLAS_FLOAT32X4& Vector1,
+    MLAS_FLOAT32X4& Vector2,
+    MLAS_FLOAT32X4& Vector3
+    )
+{
+    MLAS_FLOAT32X4 Interleave0 = MlasInterleaveLowFloat32x4(Vector0, Vector2);
+    MLAS_FLOAT32X4 Interleave1 = MlasInterleaveHighFloat32x4(Vector0, Vector2);
+    MLAS_FLOAT32X4 Interleave2 = MlasInterleaveLowFloat32x4(Vector1, Vector3);
+    MLAS_FLOAT32X4 Interleave3 = MlasInterleaveHighFloat32x4(Vector1, Vector3);
+
+    Vector0 = MlasInterleaveLowFloat32x4(Interleave0, Interleave2);
+    Vector1 = MlasInterleaveHighFloat32x4(Interleave0, Interleave2);
+    Vector2 = MlasInterleaveLowFloat32x4(Interleave1, Interleave3);
+    Vector3 = MlasInterleaveHighFloat32x4(Interleave1, Interleave3);
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradInputTransform(
+    const MLAS_FLOAT32X4 x[MLAS_WINOGRAD_INPUT_TILE],
+    MLAS_FLOAT32X4 y[MLAS_WINOGRAD_INPUT_TILE]
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a column of six vectors by the input transform
+    matrix BT.
+
+--*/
+{
+    MLAS_FLOAT32X4 p = MlasMultiplyAddFloat32x4(x[2], -4.0f, x[4]);
+    MLAS_FLOAT32X4 q = MlasMultiplyAddFloat32x4(x[1], -4.0f, x[3]);
+    MLAS_FLOAT32X4 s = MlasSubtractFloat32x4(x[4], x[2]);
+    MLAS_FLOAT32X4 u = MlasSubtractFloat32x4(x[3], x[1]);
+
+    y[0] = MlasMultiplyAddFloat32x4(x[0], 4.0f, MlasMultiplyAddFloat32x4(x[2], -5.0f, x[4]));
+    y[1] = MlasAddFloat32x4(p, q);
+    y[2] = MlasSubtractFloat32x4(p, q);
+    y[3] = MlasMultiplyAddFloat32x4(u, 2.0f, s);
+    y[4] = MlasMultiplyAddFloat32x4(u, -2.0f, s);
+    y[5] = MlasMultiplyAddFloat32x4(x[1], 4.0f, MlasMultiplyAddFloat32x4(x[3], -5.0f, x[5]));
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradOutputTransform(
+    const MLAS_FLOAT32X4 x[MLAS_WINOGRAD_INPUT_TILE],
+    MLAS_FLOAT32X4 y[MLAS_WINOGRAD_OUTPUT_TILE]
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a column of six vectors by the output transform
+    matrix AT.
+
+--*/
+{
+    MLAS_FLOAT32X4 a = MlasAddFloat32x4(x[1], x[2]);
+    MLAS_FLOAT32X4 b = MlasSubtractFloat32x4(x[1], x[2]);
+    MLAS_FLOAT32X4 c = MlasAddFloat32x4(x[3], x[4]);
+    MLAS_FLOAT32X4 d = MlasSubtractFloat32x4(x[3], x[4]);
+
+    y[0] = MlasAddFloat32x4(MlasAddFloat32x4(x[0], a), c);
+    y[1] = MlasMultiplyAddFloat32x4(d, 2.0f, b);
+    y[2] = MlasMultiplyAddFloat32x4(c, 4.0f, a);
+    y[3] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(d, 8.0f, b), x[5]);
+}
+
+void
+MlasWinogradTransformInputTile(
+    const float* const Input[4],
+    size_t RowStride,
+    float* TransformedInput,
+    size_t MatrixStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 6x6 input tile of four channels.
+
+Arguments:
+
+    Input - Supplies the address of the tile in each of the four channels.
+
+    RowStride - Supplies the number of elements between rows of the tile.
+
+    TransformedInput - Supplies the address to store the four transformed
+        channels of the first of the 36 matrices.
+
+    MatrixStride - Supplies the number of elements between the matrices.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 RowTransform[MLAS_WINOGRAD_INPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    //
+    // Transpose each row of the tile so that a vector holds a column of the
+    // four channels, then transform the rows.
+    //
+
+    for (size_t row = 0; row < MLAS_WINOGRAD_INPUT_TILE; row++) {
+
+        const size_t offset = row * RowStride;
+
+        MLAS_FLOAT32X4 x[MLAS_WINOGRAD_INPUT_TILE];
+
+        x[0] = MlasLoadFloat32x4(Input[0] + offset);
+        x[1] = MlasLoadFloat32x4(Input[1] + offset);
+        x[2] = MlasLoadFloat32x4(Input[2] + offset);
+        x[3] = MlasLoadFloat32x4(Input[3] + offset);
+
+        MlasWinogradTransposeFloat32x4(x[0], x[1], x[2], x[3]);
+
+        MLAS_FLOAT32X4 High0 = MlasLoadFloat32x4(Input[0] + offset + 2);
+        MLAS_FLOAT32X4 High1 = MlasLoadFloat32x4(Input[1] + offset + 2);
+        MLAS_FLOAT32X4 High2 = MlasLoadFloat32x4(Input[2] + offset + 2);
+        MLAS_FLOAT32X4 High3 = MlasLoadFloat32x4(Input[3] + offset + 2);
+
+        MLAS_FLOAT32X4 Interleave0 = MlasInterleaveHighFloat32x4(High0, High2);
+        MLAS_FLOAT32X4 Interleave1 = MlasInterleaveHighFloat32x4(High1, High3);
+
+        x[4] = MlasInterleaveLowFloat32x4(Interleave0, Interleave1);
+        x[5] = MlasInterleaveHighFloat32x4(Interleave0, Interleave1);
+
+        MlasWinogradInputTransform(x, RowTransform[row]);
+    }
+
+    //
+    // Transform the columns and store the 36 elements to their matrices.
+    //
+
+    for (size_t column = 0; column < MLAS_WINOGRAD_INPUT_TILE; column++) {
+
+        MLAS_FLOAT32X4 x[MLAS_WINOGRAD_INPUT_TILE];
+        MLAS_FLOAT32X4 y[MLAS_WINOGRAD_INPUT_TILE];
+
+        for (size_t row = 0; row < MLAS_WINOGRAD_INPUT_TILE; row++) {
+            x[row] = RowTransform[row][column];
+        }
+
+        MlasWinogradInputTransform(x, y);
+
+        for (size_t row = 0; row < MLAS_WINOGRAD_INPUT_TILE; row++) {
+            MlasStoreFloat32x4(TransformedInput + (row * MLAS_WINOGRAD_INPUT_TILE + column) * MatrixStride, y[row]);
+        }
+    }
+}
+
+void
+MlasWinogradTransformOutputTile(
+    const float* TransformedOutput,
+    size_t MatrixStride,
+    MLAS_FLOAT32X4 BiasVector,
+    MLAS_FLOAT32X4 Output[4][MLAS_WINOGRAD_OUTPUT_TILE]
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the matrix multiplication results of a tile to a
+    4x4 output tile of four filters.
+
+Arguments:
+
+    TransformedOutput - Supplies the address of the results of the four
+        filters in the first of the 36 matrices.
+
+    MatrixStride - Supplies the number of elements between the matrices.
+
+    BiasVector - Supplies the bias of the four filters.
+
+    Output - Receives the rows of the output tile of each filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ColumnTransform[MLAS_WINOGRAD_OUTPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    for (size_t column = 0; column < MLAS_WINOGRAD_INPUT_TILE; column++) {
+
+        MLAS_FLOAT32X4 x[MLAS_WINOGRAD_INPUT_TILE];
+        MLAS_FLOAT32X4 y[MLAS_WINOGRAD_OUTPUT_TILE];
+
+        for (size_t row = 0; row < MLAS_WINOGRAD_INPUT_TILE; row++) {
+            x[row] = MlasLoadFloat32x4(TransformedOutput + (row * MLAS_WINOGRAD_INPUT_TILE + column) * MatrixStride);
+        }
+
+        MlasWinogradOutputTransform(x, y);
+
+        for (size_t row = 0; row < MLAS_WINOGRAD_OUTPUT_TILE; row++) {
+            ColumnTransform[row][column] = y[row];
+        }
+    }
+
+    //
+    // Transform the rows and transpose each row of the four filters back to
+    // a vector per filter.
+    //
+
+    for (size_t row = 0; row < MLAS_WINOGRAD_OUTPUT_TILE; row++) {
+
+        MLAS_FLOAT32X4 y[MLAS_WINOGRAD_OUTPUT_TILE];
+
+        MlasWinogradOutputTransform(ColumnTransform[row], y);
+
+        y[0] = MlasAddFloat32x4(y[0], BiasVector);
+        y[1] = MlasAddFloat32x4(y[1], BiasVector);
+        y[2] = MlasAddFloat32x4(y[2], BiasVector);
+        y[3] = MlasAddFloat32x4(y[3], BiasVector);
+
+        MlasWinogradTransposeFloat32x4(y[0], y[1], y[2], y[3]);
+
+        Output[0][row] = y[0];
+        Output[1][row] = y[1];
+        Output[2][row] = y[2];
+        Output[3][row] = y[3];
+    }
+}
+
+void
+MlasWinogradTransformFilter(
+    const float* Filter,
+    size_t FilterCount,
+    size_t InputChannels,
+    size_t Index,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one of the 36 matrices of the transformed filter,
+    G * g * GT, as a FilterCount x InputChannels matrix.
+
+Arguments:
+
+    Filter - Supplies the filter tensor in OIHW format.
+
+    FilterCount - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels.
+
+    Index - Supplies the index of the element of the 6x6 transformed filter.
+
+    TransformedFilter - Supplies the buffer to receive the matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* RowCoefficients = MlasWinogradFilterTransform[Index / MLAS_WINOGRAD_INPUT_TILE];
+    const float* ColumnCoefficients = MlasWinogradFilterTransform[Index % MLAS_WINOGRAD_INPUT_TILE];
+
+    float Coefficients[9];
+
+    for (size_t ky = 0; ky < 3; ky++) {
+        for (size_t kx = 0; kx < 3; kx++) {
+            Coefficients[ky * 3 + kx] = RowCoefficients[ky] * ColumnCoefficients[kx];
+        }
+    }
+
+    const size_t ElementCount = FilterCount * InputChannels;
+
+    for (size_t i = 0; i < ElementCount; i++) {
+
+        float Accumulator = 0.0f;
+
+        for (size_t k = 0; k < 9; k++) {
+            Accumulator += Coefficients[k] * Filter[k];
+        }
+
+        TransformedFilter[i] = Accumulator;
+        Filter += 9;
+    }
+}
+
+void
+MlasConvWinogradTransformInputThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to transform the input tiles
+    of a range of channels.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<const MLAS_CONV_WINOGRAD_WORK_BLOCK*>(Context);
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t TileCountW = MlasDivRoundup(Parameters->OutputShape[1], MLAS_WINOGRAD_OUTPUT_TILE);
+    const size_t TileCount = WorkBlock->TileCount;
+    const size_t MatrixStride = TileCount * InputChannels;
+
+    size_t ChannelGroupStart;
+    size_t ChannelGroupCount;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, MlasDivRoundup(InputChannels, 4),
+        &ChannelGroupStart, &ChannelGroupCount);
+
+    //
+    // Tiles that cross the padding, as well as the last channels when the
+    // channel count is not a multiple of four, are copied to a zero padded
+    // buffer.
+    //
+
+    float TileBuffer[4][MLAS_WINOGRAD_TRANSFORM_COUNT];
+    float TransformedBuffer[MLAS_WINOGRAD_TRANSFORM_COUNT * 4];
+
+    //
+    // Iterate over the tiles in the outer loop so that the transformed values
+    // of consecutive channels are stored to the same cache lines.
+    //
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t tile = WorkBlock->TileStart + t;
+        const size_t ih = (tile / TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE - Parameters->Padding[0];
+        const size_t iw = (tile % TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE - Parameters->Padding[1];
+
+        //
+        // N.B. The coordinates of the padding wrap around to large unsigned
+        // values, so a single comparison rejects both edges.
+        //
+
+        const bool TileIsInterior = ih < InputHeight && InputHeight - ih >= MLAS_WINOGRAD_INPUT_TILE &&
+            iw < InputWidth && InputWidth - iw >= MLAS_WINOGRAD_INPUT_TILE;
+
+        for (size_t ChannelGroup = ChannelGroupStart; ChannelGroup < ChannelGroupStart + ChannelGroupCount; ChannelGroup++) {
+
+            const size_t c = ChannelGroup * 4;
+            const size_t ChannelCount = std::min(InputChannels - c, size_t(4));
+            const float* input = WorkBlock->Input + c * InputSize;
+
+            const float* Tile[4];
+            size_t RowStride;
+
+            if (ChannelCount == 4 && TileIsInterior) {
+
+                for (size_t k = 0; k < 4; k++) {
+                    Tile[k] = input + k * InputSize + ih * InputWidth + iw;
+                }
+
+                RowStride = InputWidth;
+
+            } else {
+
+                for (size_t k = 0; k < 4; k++) {
+
+                    for (size_t y = 0; y < MLAS_WINOGRAD_INPUT_TILE; y++) {
+                        for (size_t x = 0; x < MLAS_WINOGRAD_INPUT_TILE; x++) {
+
+                            const size_t ihy = ih + y;
+                            const size_t iwx = iw + x;
+
+                            TileBuffer[k][y * MLAS_WINOGRAD_INPUT_TILE + x] =
+                                (k < ChannelCount && ihy < InputHeight && iwx < InputWidth) ?
+                                input[k * InputSize + ihy * InputWidth + iwx] : 0.0f;
+                        }
+                    }
+
+                    Tile[k] = TileBuffer[k];
+                }
+
+                RowStride = MLAS_WINOGRAD_INPUT_TILE;
+            }
+
+            float* TransformedInput = WorkBlock->TransformedInput + t * InputChannels + c;
+
+            if (ChannelCount == 4) {
+
+                MlasWinogradTransformInputTile(Tile, RowStride, TransformedInput, MatrixStride);
+
+            } else {
+
+                MlasWinogradTransformInputTile(Tile, RowStride, TransformedBuffer, 4);
+
+                for (size_t i = 0; i < MLAS_WINOGRAD_TRANSFORM_COUNT; i++) {
+                    for (size_t k = 0; k < ChannelCount; k++) {
+                        TransformedInput[i * MatrixStride + k] = TransformedBuffer[i * 4 + k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformOutputThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to transform the output tiles
+    of a range of filters and then apply the activation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<const MLAS_CONV_WINOGRAD_WORK_BLOCK*>(Context);
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountW = MlasDivRoundup(OutputWidth, MLAS_WINOGRAD_OUTPUT_TILE);
+    const size_t TileCount = WorkBlock->TileCount;
+    const size_t MatrixStride = TileCount * FilterCount;
+    const float Beta = Parameters->Beta;
+
+    size_t FilterGroupStart;
+    size_t FilterGroupCount;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, MlasDivRoundup(FilterCount, 4),
+        &FilterGroupStart, &FilterGroupCount);
+
+    if (FilterGroupCount == 0) {
+        return;
+    }
+
+    float TransformedBuffer[MLAS_WINOGRAD_TRANSFORM_COUNT * 4];
+
+    //
+    // Iterate over the tiles in the outer loop so that the transformed values
+    // of consecutive filters are loaded from the same cache lines.
+    //
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t tile = WorkBlock->TileStart + t;
+        const size_t oh = (tile / TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t ow = (tile % TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t RowCount = std::min(OutputHeight - oh, MLAS_WINOGRAD_OUTPUT_TILE);
+        const size_t ColumnCount = std::min(OutputWidth - ow, MLAS_WINOGRAD_OUTPUT_TILE);
+
+        for (size_t FilterGroup = FilterGroupStart; FilterGroup < FilterGroupStart + FilterGroupCount; FilterGroup++) {
+
+            const size_t f = FilterGroup * 4;
+            const size_t FilterGroupSize = std::min(FilterCount - f, size_t(4));
+            float* output = WorkBlock->Output + f * OutputSize;
+
+            float BiasBuffer[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+            if (WorkBlock->Bias != nullptr) {
+                std::copy_n(WorkBlock->Bias + f, FilterGroupSize, BiasBuffer);
+            }
+
+            const MLAS_FLOAT32X4 BiasVector = MlasLoadFloat32x4(BiasBuffer);
+
+            const float* TransformedOutput = WorkBlock->TransformedOutput + t * FilterCount + f;
+
+            //
+            // The last filters when the filter count is not a multiple of
+            // four are copied to a buffer so that the vector loads stay in
+            // bounds.
+            //
+
+            if (FilterGroupSize < 4) {
+
+                for (size_t i = 0; i < MLAS_WINOGRAD_TRANSFORM_COUNT; i++) {
+                    for (size_t k = 0; k < 4; k++) {
+                        TransformedBuffer[i * 4 + k] = (k < FilterGroupSize) ? TransformedOutput[i * MatrixStride + k] : 0.0f;
+                    }
+                }
+            }
+
+            MLAS_FLOAT32X4 OutputTile[4][MLAS_WINOGRAD_OUTPUT_TILE];
+
+            if (FilterGroupSize == 4) {
+                MlasWinogradTransformOutputTile(TransformedOutput, MatrixStride, BiasVector, OutputTile);
+            } else {
+                MlasWinogradTransformOutputTile(TransformedBuffer, 4, BiasVector, OutputTile);
+            }
+
+            for (size_t k = 0; k < FilterGroupSize; k++) {
+
+                float* OutputRow = output + k * OutputSize + oh * OutputWidth + ow;
+
+                for (size_t row = 0; row < RowCount; row++) {
+
+                    MLAS_FLOAT32X4 Vector = OutputTile[k][row];
+
+                    if (ColumnCount == MLAS_WINOGRAD_OUTPUT_TILE) {
+
+                        if (Beta != 0.0f) {
+                            Vector = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(OutputRow), Beta, Vector);
+                        }
+
+                        MlasStoreFloat32x4(OutputRow, Vector);
+
+                    } else {
+
+                        float RowBuffer[MLAS_WINOGRAD_OUTPUT_TILE];
+
+                        MlasStoreFloat32x4(RowBuffer, Vector);
+
+                        for (size_t column = 0; column < ColumnCount; column++) {
+                            OutputRow[column] = (Beta != 0.0f) ? RowBuffer[column] + Beta * OutputRow[column] : RowBuffer[column];
+                        }
+                    }
+
+                    OutputRow += OutputWidth;
+                }
+            }
+        }
+    }
+
+    //
+    // The block of tiles spans whole rows of tiles, so apply the activation to
+    // the output rows of the block.
+    //
+
+    if (Parameters->Activation->ActivationKind != MlasIdentityActivation) {
+
+        const size_t TileRowStart = WorkBlock->TileStart / TileCountW;
+        const size_t RowStart = TileRowStart * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t RowEnd = std::min((TileRowStart + TileCount / TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE, OutputHeight);
+        const size_t FilterStart = FilterGroupStart * 4;
+        const size_t FilterEnd = std::min((FilterGroupStart + FilterGroupCount) * 4, FilterCount);
+
+        MlasActivation(Parameters->Activation, WorkBlock->Output + FilterStart * OutputSize + RowStart * OutputWidth,
+            nullptr, FilterEnd - FilterStart, (RowEnd - RowStart) * OutputWidth, OutputSize);
+    }
+}
+
+bool
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t InputChannels,
+    size_t FilterCount,
+    const size_t* KernelShape,
+    const size_t* DilationShape,
+    const size_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the Winograd algorithm supports and benefits a
+    convolution, independent of the size of its image.
+
+--*/
+{
+    return Dimensions == 2 &&
+        KernelShape[0] == 3 && KernelShape[1] == 3 &&
+        DilationShape[0] == 1 && DilationShape[1] == 1 &&
+        StrideShape[0] == 1 && StrideShape[1] == 1 &&
+        InputChannels >= MLAS_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_WINOGRAD_MINIMUM_CHANNELS;
+}
+
+size_t
+MlasConvWinogradPackedFilterSize(
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes of the packed filter of a
+    single group.
+
+--*/
+{
+    return MLAS_WINOGRAD_TRANSFORM_COUNT * MlasGemmPackBSize(FilterCount, InputChannels);
+}
+
+bool
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd algorithm for a convolution if it is
+    supported and computes its working buffer size.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    Returns true if the Winograd algorithm was selected, else false.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    if (!MlasConvWinogradIsSupported(Parameters->Dimensions, InputChannels, FilterCount,
+            Parameters->KernelShape, Parameters->DilationShape, Parameters->StrideShape)) {
+        return false;
+    }
+
+    //
+    // N.B. The algorithm is selected regardless of the image size, so that a
+    // filter packed by MlasConvPackFilter is always consumed and callers may
+    // release the original filter. MlasConvPrepare only calls this routine if
+    // the caller supplies a packed filter.
+    //
+
+    //
+    // Process the image in blocks of whole rows of tiles that fit the target
+    // size of the transformed input and output buffers.
+    //
+
+    const size_t TileCountH = MlasDivRoundup(Parameters->OutputShape[0], MLAS_WINOGRAD_OUTPUT_TILE);
+    const size_t TileCountW = MlasDivRoundup(Parameters->OutputShape[1], MLAS_WINOGRAD_OUTPUT_TILE);
+    const size_t TransformedTileSize = MLAS_WINOGRAD_TRANSFORM_COUNT * (InputChannels + FilterCount);
+
+    size_t TileRowsPerBlock = MLAS_WINOGRAD_TRANSFORM_BUFFER_SIZE / (TransformedTileSize * TileCountW);
+
+    TileRowsPerBlock = std::min(std::max(TileRowsPerBlock, size_t(1)), TileCountH);
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->u.Winograd.TileRowsPerBlock = TileRowsPerBlock;
+
+    //
+    // The working buffer holds the transformed input and output tiles of a
+    // block.
+    //
+
+    *WorkingBufferSize = TileRowsPerBlock * TileCountW * TransformedTileSize;
+
+    return true;
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution of a single image and
+    group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor of the group.
+
+    PackedFilter - Optionally supplies the filter of the group packed by
+        MlasConvPackFilter, else the filter is transformed by this call.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TileCountW = MlasDivRoundup(Parameters->OutputShape[1], MLAS_WINOGRAD_OUTPUT_TILE);
+    const size_t TileCount = MlasDivRoundup(Parameters->OutputShape[0], MLAS_WINOGRAD_OUTPUT_TILE) * TileCountW;
+    const size_t TilesPerBlock = Parameters->u.Winograd.TileRowsPerBlock * TileCountW;
+    const size_t PackedMatrixSize = MlasGemmPackBSize(FilterCount, InputChannels);
+
+    //
+    // Transform the filter now if the caller did not supply a packed filter.
+    // The packed GEMM kernels use aligned stores and loads, so align the
+    // buffer to the preferred buffer alignment.
+    //
+
+    std::unique_ptr<uint8_t[]> PackedFilterBuffer;
+
+    if (PackedFilter == nullptr) {
+        const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+        PackedFilterBuffer.reset(
+            new uint8_t[MlasConvWinogradPackedFilterSize(InputChannels, FilterCount) + BufferAlignment - 1]);
+        void* AlignedBuffer = reinterpret_cast<void*>(
+            (reinterpret_cast<uintptr_t>(PackedFilterBuffer.get()) + BufferAlignment - 1) & ~(BufferAlignment - 1));
+        MlasConvPackFilter(1, InputChannels, FilterCount, Filter, AlignedBuffer);
+        PackedFilter = AlignedBuffer;
+    }
+
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Bias = Bias;
+    WorkBlock.TransformedInput = WorkingBuffer;
+    WorkBlock.TransformedOutput = WorkBlock.TransformedInput + TilesPerBlock * MLAS_WINOGRAD_TRANSFORM_COUNT * InputChannels;
+    WorkBlock.Output = Output;
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    for (size_t TileStart = 0; TileStart < TileCount; TileStart += TilesPerBlock) {
+
+        const size_t TileBlockCount = std::min(TileCount - TileStart, TilesPerBlock);
+
+        WorkBlock.TileStart = TileStart;
+        WorkBlock.TileCount = TileBlockCount;
+
+        //
+        // Transform the input tiles.
+        //
+
+        WorkBlock.ThreadCount = std::min(MaximumThreadCount, ptrdiff_t(MlasDivRoundup(InputChannels, 4)));
+
+        MlasExecuteThreaded(MlasConvWinogradTransformInputThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+
+        //
+        // Multiply the transformed input tiles by the transformed filter.
+        //
+
+        const float* TransformedInput = WorkBlock.TransformedInput;
+        float* TransformedOutput = WorkBlock.TransformedOutput;
+
+        MLAS_SGEMM_DATA_PARAMS Data[MLAS_WINOGRAD_TRANSFORM_COUNT];
+
+        for (size_t i = 0; i < MLAS_WINOGRAD_TRANSFORM_COUNT; i++) {
+            Data[i].A = TransformedInput + i * TileBlockCount * InputChannels;
+            Data[i].lda = InputChannels;
+            Data[i].B = reinterpret_cast<const float*>(static_cast<const uint8_t*>(PackedFilter) + i * PackedMatrixSize);
+            Data[i].ldb = 0;
+            Data[i].C = TransformedOutput + i * TileBlockCount * FilterCount;
+            Data[i].ldc = FilterCount;
+            Data[i].alpha = 1.0f;
+            Data[i].beta = 0.0f;
+            Data[i].BIsPacked = true;
+        }
+
+        MlasGemmBatch(CblasNoTrans, CblasTrans, TileBlockCount, FilterCount, InputChannels, Data,
+            MLAS_WINOGRAD_TRANSFORM_COUNT, ThreadPool);
+
+        //
+        // Transform the output tiles and apply the activation.
+        //
+
+        WorkBlock.ThreadCount = std::min(MaximumThreadCount, ptrdiff_t(MlasDivRoundup(FilterCount, 4)));
+
+        MlasExecuteThreaded(MlasConvWinogradTransformOutputThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+    }
+}
+
+size_t
+MLASCALL
+MlasConvPackFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes of the packed filter buffer for
+    a convolution, if the convolution can use an algorithm that transforms the
+    filter.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+    FilterCount - Supplies the number of filters per group.
+
+Return Value:
+
+    Returns the size in bytes of the packed filter buffer, else zero if the
+    convolution does not use a packed filter. If non-zero, MlasConvPrepare
+    with UsePackedFilter set selects an algorithm that uses the packed filter
+    for every image size.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return 0;
+    }
+
+    const size_t Kernel[] = { size_t(KernelShape[0]), size_t(KernelShape[1]) };
+    const size_t Dilation[] = { size_t(DilationShape[0]), size_t(DilationShape[1]) };
+    const size_t Stride[] = { size_t(StrideShape[0]), size_t(StrideShape[1]) };
+
+    if (!MlasConvWinogradIsSupported(Dimensions, InputChannels, FilterCount, Kernel, Dilation, Stride)) {
+        return 0;
+    }
+
+    return GroupCount * MlasConvWinogradPackedFilterSize(InputChannels, FilterCount);
+}
+
+void
+MLASCALL
+MlasConvPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms and packs the filter of a convolution for which
+    MlasConvPackFilterSize returned a non-zero size.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    Filter - Supplies the filter tensor.
+
+    PackedFilter - Supplies the buffer to receive the packed filter, sized
+        by MlasConvPackFilterSize and aligned to the value returned from
+        MlasGetPreferredBufferAlignment().
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t MatrixSize = FilterCount * InputChannels;
+    const size_t PackedMatrixSize = MlasGemmPackBSize(FilterCount, InputChannels);
+
+    MlasThreadedBufAlloc(MatrixSize * sizeof(float));
+    float* TransformedFilter = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    uint8_t* packed = static_cast<uint8_t*>(PackedFilter);
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t i = 0; i < MLAS_WINOGRAD_TRANSFORM_COUNT; i++) {
+
+            MlasWinogradTransformFilter(Filter, FilterCount, InputChannels, i, TransformedFilter);
+
+            MlasGemmPackB(CblasTrans, FilterCount, InputChannels, TransformedFilter, InputChannels, packed);
+
+            packed += PackedMatrixSize;
+        }
+
+        Filter += MatrixSize * 9;
+    }
+}
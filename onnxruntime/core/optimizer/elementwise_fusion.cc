@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/graph/graph_utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// The operators FusedElementwise implements, for float tensors.
+bool IsElementwiseOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+         (node.InputDefs().size() == 2 &&
+          (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Max", {8, 12, 13}) ||
+           graph_utils::IsSupportedOptypeVersionAndDomain(node, "Min", {8, 12, 13}))) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13});
+}
+
+bool IsFusibleNode(const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  static constexpr std::array supported_data_types{"tensor(float)"};
+  return IsElementwiseOp(node) &&
+         graph_utils::IsSupportedProvider(node, compatible_providers) &&
+         optimizer_utils::IsSupportedDataType(node, supported_data_types);
+}
+
+struct ElementwiseTree {
+  // Nodes of the tree in post order, so that the producers of a node come before it and the root is last.
+  InlinedVector<std::reference_wrapper<Node>> nodes;
+  // Inputs of the tree, which are read by the nodes but not produced by them.
+  InlinedVector<NodeArg*> inputs;
+  size_t node_count = 0;
+};
+
+// Grows the tree through the producers of node whose only consumer is node.
+void CollectTree(Graph& graph, Node& node, const InlinedHashSet<std::string_view>& compatible_providers,
+                 ElementwiseTree& tree) {
+  ++tree.node_count;
+
+  for (int i = 0; i < static_cast<int>(node.InputDefs().size()); ++i) {
+    const Node* producer = graph_utils::GetInputNode(node, i);
+    if (producer != nullptr && tree.node_count < MLAS_FUSED_ELTWISE_MAXIMUM_INSTRUCTIONS &&
+        IsFusibleNode(*producer, compatible_providers) &&
+        producer->GetExecutionProviderType() == node.GetExecutionProviderType() &&
+        producer->GetOutputEdgesCount() == 1 && !graph.NodeProducesGraphOutput(*producer)) {
+      CollectTree(graph, *graph.GetNode(producer->Index()), compatible_providers, tree);
+      continue;
+    }
+
+    NodeArg* input = node.MutableInputDefs()[i];
+    if (std::find(tree.inputs.begin(), tree.inputs.end(), input) == tree.inputs.end()) {
+      tree.inputs.push_back(input);
+    }
+  }
+
+  tree.nodes.push_back(node);
+}
+
+}  // namespace
+
+/**
+Rewrite trees of element-wise operators to FusedElementwise. The nodes are visited consumers first, so that each tree
+is rooted at the last node of a chain and grown backwards through producers that have no other consumer. The program
+of the fused node evaluates the tree in post order.
+*/
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    auto* p_node = graph.GetNode(*it);
+    if (p_node == nullptr)
+      continue;  // node was removed as part of an earlier fusion
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusibleNode(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    ElementwiseTree tree;
+    CollectTree(graph, node, GetCompatibleExecutionProviders(), tree);
+    if (tree.nodes.size() < 2 || tree.inputs.size() > MLAS_FUSED_ELTWISE_MAXIMUM_INPUTS) {
+      continue;
+    }
+
+    // Registers hold the inputs, followed by the result of each node.
+    InlinedHashMap<NodeIndex, int64_t> result_registers;
+    InlinedVector<std::string> ops;
+    InlinedVector<int64_t> operands;
+    for (Node& tree_node : tree.nodes) {
+      InlinedVector<int64_t, 2> registers;
+      for (int i = 0; i < static_cast<int>(tree_node.InputDefs().size()); ++i) {
+        const Node* producer = graph_utils::GetInputNode(tree_node, i);
+        auto result = producer != nullptr ? result_registers.find(producer->Index()) : result_registers.end();
+        if (result != result_registers.end()) {
+          registers.push_back(result->second);
+        } else {
+          auto input = std::find(tree.inputs.begin(), tree.inputs.end(), tree_node.InputDefs()[i]);
+          registers.push_back(static_cast<int64_t>(input - tree.inputs.begin()));
+        }
+      }
+      ops.push_back(tree_node.OpType());
+      operands.push_back(registers[0]);
+      operands.push_back(registers.size() > 1 ? registers[1] : registers[0]);
+      result_registers[tree_node.Index()] = static_cast<int64_t>(tree.inputs.size() + result_registers.size());
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "/ElementwiseFusion/"), "FusedElementwise",
+                                     "fused element-wise operators", tree.inputs, node.MutableOutputDefs(), nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", gsl::span<const std::string>(ops.data(), ops.size()));
+    fused_node.AddAttribute("operands", gsl::span<const int64_t>(operands.data(), operands.size()));
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // The inputs of the tree may be read by any of its nodes, so connect their producers to the fused node before
+    // the tree is removed.
+    for (Node& tree_node : tree.nodes) {
+      for (auto edge = tree_node.InputEdgesBegin(); edge != tree_node.InputEdgesEnd(); ++edge) {
+        if (result_registers.count(edge->GetNode().Index()) == 0) {
+          const NodeArg* input = tree_node.InputDefs()[edge->GetDstArgIndex()];
+          auto index = std::find(tree.inputs.begin(), tree.inputs.end(), input) - tree.inputs.begin();
+          graph.AddEdge(edge->GetNode().Index(), fused_node.Index(), edge->GetSrcArgIndex(), static_cast<int>(index));
+        }
+      }
+    }
+
+    graph_utils::FinalizeNodeFusion(graph, tree.nodes, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -18,6 +18,20 @@ bool IsSupportedOptypeVersionAndDomain(const Node& node, const std::string& op_t
           graph_utils::MatchesOpSetDomain(node, domain));
 }
 
+// FusedGemm computes the exact (erf based) Gelu. The tanh approximation is not fused.
+bool IsExactGelu(const Node& node) {
+#ifndef DISABLE_CONTRIB_OPS
+  if (IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain)) {
+    return true;
+  }
+#endif
+  if (!IsSupportedOptypeVersionAndDomain(node, "Gelu", {20}, kOnnxDomain)) {
+    return false;
+  }
+  const AttributeProto* approximate = graph_utils::GetNodeAttribute(node, "approximate");
+  return approximate == nullptr || approximate->s() == "none";
+}
+
 // If the op has multiple versions, here we require it must have a single implementation that can work across all the
 // versions. Because in the fusion, we discarded the op version information.
 bool IsFusableActivation(const Node& node) {
@@ -34,7 +48,8 @@ bool IsFusableActivation(const Node& node) {
          IsSupportedOptypeVersionAndDomain(node, "ScaledTanh", {1}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "ParametricSoftplus", {1}, kOnnxDomain) ||
 #endif
-         IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain);
+         IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain) ||
+         IsExactGelu(node);
 }
 }  // namespace
 
@@ -88,6 +103,10 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
     // Add optional attributes for activations
     const NodeAttributes& attrs = act_node.GetAttributes();
     for (const auto& attr : attrs) {
+      if (act_node.OpType() == "Gelu" && attr.first == "approximate") {
+        // Only the exact Gelu is fused, so the attribute carries no information.
+        continue;
+      }
       AttributeProto fused_gemm_attr(attr.second);
       fused_gemm_attr.set_name("activation_" + attr.first);
       fused_gemm.AddAttributeProto(std::move(fused_gemm_attr));
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <deque>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
@@ -120,6 +121,7 @@ class NchwcTransformerImpl {
   Node& InsertReshape(NodeArg* input_arg, NodeArg* output_arg, bool split_channels);
 
   void TransformConv(Node& node);
+  void TransformConvTranspose(Node& node);
   void TransformPool(Node& node);
   void TransformBinary(Node& node, bool add_node);
   void TransformConcat(Node& node);
@@ -506,6 +508,81 @@ void NchwcTransformerImpl::TransformConv(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
+void NchwcTransformerImpl::TransformConvTranspose(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Require that the weights tensor be static. The NCHWc kernel splits the
+  // weights into a convolution filter per output phase when it is prepacked.
+  const ONNX_NAMESPACE::TensorProto* conv_W_tensor_proto = nullptr;
+  if (!graph_utils::NodeArgIsConstant(graph_, *input_defs[1]) ||
+      !graph_.GetInitializedTensor(input_defs[1]->Name(), conv_W_tensor_proto) ||
+      (conv_W_tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) ||
+      (conv_W_tensor_proto->dims_size() != 4)) {
+    return;
+  }
+
+  const int64_t input_channels = conv_W_tensor_proto->dims(0);
+  const int64_t output_channels = conv_W_tensor_proto->dims(1);
+
+  const auto* group_attr = graph_utils::GetNodeAttribute(node, "group");
+  if (group_attr != nullptr && utils::HasInt(*group_attr) && group_attr->i() != 1) {
+    return;
+  }
+
+  // The current implementation of ReorderInput requires the channel count to be
+  // aligned to this value.
+  constexpr int64_t channel_alignment = 4;
+
+  if ((input_channels % channel_alignment) != 0) {
+    return;
+  }
+
+  const auto* pads_attr = graph_utils::GetNodeAttribute(node, "pads");
+  const auto* strides_attr = graph_utils::GetNodeAttribute(node, "strides");
+  const auto* dilations_attr = graph_utils::GetNodeAttribute(node, "dilations");
+  const auto* output_padding_attr = graph_utils::GetNodeAttribute(node, "output_padding");
+
+  if ((pads_attr != nullptr && pads_attr->ints_size() != kNchwcSpatialDims * 2) ||
+      (strides_attr != nullptr && strides_attr->ints_size() != kNchwcSpatialDims) ||
+      (dilations_attr != nullptr && dilations_attr->ints_size() != kNchwcSpatialDims) ||
+      (output_padding_attr != nullptr && output_padding_attr->ints_size() != kNchwcSpatialDims)) {
+    return;
+  }
+
+  // The output phases of the NCHWc kernel are derived from the strides and
+  // dilations, which must be positive.
+  for (const auto* attr : {strides_attr, dilations_attr}) {
+    if (attr != nullptr &&
+        std::any_of(attr->ints().begin(), attr->ints().end(), [](int64_t value) { return value <= 0; })) {
+      return;
+    }
+  }
+
+  std::string nchwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nchwc");
+  Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                    "ConvTranspose",
+                                    nchwc_node_name,
+                                    input_defs,
+                                    output_defs,
+                                    &node.GetAttributes(),
+                                    kMSNchwcDomain);
+  nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+  auto* nchwc_input = LookupNchwcArgument(input_defs[0]);
+  if (nchwc_input == nullptr) {
+    InsertReorderInput(nchwc_node);
+  } else {
+    nchwc_node.MutableInputDefs()[0] = nchwc_input->nchwc_arg_;
+    nchwc_input->remaining_original_uses_--;
+  }
+
+  NchwcArgument::Shape output_shape(output_defs[0]);
+
+  CreateNchwcArgument(node, nchwc_node, output_channels, output_shape);
+  removed_nodes_.push_front(node.Index());
+}
+
 void NchwcTransformerImpl::TransformPool(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -1152,6 +1229,8 @@ void NchwcTransformerImpl::Transform(Node& node) {
   if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
       graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain)) {
     TransformConv(node);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ConvTranspose", {1, 11, 22})) {
+    TransformConvTranspose(node);
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {1, 8, 10, 11, 12}) ||
              graph_utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", {1, 7, 10, 11})) {
     TransformPool(node);
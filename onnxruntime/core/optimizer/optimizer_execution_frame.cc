@@ -51,10 +51,16 @@ OptimizerExecutionFrame::Info::Info(const std::vector<const Node*>& nodes,
     if (it != initialized_tensor_set.cend()) {
       const auto& tensor_proto = *(it->second);
       OrtValue ort_value;
-      ORT_RETURN_IF_ERROR(
-          utils::TensorProtoToOrtValue(Env::Default(),
-                                       model_path,
-                                       tensor_proto, allocator_ptr_, ort_value));
+      if (utils::HasExternalData(tensor_proto) && allocator_ptr_->Info().device == OrtDevice()) {
+        // kernels only read their inputs, so use the external data where it is, e.g. mapped from disk, instead of
+        // copying it.
+        ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(Env::Default(), model_path, tensor_proto, ort_value));
+      } else {
+        ORT_RETURN_IF_ERROR(
+            utils::TensorProtoToOrtValue(Env::Default(),
+                                         model_path,
+                                         tensor_proto, allocator_ptr_, ort_value));
+      }
 
       initializers_[idx] = std::move(ort_value);
     }
@@ -5,10 +5,17 @@
 
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "core/session/abi_devices.h"
 namespace onnxruntime {
 
+struct NumaNode {
+  int id;
+  // logical processor ids, starting from 0.
+  std::vector<int> processors;
+};
+
 class DeviceDiscovery {
  public:
   static std::unordered_set<OrtHardwareDevice>& GetDevices() {
@@ -19,9 +26,20 @@ class DeviceDiscovery {
     return devices;
   }
 
+  // NUMA nodes with at least one processor, ordered by id.
+  // If the platform does not report a topology a single node 0 with all processors is returned.
+  static const std::vector<NumaNode>& GetNumaNodes() {
+    static std::vector<NumaNode> numa_nodes(DiscoverNumaNodesForPlatform());
+    return numa_nodes;
+  }
+
+  // Logical processor the calling thread is currently running on, or -1 if the platform can't tell.
+  static int GetCurrentProcessor();
+
  private:
   DeviceDiscovery() = default;
-  // platform specific code implements this method
+  // platform specific code implements these methods
   static std::unordered_set<OrtHardwareDevice> DiscoverDevicesForPlatform();
+  static std::vector<NumaNode> DiscoverNumaNodesForPlatform();
 };
 }  // namespace onnxruntime
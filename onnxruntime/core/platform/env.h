@@ -90,6 +90,15 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // How long a thread spins waiting for work before it blocks, in microseconds. If it is negative, the thread spins
+  // for a fixed number of iterations. Only used if the thread pool allows spinning.
+  int spin_duration_us = -1;
+
+  // If it is true, each thread adapts how long it spins to how long it recently had to wait for work, up to
+  // spin_duration_us (or a default maximum if spin_duration_us is negative). Only used if the thread pool allows
+  // spinning.
+  bool adaptive_spinning = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -193,6 +202,24 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  /// How AllocatePages() backs the allocated memory.
+  enum class HugePages {
+    kNone,         // regular pages
+    kTransparent,  // ask the kernel to back the memory with transparent huge pages where supported
+    kExplicit,     // reserved huge pages, falling back to kTransparent if none are available
+  };
+
+  /**
+   * Allocates zero initialized memory directly from the operating system, e.g. for the regions of an arena.
+   * Huge pages and NUMA placement are best effort and silently ignored on platforms that don't support them.
+   * @param size The number of bytes to allocate. May be rounded up to a multiple of the (huge) page size.
+   * @param huge_pages Page size to use.
+   * @param numa_node NUMA node to place the memory on, or -1 to leave the placement to the operating system.
+   * @param[out] memory A smart pointer to the memory which frees it when destroyed.
+   */
+  virtual common::Status AllocatePages(size_t size, HugePages huge_pages, int numa_node,
+                                       MappedMemoryPtr& memory) const = 0;
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
@@ -3,6 +3,18 @@
 
 #include "core/platform/device_discovery.h"
 
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+
 namespace onnxruntime {
 std::unordered_set<OrtHardwareDevice> DeviceDiscovery::DiscoverDevicesForPlatform() {
   std::unordered_set<OrtHardwareDevice> devices;
@@ -14,4 +26,83 @@ std::unordered_set<OrtHardwareDevice> DeviceDiscovery::DiscoverDevicesForPlatfor
 
   return devices;
 }
+
+namespace {
+// Parse a sysfs cpu/node list such as "0-3,8-11". Returns false if the content is malformed.
+bool ParseSysfsList(const std::string& list, std::vector<int>& ids) {
+  ids.clear();
+  for (const auto& range : utils::SplitString(list, ",")) {
+    const auto bounds = utils::SplitString(range, "-");
+    int first = 0;
+    int last = 0;
+    if (bounds.size() == 1) {
+      if (!TryParseStringWithClassicLocale(bounds[0], first)) {
+        return false;
+      }
+      last = first;
+    } else if (bounds.size() != 2 ||
+               !TryParseStringWithClassicLocale(bounds[0], first) ||
+               !TryParseStringWithClassicLocale(bounds[1], last) ||
+               first > last) {
+      return false;
+    }
+
+    for (int id = first; id <= last; ++id) {
+      ids.push_back(id);
+    }
+  }
+
+  return true;
+}
+
+bool ReadSysfsList(const std::string& path, std::vector<int>& ids) {
+  std::ifstream file(path);
+  std::string line;
+  if (!file || !std::getline(file, line)) {
+    return false;
+  }
+
+  // an empty line is a valid empty list, e.g. the cpulist of a memory only node.
+  if (line.empty()) {
+    ids.clear();
+    return true;
+  }
+
+  return ParseSysfsList(line, ids);
+}
+}  // namespace
+
+std::vector<NumaNode> DeviceDiscovery::DiscoverNumaNodesForPlatform() {
+  std::vector<NumaNode> numa_nodes;
+
+  std::vector<int> node_ids;
+  if (ReadSysfsList("/sys/devices/system/node/online", node_ids)) {
+    for (int node_id : node_ids) {
+      NumaNode node{node_id, {}};
+      if (ReadSysfsList("/sys/devices/system/node/node" + std::to_string(node_id) + "/cpulist", node.processors) &&
+          !node.processors.empty()) {
+        numa_nodes.push_back(std::move(node));
+      }
+    }
+  }
+
+  if (numa_nodes.empty()) {
+    NumaNode node{0, {}};
+    const int num_processors = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 0; i < num_processors; ++i) {
+      node.processors.push_back(i);
+    }
+    numa_nodes.push_back(std::move(node));
+  }
+
+  return numa_nodes;
+}
+
+int DeviceDiscovery::GetCurrentProcessor() {
+#if defined(__linux__)
+  return sched_getcpu();
+#else
+  return -1;
+#endif
+}
 }  // namespace onnxruntime
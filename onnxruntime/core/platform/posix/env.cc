@@ -451,6 +451,98 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  Status AllocatePages(size_t size, HugePages huge_pages, int numa_node, MappedMemoryPtr& memory) const override {
+    ORT_RETURN_IF(size == 0, "size == 0");
+
+    static const size_t page_size = narrow<size_t>(sysconf(_SC_PAGESIZE));
+#if defined(__linux__)
+    // transparent huge pages are only used for 2MB aligned ranges
+    constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+    const size_t alignment = huge_pages == HugePages::kNone ? page_size : kHugePageSize;
+#else
+    ORT_UNUSED_PARAMETER(huge_pages);
+    ORT_UNUSED_PARAMETER(numa_node);
+    const size_t alignment = page_size;
+#endif
+    const size_t mapped_length = (size + alignment - 1) / alignment * alignment;
+    void* mapped_base = MAP_FAILED;
+
+#if defined(__linux__)
+    if (huge_pages == HugePages::kExplicit) {
+      mapped_base = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                         -1, 0);
+      if (mapped_base == MAP_FAILED) {
+        LOGS_DEFAULT(VERBOSE) << "No reserved huge pages available for " << mapped_length
+                              << " bytes, falling back to transparent huge pages.";
+      }
+    }
+
+    if (mapped_base == MAP_FAILED && huge_pages != HugePages::kNone) {
+      // over-allocate so that the range can be trimmed to the huge page alignment
+      const size_t padded_length = mapped_length + kHugePageSize;
+      char* padded_base = static_cast<char*>(
+          mmap(nullptr, padded_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      if (padded_base == MAP_FAILED) {
+        return ReportSystemError("mmap", mapped_length);
+      }
+
+      const auto padded_int = reinterpret_cast<std::uintptr_t>(padded_base);
+      char* aligned_base = padded_base + ((kHugePageSize - padded_int % kHugePageSize) % kHugePageSize);
+      const size_t head = static_cast<size_t>(aligned_base - padded_base);
+      const size_t tail = padded_length - head - mapped_length;
+      if (head != 0) {
+        UnmapFile(padded_base, head);
+      }
+      if (tail != 0) {
+        UnmapFile(aligned_base + mapped_length, tail);
+      }
+
+      if (madvise(aligned_base, mapped_length, MADV_HUGEPAGE) != 0) {
+        LOGS_DEFAULT(VERBOSE) << "madvise(MADV_HUGEPAGE) failed: " << GetErrnoInfo().second;
+      }
+
+      mapped_base = aligned_base;
+    }
+#endif
+
+    if (mapped_base == MAP_FAILED) {
+      mapped_base = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mapped_base == MAP_FAILED) {
+        return ReportSystemError("mmap", mapped_length);
+      }
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    if (numa_node >= 0) {
+      // MPOL_PREFERRED from <numaif.h>. the memory is placed on the node if possible instead of failing the
+      // allocation once the node runs out of memory.
+      constexpr int kMpolPreferred = 1;
+      constexpr size_t kBitsPerMask = sizeof(unsigned long) * 8;
+      std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerMask + 1, 0);
+      node_mask[static_cast<size_t>(numa_node) / kBitsPerMask] = 1UL << (static_cast<size_t>(numa_node) % kBitsPerMask);
+      // the kernel expects the number of bits in the mask plus one
+      if (syscall(SYS_mbind, mapped_base, mapped_length, kMpolPreferred, node_mask.data(),
+                  node_mask.size() * kBitsPerMask + 1, 0) != 0) {
+        LOGS_DEFAULT(WARNING) << "Failed to bind " << mapped_length << " bytes to NUMA node " << numa_node << ": "
+                              << GetErrnoInfo().second;
+      }
+    }
+#endif
+
+    memory = MappedMemoryPtr{static_cast<char*>(mapped_base),
+                             [mapped_base, mapped_length](void*) {
+                               UnmapFile(mapped_base, mapped_length);
+                             }};
+    return Status::OK();
+  }
+
+  static common::Status ReportSystemError(const char* operation_name, size_t length) {
+    auto [err_no, err_msg] = GetErrnoInfo();
+    std::ostringstream oss;
+    oss << operation_name << " of " << length << " bytes failed: " << err_msg;
+    return common::Status(common::SYSTEM, err_no, oss.str());
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto [err_no, err_msg] = GetErrnoInfo();
     std::ostringstream oss;
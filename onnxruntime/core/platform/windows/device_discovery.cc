@@ -3,12 +3,15 @@
 
 #include "core/platform/device_discovery.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <codecvt>
 #include <locale>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "core/common/cpuid_info.h"
 #include "core/common/logging/logging.h"
@@ -621,4 +624,52 @@ std::unordered_set<OrtHardwareDevice> DeviceDiscovery::DiscoverDevicesForPlatfor
   return {};
 }
 #endif
+
+std::vector<NumaNode> DeviceDiscovery::DiscoverNumaNodesForPlatform() {
+  std::vector<NumaNode> numa_nodes;
+
+  DWORD length = 0;
+  if (!GetLogicalProcessorInformationEx(RelationNumaNode, nullptr, &length) &&
+      GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+    std::vector<char> buffer(length);
+    auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (GetLogicalProcessorInformationEx(RelationNumaNode, info, &length)) {
+      for (DWORD offset = 0; offset < length;) {
+        const auto* entry = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        // processor ids follow the convention of the intra-op affinity string: 64 processors per group.
+        const GROUP_AFFINITY& affinity = entry->NumaNode.GroupMask;
+        NumaNode node{static_cast<int>(entry->NumaNode.NodeNumber), {}};
+        for (int bit = 0; bit < 64; ++bit) {
+          if (affinity.Mask & (KAFFINITY{1} << bit)) {
+            node.processors.push_back(static_cast<int>(affinity.Group) * 64 + bit);
+          }
+        }
+
+        if (!node.processors.empty()) {
+          numa_nodes.push_back(std::move(node));
+        }
+        offset += entry->Size;
+      }
+    }
+  }
+
+  if (numa_nodes.empty()) {
+    NumaNode node{0, {}};
+    const int num_processors = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 0; i < num_processors; ++i) {
+      node.processors.push_back(i);
+    }
+    numa_nodes.push_back(std::move(node));
+  }
+
+  std::sort(numa_nodes.begin(), numa_nodes.end(),
+            [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+  return numa_nodes;
+}
+
+int DeviceDiscovery::GetCurrentProcessor() {
+  PROCESSOR_NUMBER processor;
+  GetCurrentProcessorNumberEx(&processor);
+  return static_cast<int>(processor.Group) * 64 + processor.Number;
+}
 }  // namespace onnxruntime
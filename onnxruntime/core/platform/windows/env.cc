@@ -470,6 +470,49 @@ Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
   return Status::OK();
 }
 
+Status WindowsEnv::AllocatePages(size_t size, HugePages huge_pages, int numa_node,
+                                 MappedMemoryPtr& memory) const {
+  ORT_RETURN_IF(size == 0, "size == 0");
+
+  const DWORD preferred_node = numa_node >= 0 ? static_cast<DWORD>(numa_node) : NUMA_NO_PREFERRED_NODE;
+  void* base = nullptr;
+  size_t allocated_size = size;
+
+  // large pages require the SeLockMemoryPrivilege. windows has no transparent huge pages, so both modes try
+  // large pages and fall back to regular pages.
+  const SIZE_T large_page_size = GetLargePageMinimum();
+  if (huge_pages != HugePages::kNone && large_page_size != 0) {
+    allocated_size = (size + large_page_size - 1) / large_page_size * large_page_size;
+    base = VirtualAllocExNuma(GetCurrentProcess(), nullptr, allocated_size,
+                              MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, preferred_node);
+    if (base == nullptr) {
+      LOGS_DEFAULT(VERBOSE) << "Large page allocation of " << allocated_size
+                            << " bytes failed, errcode = " << GetLastError() << ". Falling back to regular pages.";
+      allocated_size = size;
+    }
+  }
+
+  if (base == nullptr) {
+    base = VirtualAllocExNuma(GetCurrentProcess(), nullptr, allocated_size, MEM_RESERVE | MEM_COMMIT,
+                              PAGE_READWRITE, preferred_node);
+  }
+
+  if (base == nullptr) {
+    const auto error_code = GetLastError();
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "VirtualAllocExNuma of ", allocated_size,
+                           " bytes failed, errcode = ", error_code,
+                           " - ", std::system_category().message(error_code));
+  }
+
+  memory = MappedMemoryPtr{static_cast<char*>(base),
+                           [base](void*) {
+                             if (!VirtualFree(base, 0, MEM_RELEASE)) {
+                               LOGS_DEFAULT(ERROR) << "VirtualFree failed, errcode = " << GetLastError();
+                             }
+                           }};
+  return Status::OK();
+}
+
 bool WindowsEnv::FolderExists(const std::wstring& path) const {
   DWORD attributes = GetFileAttributesW(path.c_str());
   return (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
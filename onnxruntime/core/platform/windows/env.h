@@ -66,6 +66,8 @@ class WindowsEnv : public Env {
                            FileOffsetType offset,
                            size_t length,
                            MappedMemoryPtr& mapped_memory) const override;
+  Status AllocatePages(size_t size, HugePages huge_pages, int numa_node,
+                       MappedMemoryPtr& memory) const override;
   bool FolderExists(const std::wstring& path) const override;
   bool FolderExists(const std::string& path) const override;
   bool FileExists(const std::wstring& path) const override;
@@ -5,7 +5,9 @@
 #include "core/providers/cpu/math/gemm.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/numa_partitions.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/providers/cpu/tunable/math/gemm.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
@@ -80,7 +82,7 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     Gemm<MLFloat16>);
 
-// opset 13 Adds BFloat16 support but we are not supporting it yet
+// opset 13 Adds BFloat16 support
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Gemm,
     13,
@@ -99,6 +101,22 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MLFloat16,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
     Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    Gemm<BFloat16>);
+
+size_t GemmPackBFp32Size(const TensorShape& b_shape, bool trans_b) {
+  if (b_shape.NumDimensions() != 2) {
+    return 0;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+  return MlasGemmPackBSize(N, K);
+}
 
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
@@ -174,6 +192,176 @@ void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                 thread_pool);
 }
 
+namespace {
+
+// Copies the transpose of the N x K matrix B into the K x N matrix B_t.
+void TransposeHalfMatrix(ptrdiff_t N, ptrdiff_t K, const MLFloat16* b_data, MLFloat16* b_t_data) {
+  for (ptrdiff_t k = 0; k < K; k++) {
+    for (ptrdiff_t n = 0; n < N; n++) {
+      b_t_data[k * N + n] = b_data[n * K + k];
+    }
+  }
+}
+
+// Whether the MLAS half precision GEMM can add the bias C: it must be absent, or a row vector of N elements
+// scaled by 1.
+bool HalfGemmMlasSupportsBias(ptrdiff_t N, MLFloat16 beta, const MLFloat16* c_data, const TensorShape* c_shape) {
+  if (c_data == nullptr || beta == onnxruntime::MLFloat16::Zero) {
+    return true;
+  }
+  if (beta.ToFloat() == 1.0f) {
+    return (c_shape->NumDimensions() == 1 && (*c_shape)[0] == N) ||
+           (c_shape->NumDimensions() == 2 && (*c_shape)[0] == 1 && (*c_shape)[1] == N);
+  }
+  return false;
+}
+
+// Adds beta * C, broadcast to M x N as in GemmBroadcastBias, to Y.
+void AddHalfGemmBias(ptrdiff_t M, ptrdiff_t N, MLFloat16 beta, const MLFloat16* c_data, const TensorShape* c_shape,
+                     MLFloat16* y_data) {
+  if (c_data == nullptr || beta == onnxruntime::MLFloat16::Zero) {
+    return;
+  }
+  const float beta_value = beta.ToFloat();
+  const bool is_scalar = c_shape->Size() == 1;
+  const bool is_row = !is_scalar && (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1);
+  const bool is_column = !is_scalar && !is_row && (*c_shape)[1] == 1;
+  for (ptrdiff_t m = 0; m < M; m++) {
+    for (ptrdiff_t n = 0; n < N; n++) {
+      const ptrdiff_t c_index = is_scalar ? 0 : is_row ? n : is_column ? m : m * N + n;
+      MLFloat16& y = y_data[m * N + n];
+      y = MLFloat16(y.ToFloat() + beta_value * c_data[c_index].ToFloat());
+    }
+  }
+}
+
+// Computes Y = alpha * op(A) * B + beta * C with the MLAS half precision GEMM. B is a K x N matrix with
+// leading dimension ldb, or was packed by MlasHalfGemmPackB when ldb is 0.
+void ComputeHalfGemmMlas(CBLAS_TRANSPOSE trans_a, ptrdiff_t M, ptrdiff_t N, ptrdiff_t K, float alpha,
+                         const MLFloat16* a_data, const MLFloat16* b_data, size_t ldb,
+                         MLFloat16 beta, const MLFloat16* c_data, const TensorShape* c_shape,
+                         MLFloat16* y_data, concurrency::ThreadPool* thread_pool) {
+  // The MLAS kernels compute A * B, so apply the transpose and alpha while copying A. This is O(M * K) work
+  // next to the O(M * N * K) multiply.
+  std::vector<MLFloat16> a_buffer;
+  if (trans_a != CblasNoTrans || alpha != 1.0f) {
+    a_buffer.resize(SafeInt<size_t>(M) * K);
+    for (ptrdiff_t m = 0; m < M; m++) {
+      for (ptrdiff_t k = 0; k < K; k++) {
+        const MLFloat16 a = trans_a != CblasNoTrans ? a_data[k * M + m] : a_data[m * K + k];
+        a_buffer[m * K + k] = MLFloat16(alpha * a.ToFloat());
+      }
+    }
+    a_data = a_buffer.data();
+  }
+
+  // MLAS adds a bias vector of N elements. Any other bias is added after the multiply.
+  const bool mlas_bias = HalfGemmMlasSupportsBias(N, beta, c_data, c_shape);
+
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = a_data;
+  data.lda = K;
+  data.B = b_data;
+  data.ldb = ldb;
+  data.C = y_data;
+  data.ldc = N;
+  data.Bias = mlas_bias && beta != onnxruntime::MLFloat16::Zero ? c_data : nullptr;
+  MlasHalfGemmBatch(M, N, K, 1, &data, thread_pool);
+
+  if (!mlas_bias) {
+    AddHalfGemmBias(M, N, beta, c_data, c_shape, y_data);
+  }
+}
+
+// The size a 2D B is pre-packed into for the SBGEMM kernels, 0 if B is not pre-packed.
+size_t GemmPackBBf16Size(const TensorShape& b_shape, bool trans_b) {
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  if (b_shape.NumDimensions() == 2 && MlasBf16AccelerationSupported()) {
+    const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+    const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+    return MlasSBGemmPackBSize(N, K);
+  }
+#else
+  ORT_UNUSED_PARAMETER(b_shape);
+  ORT_UNUSED_PARAMETER(trans_b);
+#endif
+  return 0;
+}
+
+// Widens the rows x cols matrix op(X) to fp32. X is cols x rows when trans is set. Widening bf16 is exact.
+void WidenBFloat16Matrix(CBLAS_TRANSPOSE trans, ptrdiff_t rows, ptrdiff_t cols, const BFloat16* x_data,
+                         float* y_data) {
+  if (trans == CblasNoTrans) {
+    BFloat16ToFloat(x_data, y_data, SafeInt<size_t>(rows) * cols);
+    return;
+  }
+  for (ptrdiff_t r = 0; r < rows; r++) {
+    for (ptrdiff_t c = 0; c < cols; c++) {
+      y_data[r * cols + c] = x_data[c * rows + r].ToFloat();
+    }
+  }
+}
+
+// Computes Y = alpha * op(A) * op(B) + beta * C in fp32 and rounds Y to bf16 once. B was pre-packed for the
+// SBGEMM kernels when packed_b is not null, and b_data is not read.
+void ComputeBFloat16Gemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b, ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
+                         float alpha, const BFloat16* a_data, const BFloat16* b_data, const void* packed_b,
+                         float beta, const BFloat16* c_data, const TensorShape* c_shape,
+                         BFloat16* y_data, concurrency::ThreadPool* thread_pool) {
+#if !defined(MLAS_SUPPORTS_SBGEMM)
+  ORT_UNUSED_PARAMETER(packed_b);
+#endif
+  std::vector<float> ab(SafeInt<size_t>(M) * N);
+  if (K != 0) {
+    // The SBGEMM kernels take A as an M x K fp32 matrix.
+    std::vector<float> a_fp32(SafeInt<size_t>(M) * K);
+    WidenBFloat16Matrix(trans_a, M, K, a_data, a_fp32.data());
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
+    if (packed_b != nullptr) {
+      MLAS_SBGEMM_DATA_PARAMS data;
+      data.AIsfp32 = true;
+      data.BIsfp32 = false;
+      data.A = a_fp32.data();
+      data.lda = static_cast<size_t>(K);
+      data.B = packed_b;
+      data.ldb = 0;
+      data.C = ab.data();
+      data.ldc = static_cast<size_t>(N);
+      MlasSBGemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), 1, &data,
+                      thread_pool);
+    } else
+#endif
+    {
+      // B is not pre-packed: widening it is exact, so compute in fp32.
+      std::vector<float> b_fp32(SafeInt<size_t>(K) * N);
+      BFloat16ToFloat(b_data, b_fp32.data(), b_fp32.size());
+      MlasGemm(CblasNoTrans, trans_b, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+               1.0f, a_fp32.data(), static_cast<size_t>(K),
+               b_fp32.data(), static_cast<size_t>(trans_b != CblasNoTrans ? K : N),
+               0.0f, ab.data(), static_cast<size_t>(N), thread_pool);
+    }
+  }
+
+  // Scale the product and add beta * C, broadcast to M x N as in GemmBroadcastBias, before rounding.
+  const bool has_bias = c_data != nullptr && beta != 0.0f;
+  const bool is_scalar = has_bias && c_shape->Size() == 1;
+  const bool is_row = has_bias && !is_scalar && (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1);
+  const bool is_column = has_bias && !is_scalar && !is_row && (*c_shape)[1] == 1;
+  for (ptrdiff_t m = 0; m < M; m++) {
+    for (ptrdiff_t n = 0; n < N; n++) {
+      float y = alpha * ab[m * N + n];
+      if (has_bias) {
+        const ptrdiff_t c_index = is_scalar ? 0 : is_row ? n : is_column ? m : m * N + n;
+        y += beta * c_data[c_index].ToFloat();
+      }
+      y_data[m * N + n] = BFloat16(y);
+    }
+  }
+}
+
+}  // namespace
+
 template <>
 void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                                   ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -199,30 +387,21 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
 
   if (c_data == nullptr)
     beta = onnxruntime::MLFloat16::Zero;
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
-  bool support_mlas = false;
-  if (c_shape == nullptr) {
-    support_mlas = true;
-  } else if (c_shape->NumDimensions() == 1 && (*c_shape)[0] == N) {
-    support_mlas = true;
-  } else if (c_shape->NumDimensions() == 2 && (((*c_shape)[0] == 1 && (*c_shape)[1] == N) || ((*c_shape)[0] == N && (*c_shape)[1] == 1))) {
-    support_mlas = true;
-  }
-  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 && beta.ToFloat() == 1.0) {
-    MLAS_HALF_GEMM_DATA_PARAMS data;
-    data.A = a_data;
-    data.lda = K;
-    data.B = b_data;
-    data.ldb = N;
-    data.C = y_data;
-    data.ldc = N;
-    if (c_shape != nullptr) {
-      data.Bias = c_data;
+
+  if (MlasHalfGemmAccelerationSupported()) {
+    // The MLAS kernels read B as K x N, so a transposed B is copied first. Gemm<MLFloat16>::PrePack does this
+    // once for a constant B.
+    std::vector<MLFloat16> b_buffer;
+    if (trans_b != CblasNoTrans) {
+      b_buffer.resize(SafeInt<size_t>(K) * N);
+      TransposeHalfMatrix(N, K, b_data, b_buffer.data());
+      b_data = b_buffer.data();
     }
-    MlasHalfGemmBatch(M, N, K, 1, &data, thread_pool);
+    ComputeHalfGemmMlas(trans_a, M, N, K, alpha.ToFloat(), a_data, b_data, static_cast<size_t>(N),
+                        beta, c_data, c_shape, y_data, thread_pool);
     return;
   }
-#endif
+
   // Fallback to Eigen
   // Broadcast the bias as needed if bias is given
   GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
@@ -237,6 +416,23 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
 #endif
 }
 
+template <>
+void Gemm<BFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                                 ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
+                                 BFloat16 alpha,
+                                 const BFloat16* a_data, const BFloat16* b_data,
+                                 BFloat16 beta,
+                                 const BFloat16* c_data, const TensorShape* c_shape,
+                                 BFloat16* y_data,
+                                 concurrency::ThreadPool* thread_pool) {
+  // if input is empty tensor, return directly as nothing need to be calculated.
+  if (M == 0 || N == 0)
+    return;
+
+  ComputeBFloat16Gemm(trans_a, trans_b, M, N, K, alpha.ToFloat(), a_data, b_data, nullptr, beta.ToFloat(),
+                      c_data, c_shape, y_data, thread_pool);
+}
+
 template void Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                                        ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                                        float alpha,
@@ -273,6 +469,100 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                                AllocatorPtr alloc, /*out*/ bool& is_packed,
+                                /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B, and only when MLAS will read the packed matrix
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 2 || !MlasHalfGemmAccelerationSupported()) {
+    return Status::OK();
+  }
+
+  b_shape_ = tensor.Shape();
+  const size_t K = trans_B_ != CblasNoTrans ? static_cast<size_t>(b_shape_[1]) : static_cast<size_t>(b_shape_[0]);
+  const size_t N = trans_B_ != CblasNoTrans ? static_cast<size_t>(b_shape_[0]) : static_cast<size_t>(b_shape_[1]);
+  const auto* b_data = tensor.Data<MLFloat16>();
+
+  // MLAS packs B on platforms whose kernels need it. The other kernels read B as is, so there is only the
+  // transpose to save for a transposed B.
+  size_t packed_b_size = MlasHalfGemmPackBSize(N, K, false);
+  if (K == 0 || N == 0 || (packed_b_size == 0 && trans_B_ == CblasNoTrans)) {
+    return Status::OK();
+  }
+
+  if (packed_b_size == 0) {
+    packed_b_size = SafeInt<size_t>(K) * N * sizeof(MLFloat16);
+    packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+    TransposeHalfMatrix(static_cast<ptrdiff_t>(N), static_cast<ptrdiff_t>(K), b_data,
+                        static_cast<MLFloat16*>(packed_b_.get()));
+    packed_b_ldb_ = N;
+  } else {
+    IAllocatorUniquePtr<MLFloat16> b_transposed;
+    if (trans_B_ != CblasNoTrans) {
+      b_transposed = IAllocator::MakeUniquePtr<MLFloat16>(alloc, SafeInt<size_t>(K) * N, true);
+      TransposeHalfMatrix(static_cast<ptrdiff_t>(N), static_cast<ptrdiff_t>(K), b_data, b_transposed.get());
+      b_data = b_transposed.get();
+    }
+    packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+    // Zero the padding so the buffer hashes the same when it is shared between sessions.
+    memset(packed_b_.get(), 0, packed_b_size);
+    MlasHalfGemmPackB(N, K, reinterpret_cast<const MLAS_FP16*>(b_data), N, packed_b_.get());
+    packed_b_ldb_ = 0;
+  }
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                               AllocatorPtr alloc, /*out*/ bool& is_packed,
+                               /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B, and only when the CPU has the SBGEMM kernels
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  const size_t packed_b_size = GemmPackBBf16Size(tensor.Shape(), trans_B_ != CblasNoTrans);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  b_shape_ = tensor.Shape();
+  const size_t K = trans_B_ != CblasNoTrans ? static_cast<size_t>(b_shape_[1]) : static_cast<size_t>(b_shape_[0]);
+  const size_t N = trans_B_ != CblasNoTrans ? static_cast<size_t>(b_shape_[0]) : static_cast<size_t>(b_shape_[1]);
+
+  // MLAS packs a K x N fp32 B. Widening bf16 to fp32 is exact, so the packed bf16 weights are the original ones.
+  std::vector<float> b_fp32(SafeInt<size_t>(K) * N);
+  WidenBFloat16Matrix(trans_B_, static_cast<ptrdiff_t>(K), static_cast<ptrdiff_t>(N), tensor.Data<BFloat16>(),
+                      b_fp32.data());
+
+  packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  // Zero the padding so the buffer hashes the same when it is shared between sessions.
+  memset(packed_b_.get(), 0, packed_b_size);
+  MlasSBGemmConvertPackB(N, K, b_fp32.data(), N, packed_b_.get());
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+#else
+  ORT_UNUSED_PARAMETER(alloc);
+  ORT_UNUSED_PARAMETER(prepacked_weights);
+#endif
+  return Status::OK();
+}
+
 template <typename T>
 Status Gemm<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
                                           int /*input_idx*/,
@@ -294,6 +584,87 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                  int input_idx,
+                                                  /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 int input_idx,
+                                                 /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+bool Gemm<T>::CanRestorePrePackedState(int /*input_idx*/) const {
+  return false;
+}
+
+template <>
+bool Gemm<float>::CanRestorePrePackedState(int input_idx) const {
+  return input_idx == 1;
+}
+
+template <>
+bool Gemm<BFloat16>::CanRestorePrePackedState(int input_idx) const {
+  return input_idx == 1;
+}
+
+template <typename T>
+Status Gemm<T>::RestorePrePackedState(const Tensor& /*tensor*/, int /*input_idx*/,
+                                      const PrePackedWeights& /*prepacked_weights*/,
+                                      /*out*/ bool& is_restored) {
+  is_restored = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::RestorePrePackedState(const Tensor& tensor, int input_idx,
+                                          const PrePackedWeights& prepacked_weights,
+                                          /*out*/ bool& is_restored) {
+  is_restored = false;
+
+  // the cached buffer must have the size the current MLAS packs B into
+  if (input_idx == 1 && prepacked_weights.buffer_sizes_.size() == 1 &&
+      prepacked_weights.buffer_sizes_[0] != 0 &&
+      prepacked_weights.buffer_sizes_[0] == GemmPackBFp32Size(tensor.Shape(), trans_B_ != CblasNoTrans)) {
+    b_shape_ = tensor.Shape();
+    is_restored = true;
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::RestorePrePackedState(const Tensor& tensor, int input_idx,
+                                             const PrePackedWeights& prepacked_weights,
+                                             /*out*/ bool& is_restored) {
+  is_restored = false;
+
+  // the cached buffer must have the size the current MLAS packs B into
+  if (input_idx == 1 && prepacked_weights.buffer_sizes_.size() == 1 &&
+      prepacked_weights.buffer_sizes_[0] != 0 &&
+      prepacked_weights.buffer_sizes_[0] == GemmPackBBf16Size(tensor.Shape(), trans_B_ != CblasNoTrans)) {
+    b_shape_ = tensor.Shape();
+    is_restored = true;
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -380,7 +751,11 @@ Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
     ComputeGemm(trans_A_, trans_B_, M, N, K, static_cast<MLFloat16>(alpha_), A->Data<MLFloat16>(), B->Data<MLFloat16>(), static_cast<MLFloat16>(beta_),
                 c_data, c_shape, y_data, thread_pool);
   } else {
-    ORT_NOT_IMPLEMENTED("Prepacking of B is supported by MLAS half gemm API, but not implemented by this kernel yet");
+    // PrePack left B as a K x N matrix for MLAS.
+    ComputeHalfGemmMlas(trans_A_, M, N, K, alpha_, A->Data<MLFloat16>(),
+                        static_cast<const MLFloat16*>(packed_b_.get()), packed_b_ldb_,
+                        c_data != nullptr ? static_cast<MLFloat16>(beta_) : onnxruntime::MLFloat16::Zero,
+                        c_data, c_shape, y_data, thread_pool);
   }
 
   ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
@@ -388,6 +763,47 @@ Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <>
+Status Gemm<BFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_ != CblasNoTrans, B ? B->Shape() : b_shape_, trans_B_ != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  ptrdiff_t M = helper.M();
+  ptrdiff_t N = helper.N();
+  ptrdiff_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  BFloat16* y_data = Y->MutableData<BFloat16>();
+
+  const BFloat16* c_data = C != nullptr ? C->Data<BFloat16>() : nullptr;
+  const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
+
+  // alpha and beta stay in fp32 rather than being rounded to bf16 as ComputeGemm takes them.
+  ComputeBFloat16Gemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<BFloat16>(),
+                      B ? B->Data<BFloat16>() : nullptr,
+                      B ? nullptr : NumaPartitions::GetLocalBuffer(packed_b_.get()),
+                      beta_, c_data, c_shape, y_data, thread_pool);
+
+  ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+
+  return Status::OK();
+}
+
 template <>
 Status Gemm<float>::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
@@ -418,29 +834,73 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
-                c_data, c_shape, y_data, thread_pool);
-  } else {
+  if (K == 0) {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    if (K > 0) {
-      MlasGemm(
-          trans_A_,
-          static_cast<size_t>(M),
-          static_cast<size_t>(N),
-          static_cast<size_t>(K),
-          alpha_,
-          A->Data<float>(),
-          static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-          packed_b_.get(),
-          c_data != nullptr ? beta_ : 0.0f,
-          y_data,
-          static_cast<size_t>(N),
-          thread_pool);
-    } else if (beta_ == 0 || c_data == nullptr) {
+    if (beta_ == 0 || c_data == nullptr) {
       EigenMatrixMapRowMajor<float> dest(y_data, narrow<Eigen::Index>(M), narrow<Eigen::Index>(N));
       dest.setZero();
     }
+    if (mlas_activation_.has_value()) {
+      MlasActivation(&*mlas_activation_, y_data, nullptr, static_cast<size_t>(M), static_cast<size_t>(N),
+                     static_cast<size_t>(N));
+    }
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+    return Status::OK();
+  }
+
+  // The SGEMM epilogue adds a (N,) or (1, N) bias or a (M, N) matrix C and applies the fused activation
+  // while each block of Y is still in the cache, instead of broadcasting C into Y up front and running
+  // the activation as a separate pass over Y.
+  MLAS_SGEMM_EPILOGUE epilogue;
+  bool use_epilogue = false;
+  float beta = c_data != nullptr ? beta_ : 0.0f;
+
+  if (mlas_activation_.has_value()) {
+    epilogue.Activation = *mlas_activation_;
+    use_epilogue = true;
+  }
+
+  if (c_data != nullptr && beta_ == 1.0f && c_shape->Size() != 1) {
+    if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+      epilogue.Bias = c_data;
+      beta = 0.0f;
+      use_epilogue = true;
+    } else if ((*c_shape)[1] != 1) {
+      epilogue.Addend = c_data;
+      epilogue.ldAddend = static_cast<size_t>(N);
+      beta = 0.0f;
+      use_epilogue = true;
+    }
+  }
+
+  if (beta != 0.0f) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+  }
+
+  MLAS_SGEMM_DATA_PARAMS data;
+  data.A = A->Data<float>();
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+  if (B) {
+    data.B = B->Data<float>();
+    data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  } else {
+    data.B = static_cast<const float*>(NumaPartitions::GetLocalBuffer(packed_b_.get()));
+    data.BIsPacked = true;
+  }
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+  data.beta = beta;
+  data.Epilogue = use_epilogue ? &epilogue : nullptr;
+
+  ITuningContext* tuning_ctx = Info().GetExecutionProvider()->GetTuningContext();
+  if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled()) {
+    cpu::tunable::SgemmParams params(tuning_ctx, trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N),
+                                     static_cast<size_t>(K), &data, 1, thread_pool);
+    ORT_RETURN_IF_ERROR(cpu::tunable::TunableSgemm(&params));
+  } else {
+    MlasGemmBatch(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                  &data, 1, thread_pool);
   }
 
   ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include "gemm_base.h"
 
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
 
@@ -28,6 +31,11 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  bool CanRestorePrePackedState(int input_idx) const override;
+
+  Status RestorePrePackedState(const Tensor& tensor, int input_idx, const PrePackedWeights& prepacked_weights,
+                               /*out*/ bool& is_restored) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                           T alpha,
@@ -41,9 +49,15 @@ class Gemm : protected GemmBase, public OpKernel {
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
 
+  // Leading dimension of the K x N matrix in packed_b_ for Gemm<MLFloat16>, 0 when MlasHalfGemmPackB packed it
+  size_t packed_b_ldb_ = 0;
+
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+  // For fused gemm + activation that Gemm<float> applies in the MLAS SGEMM epilogue
+  std::optional<MLAS_ACTIVATION> mlas_activation_;
+
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
 
@@ -14,4 +14,7 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Size of the buffer GemmPackBFp32 packs a B matrix of shape 'b_shape' into, or 0 if it doesn't pack it.
+size_t GemmPackBFp32Size(const TensorShape& b_shape, bool trans_b);
+
 };  // namespace onnxruntime
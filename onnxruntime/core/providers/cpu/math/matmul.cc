@@ -2,8 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+#include "core/framework/numa_partitions.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/math/gemm.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -88,6 +90,20 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    MatMul<BFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -220,6 +236,40 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+bool MatMul<float>::CanRestorePrePackedState(int input_idx) const {
+  return input_idx == 1;
+}
+
+Status MatMul<float>::RestorePrePackedState(const Tensor& tensor, int input_idx,
+                                            const PrePackedWeights& prepacked_weights,
+                                            /*out*/ bool& is_restored) {
+  is_restored = false;
+
+  if (input_idx != 1 || prepacked_weights.buffer_sizes_.size() != 1 || prepacked_weights.buffer_sizes_[0] == 0) {
+    return Status::OK();
+  }
+
+  // the cached buffer must have the size the current MLAS packs B into, with the packing PrePack() would pick
+  const TensorShape& b_shape = tensor.Shape();
+  size_t packed_b_size = 0;
+#if defined(__aarch64__) && defined(__linux__)
+  if (use_fastmath_mode_ && (trans_b_attr_ == 0) && b_shape.NumDimensions() == 2 &&
+      (static_cast<size_t>(b_shape[0]) * static_cast<size_t>(b_shape[1])) >= kFastMathModeKernelsizeThreshold) {
+    packed_b_size = MlasSBGemmPackBSize(static_cast<size_t>(b_shape[1]), static_cast<size_t>(b_shape[0]));
+  } else
+#endif
+  {
+    packed_b_size = GemmPackBFp32Size(b_shape, trans_b_attr_ != 0);
+  }
+
+  if (packed_b_size == prepacked_weights.buffer_sizes_[0]) {
+    b_shape_ = b_shape;
+    is_restored = true;
+  }
+
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -251,6 +301,8 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const auto* a_data = a->Data<float>();
   const auto* b_data = b ? b->Data<float>() : nullptr;
   auto* y_data = y->MutableData<float>();
+  // the copy of the packed weight on the NUMA node of this run's intra-op threads, if the session replicates them.
+  const void* packed_b = NumaPartitions::GetLocalBuffer(packed_b_.get());
 
   const size_t max_len = helper.OutputOffsets().size();
   const size_t M = static_cast<size_t>(helper.M());
@@ -266,7 +318,7 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].AIsfp32 = true;
       data[i].A = a_data + helper.LeftOffsets()[i];
       data[i].lda = lda;
-      data[i].B = data[i].BIsfp32 ? b_data + helper.RightOffsets()[i] : (float*)packed_b_.get();
+      data[i].B = data[i].BIsfp32 ? b_data + helper.RightOffsets()[i] : (float*)packed_b;
       data[i].ldb = ldb;
       data[i].C = y_data + helper.OutputOffsets()[i];
       data[i].ldc = N;
@@ -282,16 +334,242 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].BIsPacked = bool(packed_b_);
       data[i].A = a_data + helper.LeftOffsets()[i];
       data[i].lda = lda;
-      data[i].B = data[i].BIsPacked ? (float*)packed_b_.get() : b_data + helper.RightOffsets()[i];
+      data[i].B = data[i].BIsPacked ? (float*)packed_b : b_data + helper.RightOffsets()[i];
       data[i].ldb = ldb;
       data[i].C = y_data + helper.OutputOffsets()[i];
       data[i].ldc = N;
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
-    MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-                  M, N, K, data.data(), max_len, thread_pool);
+    ITuningContext* tuning_ctx = Info().GetExecutionProvider()->GetTuningContext();
+    if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled()) {
+      cpu::tunable::SgemmParams params(tuning_ctx, trans_a ? CblasTrans : CblasNoTrans,
+                                       trans_b ? CblasTrans : CblasNoTrans, M, N, K, data.data(), max_len,
+                                       thread_pool);
+      ORT_RETURN_IF_ERROR(cpu::tunable::TunableSgemm(&params));
+    } else {
+      MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+                    M, N, K, data.data(), max_len, thread_pool);
+    }
+  }
+  return Status::OK();
+}
+
+// the size B is pre-packed into for the SBGEMM kernels, 0 if B is not pre-packed
+static size_t SBGemmPackBSize(const TensorShape& b_shape) {
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  // Only handle the common case of a 2D weight matrix.
+  if (b_shape.NumDimensions() == 2 && MlasBf16AccelerationSupported()) {
+    return MlasSBGemmPackBSize(static_cast<size_t>(b_shape[1]), static_cast<size_t>(b_shape[0]));
+  }
+#else
+  ORT_UNUSED_PARAMETER(b_shape);
+#endif
+  return 0;
+}
+
+Status MatMul<BFloat16>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                                 /*out*/ bool& is_packed,
+                                 /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx != 1) {
+    return Status::OK();
   }
+
+  const size_t packed_b_size = SBGemmPackBSize(tensor.Shape());
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  b_shape_ = tensor.Shape();
+  const size_t K = static_cast<size_t>(b_shape_[0]);
+  const size_t N = static_cast<size_t>(b_shape_[1]);
+
+  // MLAS packs B from fp32. Widening bf16 to fp32 is exact, so the packed bf16 weights are the original ones.
+  std::vector<float> b_fp32(K * N);
+  BFloat16ToFloat(tensor.Data<BFloat16>(), b_fp32.data(), b_fp32.size());
+
+  packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_b_.get(), 0, packed_b_size);
+  MlasSBGemmConvertPackB(N, K, b_fp32.data(), N, packed_b_.get());
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+#else
+  ORT_UNUSED_PARAMETER(alloc);
+  ORT_UNUSED_PARAMETER(prepacked_weights);
+#endif
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   int input_idx,
+                                                   /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+bool MatMul<BFloat16>::CanRestorePrePackedState(int input_idx) const {
+  return input_idx == 1;
+}
+
+Status MatMul<BFloat16>::RestorePrePackedState(const Tensor& tensor, int input_idx,
+                                               const PrePackedWeights& prepacked_weights,
+                                               /*out*/ bool& is_restored) {
+  is_restored = false;
+
+  if (input_idx != 1 || prepacked_weights.buffer_sizes_.size() != 1 || prepacked_weights.buffer_sizes_[0] == 0) {
+    return Status::OK();
+  }
+
+  // the cached buffer must have the size the current MLAS packs B into
+  if (SBGemmPackBSize(tensor.Shape()) == prepacked_weights.buffer_sizes_[0]) {
+    b_shape_ = tensor.Shape();
+    is_restored = true;
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<BFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t y_size = static_cast<size_t>(y->Shape().Size());
+  auto* y_data = y->MutableData<BFloat16>();
+
+  if (helper.K() == 0) {
+    // When we have (M, 0, N) then the inputs are empty, but the output should
+    // be filled out with zeros.
+    std::fill_n(y_data, y_size, BFloat16::FromBits(0));
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  // the kernels take A in fp32 and accumulate into fp32 C
+  const size_t a_size = static_cast<size_t>(a->Shape().Size());
+  auto a_fp32 = IAllocator::MakeUniquePtr<float>(alloc, a_size);
+  BFloat16ToFloat(a->Data<BFloat16>(), a_fp32.get(), a_size);
+  auto y_fp32 = IAllocator::MakeUniquePtr<float>(alloc, y_size);
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  if (packed_b_) {
+    // the copy of the packed weight on the NUMA node of this run's intra-op threads, if the session replicates them.
+    const void* packed_b = NumaPartitions::GetLocalBuffer(packed_b_.get());
+
+    std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].AIsfp32 = true;
+      data[i].BIsfp32 = false;
+      data[i].A = a_fp32.get() + helper.LeftOffsets()[i];
+      data[i].lda = K;
+      data[i].B = packed_b;
+      data[i].ldb = 0;
+      data[i].C = y_fp32.get() + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    MlasSBGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+  } else
+#endif
+  {
+    // B is not pre-packed: widening it is exact, so compute in fp32.
+    const size_t b_size = static_cast<size_t>(b_shape.Size());
+    auto b_fp32 = IAllocator::MakeUniquePtr<float>(alloc, b_size);
+    BFloat16ToFloat(b->Data<BFloat16>(), b_fp32.get(), b_size);
+
+    std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_fp32.get() + helper.LeftOffsets()[i];
+      data[i].lda = K;
+      data[i].B = b_fp32.get() + helper.RightOffsets()[i];
+      data[i].ldb = N;
+      data[i].C = y_fp32.get() + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = 1.0f;
+      data[i].beta = 0.0f;
+    }
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, data.data(), max_len, thread_pool);
+  }
+
+  FloatToBFloat16(y_fp32.get(), y_data, y_size);
+  return Status::OK();
+}
+
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  auto* y_data = y->MutableData<MLFloat16>();
+
+  if (helper.K() == 0) {
+    // When we have (M, 0, N) then the inputs are empty, but the output should
+    // be filled out with zeros.
+    std::fill_n(y_data, static_cast<size_t>(y->Shape().Size()), MLFloat16::Zero);
+    return Status::OK();
+  }
+
+  const auto* a_data = a->Data<MLFloat16>();
+  const auto* b_data = b->Data<MLFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
   return Status::OK();
 }
 
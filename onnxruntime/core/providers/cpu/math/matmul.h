@@ -43,6 +43,11 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  bool CanRestorePrePackedState(int input_idx) const override;
+
+  Status RestorePrePackedState(const Tensor& tensor, int input_idx, const PrePackedWeights& prepacked_weights,
+                               /*out*/ bool& is_restored) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
@@ -65,4 +70,40 @@ class MatMul<float> final : public OpKernel {
 #endif
 };
 
+// bfloat16 MatMul. A constant 2D B is pre-packed as bf16 for the MLAS SBGEMM kernels when the CPU supports them,
+// so the weights are read at half the bandwidth of fp32. Otherwise the inputs are widened to fp32.
+template <>
+class MatMul<BFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  bool CanRestorePrePackedState(int input_idx) const override;
+
+  Status RestorePrePackedState(const Tensor& tensor, int input_idx, const PrePackedWeights& prepacked_weights,
+                               /*out*/ bool& is_restored) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  IAllocatorUniquePtr<void> packed_b_;
+};
+
+// float16 MatMul. Registered only when MLAS has half precision GEMM kernels for the CPU, so fp16 models do not
+// need Cast nodes around MatMul. A, B and Y stay in fp16; the kernels accumulate in fp32 on x86.
+template <>
+class MatMul<MLFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 }  // namespace onnxruntime
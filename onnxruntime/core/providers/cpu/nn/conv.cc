@@ -153,20 +153,87 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack filter tensor, for the convolutions that MLAS computes with a transformed filter
+  if (input_idx == 1) {
+    const auto& shape = tensor.Shape();
+    TensorShapeVector kernel_shape;
+    if (!conv_attrs_.ComputeKernelShape(shape, kernel_shape).IsOK() || kernel_shape.size() != 2 ||
+        conv_attrs_.group <= 0 || shape[0] % conv_attrs_.group != 0) {
+      return Status::OK();
+    }
+    TensorShapeVector dilations(conv_attrs_.dilations);
+    if (dilations.empty()) {
+      dilations.resize(kernel_shape.size(), 1);
+    }
+    TensorShapeVector strides(conv_attrs_.strides);
+    if (strides.empty()) {
+      strides.resize(kernel_shape.size(), 1);
+    }
+    if (dilations.size() != 2 || strides.size() != 2) {
+      return Status::OK();
+    }
+
+    const size_t group_count = narrow<size_t>(conv_attrs_.group);
+    const size_t input_channels = narrow<size_t>(shape[1]);
+    const size_t filter_count = narrow<size_t>(shape[0]) / group_count;
+
+    const size_t packed_filter_size = MlasConvPackFilterSize(kernel_shape.size(), group_count, input_channels,
+                                                             kernel_shape.data(), dilations.data(), strides.data(),
+                                                             filter_count);
+    if (packed_filter_size == 0) {
+      return Status::OK();
+    }
+    filter_shape_ = shape;
+
+    auto* packed_filter_data = alloc->Alloc(packed_filter_size);
+    packed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+    MlasConvPackFilter(group_count, input_channels, filter_count, tensor.Data<float>(), packed_filter_data);
+
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_filter_));
+      prepacked_weights->buffer_sizes_.push_back(packed_filter_size);
+    }
+
+    is_packed = true;
+  }
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_filter_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = packed_filter_ ? nullptr : context->Input<Tensor>(1);
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
+  const TensorShape& W_shape = packed_filter_ ? filter_shape_ : W->Shape();
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -231,7 +298,12 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    packed_filter_ != nullptr);
+
+    // the original filter is released once packed, so MLAS must select the algorithm that uses the packed filter
+    ORT_RETURN_IF(packed_filter_ && Parameters.Algorithm != MlasConvAlgorithmWinograd,
+                  "Conv filter was pre-packed for an algorithm that MLAS did not select.");
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
@@ -239,7 +311,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 
     MlasConv(&Parameters,
              Xdata.data(),
-             W->Data<float>(),
+             W != nullptr ? W->Data<float>() : nullptr,
+             packed_filter_.get(),
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata.data(),
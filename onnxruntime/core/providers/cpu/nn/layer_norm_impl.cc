@@ -16,33 +16,25 @@ namespace onnxruntime {
 
 namespace {
 
-template <typename T,
-          typename U,
-          typename = std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>, void>>
+// The float and MLFloat16 rows are normalized by MlasLayerNormalization, this job computes the double rows.
+template <typename U>
 void ComputeJob(
-    const T* X_data,
-    const T* scale_data,
-    const T* bias_data,
+    const double* X_data,
+    const double* scale_data,
+    const double* bias_data,
     const ptrdiff_t task_idx,
     const int64_t norm_size,
     const int64_t broadcast_param,
-    const float* scale_float_ptr,
-    const float* bias_float_ptr,
     float epsilon,
     bool simplified,
-    T* Y_data,
+    double* Y_data,
     U* mean_data,
-    U* inv_std_dev_data,
-    AllocatorPtr alloc) {
-  ORT_UNUSED_PARAMETER(scale_float_ptr);  // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(bias_float_ptr);   // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(alloc);
-
-  const T* p_input = X_data + task_idx * norm_size;
-  T* p_output = Y_data + task_idx * norm_size;
+    U* inv_std_dev_data) {
+  const double* p_input = X_data + task_idx * norm_size;
+  double* p_output = Y_data + task_idx * norm_size;
 
-  T mean(0.0f);
-  T mean_square(0.0f);
+  double mean(0.0f);
+  double mean_square(0.0f);
 
   for (int64_t h = 0; h < norm_size; h++) {
     p_output[h] = p_input[h];
@@ -72,82 +64,11 @@ void ComputeJob(
 
   if (mean_data != nullptr) {
     // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-    mean_data[task_idx] = gsl::narrow_cast<float>(mean);
+    mean_data[task_idx] = gsl::narrow_cast<U>(mean);
   }
 
   if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = gsl::narrow_cast<float>(1 / mean_square);
-  }
-}
-
-template <typename U>
-void ComputeJob(
-    const MLFloat16* X_data,
-    const MLFloat16* scale_data,
-    const MLFloat16* bias_data,
-    const ptrdiff_t task_idx,
-    const int64_t norm_size,
-    const int64_t broadcast_param,
-    const float* scale_float_ptr,
-    const float* bias_float_ptr,
-    float epsilon,
-    bool simplified,
-    MLFloat16* Y_data,
-    U* mean_data,
-    U* inv_std_dev_data,
-    AllocatorPtr alloc) {
-  ORT_UNUSED_PARAMETER(scale_data);  // only used in float/double overload
-  ORT_UNUSED_PARAMETER(bias_data);   // only used in float/double overload
-
-  const MLFloat16* p_input = X_data + task_idx * norm_size;
-  MLFloat16* p_output = Y_data + task_idx * norm_size;
-
-  float mean(0.0f);
-  float mean_square(0.0f);
-
-  const size_t num_elems = static_cast<size_t>(norm_size);
-  IAllocatorUniquePtr<float> input_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  MlasConvertHalfToFloatBuffer(p_input, input_float_uptr.get(), num_elems);
-
-  IAllocatorUniquePtr<float> output_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  float* output_float_ptr = output_float_uptr.get();
-
-  const float* input_float_ptr = input_float_uptr.get();
-  for (size_t h = 0; h < num_elems; h++) {
-    output_float_ptr[h] = input_float_ptr[h];
-    mean += input_float_ptr[h];
-    mean_square += input_float_ptr[h] * input_float_ptr[h];
-  }
-
-  mean = mean / norm_size;
-  if (simplified) {
-    mean_square = sqrt(mean_square / norm_size + epsilon);
-  } else {
-    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-  }
-
-  // Compute the offset of gamma and beta to support broadcasting.
-  int64_t i = LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, task_idx, norm_size);
-
-  for (size_t h = 0; h < num_elems; h++, i++) {
-    if (simplified) {
-      output_float_ptr[h] = output_float_ptr[h] / mean_square * scale_float_ptr[i];
-    } else if (nullptr == bias_float_ptr) {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[i];
-    } else {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[i] + bias_float_ptr[i];
-    }
-  }
-
-  MlasConvertFloatToHalfBuffer(output_float_ptr, p_output, num_elems);
-
-  if (mean_data != nullptr) {
-    // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-    mean_data[task_idx] = MLFloat16(mean);
-  }
-
-  if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = MLFloat16(1 / mean_square);
+    inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
   }
 }
 
@@ -270,30 +191,90 @@ Status LayerNormImpl::ComputeWithoutContext(
   LayerNormParams params;
   ORT_RETURN_IF_ERROR(LayerNormHelper::CheckInputs(x_shape, scale_shape, bias_shape, bias_data != nullptr, axis, params));
 
-  IAllocatorUniquePtr<float> scale_fp32;
-  IAllocatorUniquePtr<float> bias_fp32;
-  if constexpr (std::is_same_v<T, MLFloat16>) {
-    if (prepacked_scale_fp32_data_ == nullptr) {
-      const size_t num_elems = static_cast<size_t>(params.scale_size);
-      scale_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-      MlasConvertHalfToFloatBuffer(scale_data, scale_fp32.get(), num_elems);
+  if constexpr (std::is_same_v<T, double>) {
+    ORT_UNUSED_PARAMETER(alloc);
+    concurrency::ThreadPool::TryBatchParallelFor(
+        thread_pool, static_cast<int32_t>(params.num_rows),
+        [&](ptrdiff_t task_idx) {
+          ComputeJob(X_data, scale_data, bias_data, task_idx, params.norm_size, params.broadcast_param,
+                     epsilon, simplified, Y_data, mean_data, inv_std_dev_data);
+        },
+        0);
+    return Status::OK();
+  } else {
+    const size_t num_rows = static_cast<size_t>(params.num_rows);
+
+    // MLAS takes the scale and bias in fp32.
+    const float* scale_fp32_data = nullptr;
+    const float* bias_fp32_data = nullptr;
+    IAllocatorUniquePtr<float> scale_fp32;
+    IAllocatorUniquePtr<float> bias_fp32;
+    if constexpr (std::is_same_v<T, MLFloat16>) {
+      if (prepacked_scale_fp32_data_ == nullptr) {
+        const size_t num_elems = static_cast<size_t>(params.scale_size);
+        scale_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
+        MlasConvertHalfToFloatBuffer(scale_data, scale_fp32.get(), num_elems);
+      }
+      if (prepacked_bias_fp32_data_ == nullptr && bias_data) {
+        const size_t num_elems = static_cast<size_t>(params.bias_size);
+        bias_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
+        MlasConvertHalfToFloatBuffer(bias_data, bias_fp32.get(), num_elems);
+      }
+      scale_fp32_data = prepacked_scale_fp32_data_ ? prepacked_scale_fp32_data_.get() : scale_fp32.get();
+      bias_fp32_data = prepacked_bias_fp32_data_ ? prepacked_bias_fp32_data_.get() : bias_fp32.get();
+    } else {
+      scale_fp32_data = scale_data;
+      bias_fp32_data = bias_data;
     }
-    if (prepacked_bias_fp32_data_ == nullptr && bias_data) {
-      const size_t num_elems = static_cast<size_t>(params.bias_size);
-      bias_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-      MlasConvertHalfToFloatBuffer(bias_data, bias_fp32.get(), num_elems);
+
+    // MLAS writes the mean and the inverse standard deviation in fp32.
+    float* mean_fp32_data = nullptr;
+    float* inv_std_dev_fp32_data = nullptr;
+    IAllocatorUniquePtr<float> mean_fp32;
+    IAllocatorUniquePtr<float> inv_std_dev_fp32;
+    if constexpr (std::is_same_v<U, float>) {
+      mean_fp32_data = mean_data;
+      inv_std_dev_fp32_data = inv_std_dev_data;
+    } else {
+      if (mean_data != nullptr) {
+        mean_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_rows);
+        mean_fp32_data = mean_fp32.get();
+      }
+      if (inv_std_dev_data != nullptr) {
+        inv_std_dev_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_rows);
+        inv_std_dev_fp32_data = inv_std_dev_fp32.get();
+      }
     }
-  }
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      thread_pool, static_cast<int32_t>(params.num_rows),
-      [&](ptrdiff_t task_idx) {
-        ComputeJob(X_data, scale_data, bias_data, task_idx, params.norm_size, params.broadcast_param,
-                   prepacked_scale_fp32_data_ ? prepacked_scale_fp32_data_.get() : scale_fp32.get(),
-                   prepacked_bias_fp32_data_ ? prepacked_bias_fp32_data_.get() : bias_fp32.get(),
-                   epsilon, simplified, Y_data, mean_data, inv_std_dev_data, alloc);
-      },
-      0);
+    MLAS_LAYER_NORM_PARAMS<T> norm_params;
+    norm_params.Input = X_data;
+    norm_params.Scale = scale_fp32_data;
+    norm_params.Bias = simplified ? nullptr : bias_fp32_data;
+    // Row r uses the scale and bias at LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, r, norm_size).
+    if (params.broadcast_param > 0) {
+      norm_params.ScaleRowRepeat = static_cast<size_t>(params.broadcast_param);
+      norm_params.ScaleRows = (num_rows + norm_params.ScaleRowRepeat - 1) / norm_params.ScaleRowRepeat;
+    } else if (params.broadcast_param < 0) {
+      norm_params.ScaleRows = static_cast<size_t>(-params.broadcast_param);
+    }
+    norm_params.Output = Y_data;
+    norm_params.Mean = simplified ? nullptr : mean_fp32_data;
+    norm_params.InvStdDev = inv_std_dev_fp32_data;
+    norm_params.Rows = num_rows;
+    norm_params.N = static_cast<size_t>(params.norm_size);
+    norm_params.Epsilon = epsilon;
+    norm_params.Simplified = simplified;
+    MlasLayerNormalization(norm_params, thread_pool);
+
+    if constexpr (!std::is_same_v<U, float>) {
+      if (mean_data != nullptr) {
+        MlasConvertFloatToHalfBuffer(mean_fp32_data, mean_data, num_rows);
+      }
+      if (inv_std_dev_data != nullptr) {
+        MlasConvertFloatToHalfBuffer(inv_std_dev_fp32_data, inv_std_dev_data, num_rows);
+      }
+    }
+  }
 
   return Status::OK();
 }
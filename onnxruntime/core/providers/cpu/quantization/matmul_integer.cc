@@ -85,7 +85,7 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
     b_is_signed = b->IsDataType<int8_t>();
   } else {
     ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape_, nullptr, b_zero_point ? &b_zero_point->Shape() : nullptr));
-    b_data = static_cast<const uint8_t*>(packed_b_.get());
+    b_data = static_cast<const uint8_t*>(NumaPartitions::GetLocalBuffer(packed_b_.get()));
     b_is_signed = b_is_signed_;
   }
 
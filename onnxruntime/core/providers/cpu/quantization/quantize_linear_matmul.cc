@@ -102,7 +102,7 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
     b_is_signed = b->IsDataType<int8_t>();
   } else {
     ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape_, &b_scale->Shape(), &b_offset->Shape()));
-    b_data = static_cast<const uint8_t*>(packed_b_.get());
+    b_data = static_cast<const uint8_t*>(NumaPartitions::GetLocalBuffer(packed_b_.get()));
     b_is_signed = b_is_signed_;
   }
 
@@ -4,11 +4,13 @@
 #include "core/providers/cpu/tensor/pad.h"
 
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math.h"
 
+#include <algorithm>
 #include <functional>
 
 // there's no way to use a raw pointer as the copy destination with std::copy_n
@@ -416,6 +418,97 @@ static void PadAxisConstant(T* output, T constant, size_t size) {
   }
 }
 
+// Pads the innermost axis of an output row, whose input data has already been copied to [axis_start, axis_end).
+// pre_pad and post_pad are in elements of the flattened innermost axis, pre_pad_blocks and post_pad_blocks in
+// units of inner_no_pad_size.
+template <typename T>
+static void PadInnermostRow(const Mode& mode, T* axis_start, T* axis_end, int64_t pre_pad, int64_t post_pad,
+                            size_t inner_no_pad_size, int64_t pre_pad_blocks, int64_t post_pad_blocks, T value) {
+  switch (mode) {
+    case Mode::Constant:
+      PadAxisConstant(axis_start - pre_pad, value, onnxruntime::narrow<size_t>(pre_pad));
+      PadAxisConstant(axis_end, value, onnxruntime::narrow<size_t>(post_pad));
+      break;
+
+    case Mode::Edge:
+      if (inner_no_pad_size == 1) {
+        PadAxisConstant(axis_start - pre_pad, *axis_start, onnxruntime::narrow<size_t>(pre_pad));
+        PadAxisConstant(axis_end, *(axis_end - 1), onnxruntime::narrow<size_t>(post_pad));
+      } else {
+        // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
+        // Also general loop below after handling first pad axis with non-pad axis works fine.
+        PadAxis(axis_start - pre_pad, axis_start, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size,
+                onnxruntime::narrow<size_t>(pre_pad_blocks));
+        PadAxis(axis_end, axis_end - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size,
+                onnxruntime::narrow<size_t>(post_pad_blocks));
+      }
+      break;
+
+    case Mode::Reflect:
+    case Mode::Wrap:
+      if (inner_no_pad_size == 1) {
+        if (mode == Mode::Reflect) {
+          PadInnermostAxis(axis_start - pre_pad, axis_start + pre_pad, -1 /* inputDelta */, onnxruntime::narrow<size_t>(pre_pad));
+          PadInnermostAxis(axis_end, axis_end - 2, -1 /* inputDelta */, onnxruntime::narrow<size_t>(post_pad));
+        } else {
+          PadInnermostAxis(axis_start - pre_pad, axis_end - pre_pad, 1 /* inputDelta */, onnxruntime::narrow<size_t>(pre_pad));
+          PadInnermostAxis(axis_end, axis_start, 1 /* inputDelta */, onnxruntime::narrow<size_t>(post_pad));
+        }
+      } else {
+        // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
+        if (mode == Mode::Reflect) {
+          PadAxis(
+              axis_start - pre_pad,
+              axis_start + pre_pad,
+              1,
+              -ptrdiff_t(inner_no_pad_size * 2),
+              inner_no_pad_size,
+              onnxruntime::narrow<size_t>(pre_pad_blocks));
+          PadAxis(
+              axis_end,
+              axis_end - 2 * inner_no_pad_size,
+              1,
+              -ptrdiff_t(inner_no_pad_size * 2),
+              inner_no_pad_size,
+              onnxruntime::narrow<size_t>(post_pad_blocks));
+        } else {
+          PadAxis(
+              axis_start - pre_pad,
+              axis_end - pre_pad_blocks * inner_no_pad_size,
+              1,
+              0,
+              inner_no_pad_size,
+              onnxruntime::narrow<size_t>(pre_pad_blocks));
+          PadAxis(
+              axis_end,
+              axis_start,
+              1,
+              0,
+              inner_no_pad_size,
+              onnxruntime::narrow<size_t>(post_pad_blocks));
+        }
+      }
+      break;
+  }
+}
+
+// Returns true if every output row can be produced from a single input row, which is the case when the padding of
+// each outer axis only reaches into the input extent of that axis.
+static bool CanPadRowsIndependently(const Mode& mode, const PadsVector& reshaped_pad,
+                                    gsl::span<const int64_t> input_extents) {
+  const size_t new_dims_count = input_extents.size();
+  for (size_t i = 0; i < new_dims_count; i++) {
+    const int64_t extent = input_extents[i];
+    const int64_t max_pad = std::max(reshaped_pad[i], reshaped_pad[i + new_dims_count]);
+    if (extent <= 0 ||
+        (mode == Mode::Reflect && i + 1 < new_dims_count && max_pad > extent - 1) ||
+        (mode == Mode::Wrap && i + 1 < new_dims_count && max_pad > extent)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename T>
 static Status PadImpl(OpKernelContext* ctx,
                       const PadsVector& pads,
@@ -481,6 +574,65 @@ static Status PadImpl(OpKernelContext* ctx,
   auto& output_tensor = *ctx->Output(0, output_shape);
   auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
 
+  // Produce the output rows in parallel. Each row of the flattened innermost axis is either padding or a copy of one
+  // input row, found by resolving the padding of the outer axes per mode, followed by the padding of the row itself.
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+  const auto num_rows = onnxruntime::narrow<std::ptrdiff_t>(TensorShape(reshaped_output_dims).SizeToDimension(inner_axis));
+  if (num_rows > 1 && concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 &&
+      CanPadRowsIndependently(mode, reshaped_pad, input_extents)) {
+    const TensorPitches input_pitches(reshaped_input_dims);
+    const auto* input_data = reinterpret_cast<const T*>(input_tensor.DataRaw());
+    const auto row_size = onnxruntime::narrow<size_t>(reshaped_output_dims[inner_axis]);
+    const int64_t pre_pad = reshaped_pad[inner_axis];
+    const int64_t post_pad = reshaped_pad[inner_axis + new_dims_count];
+
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, num_rows,
+        TensorOpCost{static_cast<double>(row_size * sizeof(T)), static_cast<double>(row_size * sizeof(T)), 0.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            T* row_output = output + static_cast<size_t>(row) * row_size;
+            int64_t index = row;
+            int64_t input_offset = input_starts[inner_axis];
+            bool is_pad_row = false;
+            for (size_t i = inner_axis; i-- > 0;) {
+              const int64_t extent = input_extents[i];
+              int64_t coordinate = index % reshaped_output_dims[i] - reshaped_pad[i];
+              index /= reshaped_output_dims[i];
+              if (coordinate < 0 || coordinate >= extent) {
+                switch (mode) {
+                  case Mode::Constant:
+                    is_pad_row = true;
+                    break;
+                  case Mode::Edge:
+                    coordinate = coordinate < 0 ? 0 : extent - 1;
+                    break;
+                  case Mode::Reflect:
+                    coordinate = coordinate < 0 ? -coordinate : 2 * (extent - 1) - coordinate;
+                    break;
+                  case Mode::Wrap:
+                    coordinate = coordinate < 0 ? coordinate + extent : coordinate - extent;
+                    break;
+                }
+              }
+              input_offset += (coordinate + input_starts[i]) * input_pitches[i];
+            }
+
+            if (is_pad_row) {
+              PadAxisConstant(row_output, value, row_size);
+              continue;
+            }
+
+            T* axis_start = row_output + pre_pad;
+            T* axis_end = std::copy_n(input_data + input_offset, input_extents[inner_axis], axis_start);
+            PadInnermostRow(mode, axis_start, axis_end, pre_pad, post_pad, inner_no_pad_size,
+                            pads[inner_axis], pads[inner_axis + data_rank], value);
+          }
+        });
+
+    return Status::OK();
+  }
+
   TensorPitches output_pitches(reshaped_output_dims);
   size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
 
@@ -503,8 +655,8 @@ static Status PadImpl(OpKernelContext* ctx,
 
           int64_t prePad = reshaped_pad[inner_axis];
           int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, onnxruntime::narrow<size_t>(prePad));
-          PadAxisConstant(output, value, onnxruntime::narrow<size_t>(postPad));
+          PadInnermostRow(mode, axisStart, output, prePad, postPad, inner_no_pad_size,
+                          pads[inner_axis], pads[inner_axis + data_rank], value);
           output += postPad;
           alignSkip = onnxruntime::narrow<size_t>(prePad);
         }
@@ -534,15 +686,8 @@ static Status PadImpl(OpKernelContext* ctx,
 
           int64_t prePad = reshaped_pad[inner_axis];
           int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadAxisConstant(axisStart - prePad, *axisStart, onnxruntime::narrow<size_t>(prePad));
-            PadAxisConstant(output, *(output - 1), onnxruntime::narrow<size_t>(postPad));
-          } else {
-            // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
-            // Also general loop below after handling first pad axis with non-pad axis works fine.
-            PadAxis(axisStart - prePad, axisStart, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis]));
-            PadAxis(output, output - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-          }
+          PadInnermostRow(mode, axisStart, output, prePad, postPad, inner_no_pad_size,
+                          pads[inner_axis], pads[inner_axis + data_rank], value);
           output += postPad;
           alignSkip = onnxruntime::narrow<size_t>(prePad);
         }
@@ -573,48 +718,8 @@ static Status PadImpl(OpKernelContext* ctx,
 
           int64_t prePad = reshaped_pad[inner_axis];
           int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            if (mode == Mode::Reflect) {
-              PadInnermostAxis(axisStart - prePad, axisStart + prePad, -1 /* inputDelta */, onnxruntime::narrow<size_t>(prePad));
-              PadInnermostAxis(output, output - 2, -1 /* inputDelta */, onnxruntime::narrow<size_t>(postPad));
-            } else {
-              PadInnermostAxis(axisStart - prePad, output - prePad, 1 /* inputDelta */, onnxruntime::narrow<size_t>(prePad));
-              PadInnermostAxis(output, axisStart, 1 /* inputDelta */, onnxruntime::narrow<size_t>(postPad));
-            }
-          } else {
-            // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
-            if (mode == Mode::Reflect) {
-              PadAxis(
-                  axisStart - prePad,
-                  axisStart + prePad,
-                  1,
-                  -ptrdiff_t(inner_no_pad_size * 2),
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis]));
-              PadAxis(
-                  output,
-                  output - 2 * inner_no_pad_size,
-                  1,
-                  -ptrdiff_t(inner_no_pad_size * 2),
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-            } else {
-              PadAxis(
-                  axisStart - prePad,
-                  output - pads[inner_axis] * inner_no_pad_size,
-                  1,
-                  0,
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis]));
-              PadAxis(
-                  output,
-                  axisStart,
-                  1,
-                  0,
-                  inner_no_pad_size,
-                  onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-            }
-          }
+          PadInnermostRow(mode, axisStart, output, prePad, postPad, inner_no_pad_size,
+                          pads[inner_axis], pads[inner_axis + data_rank], value);
           output += postPad;
           alignSkip = onnxruntime::narrow<size_t>(prePad);
         }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Scatter
+#include <algorithm>
 #include <type_traits>
 #include <core/common/safeint.h>
 
@@ -10,6 +11,7 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 #if defined(ENABLE_TRAINING_OPS)
@@ -266,7 +268,7 @@ template <class Tdata, typename FuncT>
 Status ScatterData(
     const FuncT& func,
     const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-    Tensor* data_output) {
+    Tensor* data_output, concurrency::ThreadPool* tp) {
   const TensorShape& input_data_shape = data_input->Shape();
 
   const auto input_elements = input_data_shape.Size();
@@ -296,17 +298,9 @@ Status ScatterData(
   const auto num_dims = input_data_shape.NumDimensions();
   ORT_RETURN_IF_NOT(num_dims > 0, "ScatterElements op: input tensor must have at least one dimension");
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
+  if (num_indices == 0) {
+    return Status::OK();
+  }
 
   // This vector contains number of elements under the dimension.
   // For example, for the dimensions of [4, 2, 3] the vector
@@ -314,11 +308,11 @@ Status ScatterData(
   // contains 3 elements of dim 2.
   // For each count of dim 0 we would have 2x3=6 elements.
   // The last value is always 1.
-  // We use it to compute output element offset. For a given value of
-  // counters we multiple each counter value per corresponding entry of dim_block_size value
-  // and add up resulting the output element offset. However, for dimensions
-  // that are equal to the specified axis value we take indices_data[index]
-  // instead of the counter value.
+  // We use it to compute output element offset. For a given update
+  // we multiply each of its coordinates by the corresponding entry of dim_block_size
+  // and add up resulting the output element offset. However, for the dimension
+  // that is equal to the specified axis value we take indices_data[index]
+  // instead of the coordinate.
   // E.g. for 3-dim and axis=0
   //    output[indices[i][j][k]][j][k] = updates[i][j][k]
   // for axis 1
@@ -335,64 +329,90 @@ Status ScatterData(
     }
   }
 
+  // The updates are split into columns by their coordinates other than the one of axis. Updates in different columns
+  // have different destinations, so the columns are processed in parallel, while the updates of a column are applied
+  // along axis in order. This keeps reductions free of write conflicts and resolves duplicate indices in the same
+  // order as a serial loop over the updates.
+  const auto axis_dim = narrow<size_t>(axis);
+  const int64_t outer_count = upd_shape.SizeToDimension(axis_dim);
+  const int64_t axis_count = upd_shape[axis_dim];
+  const int64_t inner_count = upd_shape.SizeFromDimension(axis_dim + 1);
+  const int64_t axis_block_size = dim_block_size[axis_dim];
+
+  // Output offsets of the coordinates before and after axis.
+  std::vector<int64_t> outer_offsets(narrow<size_t>(outer_count));
+  for (int64_t outer = 0; outer < outer_count; ++outer) {
+    int64_t index = outer;
+    int64_t offset = 0;
+    for (size_t i = axis_dim; i-- > 0;) {
+      offset += (index % upd_shape[i]) * dim_block_size[i];
+      index /= upd_shape[i];
+    }
+    outer_offsets[narrow<size_t>(outer)] = offset;
+  }
+  std::vector<int64_t> inner_offsets(narrow<size_t>(inner_count));
+  for (int64_t inner = 0; inner < inner_count; ++inner) {
+    int64_t index = inner;
+    int64_t offset = 0;
+    for (size_t i = num_dims; i-- > axis_dim + 1;) {
+      offset += (index % upd_shape[i]) * dim_block_size[i];
+      index /= upd_shape[i];
+    }
+    inner_offsets[narrow<size_t>(inner)] = offset;
+  }
+
   const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const auto axis_idx = indices_data[narrow<size_t>(index)];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += narrow<size_t>(axis_idx * dim_block_size[narrow<size_t>(i)]);
-      } else {
-        dst_offset += narrow<size_t>(dim_counters[narrow<size_t>(i)] * dim_block_size[narrow<size_t>(i)]);
+  auto scatter_columns = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t column = first; column < last;) {
+      const int64_t outer = column / inner_count;
+      const int64_t inner_begin = column % inner_count;
+      const int64_t inner_end = std::min<int64_t>(inner_count, inner_begin + (last - column));
+      Tdata* dst_outer = dst_base + outer_offsets[narrow<size_t>(outer)];
+
+      for (int64_t axis_idx = 0; axis_idx < axis_count; ++axis_idx) {
+        const int64_t update_base = (outer * axis_count + axis_idx) * inner_count;
+        for (int64_t inner = inner_begin; inner < inner_end; ++inner) {
+          const int64_t index = update_base + inner;
+          func(dst_outer + indices_data[narrow<size_t>(index)] * axis_block_size + inner_offsets[narrow<size_t>(inner)],
+               update_data + index);
+        }
       }
+      column += inner_end - inner_begin;
     }
+  };
 
-    func(dst_base + dst_offset, update_data + index);
+  // The first column runs on this thread, so that a reduction that is not supported for Tdata reports its error
+  // before any work is handed to the thread pool.
+  scatter_columns(0, 1);
+
+  const double bytes_per_column = static_cast<double>(axis_count) * (sizeof(Tdata) + sizeof(int64_t));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(outer_count * inner_count - 1),
+      TensorOpCost{bytes_per_column, static_cast<double>(axis_count * sizeof(Tdata)), static_cast<double>(axis_count)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) { scatter_columns(first + 1, last + 1); });
 
-    if (++index == num_indices) {
-      break;
-    }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[narrow<size_t>(i)];
-      assert(v <= upd_shape[narrow<size_t>(i)]);
-      if (v < upd_shape[narrow<size_t>(i)]) {
-        // No carry, done
-        break;
-      }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[narrow<size_t>(i)] = 0;
-    }
-  }
   return Status::OK();
 }
 
 template <typename TData>
 struct ScatterDataDispatchTarget {
   Status operator()(const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-                    const std::string& reduction, Tensor* data_output) const {
+                    const std::string& reduction, Tensor* data_output, concurrency::ThreadPool* tp) const {
     if (reduction == "add")
       return ScatterData<TData>(
-          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "mul")
       return ScatterData<TData>(
-          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "min")
       return ScatterData<TData>(
-          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else if (reduction == "max")
       return ScatterData<TData>(
-          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
     else  // if (reduction == "none")
       return ScatterData<TData>(
-          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output, tp);
   }
 };
 
@@ -462,7 +482,7 @@ Status Scatter<EnabledDataTypes>::Compute(OpKernelContext* context) const {
 
   utils::MLTypeCallDispatcherFromTypeList<EnabledDataTypes> dispatcher{data_type};
   status = dispatcher.template InvokeRet<Status, ScatterDataDispatchTarget>(
-      data_input, indices_data, updates_input, axis, this->reduction_, data_output);
+      data_input, indices_data, updates_input, axis, this->reduction_, data_output, context->GetOperatorThreadPool());
 
   return status;
 }
@@ -483,7 +503,7 @@ Status GatherElementsGradImpl(const Tensor* indices_input, const Tensor* updates
                               const int64_t axis, Tensor* data_output) {
   std::vector<int64_t> indices_data{};
   ORT_RETURN_IF_ERROR(GetIndices<Tin>(*data_output, *indices_input, axis, indices_data));
-  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output);
+  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output, nullptr);
 }
 
 #define GATHER_ELEMENTS_GRAD_IMPL_SPECIALIZED(Tin, Tdata) \
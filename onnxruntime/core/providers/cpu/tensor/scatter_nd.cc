@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -396,11 +399,58 @@ struct ScatterNDDispatchTarget {
         } break;
       }
     };
+
+    const size_t offset_count = prepare.element_offsets.size();
+    if (offset_count == 0) {
+      return Status::OK();
+    }
+
+    // The first update runs on this thread, so that a reduction that is not supported for TData reports its error
+    // before any work is handed to the thread pool.
+    lambda(0);
+
+    // Update slices either share their destination or do not overlap. With a reduction, the updates of a shared
+    // destination are grouped and applied in order by one thread, so that they do not race; the groups run in
+    // parallel. The grouping is skipped when every destination is distinct.
+    std::vector<size_t> order;
+    std::vector<size_t> group_starts;
+    if (reduction != ScatterND::Reduction::None) {
+      order.resize(offset_count);
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::stable_sort(order.begin(), order.end(), [&prepare](size_t lhs, size_t rhs) {
+        return prepare.element_offsets[lhs] < prepare.element_offsets[rhs];
+      });
+      for (size_t k = 0; k < offset_count; ++k) {
+        if (k == 0 || prepare.element_offsets[order[k]] != prepare.element_offsets[order[k - 1]]) {
+          group_starts.push_back(k);
+        }
+      }
+      group_starts.push_back(offset_count);
+    }
+
+    if (group_starts.empty() || group_starts.size() - 1 == offset_count) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, offset_count - 1, static_cast<double>(prepare.element_to_copy),
+          [&lambda](ptrdiff_t first, ptrdiff_t last) {
+            for (int i = static_cast<int>(first) + 1, end = static_cast<int>(last) + 1; i < end; ++i) {
+              lambda(i);
+            }
+          });
+      return Status::OK();
+    }
+
+    const size_t group_count = group_starts.size() - 1;
     concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
+        tp, group_count,
+        static_cast<double>(prepare.element_to_copy) * static_cast<double>(offset_count) / group_count,
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          for (size_t group = static_cast<size_t>(first), end = static_cast<size_t>(last); group < end; ++group) {
+            for (size_t k = group_starts[group]; k < group_starts[group + 1]; ++k) {
+              // The first update was already applied above.
+              if (order[k] != 0) {
+                lambda(static_cast<int64_t>(order[k]));
+              }
+            }
           }
         });
     return Status::OK();
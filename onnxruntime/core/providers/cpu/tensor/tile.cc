@@ -11,6 +11,7 @@
 
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -57,46 +58,48 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
+// Tile the input one output row at a time. The trailing axes with a repeat of 1 are folded into the row, so that a
+// row is a contiguous run of the input that is copied repeats[axis] times, and each copy is a unit of parallel work.
+Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats,
+                                 concurrency::ThreadPool* thread_pool, size_t element_size) {
+  const auto& input_shape = input_tensor.Shape();
+  const auto& output_shape = output_tensor.Shape();
 
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
+  size_t axis = input_shape.NumDimensions() - 1;
+  while (axis > 0 && repeats[axis] == 1) {
+    --axis;
+  }
 
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
+  const size_t row_bytes = SafeInt<size_t>(input_shape.SizeFromDimension(axis)) * element_size;
+  const auto num_repeats = onnxruntime::narrow<std::ptrdiff_t>(repeats[axis]);
+  const auto num_rows = onnxruntime::narrow<std::ptrdiff_t>(output_shape.SizeToDimension(axis));
 
-  while (input_counters) {
-    // Copy the input data over
-    block_size = SafeInt<size_t>(innermost_dim) * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
+  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
+  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
 
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, num_rows * num_repeats,
+      TensorOpCost{static_cast<double>(row_bytes), static_cast<double>(row_bytes), 0.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t copy = first; copy < last;) {
+          // Map the output row to the input row it repeats.
+          const std::ptrdiff_t row = copy / num_repeats;
+          int64_t index = row;
+          size_t input_offset = 0;
+          size_t input_pitch = row_bytes;
+          for (size_t d = axis; d-- > 0;) {
+            input_offset += static_cast<size_t>((index % output_shape[d]) % input_shape[d]) * input_pitch;
+            index /= output_shape[d];
+            input_pitch *= static_cast<size_t>(input_shape[d]);
+          }
+
+          const std::ptrdiff_t row_last = std::min(last, (row + 1) * num_repeats);
+          for (; copy < row_last; ++copy) {
+            memcpy(output + static_cast<size_t>(copy) * row_bytes, input + input_offset, row_bytes);
+          }
+        }
+      });
 
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = onnxruntime::narrow<size_t>(output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()]);
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
-    }
-  }
   return Status::OK();
 }
 
@@ -218,6 +221,8 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
   bool is_batched_memcpy = false;
   size_t num_of_elements_per_batch = 1;
   size_t num_of_copies_per_batch = 1;
@@ -236,68 +241,75 @@ Status Tile::Compute(OpKernelContext* ctx) const {
 
     if (!is_batched_memcpy) {
       size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, static_cast<std::ptrdiff_t>(num_of_copies_per_batch),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              memcpy(static_cast<void*>(output_data_casted + static_cast<size_t>(i) * copy_bytes), input_data_raw,
+                     copy_bytes);
+            }
+          });
     } else {
       size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
       size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
 
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, static_cast<std::ptrdiff_t>(batch_count * num_of_copies_per_batch),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              const size_t batch = static_cast<size_t>(i) / num_of_copies_per_batch;
+              memcpy(static_cast<void*>(output_data_casted + static_cast<size_t>(i) * copy_bytes),
+                     static_cast<const void*>(input_data_casted + batch * copy_bytes), copy_bytes);
+            }
+          });
 
       // Now account for batch dim repeat
       if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
         copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
+        concurrency::ThreadPool::TryParallelFor(
+            thread_pool, static_cast<std::ptrdiff_t>(num_of_batch_copies - 1),
+            TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0.0},
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              for (std::ptrdiff_t i = first; i < last; ++i) {
+                memcpy(static_cast<void*>(output_data_casted + static_cast<size_t>(i + 1) * copy_bytes),
+                       static_cast<const void*>(output_data_casted), copy_bytes);
+              }
+            });
       }
     }
 
     return Status::OK();
   }
 
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
   static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
   static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
 
-  if (input_tensor.IsDataType<std::string>())
+  if (input_tensor.IsDataType<std::string>()) {
+    TensorAxisCounters input_counters(input_tensor);
+    TensorPitches output_pitches(output_tensor);
     return TileCoreForStringType(input_tensor, output_tensor, repeats, input_counters, output_pitches);
+  }
 
   if (input_tensor.IsDataType<float>() ||
       input_tensor.IsDataType<int32_t>() ||
       input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, thread_pool, sizeof(float));
 
   if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
       input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, thread_pool, sizeof(double));
 
   else if (input_tensor.IsDataType<int8_t>() ||
            input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, thread_pool, sizeof(int8_t));
 
   if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, thread_pool, sizeof(int16_t));
 
   else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
+    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, thread_pool, sizeof(bool));
 
   // TODO: Support 'string' and 'float16' types for completeness
   else
@@ -7,8 +7,10 @@
 
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
+#include "core/common/span_utils.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample_antialias.h"
+#include "core/util/math_cpuonly.h"
 
 using namespace onnxruntime::common;
 using namespace std;
@@ -556,6 +558,108 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
   return p;
 }
 
+void UpsampleBilinearSeparable(const int64_t image_count,
+                               const int32_t num_channels,
+                               const int32_t input_height,
+                               const int32_t input_width,
+                               const int32_t output_height,
+                               const int32_t output_width,
+                               const BilinearParams& p,
+                               const bool use_extrapolation,
+                               const float extrapolation_value,
+                               const float* const XdataBase,
+                               float* const YdataBase,
+                               concurrency::ThreadPool* tp) {
+  const size_t input_row_size = SafeInt<size_t>(input_width) * num_channels;
+  const size_t output_row_size = SafeInt<size_t>(output_width) * num_channels;
+  const size_t input_image_size = SafeInt<size_t>(input_height) * input_row_size;
+
+  // Interpolates the input row that starts at the given pixel offset along the width axis.
+  auto horizontal_pass = [&](const float* Xdata, int32_t row_offset, float* row) {
+    const float* input_row = Xdata + static_cast<size_t>(row_offset) * num_channels;
+    if (num_channels == 1) {
+      for (int32_t x = 0; x < output_width; ++x) {
+        row[x] = p.dx2[x] * input_row[p.in_x1[x]] + p.dx1[x] * input_row[p.in_x2[x]];
+      }
+    } else {
+      for (int32_t x = 0; x < output_width; ++x) {
+        const float* X1 = input_row + static_cast<size_t>(p.in_x1[x]) * num_channels;
+        const float* X2 = input_row + static_cast<size_t>(p.in_x2[x]) * num_channels;
+        float* Y = row + static_cast<size_t>(x) * num_channels;
+        for (int32_t c = 0; c < num_channels; ++c) {
+          Y[c] = p.dx2[x] * X1[c] + p.dx1[x] * X2[c];
+        }
+      }
+    }
+  };
+
+  const TensorOpCost cost{static_cast<double>(output_row_size * sizeof(float) * 2),
+                          static_cast<double>(output_row_size * sizeof(float)),
+                          static_cast<double>(output_row_size * 6)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(image_count * output_height), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // Two horizontally interpolated rows are kept, tagged with the image and the input row they came from, so
+        // that the output rows which fall between the same pair of input rows only run the vertical pass.
+        std::vector<float> row_buffer(output_row_size * 2);
+        float* rows[2] = {row_buffer.data(), row_buffer.data() + output_row_size};
+        int32_t row_offsets[2] = {-1, -1};
+        int64_t row_image = -1;
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t image = static_cast<int64_t>(i) / output_height;
+          const int32_t y = static_cast<int32_t>(static_cast<int64_t>(i) % output_height);
+          float* const Yrow = YdataBase + static_cast<size_t>(i) * output_row_size;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value for the whole row.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Yrow, output_row_size, extrapolation_value);
+            continue;
+          }
+
+          const float* const Xdata = XdataBase + static_cast<size_t>(image) * input_image_size;
+          if (image != row_image) {
+            row_offsets[0] = row_offsets[1] = -1;
+            row_image = image;
+          }
+
+          const int32_t offset1 = p.input_width_mul_y1[y];
+          const int32_t offset2 = p.input_width_mul_y2[y];
+          int slot1 = row_offsets[0] == offset1 ? 0 : (row_offsets[1] == offset1 ? 1 : -1);
+          int slot2 = row_offsets[0] == offset2 ? 0 : (row_offsets[1] == offset2 ? 1 : -1);
+          if (slot1 < 0) {
+            slot1 = slot2 == 0 ? 1 : 0;
+            horizontal_pass(Xdata, offset1, rows[slot1]);
+            row_offsets[slot1] = offset1;
+          }
+          if (slot2 < 0) {
+            slot2 = offset2 == offset1 ? slot1 : 1 - slot1;
+            if (slot2 != slot1) {
+              horizontal_pass(Xdata, offset2, rows[slot2]);
+              row_offsets[slot2] = offset2;
+            }
+          }
+
+          EigenVectorArrayMap<float>(Yrow, output_row_size) =
+              ConstEigenVectorArrayMap<float>(rows[slot1], output_row_size) * p.dy2[y] +
+              ConstEigenVectorArrayMap<float>(rows[slot2], output_row_size) * p.dy1[y];
+
+          // when use_extrapolation is set and original index of x is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation) {
+            for (int32_t x = 0; x < output_width; ++x) {
+              if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+                std::fill_n(Yrow + static_cast<size_t>(x) * num_channels, num_channels, extrapolation_value);
+              }
+            }
+          }
+        }
+      });
+}
+
 // Same as above, but doesn't use any floating-point for the coefficient (i.e., d*_scale_10) computation
 BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const int32_t input_width,
@@ -918,197 +1022,201 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Builds the taps of one axis for bicubic resizing: the CubicModeGridLength input coordinates that each output
+// coordinate reads (clamped to the input) and their weights.
+static void SetupUpsampleBiCubicAxis(int64_t input_size,
+                                     int64_t output_size,
+                                     float scale,
+                                     float cubic_coeff_a,
+                                     bool exclude_outside,
+                                     float roi_start,
+                                     float roi_end,
+                                     const GetOriginalCoordinateFunc& get_original_coordinate,
+                                     std::vector<float>& original,
+                                     std::vector<int64_t>& taps,
+                                     std::vector<float>& weights) {
+  original.reserve(narrow<size_t>(output_size));
+  taps.reserve(narrow<size_t>(output_size) * CubicModeGridLength);
+  weights.reserve(narrow<size_t>(output_size) * CubicModeGridLength);
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    float in = scale == 1 ? static_cast<float>(i)
+                          : get_original_coordinate(static_cast<float>(i), scale,
+                                                    static_cast<float>(output_size),
+                                                    static_cast<float>(input_size),
+                                                    roi_start, roi_end);
+    original.emplace_back(in);
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+    float coeff_sum = 1;
+
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t k = 0, val = in_int - 1; val <= in_int + 2; val++, k++) {
+        if (val < 0 || val >= input_size) {
+          coeffs[narrow<size_t>(k)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(k)];
+      }
+    }
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
+    for (int64_t k = 0, val = in_int - 1; val <= in_int + 2; val++, k++) {
+      taps.emplace_back(std::max(static_cast<int64_t>(0), std::min(val, input_size - 1)));
+      weights.emplace_back(coeffs[narrow<size_t>(k)] / coeff_sum);
+    }
   }
+}
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
-  }
-  cache[grid_start_pos] = result;
+BicubicParams SetupUpsampleBiCubic(int64_t input_height,
+                                   int64_t input_width,
+                                   int64_t output_height,
+                                   int64_t output_width,
+                                   float height_scale,
+                                   float width_scale,
+                                   float cubic_coeff_a,
+                                   bool exclude_outside,
+                                   gsl::span<const float> roi,
+                                   const GetOriginalCoordinateFunc& get_original_coordinate) {
+  BicubicParams p;
+
+  const auto roi_y_start = roi.size() / 2 - 2;
+  const auto roi_y_end = roi.size() - 2;
+  const auto roi_x_start = roi.size() / 2 - 1;
+  const auto roi_x_end = roi.size() - 1;
+
+  SetupUpsampleBiCubicAxis(input_height, output_height, height_scale, cubic_coeff_a, exclude_outside,
+                           roi[roi_y_start], roi[roi_y_end], get_original_coordinate,
+                           p.y_original, p.in_y, p.y_weights);
+  SetupUpsampleBiCubicAxis(input_width, output_width, width_scale, cubic_coeff_a, exclude_outside,
+                           roi[roi_x_start], roi[roi_x_end], get_original_coordinate,
+                           p.x_original, p.in_x, p.x_weights);
 
-  return result;
+  return p;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
+
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
                    int64_t input_height,
                    int64_t input_width,
                    int64_t output_height,
                    int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
+                   const BicubicParams& p,
                    bool use_extrapolation,
                    float extrapolation_value,
-                   bool exclude_outside,
-                   gsl::span<const float> roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+                   const float* XdataBase,
+                   float* YdataBase,
+                   concurrency::ThreadPool* tp) {
+  const size_t input_image_size = SafeInt<size_t>(input_height) * input_width;
+  const size_t row_size = narrow<size_t>(output_width);
+
+  // Interpolates the input row along the width axis.
+  auto horizontal_pass = [&](const float* input_row, float* row) {
+    const int64_t* taps = p.in_x.data();
+    const float* weights = p.x_weights.data();
+    for (size_t x = 0; x < row_size; ++x) {
+      row[x] = weights[0] * input_row[taps[0]] + weights[1] * input_row[taps[1]] +
+               weights[2] * input_row[taps[2]] + weights[3] * input_row[taps[3]];
+      taps += CubicModeGridLength;
+      weights += CubicModeGridLength;
     }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
+  };
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+  const TensorOpCost cost{static_cast<double>(row_size * sizeof(float) * CubicModeGridLength),
+                          static_cast<double>(row_size * sizeof(float)),
+                          static_cast<double>(row_size * CubicModeGridLength * 4)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // The taps of an output row are consecutive input rows (or repeats of the first or last row), so keying
+        // the horizontally interpolated rows by the input row modulo CubicModeGridLength never evicts a row that
+        // the same output row still needs.
+        std::vector<float> row_buffer(row_size * CubicModeGridLength);
+        std::array<int64_t, CubicModeGridLength> row_indices;
+        int64_t row_image = -1;
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t image = static_cast<int64_t>(i) / output_height;
+          const int64_t y = static_cast<int64_t>(i) % output_height;
+          float* const Yrow = YdataBase + static_cast<size_t>(i) * row_size;
+          const auto in_y = p.y_original[narrow<size_t>(y)];
 
           // when use_extrapolation is set and original index is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+            std::fill_n(Yrow, row_size, extrapolation_value);
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
-            }
+          const float* const Xdata = XdataBase + static_cast<size_t>(image) * input_image_size;
+          if (image != row_image) {
+            row_indices.fill(-1);
+            row_image = image;
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
+          const int64_t* taps = p.in_y.data() + y * CubicModeGridLength;
+          const float* weights = p.y_weights.data() + y * CubicModeGridLength;
+          std::array<const float*, CubicModeGridLength> rows;
+          for (size_t k = 0; k < CubicModeGridLength; k++) {
+            const auto slot = static_cast<size_t>(taps[k]) % CubicModeGridLength;
+            float* row = row_buffer.data() + slot * row_size;
+            if (row_indices[slot] != taps[k]) {
+              horizontal_pass(Xdata + static_cast<size_t>(taps[k]) * input_width, row);
+              row_indices[slot] = taps[k];
+            }
+            rows[k] = row;
           }
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+          EigenVectorArrayMap<float>(Yrow, row_size) =
+              ConstEigenVectorArrayMap<float>(rows[0], row_size) * weights[0] +
+              ConstEigenVectorArrayMap<float>(rows[1], row_size) * weights[1] +
+              ConstEigenVectorArrayMap<float>(rows[2], row_size) * weights[2] +
+              ConstEigenVectorArrayMap<float>(rows[3], row_size) * weights[3];
+
+          if (use_extrapolation) {
+            for (size_t x = 0; x < row_size; ++x) {
+              if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+                Yrow[x] = extrapolation_value;
+              }
+            }
+          }
         }
-      }
+      });
+}
 
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
+template <typename T>
+template <typename Params, typename SetupFn>
+std::shared_ptr<const Params> Upsample<T>::GetInterpolationTables(
+    std::shared_ptr<const Params> InterpolationTables::*entry,
+    gsl::span<const int64_t> input_dims,
+    gsl::span<const int64_t> output_dims,
+    gsl::span<const float> scales,
+    gsl::span<const float> roi,
+    const SetupFn& setup) const {
+  std::lock_guard<std::mutex> lock(interpolation_tables_mutex_);
+  auto& tables = interpolation_tables_;
+
+  if (!SpanEq(gsl::make_span(tables.input_dims), input_dims) ||
+      !SpanEq(gsl::make_span(tables.output_dims), output_dims) ||
+      !SpanEq(gsl::make_span(tables.scales), scales) ||
+      !SpanEq(gsl::make_span(tables.roi), roi)) {
+    // Calls that are still running hold their own reference, so replacing the tables never frees them early.
+    tables = InterpolationTables{};
+    tables.input_dims.assign(input_dims.begin(), input_dims.end());
+    tables.output_dims.assign(output_dims.begin(), output_dims.end());
+    tables.scales.assign(scales.begin(), scales.end());
+    tables.roi.assign(roi.begin(), roi.end());
+  }
 
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
+  auto& params = tables.*entry;
+  if (!params) {
+    params = std::make_shared<const Params>(setup());
   }
+  return params;
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1211,6 +1319,20 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
           }
         }
 
+        auto get_bilinear_params = [&]() {
+          return GetInterpolationTables(&InterpolationTables::bilinear, dims, output_dims, scales, roi, [&]() {
+            return SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                         height_scale, width_scale, roi, alloc, get_original_coordinate_, is_nchw);
+          });
+        };
+        auto get_bilinear_integer_params = [&]() {
+          return GetInterpolationTables(&InterpolationTables::bilinear_integer, dims, output_dims, scales, roi, [&]() {
+            return SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                height_scale, width_scale, roi, alloc, get_original_coordinate_,
+                                                is_nchw);
+          });
+        };
+
         if (is_nchw) {
           if (antialias_) {
             UpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
@@ -1219,9 +1341,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                       output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
           } else {
             UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                             height_scale, width_scale, roi,
-                             use_extrapolation_, extrapolation_value_, X->Data<T>(),
-                             Y->MutableData<T>(), alloc, get_original_coordinate_,
+                             *get_bilinear_params(), use_extrapolation_, extrapolation_value_, X->Data<T>(),
+                             Y->MutableData<T>(),
                              output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
           }
         } else {
@@ -1237,14 +1358,12 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                    Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
                 NhwcUpsampleBilinearInteger<T, true>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *get_bilinear_integer_params(), extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               } else {
                 NhwcUpsampleBilinear<T, true>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *get_bilinear_params(), extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               }
             }
@@ -1260,14 +1379,12 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                    Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
                 NhwcUpsampleBilinearInteger<T, false>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *get_bilinear_integer_params(), extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               } else {
                 NhwcUpsampleBilinear<T, false>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *get_bilinear_params(), extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               }
             }
@@ -1358,10 +1475,13 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                    Y->MutableData<T>(), alloc, get_original_coordinate_,
                                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       } else {
-        ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                      height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
-                      extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+        const auto p = GetInterpolationTables(&InterpolationTables::bicubic, dims, output_dims, scales, roi, [&]() {
+          return SetupUpsampleBiCubic(input_height, input_width, output_height, output_width, height_scale,
+                                      width_scale, cubic_coeff_a_, exclude_outside_, roi, get_original_coordinate_);
+        });
+        ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width, *p,
+                      use_extrapolation_, extrapolation_value_, X->Data<float>(), Y->MutableData<float>(),
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
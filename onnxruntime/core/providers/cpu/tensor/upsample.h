@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -58,6 +61,19 @@ struct BilinearParamsInteger {
   int32_t* dy2_scale_10{nullptr};
 };
 
+// Per-axis taps for bicubic resizing. Each output coordinate reads CubicModeGridLength input coordinates, clamped
+// to the input, with weights that already include the renormalization for exclude_outside.
+struct BicubicParams {
+  std::vector<float> x_original;
+  std::vector<float> y_original;
+
+  std::vector<int64_t> in_x;
+  std::vector<int64_t> in_y;
+
+  std::vector<float> x_weights;
+  std::vector<float> y_weights;
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -68,6 +84,32 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, gsl::span<const float> roi, gsl::span<const float> scales,
                      gsl::span<const int64_t> output_dims) const;
+
+ private:
+  // The interpolation tables only depend on the input and output shapes, the scales and the roi (the mode and the
+  // coordinate transformation are attributes), so the tables built for the most recent call are kept and reused
+  // for as long as these stay the same.
+  struct InterpolationTables {
+    TensorShapeVector input_dims;
+    TensorShapeVector output_dims;
+    InlinedVector<float> scales;
+    InlinedVector<float> roi;
+
+    std::shared_ptr<const BilinearParams> bilinear;
+    std::shared_ptr<const BilinearParamsInteger> bilinear_integer;
+    std::shared_ptr<const BicubicParams> bicubic;
+  };
+
+  template <typename Params, typename SetupFn>
+  std::shared_ptr<const Params> GetInterpolationTables(std::shared_ptr<const Params> InterpolationTables::*entry,
+                                                       gsl::span<const int64_t> input_dims,
+                                                       gsl::span<const int64_t> output_dims,
+                                                       gsl::span<const float> scales,
+                                                       gsl::span<const float> roi,
+                                                       const SetupFn& setup) const;
+
+  mutable std::mutex interpolation_tables_mutex_;
+  mutable InterpolationTables interpolation_tables_;
 };
 
 BilinearParams SetupUpsampleBilinear(const int32_t input_height,
@@ -81,6 +123,76 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      const bool is_nchw);
 
+// Resizes float images of image_count x input_height x input_width pixels with num_channels interleaved channels
+// as a horizontal pass over each input row that is used followed by a vertical pass that blends two of these rows.
+// The horizontally interpolated rows are reused by consecutive output rows, and the rows of all of the images are
+// partitioned across the thread pool. NCHW inputs are handled as N * C images with a single channel.
+void UpsampleBilinearSeparable(const int64_t image_count,
+                               const int32_t num_channels,
+                               const int32_t input_height,
+                               const int32_t input_width,
+                               const int32_t output_height,
+                               const int32_t output_width,
+                               const BilinearParams& p,
+                               const bool use_extrapolation,
+                               const float extrapolation_value,
+                               const float* const XdataBase,
+                               float* const YdataBase,
+                               concurrency::ThreadPool* tp);
+
+template <typename T>
+void UpsampleBilinear(const int32_t batch_size,
+                      const int32_t num_channels,
+                      const int32_t input_height,
+                      const int32_t input_width,
+                      const int32_t output_height,
+                      const int32_t output_width,
+                      const BilinearParams& p,
+                      const bool use_extrapolation,
+                      const float extrapolation_value,
+                      const T* const XdataBase,
+                      T* const YdataBase,
+                      concurrency::ThreadPool* tp) {
+  if constexpr (std::is_same_v<T, float>) {
+    UpsampleBilinearSeparable(static_cast<int64_t>(batch_size) * num_channels, 1, input_height, input_width,
+                              output_height, output_width, p, use_extrapolation, extrapolation_value,
+                              XdataBase, YdataBase, tp);
+  } else {
+    for (int32_t n = 0; n < batch_size; ++n) {
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          tp, num_channels,
+          [&](std::ptrdiff_t c) {
+            const T* const Xdata =
+                XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
+            T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
+            for (int32_t y = 0; y < output_height; ++y) {
+              for (int32_t x = 0; x < output_width; ++x) {
+                const int32_t output_offset = output_width * y + x;
+                // when use_extrapolation is set and original index of x or y is out of the dim range
+                // then use extrapolation_value as the output value.
+                if (use_extrapolation &&
+                    ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+                     (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
+                  Ydata[output_offset] = static_cast<T>(extrapolation_value);
+                  continue;
+                }
+
+                T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
+                T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
+                T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
+                T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+
+                Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
+                                                      p.dx1[x] * p.dy2[y] * X21 +
+                                                      p.dx2[x] * p.dy1[y] * X12 +
+                                                      p.dx1[x] * p.dy1[y] * X22);
+              }
+            }
+          });
+    }
+  }
+}
+
 template <typename T>
 void UpsampleBilinear(const int32_t batch_size,
                       const int32_t num_channels,
@@ -101,38 +213,8 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* const Xdata =
-              XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
-          T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
-            for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
-                continue;
-              }
-
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
-
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
-            }
-          }
-        });
-  }
+  UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                   use_extrapolation, extrapolation_value, XdataBase, YdataBase, tp);
 }
 
 template <typename T, bool UseExtrapolation>
@@ -142,37 +224,55 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
                           const int32_t input_width,
                           const int32_t output_height,
                           const int32_t output_width,
-                          const float height_scale,
-                          const float width_scale,
-                          gsl::span<const float> roi,
+                          const BilinearParams& p,
                           const float extrapolation_value,
                           const T* const XdataBase,
                           T* const YdataBase,
-                          AllocatorPtr& alloc,
-                          const GetOriginalCoordinateFunc& get_original_coordinate,
                           concurrency::ThreadPool* tp) {
-  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
-                                           height_scale, width_scale, roi,
-                                           alloc, get_original_coordinate, false);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
-    T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
-    concurrency::ThreadPool::TryParallelFor(
-        tp, static_cast<std::ptrdiff_t>(output_height) * output_width,
-        static_cast<double>(num_channels * 2),
-        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
-          for (std::ptrdiff_t i = first; i < last; ++i) {
-            const int32_t x = static_cast<int32_t>(i % output_width);
-            const int32_t y = static_cast<int32_t>(i / output_width);
-            const int32_t output_offset = (output_width * y + x) * num_channels;
+  if constexpr (std::is_same_v<T, float>) {
+    UpsampleBilinearSeparable(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                              UseExtrapolation, extrapolation_value, XdataBase, YdataBase, tp);
+  } else {
+    for (int32_t n = 0; n < batch_size; ++n) {
+      const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
+      T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(output_height) * output_width,
+          static_cast<double>(num_channels * 2),
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              const int32_t x = static_cast<int32_t>(i % output_width);
+              const int32_t y = static_cast<int32_t>(i / output_width);
+              const int32_t output_offset = (output_width * y + x) * num_channels;
 
-            // when use_extrapolation is set and original index of x or y is out of the dim range
-            // then use extrapolation_value as the output value.
-            if constexpr (UseExtrapolation) {
-              if ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                  (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
-                for (int32_t c = 0; c < num_channels; ++c) {
-                  Ydata[output_offset + c] = static_cast<T>(extrapolation_value);
+              // when use_extrapolation is set and original index of x or y is out of the dim range
+              // then use extrapolation_value as the output value.
+              if constexpr (UseExtrapolation) {
+                if ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+                    (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
+                  for (int32_t c = 0; c < num_channels; ++c) {
+                    Ydata[output_offset + c] = static_cast<T>(extrapolation_value);
+                  }
+                } else {
+                  const int32_t X11_offset = (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
+                  const int32_t X21_offset = (p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels;
+                  const int32_t X12_offset = (p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels;
+                  const int32_t X22_offset = (p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels;
+                  const float X11_coef = p.dx2[x] * p.dy2[y];
+                  const float X21_coef = p.dx1[x] * p.dy2[y];
+                  const float X12_coef = p.dx2[x] * p.dy1[y];
+                  const float X22_coef = p.dx1[x] * p.dy1[y];
+                  for (int32_t c = 0; c < num_channels; ++c) {
+                    const T X11 = Xdata[X11_offset + c];
+                    const T X21 = Xdata[X21_offset + c];
+                    const T X12 = Xdata[X12_offset + c];
+                    const T X22 = Xdata[X22_offset + c];
+
+                    Ydata[output_offset + c] = static_cast<T>(X11_coef * X11 +
+                                                              X21_coef * X21 +
+                                                              X12_coef * X12 +
+                                                              X22_coef * X22);
+                  }
                 }
               } else {
                 const int32_t X11_offset = (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
@@ -195,32 +295,63 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
                                                             X22_coef * X22);
                 }
               }
-            } else {
-              const int32_t X11_offset = (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
-              const int32_t X21_offset = (p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels;
-              const int32_t X12_offset = (p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels;
-              const int32_t X22_offset = (p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels;
-              const float X11_coef = p.dx2[x] * p.dy2[y];
-              const float X21_coef = p.dx1[x] * p.dy2[y];
-              const float X12_coef = p.dx2[x] * p.dy1[y];
-              const float X22_coef = p.dx1[x] * p.dy1[y];
-              for (int32_t c = 0; c < num_channels; ++c) {
-                const T X11 = Xdata[X11_offset + c];
-                const T X21 = Xdata[X21_offset + c];
-                const T X12 = Xdata[X12_offset + c];
-                const T X22 = Xdata[X22_offset + c];
-
-                Ydata[output_offset + c] = static_cast<T>(X11_coef * X11 +
-                                                          X21_coef * X21 +
-                                                          X12_coef * X12 +
-                                                          X22_coef * X22);
-              }
             }
-          }
-        });
+          });
+    }
   }
 }
 
+template <typename T, bool UseExtrapolation>
+void NhwcUpsampleBilinear(const int32_t batch_size,
+                          const int32_t num_channels,
+                          const int32_t input_height,
+                          const int32_t input_width,
+                          const int32_t output_height,
+                          const int32_t output_width,
+                          const float height_scale,
+                          const float width_scale,
+                          gsl::span<const float> roi,
+                          const float extrapolation_value,
+                          const T* const XdataBase,
+                          T* const YdataBase,
+                          AllocatorPtr& alloc,
+                          const GetOriginalCoordinateFunc& get_original_coordinate,
+                          concurrency::ThreadPool* tp) {
+  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi,
+                                           alloc, get_original_coordinate, false);
+  NhwcUpsampleBilinear<T, UseExtrapolation>(batch_size, num_channels, input_height, input_width,
+                                            output_height, output_width, p, extrapolation_value,
+                                            XdataBase, YdataBase, tp);
+}
+
+BicubicParams SetupUpsampleBiCubic(int64_t input_height,
+                                   int64_t input_width,
+                                   int64_t output_height,
+                                   int64_t output_width,
+                                   float height_scale,
+                                   float width_scale,
+                                   float cubic_coeff_a,
+                                   bool exclude_outside,
+                                   gsl::span<const float> roi,
+                                   const GetOriginalCoordinateFunc& get_original_coordinate);
+
+// Bicubic resizing of NCHW float images as a horizontal pass over each input row that is used followed by a
+// vertical pass that blends CubicModeGridLength of these rows. The rows of all of the images are partitioned
+// across the thread pool.
+void ResizeBiCubic(int64_t batch_size,
+                   int64_t num_channels,
+                   int64_t input_height,
+                   int64_t input_width,
+                   int64_t output_height,
+                   int64_t output_width,
+                   const BicubicParams& p,
+                   bool use_extrapolation,
+                   float extrapolation_value,
+                   const float* XdataBase,
+                   float* YdataBase,
+                   concurrency::ThreadPool* tp);
+
 BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const int32_t input_width,
                                                    const int32_t output_height,
@@ -239,18 +370,11 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
                                  const int32_t input_width,
                                  const int32_t output_height,
                                  const int32_t output_width,
-                                 const float height_scale,
-                                 const float width_scale,
-                                 gsl::span<const float> roi,
+                                 const BilinearParamsInteger& p,
                                  const float extrapolation_value,
                                  const T* const XdataBase,
                                  T* const YdataBase,
-                                 AllocatorPtr& alloc,
-                                 const GetOriginalCoordinateFunc& get_original_coordinate,
                                  concurrency::ThreadPool* tp) {
-  BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
-                                                         height_scale, width_scale, roi,
-                                                         alloc, get_original_coordinate, false);
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -320,6 +444,30 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
   }
 }
 
+template <typename T, bool UseExtrapolation>
+void NhwcUpsampleBilinearInteger(const int32_t batch_size,
+                                 const int32_t num_channels,
+                                 const int32_t input_height,
+                                 const int32_t input_width,
+                                 const int32_t output_height,
+                                 const int32_t output_width,
+                                 const float height_scale,
+                                 const float width_scale,
+                                 gsl::span<const float> roi,
+                                 const float extrapolation_value,
+                                 const T* const XdataBase,
+                                 T* const YdataBase,
+                                 AllocatorPtr& alloc,
+                                 const GetOriginalCoordinateFunc& get_original_coordinate,
+                                 concurrency::ThreadPool* tp) {
+  BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                         height_scale, width_scale, roi,
+                                                         alloc, get_original_coordinate, false);
+  NhwcUpsampleBilinearInteger<T, UseExtrapolation>(batch_size, num_channels, input_height, input_width,
+                                                   output_height, output_width, p, extrapolation_value,
+                                                   XdataBase, YdataBase, tp);
+}
+
 }  // namespace onnxruntime
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
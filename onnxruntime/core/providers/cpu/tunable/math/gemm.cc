@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/math/gemm.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+namespace {
+
+// Candidate columns of matrix B per slice (0 keeps the MLAS heuristic) and multiply-adds per thread (0 keeps
+// MLAS_SGEMM_THREAD_COMPLEXITY).
+constexpr size_t kSgemmStrideNCandidates[] = {0, 64, 256, 512};
+constexpr size_t kSgemmThreadComplexityCandidates[] = {0, size_t(16) * 1024, size_t(256) * 1024};
+
+bool HasNonZeroBeta(const SgemmParams* params) {
+  for (size_t i = 0; i < params->batch_size_; i++) {
+    if (params->data_[i].beta != 0.0f) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The proxy params own a copy of each C so that the repeated runs of FindFastest do not accumulate into the real
+// outputs when beta is non-zero.
+struct SgemmProxyParams : SgemmParams {
+  explicit SgemmProxyParams(const SgemmParams& params)
+      : SgemmParams(params), proxy_data_(params.data_, params.data_ + params.batch_size_) {
+    size_t c_size = 0;
+    for (const auto& data : proxy_data_) {
+      c_size = std::max(c_size, m_ == 0 ? 0 : (m_ - 1) * data.ldc + n_);
+    }
+    c_buffer_.resize(c_size * batch_size_);
+    for (size_t i = 0; i < batch_size_; i++) {
+      float* c = c_buffer_.data() + i * c_size;
+      std::copy_n(proxy_data_[i].C, m_ == 0 ? 0 : (m_ - 1) * proxy_data_[i].ldc + n_, c);
+      proxy_data_[i].C = c;
+    }
+    data_ = proxy_data_.data();
+  }
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> proxy_data_;
+  std::vector<float> c_buffer_;
+};
+
+Status SgemmDefault(const SgemmParams* params) {
+  InlinedVector<MLAS_SGEMM_DATA_PARAMS> data(params->data_, params->data_ + params->batch_size_);
+  for (auto& d : data) {
+    d.Tuning = nullptr;
+  }
+  MlasGemmBatch(params->trans_a_, params->trans_b_, params->m_, params->n_, params->k_, data.data(),
+                params->batch_size_, params->thread_pool_);
+  return Status::OK();
+}
+
+class SgemmWithTuningParams {
+ public:
+  SgemmWithTuningParams(size_t stride_n, size_t thread_complexity) {
+    tuning_.StrideN = stride_n;
+    tuning_.ThreadComplexity = thread_complexity;
+  }
+
+  Status operator()(const SgemmParams* params) {
+    ORT_RETURN_IF_ERROR(IsSupported(params));
+    InlinedVector<MLAS_SGEMM_DATA_PARAMS> data(params->data_, params->data_ + params->batch_size_);
+    for (auto& d : data) {
+      d.Tuning = &tuning_;
+    }
+    MlasGemmBatch(params->trans_a_, params->trans_b_, params->m_, params->n_, params->k_, data.data(),
+                  params->batch_size_, params->thread_pool_);
+    return Status::OK();
+  }
+
+  Status IsSupported(const SgemmParams* params) {
+    // A stride wider than B behaves like the default, and the thread partition only matters when there is more
+    // than one thread to partition across.
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+        tuning_.StrideN >= params->n_ + 16, "StrideN ", tuning_.StrideN, " is wider than N ", params->n_);
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+        tuning_.ThreadComplexity != 0 && concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool_) == 1,
+        "ThreadComplexity has no effect when running single threaded");
+    return Status::OK();
+  }
+
+ private:
+  MLAS_SGEMM_TUNING_PARAMS tuning_;
+};
+
+class SgemmTunableOp : public TunableOp<SgemmParams> {
+ public:
+  SgemmTunableOp() {
+    this->RegisterOp(SgemmDefault);
+    for (size_t stride_n : kSgemmStrideNCandidates) {
+      for (size_t thread_complexity : kSgemmThreadComplexityCandidates) {
+        if (stride_n != 0 || thread_complexity != 0) {
+          this->RegisterOp(SgemmWithTuningParams{stride_n, thread_complexity});
+        }
+      }
+    }
+  }
+
+  const SgemmParams* PreTuning(const SgemmParams* params) override {
+    if (HasNonZeroBeta(params)) {
+      return new SgemmProxyParams(*params);
+    }
+    return params;
+  }
+
+  void PostTuning(const SgemmParams* params) override {
+    if (HasNonZeroBeta(params)) {
+      delete static_cast<const SgemmProxyParams*>(params);
+    }
+  }
+};
+
+}  // namespace
+
+Status TunableSgemm(const SgemmParams* params) {
+  static SgemmTunableOp op;
+  return op(params);
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
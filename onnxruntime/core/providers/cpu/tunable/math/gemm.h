@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/status.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+struct SgemmParams : OpParams {
+  SgemmParams(ITuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b, size_t m, size_t n,
+              size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size, concurrency::ThreadPool* thread_pool)
+      : OpParams(tuning_ctx, nullptr),
+        trans_a_(trans_a),
+        trans_b_(trans_b),
+        m_(m),
+        n_(n),
+        k_(k),
+        data_(data),
+        batch_size_(batch_size),
+        thread_pool_(thread_pool) {}
+
+  std::string Signature() const override {
+    return MakeString((trans_a_ != CblasNoTrans ? "T" : "N"), (trans_b_ != CblasNoTrans ? "T" : "N"), "_", m_, "_",
+                      n_, "_", k_, "_", batch_size_, "_", (data_[0].BIsPacked ? "P" : "U"), "_",
+                      concurrency::ThreadPool::DegreeOfParallelism(thread_pool_));
+  }
+
+  CBLAS_TRANSPOSE trans_a_;
+  CBLAS_TRANSPOSE trans_b_;
+  size_t m_;
+  size_t n_;
+  size_t k_;
+  const MLAS_SGEMM_DATA_PARAMS* data_;
+  size_t batch_size_;
+  concurrency::ThreadPool* thread_pool_;
+};
+
+// Runs a batch of SGEMMs through MlasGemmBatch. When TunableOp is enabled for the CPU execution provider, the first
+// call for each (transpose, shape, batch, packing, thread count) signature times the candidate
+// MLAS_SGEMM_TUNING_PARAMS and later calls reuse the fastest one. The Tuning field of the data params is ignored.
+Status TunableSgemm(const SgemmParams* params);
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
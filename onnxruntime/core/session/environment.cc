@@ -206,6 +206,10 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int max_dead_bytes_per_chunk = -1;
     int initial_growth_chunk_size_bytes = -1;
     int64_t max_power_of_two_extend_bytes = -1L;
+    int64_t thread_cache_max_chunk_bytes = -1L;
+    int64_t thread_cache_max_bytes = -1L;
+    int huge_pages = -1;
+    int numa_node = -1;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -215,10 +219,17 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
       initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
       max_power_of_two_extend_bytes = arena_cfg->max_power_of_two_extend_bytes;
+      thread_cache_max_chunk_bytes = arena_cfg->thread_cache_max_chunk_bytes;
+      thread_cache_max_bytes = arena_cfg->thread_cache_max_bytes;
+      huge_pages = arena_cfg->huge_pages;
+      numa_node = arena_cfg->numa_node;
     }
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
-                            initial_growth_chunk_size_bytes, max_power_of_two_extend_bytes};
+                            initial_growth_chunk_size_bytes, max_power_of_two_extend_bytes,
+                            thread_cache_max_chunk_bytes, thread_cache_max_bytes};
+    l_arena_cfg.huge_pages = huge_pages;
+    l_arena_cfg.numa_node = numa_node;
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
         0,
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <sstream>
+#include <limits>
 #include <list>
 #include <string>
 #include <thread>
@@ -51,6 +52,7 @@
 #include "core/optimizer/transformer_memcpy.h"
 #include "core/optimizer/transpose_optimization/ort_optimizer_utils.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/device_discovery.h"
 #include "core/platform/threadpool.h"
 #ifdef _WIN32
 #include "core/platform/tracing.h"
@@ -131,6 +133,45 @@ inline std::basic_string<T> GetCurrentTimeString() {
   return std::basic_string<T>(time_str);
 }
 
+// One intra-op thread pool per NUMA node. The worker threads of each pool may run on any processor of its node.
+std::unique_ptr<NumaPartitions> CreateNumaPartitions(const OrtThreadPoolParams& params) {
+  const auto& numa_nodes = DeviceDiscovery::GetNumaNodes();
+  const int num_nodes = static_cast<int>(numa_nodes.size());
+
+  int num_processors = 0;
+  for (const auto& node : numa_nodes) {
+    num_processors += static_cast<int>(node.processors.size());
+  }
+  const int num_physical_cores = std::max(1, Env::Default().GetNumPhysicalCpuCores());
+
+  std::vector<std::unique_ptr<concurrency::ThreadPool>> thread_pools;
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node = numa_nodes[i];
+    OrtThreadPoolParams to = params;
+    if (params.thread_pool_size > 0) {
+      to.thread_pool_size = std::max(1, params.thread_pool_size / num_nodes + (i < params.thread_pool_size % num_nodes));
+    } else {
+      to.thread_pool_size = std::max(1, static_cast<int>(node.processors.size()) * num_physical_cores /
+                                            std::max(num_processors, 1));
+    }
+
+    // the affinity string has one entry per thread except the calling thread. processor ids start from 1.
+    std::string node_processors;
+    for (int processor : node.processors) {
+      node_processors += (node_processors.empty() ? "" : ",") + std::to_string(processor + 1);
+    }
+    to.affinity_str.clear();
+    for (int t = 1; t < to.thread_pool_size; ++t) {
+      to.affinity_str += (to.affinity_str.empty() ? "" : ";") + node_processors;
+    }
+    to.auto_set_affinity = false;
+
+    thread_pools.push_back(concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP));
+  }
+
+  return std::make_unique<NumaPartitions>(numa_nodes, std::move(thread_pools));
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 
 static bool HasControlflowNodes(const Graph& graph) {
@@ -436,6 +477,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.spin_duration_us = std::stoi(session_options_.config_options.GetConfigOrDefault(
+            kOrtSessionOptionsConfigIntraOpSpinDurationUs, "-1"));
+        to.adaptive_spinning = session_options_.config_options.GetConfigOrDefault(
+                                   kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -454,8 +499,24 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
           ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set for intra op thread pool");
         }
 
-        thread_pool_ =
-            concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+        const bool numa_partitioning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaPartitioning,
+                                                               "0") == "1";
+        if (numa_partitioning && session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL) {
+          ORT_ENFORCE(to.affinity_str.empty(),
+                      "NUMA partitioning of the intra-op threads can't be combined with intra-op thread affinities");
+          numa_partitions_ = CreateNumaPartitions(to);
+          LOGS(*session_logger_, INFO) << "Created " << numa_partitions_->NumPartitions()
+                                       << " intra-op thread pools, one per NUMA node";
+        } else {
+          if (numa_partitioning) {
+            LOGS(*session_logger_, WARNING)
+                << "NUMA partitioning of the intra-op threads requires the sequential execution mode. Ignoring it.";
+          }
+
+          thread_pool_ =
+              concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+        }
       }
     }
     if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
@@ -473,6 +534,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.name = inter_thread_pool_name_.c_str();
         to.set_denormal_as_zero = set_denormal_as_zero;
         to.allow_spinning = allow_inter_op_spinning;
+        to.spin_duration_us = std::stoi(session_options_.config_options.GetConfigOrDefault(
+            kOrtSessionOptionsConfigInterOpSpinDurationUs, "-1"));
+        to.adaptive_spinning = session_options_.config_options.GetConfigOrDefault(
+                                   kOrtSessionOptionsConfigInterOpAdaptiveSpinning, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
 
         // Set custom threading functions
@@ -737,6 +802,12 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (is_inited_) {
+    SaveCpuTuningResults();
+  }
+#endif
+
   // Unregister the session and ETW callbacks
 #ifdef _WIN32
   std::lock_guard<std::mutex> lock(active_sessions_mutex_);
@@ -1577,7 +1648,14 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   }
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
+  ORT_RETURN_IF_ERROR(CreateModelFromOrtFormatBytes());
+
+  is_model_loaded_ = true;
+
+  return Status::OK();
+}
 
+Status InferenceSession::CreateModelFromOrtFormatBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1658,7 +1736,6 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
 #endif
 
   ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
-  model_ = std::move(tmp_model);
 
   KernelTypeStrResolver kernel_type_str_resolver{};
   if (const auto* fbs_kernel_type_str_resolver = fbs_session->kernel_type_str_resolver();
@@ -1668,7 +1745,7 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
 #if !defined(ORT_MINIMAL_BUILD)
     // insert the kernel type constraints if we're updating an old model that had kernel hashes.
     if (is_supported_with_update) {
-      ORT_RETURN_IF_ERROR(kernel_type_str_resolver.RegisterGraphNodeOpSchemas(model_->MainGraph()));
+      ORT_RETURN_IF_ERROR(kernel_type_str_resolver.RegisterGraphNodeOpSchemas(tmp_model->MainGraph()));
     }
 #endif
   }
@@ -1679,12 +1756,183 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
           kernel_type_str_resolver));
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
   kernel_registry_manager_.SetKernelTypeStrResolver(std::move(kernel_type_str_resolver));
+  model_ = std::move(tmp_model);
 
-  is_model_loaded_ = true;
+  return Status::OK();
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status InferenceSession::LoadOptimizedModelFromCache() {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "");
+
+  // ORT format models are already optimized. the optimizations of models with custom op domains or shared
+  // initializers depend on state that isn't part of the key.
+  if (cache_dir.empty() || !ort_format_model_bytes_.empty() || !session_options_.optimized_model_filepath.empty() ||
+      HasLocalSchema() || !session_options_.initializers_to_share_map.empty()) {
+    return Status::OK();
+  }
 
+  // graph capture is set up while optimizing the model
+  for (const auto& ep : execution_providers_) {
+    if (ep->IsGraphCaptureEnabled()) {
+      return Status::OK();
+    }
+  }
+
+  // the key hashes the initializers, which is wasted on models that can't be saved
+  if (!OptimizedModelCache::InitializersFitOrtFormat(model_->MainGraph())) {
+    LOGS(*session_logger_, INFO) << "The initializers of the model exceed the 2GB size limit of ORT format models. "
+                                    "The optimized model cache is not used.";
+    return Status::OK();
+  }
+
+  std::string key;
+  ORT_RETURN_IF_ERROR(OptimizedModelCache::CreateKey(*model_, session_options_, optimizers_to_disable_,
+                                                     execution_providers_, key));
+  OptimizedModelCache cache(ToPathString(cache_dir), key);
+
+  if (cache.HasEntry()) {
+    auto status = LoadOrtModelBytes(cache.EntryPath().native(), ort_format_model_bytes_,
+                                    ort_format_model_bytes_data_holder_);
+    if (status.IsOK()) {
+      status = CreateModelFromOrtFormatBytes();
+    }
+
+    if (status.IsOK()) {
+      LOGS(*session_logger_, INFO) << "Loaded the optimized model from " << cache.EntryPath().string();
+      return Status::OK();
+    }
+
+    // fall back to optimizing the ONNX model, and replace the entry
+    LOGS(*session_logger_, WARNING) << "Ignoring optimized model cache entry " << cache.EntryPath().string() << ": "
+                                    << status.ErrorMessage();
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ORT_RETURN_IF_ERROR(SaveModelMetadata(*model_));
+  }
+
+  optimized_model_cache_.emplace(std::move(cache));
   return Status::OK();
 }
 
+void InferenceSession::SaveOptimizedModelToCache() {
+  // nodes compiled by an execution provider can't be saved in ORT format
+  std::function<bool(const Graph&)> has_compiled_nodes = [&has_compiled_nodes](const Graph& graph) {
+    for (const auto& node : graph.Nodes()) {
+      if (node.NodeType() == Node::Type::Fused) {
+        return true;
+      }
+
+      for (const auto& subgraph : node.GetSubgraphs()) {
+        if (has_compiled_nodes(*subgraph)) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  };
+
+  if (has_compiled_nodes(model_->MainGraph())) {
+    LOGS(*session_logger_, INFO) << "The optimized model contains compiled nodes and is not saved to the optimized "
+                                    "model cache.";
+  } else if (!OptimizedModelCache::InitializersFitOrtFormat(model_->MainGraph())) {
+    LOGS(*session_logger_, WARNING) << "The initializers of the optimized model exceed the 2GB size limit of ORT "
+                                       "format models. The model is not saved to the optimized model cache.";
+  } else {
+    Status status;
+    ORT_TRY {
+      status = optimized_model_cache_->Save(
+          [this](const std::filesystem::path& path) { return SaveToOrtFormat(path); });
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save the optimized model to "
+                                      << optimized_model_cache_->EntryPath().string() << ": "
+                                      << status.ErrorMessage();
+    }
+  }
+
+  optimized_model_cache_.reset();
+}
+
+Status InferenceSession::InitializeCpuTunableOp() {
+  const auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider);
+  ITuningContext* tuning_ctx = cpu_ep != nullptr ? cpu_ep->GetTuningContext() : nullptr;
+  if (tuning_ctx == nullptr) {
+    return Status::OK();
+  }
+
+  const auto& config_options = session_options_.config_options;
+  if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+    tuning_ctx->EnableTunableOp();
+  }
+  if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+    tuning_ctx->EnableTuning();
+  }
+  const std::string max_tuning_duration_ms =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "");
+  if (!max_tuning_duration_ms.empty()) {
+    tuning_ctx->SetMaxTuningDurationMs(ParseStringWithClassicLocale<int>(max_tuning_duration_ms));
+  }
+
+  const std::string tuning_results_file =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTuningResultsFile, "");
+  if (tuning_results_file.empty()) {
+    return Status::OK();
+  }
+
+  // a cache file that cannot be read is ignored, and replaced when the session saves its own results
+  std::vector<TuningResults> tuning_results;
+  bool found_tuning_results = false;
+  auto status = inference_session_utils::LoadTuningResultsFromFile(ToPathString(tuning_results_file), tuning_results,
+                                                                   found_tuning_results, *session_logger_);
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Ignoring the CPU tuning results file " << tuning_results_file << ": "
+                                    << status.ErrorMessage();
+    return Status::OK();
+  }
+
+  if (found_tuning_results) {
+    ORT_RETURN_IF_ERROR(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ false));
+  }
+
+  return Status::OK();
+}
+
+void InferenceSession::SaveCpuTuningResults() {
+  const std::string tuning_results_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTuningResultsFile, "");
+  const auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider);
+  const ITuningContext* tuning_ctx = cpu_ep != nullptr ? cpu_ep->GetTuningContext() : nullptr;
+  if (tuning_results_file.empty() || tuning_ctx == nullptr || !tuning_ctx->IsTuningEnabled()) {
+    return;
+  }
+
+  Status status;
+  ORT_TRY {
+    status = inference_session_utils::SaveTuningResultsToFile(ToPathString(tuning_results_file),
+                                                              {tuning_ctx->GetTuningResults()});
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to save the CPU tuning results to " << tuning_results_file << ": "
+                                    << status.ErrorMessage();
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 bool InferenceSession::IsInitialized() const {
   std::lock_guard<std::mutex> l(session_mutex_);
   return is_inited_;
@@ -2024,10 +2272,8 @@ common::Status InferenceSession::Initialize() {
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
-    onnxruntime::Graph& graph = model_->MainGraph();
-
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
-    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
+    const InitializedTensorSet& initializers = model_->MainGraph().GetAllInitializedTensors();
     for (const auto& it : initializers) {
       if (utils::HasExternalData(*it.second) && !utils::HasExternalDataInMemory(*it.second)) {
         return common::Status(common::ONNXRUNTIME, common::FAIL,
@@ -2056,18 +2302,27 @@ common::Status InferenceSession::Initialize() {
 
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS) && !defined(ORT_MINIMAL_BUILD)
     if (!session_options_.external_initializers.empty()) {
-      ORT_RETURN_IF_ERROR_SESSIONID_(graph.InjectExternalInitializedTensors(session_options_.external_initializers));
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          model_->MainGraph().InjectExternalInitializedTensors(session_options_.external_initializers));
       InlinedHashMap<std::string, OrtValue>{}.swap(session_options_.external_initializers);
     }
 
     if (!session_options_.external_initializer_files_mmap.empty()) {
       ORT_RETURN_IF_ERROR_SESSIONID_(
-          graph.InjectExternalInitializersFromFilesInMemory(session_options_.external_initializer_files_mmap));
+          model_->MainGraph().InjectExternalInitializersFromFilesInMemory(
+              session_options_.external_initializer_files_mmap));
       InlinedHashMap<std::basic_string<ORTCHAR_T>, std::pair<char*, size_t>>{}.swap(
           session_options_.external_initializer_files_mmap);
     }
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // may replace model_ with the optimized model from a previous session
+    ORT_RETURN_IF_ERROR_SESSIONID_(LoadOptimizedModelFromCache());
+#endif
+
+    onnxruntime::Graph& graph = model_->MainGraph();
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     TraceLoggingWriteStart(session_activity, "OrtInferenceSessionActivity");
     session_activity_started_ = true;
@@ -2114,6 +2369,7 @@ common::Status InferenceSession::Initialize() {
         session_profiler_,
         session_options_,
         prepacked_weights_container_);
+    session_state_->SetNumaPartitions(numa_partitions_.get());
 
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
@@ -2245,8 +2501,18 @@ common::Status InferenceSession::Initialize() {
 #endif
 
       // apply any transformations to the main graph and any subgraphs
+      TimePoint transform_tp;
+      if (session_profiler_.IsEnabled()) {
+        transform_tp = session_profiler_.Start();
+      }
+
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
 
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_graph_transformation",
+                                                transform_tp);
+      }
+
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
       if (session_options_.IsLoadCancellationFlagSet()) {
@@ -2397,6 +2663,10 @@ common::Status InferenceSession::Initialize() {
 
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+
+      if (optimized_model_cache_.has_value()) {
+        SaveOptimizedModelToCache();
+      }
 #else   // !defined(ORT_MINIMAL_BUILD)
       ORT_RETURN_IF_ERROR_SESSIONID_(
           ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -2460,6 +2730,8 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    ORT_RETURN_IF_ERROR_SESSIONID_(InitializeCpuTunableOp());
+
     std::vector<TuningResults> tuning_results;
     bool found_tuning_results = false;
     ORT_RETURN_IF_ERROR_SESSIONID_(inference_session_utils::ParseTuningResultsFromModelMetadata(
@@ -2846,23 +3118,24 @@ Status InferenceSession::PartialRun(onnxruntime::RunOptions& run_options,
 namespace {
 // Concurrent runs counting and thread-pool spin control
 struct ThreadPoolSpinningSwitch {
-  concurrency::ThreadPool* intra_tp_{nullptr};
-  concurrency::ThreadPool* inter_tp_{nullptr};
+  // The intra-op pool, or one pool per NUMA partition, and the inter-op pool
+  InlinedVector<concurrency::ThreadPool*> thread_pools_;
   std::atomic<int>& concurrent_num_runs_;
   // __Ctor Refcounting and spinning control
-  ThreadPoolSpinningSwitch(concurrency::ThreadPool* intra_tp,
-                           concurrency::ThreadPool* inter_tp,
+  ThreadPoolSpinningSwitch(InlinedVector<concurrency::ThreadPool*> thread_pools,
                            std::atomic<int>& ref) noexcept
-      : intra_tp_(intra_tp), inter_tp_(inter_tp), concurrent_num_runs_(ref) {
+      : thread_pools_(std::move(thread_pools)), concurrent_num_runs_(ref) {
     if (concurrent_num_runs_.fetch_add(1, std::memory_order_relaxed) == 0) {
-      if (intra_tp_) intra_tp_->EnableSpinning();
-      if (inter_tp_) inter_tp_->EnableSpinning();
+      for (auto* tp : thread_pools_) {
+        if (tp) tp->EnableSpinning();
+      }
     }
   }
   ~ThreadPoolSpinningSwitch() {
     if (1 == concurrent_num_runs_.fetch_sub(1, std::memory_order_acq_rel)) {
-      if (intra_tp_) intra_tp_->DisableSpinning();
-      if (inter_tp_) inter_tp_->DisableSpinning();
+      for (auto* tp : thread_pools_) {
+        if (tp) tp->DisableSpinning();
+      }
     }
   }
 };
@@ -2918,9 +3191,19 @@ Status InferenceSession::Run(const RunOptions& run_options,
   const bool control_spinning = use_per_session_threads_ &&
                                 force_spinning_stop_between_runs_ &&
                                 !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id);
-  auto* intra_tp = (control_spinning) ? thread_pool_.get() : nullptr;
-  auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
-  ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
+  // With NUMA partitioning the intra-op threads live in the per-partition pools and thread_pool_ is not created.
+  InlinedVector<concurrency::ThreadPool*> spinning_tps;
+  if (control_spinning) {
+    if (numa_partitions_) {
+      for (size_t i = 0; i < numa_partitions_->NumPartitions(); ++i) {
+        spinning_tps.push_back(numa_partitions_->GetThreadPool(i));
+      }
+    } else {
+      spinning_tps.push_back(thread_pool_.get());
+    }
+    spinning_tps.push_back(inter_op_thread_pool_.get());
+  }
+  ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(std::move(spinning_tps), current_num_runs_);
 
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
@@ -3006,6 +3289,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
       }
 #endif
 
+      // run the kernels on the intra-op threads and weight copies of one NUMA node
+      std::optional<NumaPartitions::RunScope> numa_run_scope;
+      if (numa_partitions_) {
+        numa_run_scope.emplace(*numa_partitions_, numa_partitions_->SelectPartition());
+      }
+
       // execute the graph
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
       session_state_->IncrementGraphExecutionCounter();
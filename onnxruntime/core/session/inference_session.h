@@ -20,6 +20,7 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/kernel_registry_manager.h"
+#include "core/framework/numa_partitions.h"
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/resource_accountant.h"
 #include "core/framework/session_state.h"
@@ -30,6 +31,7 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/session/optimized_model_cache.h"
 #include <mutex>
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -663,6 +665,8 @@ class InferenceSession {
     if (session_options_.use_per_session_threads) {
       if (external_intra_op_thread_pool_) {
         return external_intra_op_thread_pool_;
+      } else if (numa_partitions_) {
+        return numa_partitions_->GetThreadPool(0);
       } else {
         return thread_pool_.get();
       }
@@ -731,6 +735,19 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  // Replaces the loaded ONNX model with the optimized model from the optimized model cache if there is an entry for
+  // it. Otherwise sets up optimized_model_cache_ so that SaveOptimizedModelToCache() saves the optimized model.
+  [[nodiscard]] common::Status LoadOptimizedModelFromCache();
+
+  // Saves the optimized model to optimized_model_cache_. Failures are logged.
+  void SaveOptimizedModelToCache();
+
+  // Applies the CPU EP TunableOp session options and loads the cached CPU tuning results, if any.
+  [[nodiscard]] common::Status InitializeCpuTunableOp();
+
+  // Saves the CPU tuning results to the file set in the session options if tuning is enabled. Failures are logged.
+  void SaveCpuTuningResults();
 #endif
 
   /**
@@ -752,6 +769,9 @@ class InferenceSession {
 
   [[nodiscard]] common::Status LoadOrtModelWithLoader(std::function<Status()> load_ort_format_model_bytes);
 
+  // Creates model_ from the ORT format model in ort_format_model_bytes_. model_ is unchanged on failure.
+  [[nodiscard]] common::Status CreateModelFromOrtFormatBytes();
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -816,6 +836,9 @@ class InferenceSession {
   onnxruntime::GraphTransformerManager graph_transformer_mgr_;
 
   InlinedHashSet<gsl::not_null<const ONNX_NAMESPACE::OpSchema*>> saved_runtime_optimization_produced_node_op_schemas_;
+
+  // Set while initializing a session that saves its optimized model to the optimized model cache.
+  std::optional<OptimizedModelCache> optimized_model_cache_;
 #endif
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
   InlinedHashSet<std::string> optimizers_to_disable_;
@@ -863,6 +886,10 @@ class InferenceSession {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
+  // Per NUMA node intra-op thread pools and pre-packed weight copies. Replaces thread_pool_ if
+  // kOrtSessionOptionsConfigIntraOpNumaPartitioning is enabled.
+  std::unique_ptr<NumaPartitions> numa_partitions_;
+
   // Global threadpools. These are intialized and used when use_per_session_threads is false *and*
   // the environment is created with create_global_thread_pools = true.
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
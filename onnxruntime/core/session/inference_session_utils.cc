@@ -5,6 +5,11 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <atomic>
+#include <fstream>
+
+#include "core/platform/env.h"
+
 namespace onnxruntime {
 
 //---------------------
@@ -115,6 +120,11 @@ void from_json(const json& j, TuningResults& trs) {
   j.at("validators").get_to(trs.validators);
 }
 
+// This function is called by nlohmann/json
+void to_json(json& j, const TuningResults& trs) {
+  j = json{{"ep", trs.ep}, {"results", trs.results}, {"validators", trs.validators}};
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -270,6 +280,63 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+Status LoadTuningResultsFromFile(const std::filesystem::path& path,
+                                 std::vector<TuningResults>& results,
+                                 bool& file_found,
+                                 const logging::Logger& logger) {
+  results.clear();
+  std::error_code ec;
+  file_found = std::filesystem::is_regular_file(path, ec);
+  if (!file_found) {
+    return Status::OK();
+  }
+
+  LOGS(logger, INFO) << "Loading tuning results from " << path.string();
+
+  std::ifstream ifs(path);
+  ORT_RETURN_IF(!ifs, "Failed to open the tuning results file ", path.string());
+
+  Status status;
+  ORT_TRY {
+    results = json::parse(ifs).get<std::vector<TuningResults>>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The tuning results file ", path.string(),
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+
+  return status;
+}
+
+Status SaveTuningResultsToFile(const std::filesystem::path& path, const std::vector<TuningResults>& results) {
+  static std::atomic<uint64_t> temp_file_counter{0};
+  auto temp_path = path;
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                            std::to_string(temp_file_counter++) + ".tmp");
+
+  std::error_code ec;
+  {
+    std::ofstream ofs(temp_path);
+    ORT_RETURN_IF(!ofs, "Failed to create ", temp_path.string());
+    ofs << json(results).dump(2);
+    if (!ofs.flush()) {
+      ofs.close();
+      std::filesystem::remove(temp_path, ec);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write ", temp_path.string());
+    }
+  }
+
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the tuning results file ", path.string());
+  }
+
+  return Status::OK();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
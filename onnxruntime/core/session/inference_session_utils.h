@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include "core/flatbuffers/schema/ort.fbs.h"
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -65,6 +67,16 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ bool& key_found,
                                            const logging::Logger& logger);
 
+// Reads the tuning results cached in the json file at `path`. `file_found` is false if there is no such file.
+Status LoadTuningResultsFromFile(const std::filesystem::path& path,
+                                 /*out*/ std::vector<TuningResults>& results,
+                                 /*out*/ bool& file_found,
+                                 const logging::Logger& logger);
+
+// Writes the tuning results to the json file at `path`. The file is replaced atomically so that concurrent readers
+// never see a partially written file.
+Status SaveTuningResultsToFile(const std::filesystem::path& path, const std::vector<TuningResults>& results);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
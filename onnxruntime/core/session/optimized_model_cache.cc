@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/optimized_model_cache.h"
+
+#include <atomic>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include "core/common/path_string.h"
+#include "core/framework/cache_key_utils.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/session_options.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+#include "core/platform/env.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Bump when the content of the keys changes.
+constexpr uint32_t kFormatVersion = 1;
+
+std::string HashString(const std::string& value) {
+  return cache_key_utils::HashToHex(value.data(), value.size());
+}
+
+void AppendNodeArgs(std::ostream& ss, const char* label, const std::vector<const NodeArg*>& node_args) {
+  for (const auto* node_arg : node_args) {
+    ss << "\n" << label << "=" << node_arg->Name();
+    if (const auto* type = node_arg->TypeAsProto(); type != nullptr) {
+      ss << ":" << HashString(type->SerializeAsString());
+    }
+  }
+}
+
+Status AppendInitializer(std::ostream& ss, const Graph& graph, const std::string& name,
+                         const ONNX_NAMESPACE::TensorProto& initializer) {
+  ss << "\ninitializer=" << name << ":" << initializer.data_type() << ":";
+  for (const auto dim : initializer.dims()) {
+    ss << dim << ",";
+  }
+
+  ss << ":";
+  if (initializer.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    ss << HashString(initializer.SerializeAsString());
+    return Status::OK();
+  }
+
+  // initializers whose data lives in an OrtValue, e.g. ones that were memory mapped or injected by the user
+  OrtValue value;
+  if (graph.GetOrtValueInitializer(name, value) && value.IsTensor()) {
+    const auto& tensor = value.Get<Tensor>();
+    ss << cache_key_utils::HashToHex(tensor.DataRaw(), tensor.SizeInBytes());
+    return Status::OK();
+  }
+
+  // external data in a file is identified by its location instead of being read, which would load the whole model.
+  // the time of the last write of the file catches files that were rewritten in place.
+  if (utils::HasExternalData(initializer) && !utils::HasExternalDataInMemory(initializer)) {
+    std::basic_string<ORTCHAR_T> external_file_path;
+    FileOffsetType file_offset = 0;
+    SafeInt<size_t> tensor_byte_size = 0;
+    ORT_RETURN_IF_ERROR(utils::GetExternalDataInfo(initializer, graph.ModelPath().parent_path(), external_file_path,
+                                                   file_offset, tensor_byte_size));
+
+    std::error_code ec;
+    const auto last_write_time = std::filesystem::last_write_time(external_file_path, ec);
+    ORT_RETURN_IF(ec, "Failed to get the last write time of the external data file ",
+                  PathToUTF8String(external_file_path), ": ", ec.message());
+
+    ss << "external=" << PathToUTF8String(std::filesystem::absolute(external_file_path, ec).native()) << ":"
+       << file_offset << ":" << static_cast<size_t>(tensor_byte_size) << ":"
+       << last_write_time.time_since_epoch().count();
+    return Status::OK();
+  }
+
+  std::vector<uint8_t> data;
+  ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(initializer, graph.ModelPath(), data));
+  ss << cache_key_utils::HashToHex(data.data(), data.size());
+  return Status::OK();
+}
+
+// Appends the description of 'graph' and its subgraphs to 'ss'.
+Status AppendGraph(std::ostream& ss, const Graph& graph) {
+  AppendNodeArgs(ss, "input", graph.GetInputsIncludingInitializers());
+  AppendNodeArgs(ss, "output", graph.GetOutputs());
+
+  for (const auto& node : graph.Nodes()) {
+    ss << "\nnode=" << node.Name() << ":" << node.Domain() << ":" << node.OpType() << ":" << node.SinceVersion();
+    for (const auto* def : node.InputDefs()) {
+      ss << "\n in=" << (def->Exists() ? def->Name() : "");
+    }
+    for (const auto* def : node.OutputDefs()) {
+      ss << "\n out=" << (def->Exists() ? def->Name() : "");
+    }
+
+    // attributes are hashed in name order as the order of NodeAttributes is unspecified
+    const auto subgraphs = node.GetAttributeNameToSubgraphMap();
+    std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+    for (const auto& [name, attribute] : node.GetAttributes()) {
+      attributes.emplace(name, &attribute);
+    }
+    for (const auto& [name, attribute] : attributes) {
+      ss << "\n attr." << name << "=";
+      if (auto subgraph = subgraphs.find(name); subgraph != subgraphs.end()) {
+        ss << "{";
+        ORT_RETURN_IF_ERROR(AppendGraph(ss, *subgraph->second));
+        ss << "\n}";
+      } else {
+        ss << HashString(attribute->SerializeAsString());
+      }
+    }
+  }
+
+  const auto& initializers = graph.GetAllInitializedTensors();
+  const std::map<std::string, const ONNX_NAMESPACE::TensorProto*> sorted_initializers(initializers.begin(),
+                                                                                      initializers.end());
+  for (const auto& [name, initializer] : sorted_initializers) {
+    ORT_RETURN_IF_ERROR(AppendInitializer(ss, graph, name, *initializer));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+OptimizedModelCache::OptimizedModelCache(std::filesystem::path cache_dir, const std::string& key)
+    : cache_dir_(std::move(cache_dir)),
+      entry_path_(cache_dir_ / (cache_key_utils::HashToHex(key.data(), key.size()) + ".ort")) {
+}
+
+bool OptimizedModelCache::InitializersFitOrtFormat(const Graph& graph) {
+  uint64_t initializers_size = 0;
+  for (const auto& [name, initializer] : graph.GetAllInitializedTensors()) {
+    size_t size = 0;
+    if (utils::GetSizeInBytesFromTensorProto<0>(*initializer, &size).IsOK()) {
+      initializers_size += size;
+    }
+  }
+
+  return initializers_size < static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+}
+
+Status OptimizedModelCache::CreateKey(const Model& model,
+                                      const SessionOptions& session_options,
+                                      const InlinedHashSet<std::string>& optimizers_to_disable,
+                                      const ExecutionProviders& execution_providers,
+                                      std::string& key) {
+  std::ostringstream ss;
+  ss << "format=" << kFormatVersion
+     << "\n" << cache_key_utils::GetBuildDescription()
+     << "\ncpu=" << cache_key_utils::GetCpuDescription();
+
+  ss << "\nlevel=" << static_cast<int>(session_options.graph_optimization_level)
+     << "\ndeterministic=" << session_options.use_deterministic_compute;
+
+  const std::set<std::string> disabled_optimizers(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  for (const auto& optimizer : disabled_optimizers) {
+    ss << "\ndisabled=" << optimizer;
+  }
+
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    ss << "\nfree_dim=" << static_cast<int>(dim_override.dim_identifier_type) << ":" << dim_override.dim_identifier
+       << "=" << dim_override.dim_value;
+  }
+
+  // config entries enable optimizers and change what they do. the cache directory itself is not part of the key.
+  const auto& config_entries = session_options.config_options.GetConfigOptionsMap();
+  const std::map<std::string, std::string> sorted_config_entries(config_entries.begin(), config_entries.end());
+  for (const auto& [config_key, value] : sorted_config_entries) {
+    if (config_key != kOrtSessionOptionsOptimizedModelCacheDir) {
+      ss << "\nconfig." << config_key << "=" << value;
+    }
+  }
+
+  for (const auto& ep : execution_providers) {
+    ss << "\nep=" << ep->Type();
+    const auto provider_options = ep->GetProviderOptions();
+    const std::map<std::string, std::string> sorted_provider_options(provider_options.begin(),
+                                                                     provider_options.end());
+    for (const auto& [option, value] : sorted_provider_options) {
+      ss << "\n " << option << "=" << value;
+    }
+  }
+
+  ss << "\nir_version=" << model.IrVersion();
+
+  const auto& graph = model.MainGraph();
+  const std::map<std::string, int> opsets(graph.DomainToVersionMap().begin(), graph.DomainToVersionMap().end());
+  for (const auto& [domain, version] : opsets) {
+    ss << "\nopset=" << domain << ":" << version;
+  }
+
+  // the metadata is saved with the model, and may contain the tuning results and session options of the model
+  const std::map<std::string, std::string> metadata(model.MetaData().begin(), model.MetaData().end());
+  for (const auto& [name, value] : metadata) {
+    ss << "\nmetadata." << name << "=" << HashString(value);
+  }
+
+  ORT_RETURN_IF_ERROR(AppendGraph(ss, graph));
+
+  key = ss.str();
+  return Status::OK();
+}
+
+bool OptimizedModelCache::HasEntry() const {
+  std::error_code ec;
+  return std::filesystem::is_regular_file(entry_path_, ec);
+}
+
+Status OptimizedModelCache::Save(const std::function<Status(const std::filesystem::path&)>& save_model) const {
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  ORT_RETURN_IF(ec, "Failed to create the optimized model cache directory ", cache_dir_.string(), ": ",
+                ec.message());
+
+  static std::atomic<uint64_t> temp_file_counter{0};
+  auto temp_path = entry_path_;
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                            std::to_string(temp_file_counter++) + ".tmp");
+
+  auto status = save_model(temp_path);
+  if (!status.IsOK()) {
+    std::filesystem::remove(temp_path, ec);
+    return status;
+  }
+
+  std::filesystem::rename(temp_path, entry_path_, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the optimized model cache entry ",
+                           entry_path_.string());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
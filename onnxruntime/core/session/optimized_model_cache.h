@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+
+class ExecutionProviders;
+class Graph;
+class Model;
+struct SessionOptions;
+
+// Persists models in ORT format after the graph optimizations and the partitioning, so that later sessions, also in
+// other processes, can load the optimized model instead of optimizing the original model again.
+//
+// An entry is keyed by everything that determines the optimized graph: the ORT build, the CPU features, the
+// optimization level, the disabled optimizers, the session config entries, the execution providers and their options,
+// and a hash of the model including its initializers, where external data files are identified by their location
+// and the time of their last write. The entry file name is a hash of the key, so changing any of
+// them creates a new entry and stale entries are never read.
+class OptimizedModelCache {
+ public:
+  // 'key' is created with CreateKey().
+  OptimizedModelCache(std::filesystem::path cache_dir, const std::string& key);
+
+  // Creates the key of the optimized 'model' of a session with 'session_options' and 'execution_providers'.
+  // 'optimizers_to_disable' are the disabled optimizers of the session.
+  static Status CreateKey(const Model& model,
+                          const SessionOptions& session_options,
+                          const InlinedHashSet<std::string>& optimizers_to_disable,
+                          const ExecutionProviders& execution_providers,
+                          std::string& key);
+
+  // Returns true if the initializers of 'graph' fit in an ORT format model, which stores them in the flatbuffer and
+  // is limited to 2GB. Models with larger initializers are never saved, so their keys aren't created.
+  static bool InitializersFitOrtFormat(const Graph& graph);
+
+  const std::filesystem::path& EntryPath() const noexcept { return entry_path_; }
+
+  bool HasEntry() const;
+
+  // Writes the entry with 'save_model', which saves the model in ORT format to the path it is given.
+  // The model is saved to a temporary file that is renamed, so concurrent readers and writers of the same entry never
+  // see a partial file.
+  Status Save(const std::function<Status(const std::filesystem::path&)>& save_model) const;
+
+ private:
+  std::filesystem::path cache_dir_;
+  std::filesystem::path entry_path_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -21,6 +21,12 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // How long the threads spin before blocking, in microseconds. Negative: spin for a fixed number of iterations.
+  int spin_duration_us = -1;
+
+  // If it is true, each thread adapts how long it spins to its recent idle periods, up to spin_duration_us.
+  bool adaptive_spinning = false;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
@@ -2052,6 +2052,14 @@ for model inference.)pbdoc");
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "thread_cache_max_chunk_bytes") {
+            ort_arena_cfg->thread_cache_max_chunk_bytes = kvp.second.cast<int64_t>();
+          } else if (key == "thread_cache_max_bytes") {
+            ort_arena_cfg->thread_cache_max_bytes = kvp.second.cast<int64_t>();
+          } else if (key == "huge_pages") {
+            ort_arena_cfg->huge_pages = kvp.second.cast<int>();
+          } else if (key == "numa_node") {
+            ort_arena_cfg->numa_node = kvp.second.cast<int>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -2063,7 +2071,11 @@ for model inference.)pbdoc");
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("thread_cache_max_chunk_bytes", &OrtArenaCfg::thread_cache_max_chunk_bytes)
+      .def_readwrite("thread_cache_max_bytes", &OrtArenaCfg::thread_cache_max_bytes)
+      .def_readwrite("huge_pages", &OrtArenaCfg::huge_pages)
+      .def_readwrite("numa_node", &OrtArenaCfg::numa_node);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "test/common/random_generator.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if !defined(DISABLE_CONTRIB_OPS)
+
+// Sigmoid((x + b) * s) * (x + b), with b broadcast along the last axis and s a scalar.
+TEST(FusedElementwiseTest, BiasScaleSwish) {
+  RandomValueGenerator random{};
+  const std::vector<int64_t> x_dims{2, 3, 4100};
+  const std::vector<float> x = random.Uniform<float>(x_dims, -4.0f, 4.0f);
+  const std::vector<float> b = random.Uniform<float>(std::vector<int64_t>{4100}, -1.0f, 1.0f);
+  const float s = 1.702f;
+
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    const float biased = x[i] + b[i % b.size()];
+    y[i] = biased / (1.0f + std::exp(-biased * s));
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Mul", "Sigmoid", "Mul"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 3, 2, 4, 4, 5, 3});
+  test.AddInput<float>("x", x_dims, x);
+  test.AddInput<float>("b", {4100}, b);
+  test.AddInput<float>("s", {}, {s});
+  test.AddOutput<float>("y", x_dims, y);
+  test.SetOutputAbsErr("y", 1e-5f);
+  test.Run();
+}
+
+// Inputs broadcast along different axes: [3, 1, 5] and [4, 1] give an output of shape [3, 4, 5].
+TEST(FusedElementwiseTest, MultidirectionalBroadcast) {
+  RandomValueGenerator random{};
+  const std::vector<float> a = random.Uniform<float>(std::vector<int64_t>{3, 1, 5}, 0.5f, 2.0f);
+  const std::vector<float> b = random.Uniform<float>(std::vector<int64_t>{4, 1}, 0.5f, 2.0f);
+
+  std::vector<float> y(3 * 4 * 5);
+  for (int64_t i = 0; i < 3; ++i) {
+    for (int64_t j = 0; j < 4; ++j) {
+      for (int64_t k = 0; k < 5; ++k) {
+        const float lhs = a[i * 5 + k];
+        const float rhs = b[j];
+        y[(i * 4 + j) * 5 + k] = std::sqrt(std::max(lhs - rhs, 0.0f)) + std::tanh(lhs / rhs);
+      }
+    }
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sub", "Relu", "Sqrt", "Div", "Tanh", "Add"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 2, 2, 3, 3, 0, 1, 5, 5, 4, 6});
+  test.AddInput<float>("a", {3, 1, 5}, a);
+  test.AddInput<float>("b", {4, 1}, b);
+  test.AddOutput<float>("y", {3, 4, 5}, y);
+  test.SetOutputAbsErr("y", 1e-5f);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, ScalarOutput) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Max", "Neg", "Abs", "Reciprocal"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 2, 2, 3, 3, 4, 4});
+  test.AddInput<float>("a", {}, {-4.0f});
+  test.AddInput<float>("b", {1}, {2.0f});
+  test.AddOutput<float>("y", {1}, {0.5f});
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, OperandDefinedLater) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Exp"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 2, 2, 2});
+  test.AddInput<float>("a", {2}, {1.0f, 2.0f});
+  test.AddInput<float>("b", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("y", {2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "which is not defined before it");
+}
+
+#endif  // !defined(DISABLE_CONTRIB_OPS)
+
+}  // namespace test
+}  // namespace onnxruntime
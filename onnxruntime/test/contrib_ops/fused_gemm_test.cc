@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <functional>
+
+#include "gtest/gtest.h"
+
+#include "test/common/random_generator.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if !defined(DISABLE_CONTRIB_OPS)
+
+namespace {
+
+struct FusedGemmTestParams {
+  int64_t M;
+  int64_t N;
+  int64_t K;
+  bool trans_b;
+  bool b_is_initializer;
+  float beta;
+  std::vector<int64_t> c_dims;
+  std::string activation;
+  std::vector<std::pair<std::string, float>> activation_attributes;
+  std::function<float(float)> activation_function;
+};
+
+void RunFusedGemmTest(const FusedGemmTestParams& params) {
+  RandomValueGenerator random{};
+  const int64_t M = params.M;
+  const int64_t N = params.N;
+  const int64_t K = params.K;
+
+  const std::vector<float> a = random.Uniform<float>(std::vector<int64_t>{M, K}, -1.0f, 1.0f);
+  const std::vector<int64_t> b_dims = params.trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N};
+  const std::vector<float> b = random.Uniform<float>(b_dims, -1.0f, 1.0f);
+  const std::vector<float> c = random.Uniform<float>(params.c_dims, -1.0f, 1.0f);
+
+  const int64_t c_rows = params.c_dims.size() == 2 ? params.c_dims[0] : 1;
+  const int64_t c_cols = params.c_dims.back();
+
+  std::vector<float> expected(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * (params.trans_b ? b[n * K + k] : b[k * N + n]);
+      }
+      sum += params.beta * c[(c_rows == 1 ? 0 : m) * c_cols + (c_cols == 1 ? 0 : n)];
+      expected[m * N + n] = params.activation_function(sum);
+    }
+  }
+
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("transA", 0);
+  test.AddAttribute<int64_t>("transB", params.trans_b ? 1 : 0);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", params.beta);
+  test.AddAttribute("activation", params.activation);
+  for (const auto& [name, value] : params.activation_attributes) {
+    test.AddAttribute("activation_" + name, value);
+  }
+
+  test.AddInput<float>("A", {M, K}, a);
+  test.AddInput<float>("B", b_dims, b, params.b_is_initializer);
+  test.AddInput<float>("C", params.c_dims, c);
+  test.AddOutput<float>("Y", {M, N}, expected, false, 1e-4f, 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(FusedGemmTest, ReluWithRowBias) {
+  RunFusedGemmTest({5, 37, 19, false, false, 1.0f, {37}, "Relu", {},
+                    [](float x) { return std::max(x, 0.0f); }});
+}
+
+TEST(FusedGemmTest, LeakyReluWithMatrixAddend) {
+  RunFusedGemmTest({17, 40, 33, false, true, 1.0f, {17, 40}, "LeakyRelu", {{"alpha", 0.1f}},
+                    [](float x) { return x >= 0.0f ? x : 0.1f * x; }});
+}
+
+TEST(FusedGemmTest, GeluWithTransposedB) {
+  RunFusedGemmTest({9, 64, 48, true, true, 1.0f, {1, 64}, "Gelu", {},
+                    [](float x) { return 0.5f * x * (1.0f + std::erf(x * 0.70710678f)); }});
+}
+
+TEST(FusedGemmTest, HardSigmoidWithColumnBias) {
+  RunFusedGemmTest({6, 20, 12, false, false, 1.0f, {6, 1}, "HardSigmoid", {{"alpha", 0.2f}, {"beta", 0.5f}},
+                    [](float x) { return std::min(std::max(0.2f * x + 0.5f, 0.0f), 1.0f); }});
+}
+
+TEST(FusedGemmTest, SigmoidWithScaledBias) {
+  RunFusedGemmTest({1, 33, 70, false, false, 0.5f, {33}, "Sigmoid", {},
+                    [](float x) { return 1.0f / (1.0f + std::exp(-x)); }});
+}
+
+TEST(FusedGemmTest, EluIsAppliedSeparately) {
+  RunFusedGemmTest({4, 16, 8, true, false, 1.0f, {4, 16}, "Elu", {{"alpha", 1.0f}},
+                    [](float x) { return x >= 0.0f ? x : std::expm1(x); }});
+}
+
+#endif  // !defined(DISABLE_CONTRIB_OPS)
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include <gsl/gsl>
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "contrib_ops/cpu/transformers/generation_device_helper.h"
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+#include "contrib_ops/cpu/transformers/sequences.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::BeamSearchParameters;
+using contrib::transformers::GreedySearchParameters;
+using contrib::transformers::LogitsProcessorList;
+using contrib::transformers::Sequences;
+namespace transformers = contrib::transformers;
+
+namespace {
+
+// Applies the processors one at a time, so the search helpers take the path that does not fuse them into the
+// log softmax and top-k.
+class UnfusedLogitsProcessorList : public transformers::ILogitsProcessorList {
+ public:
+  explicit UnfusedLogitsProcessorList(LogitsProcessorList& processors) : processors_(processors) {}
+
+  void Process(const transformers::ISequences* sequences, gsl::span<float>& next_token_scores, int step) override {
+    processors_.Process(sequences, next_token_scores, step);
+  }
+
+ private:
+  LogitsProcessorList& processors_;
+};
+
+// Keeps the candidates the beam search helper passes to the scorer.
+class CandidateRecorder : public transformers::IBeamScorer {
+ public:
+  void Process(transformers::ISequences& /*sequences*/,
+               gsl::span<const float>& next_scores,
+               gsl::span<const int32_t>& next_tokens,
+               gsl::span<const int32_t>& next_indices) override {
+    scores.assign(next_scores.begin(), next_scores.end());
+    tokens.assign(next_tokens.begin(), next_tokens.end());
+    indices.assign(next_indices.begin(), next_indices.end());
+  }
+
+  void Finalize(transformers::ISequences& /*sequences*/, gsl::span<const float>& /*final_beam_scores*/,
+                Tensor* /*output_sequences*/, Tensor* /*output_sequence_scores*/) override {}
+
+  void OutputScores(gsl::span<const float>& /*final_scores*/, Tensor* /*output_scores*/) override {}
+
+  bool IsDone() const override { return false; }
+
+  gsl::span<float> GetNextScores() override { return scores; }
+  gsl::span<int32_t> GetNextTokens() override { return tokens; }
+  gsl::span<int32_t> GetNextIndicesCPU() override { return indices; }
+
+  std::vector<float> scores;
+  std::vector<int32_t> tokens;
+  std::vector<int32_t> indices;
+};
+
+// Random logits of shape (rows, input_length, vocab_size), and sequences that contain the best tokens of the last
+// logits of each row, so the repetition penalty moves the tokens that compete for the top places.
+struct SearchInputs {
+  SearchInputs(int rows, int input_length, int vocab_size, int sequence_length, int max_length)
+      : sequences_buffer(2 * static_cast<size_t>(rows) * max_length) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> logit(-4.0f, 4.0f);
+    std::uniform_int_distribution<int32_t> token(0, vocab_size - 1);
+
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({rows, input_length, vocab_size}), allocator,
+                         logits);
+    gsl::span<float> logits_data = logits.GetMutable<Tensor>()->MutableDataAsSpan<float>();
+    std::generate(logits_data.begin(), logits_data.end(), [&]() { return logit(generator); });
+
+    for (int i = 0; i < rows; i++) {
+      const float* last_logits = logits_data.data() + (static_cast<size_t>(i) * input_length + input_length - 1) *
+                                                          vocab_size;
+      std::vector<int32_t> best(vocab_size);
+      for (int32_t t = 0; t < vocab_size; t++) best[t] = t;
+      std::partial_sort(best.begin(), best.begin() + 3, best.end(),
+                        [&](int32_t a, int32_t b) { return last_logits[a] > last_logits[b]; });
+
+      int32_t* sequence = sequences_buffer.data() + static_cast<size_t>(i) * max_length;
+      for (int s = 0; s < sequence_length; s++) {
+        sequence[s] = s < 3 ? best[(i + s) % 3] : token(generator);
+      }
+    }
+    sequences.Init(sequences_buffer, rows, sequence_length, max_length);
+  }
+
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  OrtValue logits;
+  std::vector<int32_t> sequences_buffer;
+  Sequences sequences;
+};
+
+// Runs the beam search logits processing with the processors fused into the top-k selection, then with the processor
+// pipeline, and checks that both pass the same candidates to the scorer.
+void RunBeamSearchSelection(int input_length, float repetition_penalty, float temperature) {
+  constexpr int batch_size = 2, num_beams = 3, vocab_size = 50, sequence_length = 6, max_length = 10;
+  constexpr int batch_beam_size = batch_size * num_beams;
+
+  BeamSearchParameters parameters{};
+  parameters.batch_size = batch_size;
+  parameters.num_beams = num_beams;
+  parameters.vocab_size = vocab_size;
+  parameters.sequence_length = sequence_length;
+  parameters.max_length = max_length;
+  parameters.repetition_penalty = repetition_penalty;
+  parameters.temperature = temperature;
+
+  LogitsProcessorList processors;
+  processors.Init(parameters);
+  float inline_repetition_penalty = 1.0f;
+  float inline_temperature = 1.0f;
+  ASSERT_TRUE(processors.GetInlineProcessors(1, inline_repetition_penalty, inline_temperature));
+  UnfusedLogitsProcessorList unfused_processors(processors);
+
+  SearchInputs inputs(batch_beam_size, input_length, vocab_size, sequence_length, max_length);
+
+  std::vector<float> beam_scores(batch_beam_size);
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<float> beam_score(-3.0f, 0.0f);
+  std::generate(beam_scores.begin(), beam_scores.end(), [&]() { return beam_score(generator); });
+
+  CandidateRecorder candidates[2];
+  for (int fused = 0; fused < 2; fused++) {
+    std::vector<float> next_token_logits(static_cast<size_t>(batch_beam_size) * vocab_size);
+    std::vector<float> next_token_scores(static_cast<size_t>(batch_beam_size) * vocab_size);
+    std::vector<int32_t> next_tokens(2 * batch_size * num_beams);
+    std::vector<int32_t> next_indices(2 * batch_size * num_beams);
+    std::vector<float> next_scores(2 * batch_size * num_beams);
+    std::vector<float> state_beam_scores(beam_scores);
+
+    transformers::IBeamSearchState<float> beam_state;
+    beam_state.next_token_logits = next_token_logits;
+    beam_state.next_token_scores = next_token_scores;
+    beam_state.next_tokens = next_tokens;
+    beam_state.next_indices = next_indices;
+    beam_state.next_scores = next_scores;
+    beam_state.beam_scores = state_beam_scores;
+
+    transformers::ILogitsProcessorList* logits_processors = fused ? static_cast<transformers::ILogitsProcessorList*>(
+                                                                        &processors)
+                                                                  : &unfused_processors;
+    ASSERT_STATUS_OK(contrib::GenerationCpuDeviceHelper::ProcessLogits<float>(
+        inputs.logits, &beam_state, &inputs.sequences, inputs.allocator, nullptr, logits_processors,
+        &candidates[fused], &parameters, 1, nullptr, nullptr));
+  }
+
+  EXPECT_EQ(candidates[0].tokens, candidates[1].tokens);
+  EXPECT_EQ(candidates[0].indices, candidates[1].indices);
+  ASSERT_EQ(candidates[0].scores.size(), candidates[1].scores.size());
+  for (size_t i = 0; i < candidates[0].scores.size(); i++) {
+    EXPECT_NEAR(candidates[0].scores[i], candidates[1].scores[i], 1e-4f) << "candidate " << i;
+  }
+}
+
+// Runs the greedy search logits processing with and without the fused selection and checks the next tokens match.
+void RunGreedySearchSelection(int input_length, float repetition_penalty, float temperature) {
+  constexpr int batch_size = 3, vocab_size = 50, sequence_length = 6, max_length = 10;
+
+  GreedySearchParameters parameters{};
+  parameters.batch_size = batch_size;
+  parameters.num_beams = 1;
+  parameters.vocab_size = vocab_size;
+  parameters.sequence_length = sequence_length;
+  parameters.max_length = max_length;
+  parameters.repetition_penalty = repetition_penalty;
+  parameters.temperature = temperature;
+
+  LogitsProcessorList processors;
+  processors.Init(parameters);
+  float inline_repetition_penalty = 1.0f;
+  float inline_temperature = 1.0f;
+  ASSERT_TRUE(processors.GetInlineProcessors(1, inline_repetition_penalty, inline_temperature));
+  UnfusedLogitsProcessorList unfused_processors(processors);
+
+  SearchInputs inputs(batch_size, input_length, vocab_size, sequence_length, max_length);
+
+  std::vector<int32_t> next_tokens[2];
+  for (int fused = 0; fused < 2; fused++) {
+    std::vector<float> next_token_scores(static_cast<size_t>(batch_size) * vocab_size);
+    next_tokens[fused].resize(batch_size);
+
+    transformers::IGreedySearchState<float> greedy_state;
+    greedy_state.next_token_scores = next_token_scores;
+    greedy_state.next_tokens = next_tokens[fused];
+
+    transformers::ILogitsProcessorList* logits_processors = fused ? static_cast<transformers::ILogitsProcessorList*>(
+                                                                        &processors)
+                                                                  : &unfused_processors;
+    ASSERT_STATUS_OK(contrib::GenerationCpuDeviceHelper::GreedySearchProcessLogits<float>(
+        inputs.logits, &greedy_state, nullptr, &inputs.sequences, inputs.allocator, nullptr, logits_processors,
+        &parameters, false, 1, nullptr, nullptr));
+  }
+
+  EXPECT_EQ(next_tokens[0], next_tokens[1]);
+}
+
+}  // namespace
+
+TEST(GenerationDeviceHelperTest, BeamSearchFusedSelectionMatchesProcessors) {
+  for (int input_length : {1, 3}) {
+    for (float repetition_penalty : {1.0f, 1.3f, 0.8f}) {
+      for (float temperature : {1.0f, 0.7f}) {
+        SCOPED_TRACE(MakeString("input_length ", input_length, " repetition_penalty ", repetition_penalty,
+                                " temperature ", temperature));
+        RunBeamSearchSelection(input_length, repetition_penalty, temperature);
+      }
+    }
+  }
+}
+
+TEST(GenerationDeviceHelperTest, GreedySearchFusedSelectionMatchesProcessors) {
+  for (int input_length : {1, 3}) {
+    for (float repetition_penalty : {1.0f, 1.3f, 0.8f}) {
+      for (float temperature : {1.0f, 0.7f}) {
+        SCOPED_TRACE(MakeString("input_length ", input_length, " repetition_penalty ", repetition_penalty,
+                                " temperature ", temperature));
+        RunGreedySearchSelection(input_length, repetition_penalty, temperature);
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifndef ORT_MINIMAL_BUILD
+#include <optional>
+
+#include "gtest/gtest.h"
+
+#include "core/common/narrow.h"
+#include "core/common/span_utils.h"
+#include "core/framework/float16.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct TestOptionsLowBits {
+  int64_t bits{2};
+  int64_t M{1};
+  int64_t N{1};
+  int64_t K{1};
+  int64_t block_size{32};
+  int64_t accuracy_level{0};
+
+  bool has_zero_point{false};
+  bool has_bias{false};
+  bool is_b_constant{true};
+};
+
+[[maybe_unused]] std::ostream& operator<<(std::ostream& os, const TestOptionsLowBits& opts) {
+  return os << "bits:" << opts.bits << ", M:" << opts.M << ", N:" << opts.N << ", K:" << opts.K
+            << ", block_size:" << opts.block_size
+            << ", accuracy_level:" << opts.accuracy_level
+            << ", has_zero_point:" << opts.has_zero_point
+            << ", has_bias:" << opts.has_bias
+            << ", is_b_constant:" << opts.is_b_constant;
+}
+
+// Reads the index-th bits wide value of an LSB first bit stream.
+uint32_t ExtractBits(const uint8_t* data, int64_t bits, int64_t index) {
+  uint32_t value = 0;
+  for (int64_t b = 0; b < bits; b++) {
+    const int64_t bit = index * bits + b;
+    value |= ((data[bit / 8] >> (bit % 8)) & 1u) << b;
+  }
+  return value;
+}
+
+// B is generated directly in the packed 2-bit or 3-bit format, with random values, scales and zero points.
+// The expected output is computed from B dequantized in the test.
+template <typename T1>
+void RunTestLowBits(const TestOptionsLowBits& opts) {
+  SCOPED_TRACE(opts);
+
+  const int64_t M = opts.M, N = opts.N, K = opts.K, bits = opts.bits;
+  const int64_t k_blocks = (K + opts.block_size - 1) / opts.block_size;
+  const int64_t blob_size = opts.block_size * bits / 8;
+  const int64_t zp_bytes_per_column = (k_blocks * bits + 7) / 8;
+
+  RandomValueGenerator random{1234};
+  std::vector<float> a_vals(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+  std::vector<uint8_t> b_vals(random.Uniform<uint8_t>(AsSpan({N, k_blocks, blob_size}), 0, 255));
+  std::vector<float> scales(random.Uniform<float>(AsSpan({N, k_blocks}), 0.01f, 0.05f));
+  std::vector<uint8_t> zero_points;
+  if (opts.has_zero_point) {
+    zero_points = random.Uniform<uint8_t>(AsSpan({N, zp_bytes_per_column}), 0, 255);
+  }
+
+  const std::vector<int64_t> bias_shape = {N};
+  std::optional<std::vector<float>> bias;
+  if (opts.has_bias) {
+    bias = random.Uniform<float>(bias_shape, 1.0f, 5.0f);
+  }
+
+  if constexpr (std::is_same<T1, MLFloat16>::value) {
+    // Compute the expected values from the fp16 rounded inputs.
+    for (auto* values : {&a_vals, &scales}) {
+      for (auto& v : *values) {
+        v = MLFloat16(v).ToFloat();
+      }
+    }
+    if (bias.has_value()) {
+      for (auto& v : *bias) {
+        v = MLFloat16(v).ToFloat();
+      }
+    }
+  }
+
+  std::vector<float> dequantized_b(N * K);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t block = k / opts.block_size;
+      const uint32_t zp = opts.has_zero_point
+                              ? ExtractBits(zero_points.data() + n * zp_bytes_per_column, bits, block)
+                              : (1u << (bits - 1));
+      const uint32_t q = ExtractBits(b_vals.data() + n * k_blocks * blob_size, bits, k);
+      dequantized_b[n * K + k] = (static_cast<float>(q) - static_cast<float>(zp)) * scales[n * k_blocks + block];
+    }
+  }
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_vals[m * K + k] * dequantized_b[n * K + k];
+      }
+      expected_vals[m * N + n] = sum + (bias.has_value() ? (*bias)[n] : 0.0f);
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", opts.block_size);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("accuracy_level", opts.accuracy_level);
+
+  if constexpr (std::is_same<T1, float>::value) {
+    test.AddInput<T1>("A", {M, K}, a_vals, false);
+    test.AddInput<uint8_t>("B", {N, k_blocks, blob_size}, b_vals, opts.is_b_constant);
+    test.AddInput<T1>("scales", {N, k_blocks}, scales, true);
+  } else {
+    test.AddInput<T1>("A", {M, K}, FloatsToMLFloat16s(a_vals), false);
+    test.AddInput<uint8_t>("B", {N, k_blocks, blob_size}, b_vals, opts.is_b_constant);
+    test.AddInput<T1>("scales", {N, k_blocks}, FloatsToMLFloat16s(scales), true);
+  }
+
+  if (opts.has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N, zp_bytes_per_column}, zero_points, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+
+  // Account for deprecated "g_idx" input
+  test.AddOptionalInputEdge<int32_t>();
+
+  if (bias.has_value()) {
+    if constexpr (std::is_same<T1, float>::value) {
+      test.AddInput<T1>("bias", bias_shape, *bias, true);
+    } else {
+      test.AddInput<T1>("bias", bias_shape, FloatsToMLFloat16s(*bias), true);
+    }
+  } else {
+    test.AddOptionalInputEdge<T1>();
+  }
+
+  if constexpr (std::is_same<T1, float>::value) {
+    test.AddOutput<T1>("Y", {M, N}, expected_vals);
+    test.SetOutputAbsErr("Y", 1e-3f);
+    test.SetOutputRelErr("Y", 1e-3f);
+  } else {
+    test.AddOutput<T1>("Y", {M, N}, FloatsToMLFloat16s(expected_vals));
+    test.SetOutputAbsErr("Y", 0.02f);
+    test.SetOutputRelErr("Y", 0.01f);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers));
+  test.RunWithConfig();
+}
+
+template <typename T1>
+void TestMatMulLowBits(int64_t bits, int64_t M, int64_t N, int64_t K, int64_t block_size) {
+  for (bool has_zero_point : {false, true}) {
+    for (bool has_bias : {false, true}) {
+      for (bool is_b_constant : {true, false}) {
+        TestOptionsLowBits opts{};
+        opts.bits = bits;
+        opts.M = M, opts.N = N, opts.K = K;
+        opts.block_size = block_size;
+        opts.has_zero_point = has_zero_point;
+        opts.has_bias = has_bias;
+        opts.is_b_constant = is_b_constant;
+        RunTestLowBits<T1>(opts);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MatMulNBits, Float32_2b) {
+  TestMatMulLowBits<float>(2, 1, 1, 16, 16);
+  TestMatMulLowBits<float>(2, 1, 67, 288, 32);
+  TestMatMulLowBits<float>(2, 3, 35, 97, 32);
+  TestMatMulLowBits<float>(2, 37, 64, 256, 128);
+  TestMatMulLowBits<float>(2, 100, 33, 520, 64);
+}
+
+TEST(MatMulNBits, Float32_3b) {
+  TestMatMulLowBits<float>(3, 1, 1, 16, 16);
+  TestMatMulLowBits<float>(3, 1, 67, 288, 32);
+  TestMatMulLowBits<float>(3, 3, 35, 97, 32);
+  TestMatMulLowBits<float>(3, 37, 64, 256, 128);
+  TestMatMulLowBits<float>(3, 100, 33, 520, 64);
+}
+
+TEST(MatMulNBits, Float32_3b_AccuracyLevel4) {
+  // There is no int8 compute for 2-bit and 3-bit B, the kernel falls back to fp32 compute.
+  TestOptionsLowBits opts{};
+  opts.bits = 3;
+  opts.M = 5, opts.N = 40, opts.K = 160;
+  opts.block_size = 32;
+  opts.accuracy_level = 4;
+  opts.has_zero_point = true;
+  RunTestLowBits<float>(opts);
+}
+
+TEST(MatMulNBits, Float16_2b_3b) {
+  TestMatMulLowBits<MLFloat16>(2, 2, 48, 128, 32);
+  TestMatMulLowBits<MLFloat16>(3, 2, 48, 128, 32);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // ORT_MINIMAL_BUILD
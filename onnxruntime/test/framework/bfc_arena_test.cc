@@ -7,6 +7,8 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -481,5 +483,187 @@ TEST(BFCArenaTest, TestExtendStrategy) {
   ASSERT_EQ(extend_delta_bytes, extend_limit);
 }
 
+TEST(BFCArenaTest, HugePageRegions) {
+  OrtArenaCfg config(0, 0, -1, -1, -1, -1L);
+  config.huge_pages = 1;
+  config.numa_node = 0;
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  BFCArena& a = *static_cast<BFCArena*>(allocator.get());
+
+  std::vector<void*> ptrs;
+  for (size_t size : {size_t{1024}, size_t{4} << 20, size_t{16} << 20}) {
+    void* p = a.Alloc(size);
+    ASSERT_NE(p, nullptr);
+    std::memset(p, 0xab, size);
+    ptrs.push_back(p);
+  }
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheServesRepeatedAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             4096, 1 << 20);
+  AllocatorStats stats;
+
+  void* p1 = a.Alloc(1000);
+  a.Free(p1);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.thread_cache_bytes, 1024);
+
+  // same rounded size is served from the cache, a different one is not.
+  void* p2 = a.Alloc(1024);
+  EXPECT_EQ(p1, p2);
+  void* p3 = a.Alloc(512);
+  EXPECT_NE(p2, p3);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 3);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.bytes_in_use, 1024 + 512);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+
+  // chunks larger than the limit go straight back to the arena.
+  void* large = a.Alloc(8192);
+  a.Free(large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+
+  a.Free(p2);
+  a.Free(p3);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.thread_cache_bytes, 1024 + 512);
+
+  // Shrink returns the cached chunks to the arena.
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+  void* p4 = a.Alloc(1024);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  a.Free(p4);
+}
+
+TEST(BFCArenaTest, ThreadCacheFlushesOverLimit) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             4096, 4096);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 8; ++i) {
+    ptrs.push_back(a.Alloc(1024));
+  }
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  // the cache goes over the limit with the 5th and the 8th chunk, and is flushed to half of the limit each time.
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_flushes, 2);
+  EXPECT_EQ(stats.thread_cache_bytes, 2048);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheFlushedWhenOutOfMemory) {
+  // the arena is limited to its first 1MB region, so the cached chunks have to be returned to serve the last request.
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 20, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             64 * 1024, 1 << 20);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 16; ++i) {
+    ptrs.push_back(a.Alloc(64 * 1024));
+  }
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  void* p = a.Alloc(512 * 1024);
+  EXPECT_NE(p, nullptr);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, 512 * 1024);
+  a.Free(p);
+}
+
+TEST(BFCArenaTest, ThreadCacheMultipleThreads) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             16 * 1024, 64 * 1024);
+  constexpr int num_threads = 8;
+  constexpr int num_iterations = 1000;
+  const size_t sizes[] = {256, 1024, 4096, 16 * 1024, 64 * 1024};
+
+  // every thread fills its buffers with its own id and checks them before freeing, which fails if two live
+  // allocations overlap. half of the buffers are freed by the next thread to move chunks between the caches.
+  std::vector<std::vector<void*>> handed_over(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < num_iterations; ++i) {
+        ptrs.clear();
+        for (size_t size : sizes) {
+          void* p = a.Alloc(size);
+          std::memset(p, t, size);
+          ptrs.push_back(p);
+        }
+
+        for (size_t j = 0; j < ptrs.size(); ++j) {
+          const auto* bytes = static_cast<const unsigned char*>(ptrs[j]);
+          ASSERT_EQ(bytes[0], t);
+          ASSERT_EQ(bytes[sizes[j] - 1], t);
+          if (i % 2 == 0 || j % 2 == 0) {
+            a.Free(ptrs[j]);
+          } else {
+            handed_over[t].push_back(ptrs[j]);
+          }
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  threads.clear();
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (void* p : handed_over[(t + 1) % num_threads]) {
+        a.Free(p);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.num_allocs, num_threads * num_iterations * static_cast<int64_t>(std::size(sizes)));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -30,6 +30,7 @@
 #include "core/graph/model.h"
 #include "core/graph/op.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/platform/device_discovery.h"
 #include "core/platform/env.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
@@ -58,6 +59,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -3100,5 +3102,217 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
 }
 #endif
 
+// The MatMul weight of matmul_1.onnx is pre-packed and copied to every NUMA node. Runs on the partitioned intra-op
+// threads must produce the same results as runs on a single thread pool.
+TEST(InferenceSessionTests, IntraOpNumaPartitioning) {
+  const size_t num_numa_nodes = DeviceDiscovery::GetNumaNodes().size();
+
+  auto run_matmul = [num_numa_nodes](bool numa_partitioning, std::vector<float>& y) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.IntraOpNumaPartitioning";
+    so.intra_op_param.thread_pool_size = static_cast<int>(2 * num_numa_nodes);
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigIntraOpNumaPartitioning,
+                                                      numa_partitioning ? "1" : "0"));
+
+    InferenceSessionTestGlobalThreadPools session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load("testdata/matmul_1.onnx"));
+    ASSERT_STATUS_OK(session.Initialize());
+    ASSERT_NE(session.GetIntraOpThreadPoolToUse(), nullptr);
+
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                         {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &x);
+    NameMLValMap feeds{{"X", x}};
+    std::vector<std::string> output_names{"Y"};
+
+    // run a few times so that runs may land on different partitions
+    for (int i = 0; i < 4; ++i) {
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+      auto data = fetches[0].Get<Tensor>().DataAsSpan<float>();
+      y.assign(data.begin(), data.end());
+    }
+  };
+
+  std::vector<float> expected;
+  std::vector<float> actual;
+  run_matmul(false, expected);
+  run_matmul(true, actual);
+  ASSERT_EQ(expected.size(), size_t{3});
+  EXPECT_EQ(actual, expected);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+// Sessions with the same model and options load the optimized model from the cache instead of optimizing it again.
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  TemporaryDirectory cache_dir(ORT_TSTR("optimized_model_cache_test"));
+
+  auto count_entries = [&cache_dir]() {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir.Path())) {
+      count += entry.path().extension() == ORT_TSTR(".ort") ? 1 : 0;
+    }
+    return count;
+  };
+
+  // 'optimized' is set if the session optimized the model instead of loading it from the cache
+  auto run_session = [&cache_dir](TransformerLevel level, bool& optimized) {
+    SessionOptions so;
+    so.session_logid = "OptimizedModelCache";
+    so.graph_optimization_level = level;
+    so.enable_profiling = true;
+    so.profile_file_prefix = ORT_TSTR("optimized_model_cache_test");
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                      ToUTF8String(cache_dir.Path()).c_str()));
+
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    RunModel(session_object, RunOptions{});
+
+    std::ifstream profile(session_object.EndProfiling());
+    ASSERT_TRUE(profile);
+    const std::string events{std::istreambuf_iterator<char>(profile), std::istreambuf_iterator<char>()};
+    optimized = events.find("session_graph_transformation") != std::string::npos;
+  };
+
+  bool optimized = false;
+  run_session(TransformerLevel::Level2, optimized);
+  EXPECT_TRUE(optimized);
+  ASSERT_EQ(count_entries(), size_t{1});
+
+  run_session(TransformerLevel::Level2, optimized);
+  EXPECT_FALSE(optimized);
+  ASSERT_EQ(count_entries(), size_t{1});
+
+  // different options create a new entry
+  run_session(TransformerLevel::Level1, optimized);
+  EXPECT_TRUE(optimized);
+  ASSERT_EQ(count_entries(), size_t{2});
+
+  // corrupted entries are ignored and replaced
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir.Path())) {
+    std::ofstream(entry.path(), std::ios::binary | std::ios::trunc) << "not an ORT format model";
+  }
+
+  run_session(TransformerLevel::Level2, optimized);
+  EXPECT_TRUE(optimized);
+  run_session(TransformerLevel::Level2, optimized);
+  EXPECT_FALSE(optimized);
+  ASSERT_EQ(count_entries(), size_t{2});
+}
+
+// The key of a model with external data identifies the data file by its location and the time of its last write
+// instead of reading it.
+TEST(InferenceSessionTests, OptimizedModelCacheExternalData) {
+  TemporaryDirectory cache_dir(ORT_TSTR("optimized_model_cache_external_data_test"));
+  TemporaryDirectory model_dir(ORT_TSTR("optimized_model_cache_external_data_model"));
+  const std::filesystem::path model_path = std::filesystem::path(model_dir.Path()) /
+                                           ORT_TSTR("model_with_external_initializers.onnx");
+  const std::filesystem::path data_path = std::filesystem::path(model_dir.Path()) / ORT_TSTR("Pads.bin");
+  std::filesystem::copy_file(ORT_TSTR("testdata/model_with_external_initializers.onnx"), model_path);
+  std::filesystem::copy_file(ORT_TSTR("testdata/Pads.bin"), data_path);
+
+  auto run_session = [&](bool& optimized) {
+    SessionOptions so;
+    so.session_logid = "OptimizedModelCacheExternalData";
+    so.enable_profiling = true;
+    so.profile_file_prefix = ORT_TSTR("optimized_model_cache_external_data_test");
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                      ToUTF8String(cache_dir.Path()).c_str()));
+
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_path.native()));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    std::ifstream profile(session_object.EndProfiling());
+    ASSERT_TRUE(profile);
+    const std::string events{std::istreambuf_iterator<char>(profile), std::istreambuf_iterator<char>()};
+    optimized = events.find("session_graph_transformation") != std::string::npos;
+  };
+
+  bool optimized = false;
+  run_session(optimized);
+  EXPECT_TRUE(optimized);
+  run_session(optimized);
+  EXPECT_FALSE(optimized);
+
+  // rewriting the data file creates a new entry
+  std::filesystem::last_write_time(data_path, std::filesystem::last_write_time(data_path) + std::chrono::hours(1));
+  run_session(optimized);
+  EXPECT_TRUE(optimized);
+  run_session(optimized);
+  EXPECT_FALSE(optimized);
+}
+
+#if !defined(ORT_NO_RTTI)
+// A session with tuning enabled tunes the MatMul of matmul_1.onnx on its first run and saves the result to the CPU
+// tuning results file when it is destroyed. Later sessions load the result from the file.
+TEST(InferenceSessionTests, CpuTuningResultsFile) {
+  TemporaryDirectory tuning_dir(ORT_TSTR("cpu_tuning_results_test"));
+  const std::filesystem::path tuning_results_file = std::filesystem::path(tuning_dir.Path()) / "tuning_results.json";
+
+  auto count_cpu_results = [](const std::vector<TuningResults>& trs) {
+    size_t count = 0;
+    for (const auto& tr : trs) {
+      if (tr.ep == kCpuExecutionProvider) {
+        for (const auto& [op_signature, kernel_map] : tr.results) {
+          count += kernel_map.size();
+        }
+      }
+    }
+    return count;
+  };
+
+  // 'num_results' is the number of CPU tuning results the session has after one run
+  auto run_session = [&](bool tuning_enable, size_t& num_results) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.CpuTuningResultsFile";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpEnable, "1"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpTuningEnable,
+                                                      tuning_enable ? "1" : "0"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "1"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTuningResultsFile,
+                                                      tuning_results_file.string().c_str()));
+
+    InferenceSession session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load("testdata/matmul_1.onnx"));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                         {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &x);
+    NameMLValMap feeds{{"X", x}};
+    std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+
+    const std::vector<float> expected_y{5.f, 11.f, 17.f};
+    const auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(std::vector<float>(y.begin(), y.end()), expected_y);
+
+    num_results = count_cpu_results(session.GetTuningResults());
+  };
+
+  size_t num_results = 0;
+  run_session(/*tuning_enable*/ true, num_results);
+  EXPECT_EQ(num_results, size_t{1});
+  ASSERT_TRUE(std::filesystem::is_regular_file(tuning_results_file));
+
+  run_session(/*tuning_enable*/ false, num_results);
+  EXPECT_EQ(num_results, size_t{1});
+
+  // a corrupted file is ignored and replaced
+  std::ofstream(tuning_results_file, std::ios::trunc) << "not a tuning results file";
+  run_session(/*tuning_enable*/ false, num_results);
+  EXPECT_EQ(num_results, size_t{0});
+  run_session(/*tuning_enable*/ true, num_results);
+  EXPECT_EQ(num_results, size_t{1});
+  run_session(/*tuning_enable*/ false, num_results);
+  EXPECT_EQ(num_results, size_t{1});
+}
+#endif  // !defined(ORT_NO_RTTI)
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace test
 }  // namespace onnxruntime
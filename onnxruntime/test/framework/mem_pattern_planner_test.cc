@@ -1,7 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/framework/allocator.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/tensor.h"
+#include "test/util/include/asserts.h"
 #include "gtest/gtest.h"
 
 namespace onnxruntime {
@@ -35,5 +39,93 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+static MemoryPatternCacheEntry CreateCacheEntry(std::initializer_list<size_t> block_sizes) {
+  constexpr bool using_counters = false;
+  MemPatternPlanner planner{using_counters};
+  int idx = 0;
+  for (auto size : block_sizes) {
+    planner.TraceAllocation(idx++, size);
+  }
+
+  MemoryPatternCacheEntry entry;
+  entry.patterns.locations.push_back(OrtDevice());
+  entry.patterns.patterns.push_back(planner.GenerateMemPattern());
+  return entry;
+}
+
+static OrtValue CreateInput(std::initializer_list<int64_t> dims) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(dims), CPUAllocator::DefaultInstance(), value);
+  return value;
+}
+
+TEST(MemoryPatternCacheTest, BucketPolicy) {
+  MemoryPatternBucketPolicy policy;
+  ASSERT_STATUS_OK(MemoryPatternBucketPolicy::Parse("0", policy));
+  EXPECT_TRUE(policy.IsExact());
+  EXPECT_EQ(policy.Bucket(7), 7);
+
+  ASSERT_STATUS_OK(MemoryPatternBucketPolicy::Parse("pow2", policy));
+  EXPECT_FALSE(policy.IsExact());
+  EXPECT_EQ(policy.Bucket(1), 1);
+  EXPECT_EQ(policy.Bucket(5), 8);
+  EXPECT_EQ(policy.Bucket(8), 8);
+  EXPECT_EQ(policy.Bucket(129), 256);
+
+  ASSERT_STATUS_OK(MemoryPatternBucketPolicy::Parse("32", policy));
+  EXPECT_EQ(policy.Bucket(1), 1);
+  EXPECT_EQ(policy.Bucket(20), 32);
+  EXPECT_EQ(policy.Bucket(33), 64);
+
+  EXPECT_FALSE(MemoryPatternBucketPolicy::Parse("-4", policy).IsOK());
+  EXPECT_FALSE(MemoryPatternBucketPolicy::Parse("pow3", policy).IsOK());
+
+  // inputs whose shapes round to the same values share a key, transposed shapes do not
+  std::vector<OrtValue> a{CreateInput({2, 20}), CreateInput({20})};
+  std::vector<OrtValue> b{CreateInput({2, 30}), CreateInput({17})};
+  std::vector<OrtValue> c{CreateInput({30, 2}), CreateInput({17})};
+  EXPECT_EQ(policy.CalculateKey(a), policy.CalculateKey(b));
+  EXPECT_NE(policy.CalculateKey(b), policy.CalculateKey(c));
+
+  ASSERT_STATUS_OK(MemoryPatternBucketPolicy::Parse("0", policy));
+  EXPECT_NE(policy.CalculateKey(a), policy.CalculateKey(b));
+}
+
+TEST(MemoryPatternCacheTest, LruEviction) {
+  MemoryPatternCache cache(2);
+  EXPECT_EQ(cache.Find(1), nullptr);
+  cache.Insert(1, CreateCacheEntry({64}));
+  cache.Insert(2, CreateCacheEntry({128}));
+  EXPECT_NE(cache.Find(1), nullptr);  // 2 is now the least recently used entry
+  cache.Insert(3, CreateCacheEntry({256}));
+
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_NE(cache.Find(1), nullptr);
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_NE(cache.Find(3), nullptr);
+
+  const auto& stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.evictions, 1u);
+}
+
+TEST(MemoryPatternCacheTest, ReplaceOnlyWithLargerPattern) {
+  MemoryPatternCache cache;
+  auto first = cache.Insert(1, CreateCacheEntry({64, 128}));
+
+  // a smaller pattern does not replace the cached one
+  auto entry = cache.Insert(1, CreateCacheEntry({32, 256}));
+  EXPECT_EQ(entry, first);
+  EXPECT_EQ(entry->patterns.patterns[0].GetBlock(1)->size_, 128u);
+
+  // a pattern with room for every block does, and the old entry stays valid for its users
+  entry = cache.Insert(1, CreateCacheEntry({64, 256}));
+  EXPECT_NE(entry, first);
+  EXPECT_EQ(entry->patterns.patterns[0].GetBlock(1)->size_, 256u);
+  EXPECT_EQ(first->patterns.patterns[0].GetBlock(1)->size_, 128u);
+  EXPECT_EQ(cache.Find(1), entry);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,7 +3,11 @@
 
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/test_environment.h"
 #include "test_utils.h"
 #include "core/session/inference_session.h"
 
@@ -145,5 +149,108 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
 
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                          testing::Values(1, 0));
+
+// X feeds 'num_branches' independent chains of 'chain_length' Add(prev, X) nodes whose outputs are summed up,
+// so Y = num_branches * (chain_length + 1) * X.
+static std::string CreateManyBranchModel(int num_branches, int chain_length) {
+  onnxruntime::Model model("many_branches", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  std::vector<onnxruntime::NodeArg*> sum_inputs;
+  for (int b = 0; b < num_branches; ++b) {
+    onnxruntime::NodeArg* prev = &x_arg;
+    for (int c = 0; c < chain_length; ++c) {
+      const std::string name = "add_" + std::to_string(b) + "_" + std::to_string(c);
+      auto& out = graph.GetOrCreateNodeArg(name + "_out", &float_tensor);
+      graph.AddNode(name, "Add", name, {prev, &x_arg}, {&out});
+      prev = &out;
+    }
+    sum_inputs.push_back(prev);
+  }
+
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("sum", "Sum", "sum", sum_inputs, {&y_arg});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+TEST(ParallelExecutor, DependencyDrivenExecution) {
+  constexpr int num_branches = 8;
+  constexpr int chain_length = 6;
+  const std::string model_data = CreateManyBranchModel(num_branches, chain_length);
+
+  SessionOptions so;
+  so.session_logid = "ParallelExecutor.DependencyDrivenExecution";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDependencyDrivenExecution, "1"));
+  // keep the chains intact so the executor sees the branches
+  so.graph_optimization_level = TransformerLevel::Default;
+
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+  ASSERT_NE(session.GetSessionState().GetNodeDependencyPlan(), nullptr);
+  EXPECT_EQ(session.GetSessionState().GetNodeDependencyPlan()->roots.size(), static_cast<size_t>(num_branches));
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4}, {1.f, 2.f, 3.f, 4.f}, &x);
+  NameMLValMap feeds{{"X", x}};
+  std::vector<std::string> output_names{"Y"};
+
+  constexpr float factor = num_branches * (chain_length + 1);
+  for (int i = 0; i < 10; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y.size(), 4u);
+    for (size_t j = 0; j < y.size(); ++j) {
+      EXPECT_EQ(y[j], factor * (j + 1));
+    }
+  }
+}
+
+TEST(ParallelExecutor, DependencyDrivenExecutionStatusPropagation) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{TestOp::OpSchema()};
+  ASSERT_STATUS_OK(registry->RegisterOpSet(schemas, TestOp::OpDomain, 10, 11));
+  KernelCreateFn kernel_create_fn = [](FuncManager&, const OpKernelInfo& info, std::unique_ptr<OpKernel>& out) { out = std::make_unique<typename TestOp::OpKernelImpl>(info); return Status::OK(); };
+  auto kernel_def = TestOp::KernelDef();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(kernel_def, kernel_create_fn));
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "ParallelExecutor.DependencyDrivenExecutionStatusPropagation";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDependencyDrivenExecution, "1"));
+
+  {  // test failure
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+    tester.AddInput<int64_t>("action", {1}, {/*failure*/ 1});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectFailure, "Action was 1", {kTensorrtExecutionProvider}, nullptr,
+               nullptr);
+  }
+
+  {  // test exception
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+    tester.AddInput<int64_t>("action", {1}, {/*exception*/ 2});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectFailure, "Throwing as action was 2", {kTensorrtExecutionProvider},
+               nullptr, nullptr);
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
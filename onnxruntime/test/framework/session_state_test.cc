@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <absl/base/config.h>
 
@@ -9,6 +11,7 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/numa_partitions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
@@ -17,6 +20,7 @@
 #include "core/graph/model.h"
 #include "core/graph/model_saving_options.h"
 #include "core/graph/op.h"
+#include "core/platform/device_discovery.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/thread_utils.h"
@@ -622,6 +626,21 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
+  bool CanRestorePrePackedState(int input_idx) const override {
+    ORT_UNUSED_PARAMETER(input_idx);
+    return true;
+  }
+
+  Status RestorePrePackedState(const Tensor& tensor, int input_idx, const PrePackedWeights& prepacked_weights,
+                               /*out*/ bool& is_restored) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+
+    is_restored = prepacked_weights.buffer_sizes_.size() == 1 &&
+                  prepacked_weights.buffer_sizes_[0] == sizeof(float) * 2;
+    return Status::OK();
+  }
+
   int prepack_calls_count = 0;
   int store_pre_packed_weight_calls_count = 0;
   IAllocatorUniquePtr<void> weight_packed_;
@@ -759,6 +778,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -801,6 +821,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -832,6 +854,15 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
   // check prepacking
   ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), size_t(test_param.test_prepacking ? 1 : 0));
+
+  for (const auto& node : model.MainGraph().Nodes()) {
+    const auto* kernel = session_state.GetKernel(node.Index());
+    ASSERT_NE(kernel, nullptr);
+    if (test_param.test_prepacking && node.OpType() == "PrePackingTest") {
+      ASSERT_EQ(static_cast<const PrePackingTestOpKernel*>(kernel)->prepack_calls_count, 1);
+    }
+  }
 }
 
 class SessionStateTestSharedInitalizersWithPrePacking : public ::testing::Test {
@@ -1230,7 +1261,132 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test4) {
   ASSERT_EQ(if_node_branches_shared_prepack_counter_2, static_cast<size_t>(2));
 }
 
+// NUMA partitioning: every partition gets its own copy of the pre-packed weight, which the kernels of a Run on that
+// partition read through NumaPartitions::GetLocalBuffer.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, NumaPartitionsReplicatePrePackedWeights) {
+  SessionOptions sess_options;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+  CreateSimpleGraph(model.MainGraph());
+  PlaceAllNodesToCPUEP(model.MainGraph());
+
+  // two partitions on the same node, so the test doesn't depend on the topology of the machine.
+  const auto& numa_nodes = DeviceDiscovery::GetNumaNodes();
+  ASSERT_FALSE(numa_nodes.empty());
+  ASSERT_FALSE(numa_nodes[0].processors.empty());
+  std::vector<std::unique_ptr<concurrency::ThreadPool>> thread_pools;
+  thread_pools.push_back(nullptr);
+  thread_pools.push_back(nullptr);
+  NumaPartitions numa_partitions({numa_nodes[0], numa_nodes[0]}, std::move(thread_pools));
+
+  SessionState session_state(model.MainGraph(),
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             edlm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+  session_state.SetNumaPartitions(&numa_partitions);
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+  const void* packed = kernel->weight_packed_.get();
+  ASSERT_NE(packed, nullptr);
+
+  // outside of a Run the kernel reads the original buffer
+  ASSERT_EQ(NumaPartitions::GetLocalBuffer(packed), packed);
+
+  const void* replicas[2];
+  for (size_t partition = 0; partition < 2; ++partition) {
+    NumaPartitions::RunScope run_scope(numa_partitions, partition);
+    replicas[partition] = NumaPartitions::GetLocalBuffer(packed);
+    ASSERT_NE(replicas[partition], packed);
+    const float* data = static_cast<const float*>(replicas[partition]);
+    EXPECT_EQ(data[0], 1.2345f);
+    EXPECT_EQ(data[1], 1.2345f * 2.f);
+    EXPECT_EQ(session_state.GetThreadPoolForCurrentRun(), nullptr);
+  }
+
+  EXPECT_NE(replicas[0], replicas[1]);
+  EXPECT_EQ(NumaPartitions::GetLocalBuffer(packed), packed);
+  EXPECT_EQ(session_state.GetThreadPoolForCurrentRun(), nullptr);
+}
+
 #ifndef __wasm__
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, PrePackedWeightsDiskCache) {
+  const auto cache_dir = std::filesystem::temp_directory_path() / ORT_TSTR("ort_prepacked_weights_disk_cache_test");
+  std::filesystem::remove_all(cache_dir);
+
+  SessionOptions sess_options;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsPrePackedWeightsCacheDir] =
+      PathToUTF8String(cache_dir.native());
+
+  auto finalize_session = [&](size_t expected_prepack_calls, size_t expected_cache_hits) {
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    CreateSimpleGraph(model.MainGraph());
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               edlm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+    EXPECT_EQ(kernel->prepack_calls_count, static_cast<int>(expected_prepack_calls));
+    EXPECT_EQ(session_state.GetPrePackedWeightsCacheHitsCounter(), expected_cache_hits);
+    EXPECT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+
+    // the initializer was released whether it was pre-packed or loaded from the cache
+    EXPECT_TRUE(session_state.GetConstantInitializedTensors().empty());
+    const float* data = static_cast<const float*>(kernel->weight_packed_.get());
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data[0], 1.2345f);
+    EXPECT_EQ(data[1], 1.2345f * 2.f);
+  };
+
+  // the first session pre-packs the weight and writes it to the cache, the second one maps it from there
+  finalize_session(1, 0);
+  std::vector<std::filesystem::path> entries;
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+    entries.push_back(entry.path());
+  }
+  ASSERT_EQ(entries.size(), static_cast<size_t>(1));
+  finalize_session(0, 1);
+
+  // a corrupted entry is ignored and replaced
+  {
+    std::fstream entry(entries[0], std::ios::in | std::ios::out | std::ios::binary);
+    entry.seekp(-1, std::ios::end);
+    entry.put('\x7f');
+  }
+  finalize_session(1, 0);
+  finalize_session(0, 1);
+
+  // a different MLAS configuration doesn't use the entry
+  sess_options.config_options.configurations["mlas.test_option"] = "1";
+  finalize_session(1, 0);
+
+  std::filesystem::remove_all(cache_dir);
+}
+
 // sharing is on
 TEST_F(SessionStateTestSharedInitalizersWithPrePacking, TestPrepackedSerialization) {
   const std::filesystem::path model_with_external_initializers =
@@ -1425,7 +1581,9 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true}));
 #endif
 
 }  // namespace test
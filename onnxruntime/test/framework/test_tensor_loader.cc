@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 
 #include "core/common/common.h"
+#include "core/common/span_utils.h"
 #include "core/framework/callback.h"
 #include "core/framework/tensorprotoutils.h"
 #include "test/util/include/file_util.h"
@@ -171,6 +172,45 @@ TEST(CApiTensorTest, load_float_tensor_with_external_data) {
   run_external_data_test<true>();
   run_external_data_test<false>();
 }
+
+TEST(CApiTensorTest, share_mapped_external_data) {
+  FILE* fp;
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  CreateTestFile(fp, filename);
+  ScopedFileDeleter file_deleter(filename);
+  const float test_data[] = {1.0f, 2.2f, 3.5f};
+  ASSERT_EQ(sizeof(test_data), fwrite(test_data, 1, sizeof(test_data), fp));
+  ASSERT_EQ(0, fclose(fp));
+
+  onnx::TensorProto p;
+  p.set_name("shared");
+  onnx::StringStringEntryProto* location = p.mutable_external_data()->Add();
+  location->set_key("location");
+  location->set_value(ToUTF8String(filename));
+  p.mutable_dims()->Add(3);
+  p.set_data_location(onnx::TensorProto_DataLocation_EXTERNAL);
+  p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+
+  OrtValue value1;
+  OrtValue value2;
+  OrtValue unshared_value;
+  ASSERT_STATUS_OK(utils::GetExtDataFromTensorProto(Env::Default(), std::filesystem::path(), p, value1, nullptr, true));
+  ASSERT_STATUS_OK(utils::GetExtDataFromTensorProto(Env::Default(), std::filesystem::path(), p, value2, nullptr, true));
+  ASSERT_STATUS_OK(utils::GetExtDataFromTensorProto(Env::Default(), std::filesystem::path(), p, unshared_value));
+
+  const void* shared_data = value1.Get<Tensor>().DataRaw();
+  if constexpr (endian::native == endian::little) {
+    EXPECT_EQ(value2.Get<Tensor>().DataRaw(), shared_data);
+    EXPECT_TRUE(SpanEq(value1.Get<Tensor>().DataAsSpan<float>(), gsl::make_span(test_data, 3)));
+  }
+  EXPECT_NE(unshared_value.Get<Tensor>().DataRaw(), shared_data);
+
+  // the data stays valid while any value references it.
+  value1 = OrtValue();
+  if constexpr (endian::native == endian::little) {
+    EXPECT_TRUE(SpanEq(value2.Get<Tensor>().DataAsSpan<float>(), gsl::make_span(test_data, 3)));
+  }
+}
 #endif
 
 #if defined(__amd64__) || defined(_M_X64)
@@ -18,6 +18,11 @@ void HGEMM(benchmark::State& state, bool transA, bool transB) {
   const size_t N = static_cast<size_t>(state.range(1));
   const size_t K = static_cast<size_t>(state.range(2));
 
+  if (!MlasHGemmSupported(transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans)) {
+    state.SkipWithError("HGEMM is not supported on this CPU.");
+    return;
+  }
+
   auto A = RandomVectorUniform(static_cast<size_t>(M * K), MLAS_FP16(-1.0f), MLAS_FP16(1.0f));
   auto B = RandomVectorUniform(static_cast<size_t>(N * K), MLAS_FP16(-1.0f), MLAS_FP16(1.0f));
   std::vector<MLAS_FP16> C(static_cast<size_t>(M * N));
@@ -87,3 +92,50 @@ static void GemmLLMSizeProducts(benchmark::internal::Benchmark* b) {
 }
 BENCHMARK_CAPTURE(HGEMM, LLM_TransB, false, true)->Apply(GemmLLMSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(HGEMM, LLM_B, false, false)->Apply(GemmLLMSizeProducts)->UseRealTime();
+
+void HALFGEMM(benchmark::State& state, bool with_bias) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  if (!MlasHalfGemmAccelerationSupported()) {
+    state.SkipWithError("Half precision GEMM is not supported on this CPU.");
+    return;
+  }
+
+  auto A = RandomVectorUniform(static_cast<size_t>(M * K), MLAS_FP16(-1.0f), MLAS_FP16(1.0f));
+  auto B = RandomVectorUniform(static_cast<size_t>(N * K), MLAS_FP16(-1.0f), MLAS_FP16(1.0f));
+  auto Bias = RandomVectorUniform(static_cast<size_t>(N), MLAS_FP16(-1.0f), MLAS_FP16(1.0f));
+  std::vector<MLAS_FP16> C(static_cast<size_t>(M * N));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 8;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  MLAS_HALF_GEMM_DATA_PARAMS params;
+  params.A = A.data();
+  params.lda = K;
+  params.B = B.data();
+  params.ldb = N;
+  params.C = C.data();
+  params.ldc = N;
+  params.Bias = with_bias ? Bias.data() : nullptr;
+
+  MlasHalfGemmBatch(M, N, K, 1, &params, tp.get());
+
+  for (auto _ : state) {
+    MlasHalfGemmBatch(M, N, K, 1, &params, tp.get());
+  }
+}
+
+BENCHMARK_CAPTURE(HALFGEMM, GEMV_NoBias, false)->Apply(GemmSizeWithOne)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, GEMV_Bias, true)->Apply(GemmSizeWithOne)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, NORMAL_NoBias, false)->Apply(GemmSizeProducts)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, NORMAL_Bias, true)->Apply(GemmSizeProducts)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, LLM_NoBias, false)->Apply(GemmLLMSizeProducts)->UseRealTime();
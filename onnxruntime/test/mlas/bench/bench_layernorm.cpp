@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+using onnxruntime::narrow;
+
+template <typename T>
+void LAYERNORM(benchmark::State& state) {
+  const auto rows = narrow<size_t>(state.range(0));
+  const auto n = narrow<size_t>(state.range(1));
+  const auto has_skip = narrow<bool>(state.range(2));
+  const auto simplified = narrow<bool>(state.range(3));
+  const auto threads = narrow<int>(state.range(4));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(
+          &onnxruntime::Env::Default(), tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  const auto input_f = RandomVectorUniform<float>(rows * n, -1.0f, 1.0f);
+  const auto skip_f = RandomVectorUniform<float>(rows * n, -1.0f, 1.0f);
+  const auto scale = RandomVectorUniform<float>(n, 0.5f, 1.5f);
+  const auto bias = RandomVectorUniform<float>(n, -0.5f, 0.5f);
+
+  std::vector<T> input(input_f.begin(), input_f.end());
+  std::vector<T> skip(skip_f.begin(), skip_f.end());
+  std::vector<T> output(rows * n);
+  std::vector<T> skip_sum_output(has_skip ? rows * n : 0);
+
+  MLAS_LAYER_NORM_PARAMS<T> params;
+  params.Input = input.data();
+  params.Skip = has_skip ? skip.data() : nullptr;
+  params.SkipRows = rows;
+  params.Scale = scale.data();
+  params.Bias = simplified ? nullptr : bias.data();
+  params.Output = output.data();
+  params.SkipSumOutput = has_skip ? skip_sum_output.data() : nullptr;
+  params.Rows = rows;
+  params.N = n;
+  params.Epsilon = 1e-5f;
+  params.Simplified = simplified;
+
+  // warming up run
+  MlasLayerNormalization(params, tp.get());
+
+  for (auto _ : state) {
+    MlasLayerNormalization(params, tp.get());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * rows * n * sizeof(T) * (has_skip ? 4 : 2));
+}
+
+static void LayerNormArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"Rows", "N", "Skip", "Simplified", "Threads"});
+
+  b->ArgsProduct({
+      {1, 128, 2048},                   // Rows
+      {768, 4096},                      // N
+      {int64_t{false}, int64_t{true}},  // Skip
+      {int64_t{false}, int64_t{true}},  // Simplified
+      {1, 8},                           // Threads
+  });
+}
+
+BENCHMARK(LAYERNORM<float>)->Apply(LayerNormArgs)->UseRealTime();
+BENCHMARK(LAYERNORM<MLAS_FP16>)->Apply(LayerNormArgs)->UseRealTime();
@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <vector>
 #include <type_traits>
+#include <utility>
 
 #include "benchmark/benchmark.h"
 
@@ -31,10 +32,17 @@ void RunQNBitGemmBenchmark(size_t BlkLen,
   }
 
   size_t QuantBDataSizeInBytes, QuantBScaleSize, QuantBZeroPointSizeInBytes;
-  MlasBlockwiseQuantizedBufferSizes<BlkBitWidth>(
-      static_cast<int>(BlkLen), /* columnwise */ true,
-      static_cast<int>(K), static_cast<int>(N),
-      QuantBDataSizeInBytes, QuantBScaleSize, &QuantBZeroPointSizeInBytes);
+  if constexpr (BlkBitWidth == 3) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    QuantBDataSizeInBytes = N * BlockCountK * BlkLen * BlkBitWidth / 8;
+    QuantBScaleSize = N * BlockCountK;
+    QuantBZeroPointSizeInBytes = N * ((BlockCountK * BlkBitWidth + 7) / 8);
+  } else {
+    MlasBlockwiseQuantizedBufferSizes<BlkBitWidth>(
+        static_cast<int>(BlkLen), /* columnwise */ true,
+        static_cast<int>(K), static_cast<int>(N),
+        QuantBDataSizeInBytes, QuantBScaleSize, &QuantBZeroPointSizeInBytes);
+  }
 
   OrtThreadPoolParams tpo;
   tpo.thread_pool_size = static_cast<int>(Threads);
@@ -56,11 +64,20 @@ void RunQNBitGemmBenchmark(size_t BlkLen,
   std::vector<uint8_t> QuantBZeroPoint(Symmetric ? 0 : QuantBZeroPointSizeInBytes);
   bool has_zp_input = !Symmetric;
 
-  MlasQuantizeBlockwise<AType, BlkBitWidth>(QuantBData.data(), QuantBScale.data(),
-                                            Symmetric ? nullptr : QuantBZeroPoint.data(),
-                                            B.data(), static_cast<int>(BlkLen), /* columnwise */ true,
-                                            static_cast<int>(K), static_cast<int>(N), static_cast<int>(N),
-                                            tp.get());
+  if constexpr (BlkBitWidth == 3) {
+    // MlasQuantizeBlockwise does not pack 3-bit values, so random bit streams stand in for quantized B.
+    QuantBData = RandomVectorUniform<uint8_t>(QuantBData.size());
+    QuantBScale = RandomVectorUniform(QuantBScale.size(), AType(0.01f), AType(0.1f));
+    if (!Symmetric) {
+      QuantBZeroPoint = RandomVectorUniform<uint8_t>(QuantBZeroPoint.size());
+    }
+  } else {
+    MlasQuantizeBlockwise<AType, BlkBitWidth>(QuantBData.data(), QuantBScale.data(),
+                                              Symmetric ? nullptr : QuantBZeroPoint.data(),
+                                              B.data(), static_cast<int>(BlkLen), /* columnwise */ true,
+                                              static_cast<int>(K), static_cast<int>(N), static_cast<int>(N),
+                                              tp.get());
+  }
 
   std::unique_ptr<std::byte[]> Workspace;
   if (const auto WorkspaceSize = MlasQNBitGemmBatchWorkspaceSize(M, N, K, 1, BlkBitWidth, BlkLen, !Symmetric, ComputeType);
@@ -138,6 +155,50 @@ BENCHMARK(QNBITGEMM<float, 4>)->Apply(QNBitGemmArgs<float>)->UseRealTime();
 BENCHMARK(QNBITGEMM<float, 8>)->Apply(QNBitGemmArgs<float>)->UseRealTime();
 BENCHMARK(QNBITGEMM<MLAS_FP16, 4>)->Apply(QNBitGemmArgs<MLAS_FP16>)->UseRealTime();
 
+// Token by token decoding: M is the number of tokens per step, reported as a tokens/s rate of a single
+// MatMulNBits at the projection shapes of 7B/8B LLMs.
+template <typename AType, size_t BlkBitWidth>
+void QNBITGEMM_DECODE(benchmark::State& state) {
+  QNBITGEMM<AType, BlkBitWidth>(state);
+
+  state.counters["tokens/s"] =
+      benchmark::Counter(static_cast<double>(state.range(1)), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// 2-bit and 3-bit B only support SQNBIT_CompFp32.
+static void QNBitGemmLowBitDecodeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"BlkLen", "M", "N", "K", "Threads", "Symmetric", "HasBias", "ComputeType"});
+
+  for (const auto& [N, K] : std::vector<std::pair<int64_t, int64_t>>{
+           {4096, 4096}, {11008, 4096}, {4096, 11008}, {14336, 4096}, {4096, 14336}, {6144, 4096}}) {
+    for (int64_t M : {1, 2, 4}) {
+      for (int64_t Threads : {1, 8}) {
+        b->Args({32, M, N, K, Threads, int64_t{true}, int64_t{true}, int64_t{SQNBIT_CompFp32}});
+      }
+    }
+  }
+}
+
+static void QNBitGemmDecodeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"BlkLen", "M", "N", "K", "Threads", "Symmetric", "HasBias", "ComputeType"});
+
+  for (const auto& [N, K] : std::vector<std::pair<int64_t, int64_t>>{
+           {4096, 4096}, {11008, 4096}, {4096, 11008}, {14336, 4096}, {4096, 14336}, {6144, 4096}}) {
+    for (int64_t M : {1, 2, 4}) {
+      for (int64_t Threads : {1, 8}) {
+        for (int64_t ComputeType : {int64_t{SQNBIT_CompFp32}, int64_t{SQNBIT_CompInt8}}) {
+          b->Args({32, M, N, K, Threads, int64_t{true}, int64_t{true}, ComputeType});
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK(QNBITGEMM_DECODE<float, 4>)->Apply(QNBitGemmDecodeArgs)->UseRealTime();
+BENCHMARK(QNBITGEMM_DECODE<float, 8>)->Apply(QNBitGemmDecodeArgs)->UseRealTime();
+BENCHMARK(QNBITGEMM_DECODE<float, 2>)->Apply(QNBitGemmLowBitDecodeArgs)->UseRealTime();
+BENCHMARK(QNBITGEMM_DECODE<float, 3>)->Apply(QNBitGemmLowBitDecodeArgs)->UseRealTime();
+
 // This test gets benchmark arguments from environment variables.
 template <typename AType, size_t BlkBitWidth>
 void QNBITGEMM_ENV(benchmark::State& state) {
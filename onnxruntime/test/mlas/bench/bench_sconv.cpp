@@ -38,8 +38,7 @@ static const std::vector<std::string>& ArgNamesForConv(size_t rank) {
   return rank_to_args_name[rank];
 }
 
-// dummy for some strange build error when using Bench capture
-void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+static void SCONV_NCHW_Run(benchmark::State& state, bool pack_filter) {
   const int64_t rank = state.range(0);                       // Rank
   const int64_t batch_size = state.range(1);                 // N
   const int64_t groups = state.range(2);                     // G
@@ -110,7 +109,8 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
                   &activation,
                   &WorkingBufferSize,
                   0.0f,
-                  nullptr);
+                  nullptr,
+                  pack_filter);
 
   auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
   auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
@@ -118,10 +118,38 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   std::vector<float> Y(static_cast<size_t>(y_size));
   std::vector<float> working_buffer(WorkingBufferSize);
 
+  // pack the filter once as the Conv kernel does for constant filters, if the selected algorithm supports it.
+  // the packed filter must be aligned to the preferred buffer alignment.
+  std::vector<uint8_t> packed_filter_buffer;
+  void* packed_filter = nullptr;
+  if (pack_filter) {
+    const size_t packed_filter_size = MlasConvPackFilterSize(static_cast<size_t>(rank),
+                                                             static_cast<size_t>(groups),
+                                                             static_cast<size_t>(input_channels_per_group),
+                                                             kernel_shape.data(),
+                                                             dilations.data(),
+                                                             strides.data(),
+                                                             static_cast<size_t>(output_channels_per_group));
+    if (packed_filter_size == 0) {
+      state.SkipWithError("The convolution does not use a packed filter.");
+      return;
+    }
+    const size_t alignment = MlasGetPreferredBufferAlignment();
+    packed_filter_buffer.resize(packed_filter_size + alignment - 1);
+    packed_filter = reinterpret_cast<void*>(
+        (reinterpret_cast<uintptr_t>(packed_filter_buffer.data()) + alignment - 1) & ~(alignment - 1));
+    MlasConvPackFilter(static_cast<size_t>(groups),
+                       static_cast<size_t>(input_channels_per_group),
+                       static_cast<size_t>(output_channels_per_group),
+                       F.data(),
+                       packed_filter);
+  }
+
   // warm up first round.
   MlasConv(&Parameters,
            X.data(),
            F.data(),
+           packed_filter,
            nullptr,
            working_buffer.data(),
            Y.data(),
@@ -131,6 +159,7 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
     MlasConv(&Parameters,
              X.data(),
              F.data(),
+             packed_filter,
              nullptr,
              working_buffer.data(),
              Y.data(),
@@ -138,6 +167,88 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   }
 }
 
+// dummy for some strange build error when using Bench capture
+void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+  SCONV_NCHW_Run(state, false);
+}
+
+void SCONV_NCHW_PACKED_FILTER(benchmark::State& state, const char* /*dummy*/) {
+  SCONV_NCHW_Run(state, true);
+}
+
+// Runs the direct NCHWc convolution of a rank 2, single group NCHW convolution, which is the algorithm the NCHWc
+// transformer otherwise uses for 3x3 convolutions. The input and filter are reordered outside of the timed loop.
+void SCONV_NCHWC(benchmark::State& state, const char* /*dummy*/) {
+  const int64_t rank = state.range(0);
+  const int64_t batch_size = state.range(1);
+  const int64_t groups = state.range(2);
+  const int64_t input_channels = state.range(3);
+  const int64_t output_channels = state.range(4);
+
+  if (rank != 2 || groups != 1) {
+    state.SkipWithError("Only rank 2 convolutions with a single group are supported.");
+    return;
+  }
+
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("The NCHWc convolution is not supported on this platform.");
+    return;
+  }
+
+  size_t arg_position = 5;
+  const auto input_shape = BenchArgsVector(state, arg_position, rank);
+  const auto kernel_shape = BenchArgsVector(state, arg_position, rank);
+  const auto paddings = BenchArgsVector(state, arg_position, rank * 2);
+  const auto strides = BenchArgsVector(state, arg_position, rank);
+  const auto dilations = BenchArgsVector(state, arg_position, rank);
+
+  const int64_t nchwc_input_channels = (input_channels + block_size - 1) & ~(block_size - 1);
+  const int64_t nchwc_output_channels = (output_channels + block_size - 1) & ~(block_size - 1);
+
+  std::vector<int64_t> output_shape(2);
+  for (size_t i = 0; i < 2; ++i) {
+    auto km = 1 + dilations[i] * (kernel_shape[i] - 1);
+    output_shape[i] = (paddings[i] + paddings[i + 2] + input_shape[i] - km) / strides[i] + 1;
+  }
+
+  const int64_t x_shape[] = {batch_size, input_channels, input_shape[0], input_shape[1]};
+  const int64_t f_shape[] = {output_channels, input_channels, kernel_shape[0], kernel_shape[1]};
+  const int64_t nchwc_x_shape[] = {batch_size, nchwc_input_channels, input_shape[0], input_shape[1]};
+  const int64_t nchwc_y_shape[] = {batch_size, nchwc_output_channels, output_shape[0], output_shape[1]};
+
+  auto X = RandomVectorUniform(std::vector<int64_t>(std::begin(x_shape), std::end(x_shape)), -2.0, 2.0);
+  auto F = RandomVectorUniform(std::vector<int64_t>(std::begin(f_shape), std::end(f_shape)), -1.0, 1.0);
+
+  const size_t input_size = static_cast<size_t>(input_shape[0] * input_shape[1]);
+  std::vector<float> nchwc_x(static_cast<size_t>(batch_size * nchwc_input_channels) * input_size);
+  for (int64_t n = 0; n < batch_size; n++) {
+    MlasReorderInputNchw(X.data() + n * input_channels * input_size,
+                         nchwc_x.data() + n * nchwc_input_channels * input_size,
+                         static_cast<size_t>(input_channels),
+                         input_size);
+  }
+
+  std::vector<float> nchwc_f(static_cast<size_t>(nchwc_output_channels * nchwc_input_channels *
+                                                 kernel_shape[0] * kernel_shape[1]));
+  MlasReorderFilterOIHWBiBo(f_shape, F.data(), nchwc_f.data());
+
+  std::vector<float> nchwc_y(static_cast<size_t>(batch_size * nchwc_output_channels *
+                                                 output_shape[0] * output_shape[1]));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  // warm up first round.
+  MlasNchwcConv(nchwc_x_shape, kernel_shape.data(), dilations.data(), paddings.data(), strides.data(), nchwc_y_shape,
+                1, nchwc_x.data(), nchwc_f.data(), nullptr, nchwc_y.data(), &activation, true, nullptr);
+
+  for (auto _ : state) {
+    MlasNchwcConv(nchwc_x_shape, kernel_shape.data(), dilations.data(), paddings.data(), strides.data(), nchwc_y_shape,
+                  1, nchwc_x.data(), nchwc_f.data(), nullptr, nchwc_y.data(), &activation, true, nullptr);
+  }
+}
+
 static void ResNet50(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
 
@@ -245,3 +356,22 @@ static void General_Conv2d(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SCONV_NCHW, 2d, "")->Apply(General_Conv2d)->UseRealTime();
+
+// The 3x3 convolutions with unit strides of common vision backbones, which MLAS computes with the Winograd algorithm.
+// SCONV_NCHW transforms the filter on every call, SCONV_NCHW_PACKED_FILTER uses the filter transformed once as the
+// Conv kernel does for constant filters, and SCONV_NCHWC runs the direct NCHWc convolution for comparison.
+static void Winograd3x3(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+  //    Rank, N, G, Cpg, Fpg,   I,    , K, , P, , , , S, , D, ,
+  b->Args({2, 1, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});      // ResNet50 Conv 2.X
+  b->Args({2, 1, 1, 128, 128, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});    // ResNet50 Conv 3.X
+  b->Args({2, 1, 1, 256, 256, 14, 14, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});    // ResNet50 Conv 4.X
+  b->Args({2, 1, 1, 512, 512, 7, 7, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});      // ResNet50 Conv 5.X
+  b->Args({2, 1, 1, 64, 64, 224, 224, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});    // VGG16 Conv 1.2
+  b->Args({2, 1, 1, 256, 256, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});    // VGG16 Conv 3.X
+  b->Args({2, 4, 1, 128, 128, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});    // batched
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHW, Winograd3x3, "")->Apply(Winograd3x3)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHW_PACKED_FILTER, Winograd3x3, "")->Apply(Winograd3x3)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHWC, Winograd3x3, "")->Apply(Winograd3x3)->UseRealTime();
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+//
+// The Winograd algorithm reassociates the sums of the convolution through the
+// input and output transforms, so unlike the other convolution algorithms its
+// results are only within an error bound of the direct convolution.
+//
+
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  struct Config {
+    size_t batch_count;
+    size_t group_count;
+    size_t input_channels;
+    size_t input_height;
+    size_t input_width;
+    size_t filter_count;
+    size_t padding;
+    bool pack_filter;
+    bool has_bias;
+    bool has_sum;
+    MLAS_ACTIVATION_KIND activation_kind;
+  };
+
+  void Test(const Config& c) {
+    const size_t output_height = c.input_height + 2 * c.padding - 2;
+    const size_t output_width = c.input_width + 2 * c.padding - 2;
+    const size_t input_size = c.input_height * c.input_width;
+    const size_t output_size = output_height * output_width;
+
+    std::default_random_engine generator(static_cast<unsigned>(c.input_channels * 131 + c.filter_count * 17 +
+                                                               c.input_height));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto generate = [&](size_t count) {
+      std::vector<float> values(count);
+      for (auto& value : values) {
+        value = distribution(generator);
+      }
+      return values;
+    };
+
+    const std::vector<float> input = generate(c.batch_count * c.group_count * c.input_channels * input_size);
+    const std::vector<float> filter = generate(c.group_count * c.filter_count * c.input_channels * 9);
+    const std::vector<float> bias = generate(c.group_count * c.filter_count);
+    const std::vector<float> sum = generate(c.batch_count * c.group_count * c.filter_count * output_size);
+    std::vector<float> output(c.has_sum ? sum : std::vector<float>(sum.size()));
+
+    const int64_t input_shape[] = {int64_t(c.input_height), int64_t(c.input_width)};
+    const int64_t kernel_shape[] = {3, 3};
+    const int64_t dilation_shape[] = {1, 1};
+    const int64_t padding[] = {int64_t(c.padding), int64_t(c.padding), int64_t(c.padding), int64_t(c.padding)};
+    const int64_t stride_shape[] = {1, 1};
+    const int64_t output_shape[] = {int64_t(output_height), int64_t(output_width)};
+
+    MLAS_ACTIVATION activation;
+    activation.ActivationKind = c.activation_kind;
+
+    MLAS_CONV_PARAMETERS parameters;
+    size_t working_buffer_size;
+
+    // Without a packed filter, the filter would be transformed on every call, so Winograd is never selected.
+    MlasConvPrepare(&parameters, 2, c.batch_count, c.group_count, c.input_channels, input_shape, kernel_shape,
+                    dilation_shape, padding, stride_shape, output_shape, c.filter_count, &activation,
+                    &working_buffer_size, c.has_sum ? 1.0f : 0.0f, threadpool_, false);
+
+    ASSERT_NE(parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    // With pack_filter unset, the caller promised a packed filter but passes none, which makes MlasConv transform
+    // the filter into a buffer of its own.
+    MlasConvPrepare(&parameters, 2, c.batch_count, c.group_count, c.input_channels, input_shape, kernel_shape,
+                    dilation_shape, padding, stride_shape, output_shape, c.filter_count, &activation,
+                    &working_buffer_size, c.has_sum ? 1.0f : 0.0f, threadpool_, true);
+
+    ASSERT_EQ(parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    const void* packed_filter = nullptr;
+
+    if (c.pack_filter) {
+      const size_t packed_filter_size = MlasConvPackFilterSize(2, c.group_count, c.input_channels, kernel_shape,
+                                                               dilation_shape, stride_shape, c.filter_count);
+      ASSERT_NE(packed_filter_size, size_t(0));
+      void* buffer = buffer_packed_filter_.GetBuffer(packed_filter_size, true);
+      MlasConvPackFilter(c.group_count, c.input_channels, c.filter_count, filter.data(), buffer);
+      packed_filter = buffer;
+    }
+
+    MlasConv(&parameters, input.data(), filter.data(), packed_filter, c.has_bias ? bias.data() : nullptr,
+             buffer_working_.GetBuffer(working_buffer_size), output.data(), threadpool_);
+
+    for (size_t b = 0; b < c.batch_count; b++) {
+      for (size_t g = 0; g < c.group_count; g++) {
+        const size_t image = b * c.group_count + g;
+        const float* x = input.data() + image * c.input_channels * input_size;
+
+        for (size_t f = 0; f < c.filter_count; f++) {
+          const size_t filter_index = g * c.filter_count + f;
+          const float* w = filter.data() + filter_index * c.input_channels * 9;
+          const size_t output_offset = (image * c.filter_count + f) * output_size;
+
+          for (size_t oh = 0; oh < output_height; oh++) {
+            for (size_t ow = 0; ow < output_width; ow++) {
+              double expected = 0.0;
+              double magnitude = 0.0;
+
+              for (size_t ic = 0; ic < c.input_channels; ic++) {
+                for (size_t ky = 0; ky < 3; ky++) {
+                  const size_t ih = oh + ky - c.padding;
+                  for (size_t kx = 0; kx < 3; kx++) {
+                    const size_t iw = ow + kx - c.padding;
+                    if (ih < c.input_height && iw < c.input_width) {
+                      const double product = double(x[ic * input_size + ih * c.input_width + iw]) *
+                                             w[(ic * 3 + ky) * 3 + kx];
+                      expected += product;
+                      magnitude += std::fabs(product);
+                    }
+                  }
+                }
+              }
+
+              if (c.has_bias) {
+                expected += bias[filter_index];
+              }
+              if (c.has_sum) {
+                expected += sum[output_offset + oh * output_width + ow];
+              }
+              if (c.activation_kind == MlasReluActivation) {
+                expected = std::max(expected, 0.0);
+              }
+
+              // The error of F(4x4, 3x3) grows with the magnitude of the products that are summed rather than with
+              // the magnitude of the result, so bound it relative to the sum of the absolute products.
+              const double tolerance = 1e-5 + magnitude * 2e-5;
+
+              ASSERT_NEAR(output[output_offset + oh * output_width + ow], expected, tolerance)
+                  << "@[" << b << "," << g << "," << f << "," << oh << "," << ow << "], B=" << c.batch_count
+                  << " G=" << c.group_count << " Cpg=" << c.input_channels << " Fpg=" << c.filter_count
+                  << " H=" << c.input_height << " W=" << c.input_width << " Pad=" << c.padding
+                  << " pack_filter=" << c.pack_filter;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  MatrixGuardBuffer<uint8_t> buffer_packed_filter_;
+  MatrixGuardBuffer<float> buffer_working_;
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasConv2DWinogradTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Conv2dWinograd");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    const Config configs[] = {
+        // B, G, Cpg, H, W, Fpg, pad, pack_filter, bias, sum, activation
+        {1, 1, 64, 8, 8, 64, 1, false, true, false, MlasIdentityActivation},
+        {1, 1, 64, 8, 8, 64, 1, true, true, false, MlasIdentityActivation},
+        {1, 1, 64, 6, 6, 64, 0, true, false, false, MlasIdentityActivation},
+        {1, 1, 64, 1, 1, 64, 1, true, true, false, MlasReluActivation},
+        {1, 1, 67, 13, 11, 70, 1, true, true, false, MlasReluActivation},
+        {2, 1, 96, 17, 23, 65, 1, true, true, true, MlasIdentityActivation},
+        {1, 2, 64, 9, 9, 64, 0, true, true, false, MlasReluActivation},
+        {2, 2, 64, 7, 14, 66, 1, false, false, true, MlasReluActivation},
+        {1, 1, 128, 56, 56, 128, 1, true, true, false, MlasReluActivation},
+        {1, 1, 256, 28, 28, 256, 1, true, true, true, MlasIdentityActivation},
+    };
+
+    for (const auto& c : configs) {
+      Test(c);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest>::RegisterShortExecute();
+  }
+  return count;
+});
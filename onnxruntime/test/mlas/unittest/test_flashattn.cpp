@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/mlas/lib/mlasi.h"
+
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  struct Config {
+    int batch_size;
+    int num_heads;
+    int kv_num_heads;
+    int q_sequence_length;
+    int kv_buffer_sequence_length;
+    int head_size;
+    int q_block_size;
+    int kv_block_size;
+    bool is_causal;
+    int local_window_size;
+  };
+
+  // Reference attention on fp32 data in the layouts of MlasFlashAttentionThreadedArgs.
+  static void ReferenceAttention(const Config& c, const std::vector<int32_t>& kv_valid_lengths,
+                                 const float* Q, const float* K, const float* V, float* Output) {
+    const int heads_per_kv_head = c.num_heads / c.kv_num_heads;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(c.head_size));
+    std::vector<float> scores(c.kv_buffer_sequence_length);
+
+    for (int b = 0; b < c.batch_size; b++) {
+      const int kv_length = kv_valid_lengths[b];
+      const int past_length = std::max(kv_length - c.q_sequence_length, 0);
+      for (int n = 0; n < c.num_heads; n++) {
+        const float* k = K + (b * c.kv_num_heads + n / heads_per_kv_head) * c.kv_buffer_sequence_length * c.head_size;
+        const float* v = V + (b * c.kv_num_heads + n / heads_per_kv_head) * c.kv_buffer_sequence_length * c.head_size;
+        for (int s = 0; s < c.q_sequence_length; s++) {
+          const float* q = Q + ((b * c.num_heads + n) * c.q_sequence_length + s) * c.head_size;
+          float* out = Output + ((b * c.q_sequence_length + s) * c.num_heads + n) * c.head_size;
+
+          int begin = 0;
+          int end = kv_length;
+          if (c.is_causal) {
+            const int position = past_length + s;
+            end = std::min(kv_length, position + 1);
+            if (c.local_window_size >= 0) {
+              begin = std::max(position - c.local_window_size, 0);
+            }
+          }
+
+          std::fill_n(out, c.head_size, 0.0f);
+          if (begin >= end) {
+            continue;
+          }
+
+          float max_score = std::numeric_limits<float>::lowest();
+          for (int j = begin; j < end; j++) {
+            float dot = 0.0f;
+            for (int h = 0; h < c.head_size; h++) {
+              dot += q[h] * k[j * c.head_size + h];
+            }
+            scores[j] = dot * scale;
+            max_score = std::max(max_score, scores[j]);
+          }
+          float sum = 0.0f;
+          for (int j = begin; j < end; j++) {
+            scores[j] = std::exp(scores[j] - max_score);
+            sum += scores[j];
+          }
+          for (int j = begin; j < end; j++) {
+            for (int h = 0; h < c.head_size; h++) {
+              out[h] += scores[j] / sum * v[j * c.head_size + h];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  template <typename T>
+  void Test(const Config& c, const std::vector<int32_t>& kv_valid_lengths) {
+    const size_t q_size = static_cast<size_t>(c.batch_size) * c.num_heads * c.q_sequence_length * c.head_size;
+    const size_t kv_size = static_cast<size_t>(c.batch_size) * c.kv_num_heads * c.kv_buffer_sequence_length * c.head_size;
+
+    std::default_random_engine generator(static_cast<unsigned>(q_size + kv_size));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> q(q_size), k(kv_size), v(kv_size);
+    for (auto* data : {&q, &k, &v}) {
+      for (auto& value : *data) {
+        // Round through T so the reference sees the same inputs.
+        value = static_cast<float>(T(distribution(generator)));
+      }
+    }
+
+    std::vector<T> q_t(q.begin(), q.end()), k_t(k.begin(), k.end()), v_t(v.begin(), v.end());
+    std::vector<T> output(q_size);
+    std::vector<float> output_ref(q_size);
+
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = c.batch_size;
+    args.num_heads = c.num_heads;
+    args.q_sequence_length = c.q_sequence_length;
+    args.kv_sequence_length = c.kv_buffer_sequence_length;
+    args.qk_head_size = c.head_size;
+    args.v_head_size = c.head_size;
+    args.q_block_size = c.q_block_size;
+    args.kv_block_size = c.kv_block_size;
+    args.scale = 1.0f / std::sqrt(static_cast<float>(c.head_size));
+    args.thread_count = 3;
+    args.query = q_t.data();
+    args.key = k_t.data();
+    args.value = v_t.data();
+    args.output = output.data();
+    args.is_fp16 = std::is_same<T, MLAS_FP16>::value;
+    args.kv_num_heads = c.kv_num_heads;
+    args.kv_valid_lengths = kv_valid_lengths.data();
+    args.is_causal = c.is_causal;
+    args.local_window_size = c.local_window_size;
+    args.buffer_size_per_thread = MlasFlashAttentionGetBufferSizePerThread(&args);
+    std::vector<float> buffer(args.buffer_size_per_thread * args.thread_count / sizeof(float));
+    args.buffer = buffer.data();
+
+    MlasFlashAttention(&args, nullptr);
+    ReferenceAttention(c, kv_valid_lengths, q.data(), k.data(), v.data(), output_ref.data());
+
+    const float tolerance = args.is_fp16 ? 2e-3f : 1e-5f;
+    for (size_t i = 0; i < q_size; i++) {
+      const float actual = static_cast<float>(output[i]);
+      ASSERT_NEAR(actual, output_ref[i], tolerance + std::fabs(output_ref[i]) * tolerance)
+          << "@" << i << ", B=" << c.batch_size << " N=" << c.num_heads << " N_kv=" << c.kv_num_heads
+          << " S=" << c.q_sequence_length << " T=" << c.kv_buffer_sequence_length << " H=" << c.head_size
+          << " Br=" << c.q_block_size << " Bc=" << c.kv_block_size << " causal=" << c.is_causal
+          << " window=" << c.local_window_size << " fp16=" << args.is_fp16;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("FlashAttention");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    const Config configs[] = {
+        // B, N, N_kv, S, T, H, Br, Bc, causal, window
+        {2, 4, 4, 17, 17, 16, 8, 8, false, -1},
+        {2, 4, 4, 17, 17, 16, 5, 7, true, -1},
+        {1, 8, 2, 33, 33, 32, 16, 16, true, -1},
+        {1, 8, 2, 33, 33, 32, 16, 7, true, 5},
+        {2, 6, 3, 1, 40, 24, 1, 16, true, -1},
+        {2, 6, 3, 4, 40, 24, 4, 16, true, 9},
+    };
+
+    for (const auto& c : configs) {
+      // A full cache, then a cache filled to different lengths in each batch.
+      std::vector<int32_t> full(c.batch_size, c.kv_buffer_sequence_length);
+      std::vector<int32_t> partial(c.batch_size);
+      for (int b = 0; b < c.batch_size; b++) {
+        partial[b] = std::max(c.kv_buffer_sequence_length - 3 * (b + 1), c.q_sequence_length);
+      }
+
+      Test<float>(c, full);
+      Test<float>(c, partial);
+      Test<MLAS_FP16>(c, full);
+      Test<MLAS_FP16>(c, partial);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasFusedEltwiseTest : public MlasTestBase {
+ private:
+  static float Reference(MLAS_FUSED_ELTWISE_OPCODE Opcode, float a, float b) {
+    switch (Opcode) {
+      case MlasFusedEltwiseAdd:
+        return a + b;
+      case MlasFusedEltwiseSub:
+        return a - b;
+      case MlasFusedEltwiseMul:
+        return a * b;
+      case MlasFusedEltwiseDiv:
+        return a / b;
+      case MlasFusedEltwiseMax:
+        return std::max(a, b);
+      case MlasFusedEltwiseMin:
+        return std::min(a, b);
+      case MlasFusedEltwiseRelu:
+        return std::max(a, 0.0f);
+      case MlasFusedEltwiseNeg:
+        return -a;
+      case MlasFusedEltwiseAbs:
+        return std::fabs(a);
+      case MlasFusedEltwiseSqrt:
+        return std::sqrt(a);
+      case MlasFusedEltwiseReciprocal:
+        return 1.0f / a;
+      case MlasFusedEltwiseLogistic:
+        return 1.0f / (1.0f + std::exp(-a));
+      case MlasFusedEltwiseTanh:
+        return std::tanh(a);
+      case MlasFusedEltwiseExp:
+        return std::exp(a);
+      case MlasFusedEltwiseErf:
+        return std::erf(a);
+    }
+    return 0.0f;
+  }
+
+  void Test(const std::vector<MLAS_FUSED_ELTWISE_INSTRUCTION>& Program, const std::vector<bool>& InputIsScalar,
+            size_t N) {
+    std::default_random_engine generator(static_cast<unsigned>(Program.size() * 131 + InputIsScalar.size() * 17 + N));
+    // Positive values keep Div, Sqrt and Reciprocal away from poles.
+    std::uniform_real_distribution<float> distribution(0.5f, 2.0f);
+
+    const size_t InputCount = InputIsScalar.size();
+    std::vector<std::vector<float>> inputs(InputCount);
+    std::vector<const float*> input_pointers(InputCount);
+    std::unique_ptr<bool[]> is_scalar(new bool[InputCount]);
+    for (size_t i = 0; i < InputCount; i++) {
+      inputs[i].resize(InputIsScalar[i] ? 1 : N);
+      for (auto& value : inputs[i]) {
+        value = distribution(generator);
+      }
+      input_pointers[i] = inputs[i].data();
+      is_scalar[i] = InputIsScalar[i];
+    }
+
+    std::vector<float> output(N, -1.0f);
+    MlasComputeFusedEltwise(Program.data(), Program.size(), input_pointers.data(), is_scalar.get(), InputCount,
+                            output.data(), N);
+
+    std::vector<float> registers(InputCount + Program.size());
+    for (size_t n = 0; n < N; n++) {
+      for (size_t i = 0; i < InputCount; i++) {
+        registers[i] = inputs[i][InputIsScalar[i] ? 0 : n];
+      }
+      for (size_t k = 0; k < Program.size(); k++) {
+        const float a = registers[Program[k].Operands[0]];
+        const float b = registers[Program[k].Operands[1]];
+        registers[InputCount + k] = Reference(Program[k].Opcode, a, b);
+      }
+      const float expected = registers.back();
+      ASSERT_NEAR(output[n], expected, 1e-5f + std::fabs(expected) * 1e-5f) << "@" << n << ", N=" << N;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("FusedEltwise");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t N : {1, 3, 4, 17, 256, 1000, 4099}) {
+      // Mul(Sigmoid(Mul(Add(x, b), s)), Add(x, b))
+      Test({{MlasFusedEltwiseAdd, {0, 1}},
+            {MlasFusedEltwiseMul, {3, 2}},
+            {MlasFusedEltwiseLogistic, {4, 0}},
+            {MlasFusedEltwiseMul, {5, 3}}},
+           {false, false, true}, N);
+      Test({{MlasFusedEltwiseSub, {1, 0}},
+            {MlasFusedEltwiseDiv, {0, 2}},
+            {MlasFusedEltwiseMax, {2, 3}},
+            {MlasFusedEltwiseMin, {4, 1}},
+            {MlasFusedEltwiseTanh, {5, 0}},
+            {MlasFusedEltwiseExp, {6, 0}},
+            {MlasFusedEltwiseErf, {1, 0}},
+            {MlasFusedEltwiseAdd, {7, 8}}},
+           {true, false}, N);
+      Test({{MlasFusedEltwiseNeg, {0, 0}},
+            {MlasFusedEltwiseRelu, {2, 0}},
+            {MlasFusedEltwiseAbs, {2, 0}},
+            {MlasFusedEltwiseSqrt, {4, 0}},
+            {MlasFusedEltwiseReciprocal, {5, 0}},
+            {MlasFusedEltwiseAdd, {3, 6}},
+            {MlasFusedEltwiseMul, {7, 1}}},
+           {false, true}, N);
+      // All operands broadcast.
+      Test({{MlasFusedEltwiseMul, {0, 1}},
+            {MlasFusedEltwiseLogistic, {2, 0}}},
+           {true, true}, N);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFusedEltwiseTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -133,11 +133,19 @@ class MlasHalfGemmTest : public MlasTestBase {
               sum = float(Bias[n]);
             }
             for (size_t kk = 0; kk < std::min(KStride, K - k); kk++) {
+#if defined(MLAS_TARGET_AMD64)
+              // The x86 kernels convert A and B to fp16, then accumulate in fp32.
+              sum += float(MLFp16(float(*b))) * float(MLFp16(float(*a)));
+#else
               MLFp16 down(float(*b) * float(*a) + sum);
               sum = float(down);
+#endif
               b += N;
               a += 1;
             }
+#if defined(MLAS_TARGET_AMD64)
+            sum = float(MLFp16(sum));
+#endif
             if (k == 0) {
               *c = sum;
             } else {
@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/mlas/lib/mlasi.h"
+
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  struct Config {
+    size_t rows;
+    size_t n;
+    size_t skip_rows;       // 0 for no skip
+    size_t scale_rows;
+    size_t scale_row_repeat;
+    bool has_skip_bias;
+    bool has_bias;
+    bool has_skip_sum_output;
+    bool simplified;
+  };
+
+  template <typename T>
+  void Test(const Config& c) {
+    std::default_random_engine generator(static_cast<unsigned>(c.rows * 131 + c.n));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+    auto generate = [&](size_t count, bool round_to_t) {
+      std::vector<float> values(count);
+      for (auto& value : values) {
+        value = distribution(generator);
+        if (round_to_t) {
+          // Round through T so the reference sees the same inputs.
+          value = static_cast<float>(T(value));
+        }
+      }
+      return values;
+    };
+
+    const std::vector<float> input = generate(c.rows * c.n, true);
+    const std::vector<float> skip = generate(c.skip_rows * c.n, true);
+    const std::vector<float> skip_bias = generate(c.has_skip_bias ? c.n : 0, false);
+    const std::vector<float> scale = generate(c.scale_rows * c.n, false);
+    const std::vector<float> bias = generate(c.has_bias ? c.scale_rows * c.n : 0, false);
+
+    std::vector<T> input_t(input.begin(), input.end());
+    std::vector<T> skip_t(skip.begin(), skip.end());
+    std::vector<T> output(c.rows * c.n);
+    std::vector<T> skip_sum_output(c.has_skip_sum_output ? c.rows * c.n : 0);
+    std::vector<float> mean(c.rows), inv_std_dev(c.rows);
+
+    MLAS_LAYER_NORM_PARAMS<T> params;
+    params.Input = input_t.data();
+    params.Skip = c.skip_rows > 0 ? skip_t.data() : nullptr;
+    params.SkipRows = std::max<size_t>(c.skip_rows, 1);
+    params.SkipBias = c.has_skip_bias ? skip_bias.data() : nullptr;
+    params.Scale = scale.data();
+    params.Bias = c.has_bias ? bias.data() : nullptr;
+    params.ScaleRows = c.scale_rows;
+    params.ScaleRowRepeat = c.scale_row_repeat;
+    params.Output = output.data();
+    params.SkipSumOutput = c.has_skip_sum_output ? skip_sum_output.data() : nullptr;
+    params.Mean = mean.data();
+    params.InvStdDev = inv_std_dev.data();
+    params.Rows = c.rows;
+    params.N = c.n;
+    params.Epsilon = 1e-5f;
+    params.Simplified = c.simplified;
+
+    MlasLayerNormalization(params, threadpool_);
+
+    const bool is_fp16 = std::is_same<T, MLAS_FP16>::value;
+    const float tolerance = is_fp16 ? 2e-3f : 1e-5f;
+    std::vector<double> x(c.n);
+
+    for (size_t r = 0; r < c.rows; r++) {
+      double sum = 0.0, sum_square = 0.0;
+      for (size_t i = 0; i < c.n; i++) {
+        x[i] = input[r * c.n + i];
+        if (c.skip_rows > 0) {
+          x[i] += skip[(r % c.skip_rows) * c.n + i];
+        }
+        if (c.has_skip_bias) {
+          x[i] += skip_bias[i];
+        }
+        sum += x[i];
+        sum_square += x[i] * x[i];
+      }
+      const double row_mean = sum / c.n;
+      const double variance = c.simplified ? sum_square / c.n : sum_square / c.n - row_mean * row_mean;
+      const double row_inv_std_dev = 1.0 / std::sqrt(variance + 1e-5);
+      const size_t scale_offset = ((r / c.scale_row_repeat) % c.scale_rows) * c.n;
+
+      ASSERT_NEAR(inv_std_dev[r], row_inv_std_dev, 1e-4 * row_inv_std_dev) << "row " << r;
+      if (!c.simplified) {
+        ASSERT_NEAR(mean[r], row_mean, 1e-5) << "row " << r;
+      }
+
+      for (size_t i = 0; i < c.n; i++) {
+        double expected = (x[i] - (c.simplified ? 0.0 : row_mean)) * row_inv_std_dev * scale[scale_offset + i];
+        if (c.has_bias) {
+          expected += bias[scale_offset + i];
+        }
+        const float actual = static_cast<float>(output[r * c.n + i]);
+        ASSERT_NEAR(actual, expected, tolerance + std::fabs(expected) * tolerance)
+            << "@[" << r << "," << i << "], rows=" << c.rows << " N=" << c.n << " skip_rows=" << c.skip_rows
+            << " scale_rows=" << c.scale_rows << " repeat=" << c.scale_row_repeat << " simplified=" << c.simplified
+            << " fp16=" << is_fp16;
+
+        if (c.has_skip_sum_output) {
+          const float skip_sum = static_cast<float>(skip_sum_output[r * c.n + i]);
+          ASSERT_NEAR(skip_sum, x[i], tolerance + std::fabs(x[i]) * tolerance) << "@[" << r << "," << i << "]";
+        }
+      }
+    }
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasLayerNormTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LayerNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    const Config configs[] = {
+        // rows, N, skip_rows, scale_rows, repeat, skip_bias, bias, skip_sum_output, simplified
+        {1, 2, 0, 1, 1, false, false, false, false},
+        {3, 7, 0, 1, 1, false, true, false, false},
+        {4, 8, 0, 1, 1, false, true, false, true},
+        {5, 15, 5, 1, 1, true, true, true, false},
+        {2, 16, 1, 1, 1, false, false, true, true},
+        {7, 17, 7, 1, 1, true, true, false, false},
+        {6, 33, 3, 1, 1, false, true, true, false},
+        {8, 64, 0, 4, 2, false, true, false, false},
+        {8, 64, 0, 2, 1, false, true, false, true},
+        {3, 255, 3, 1, 1, true, false, true, true},
+        {4, 256, 4, 1, 1, true, true, true, false},
+        {2, 257, 2, 1, 1, false, true, false, false},
+        {16, 768, 16, 1, 1, true, true, true, false},
+        {9, 1000, 3, 3, 1, false, true, true, false},
+        {5, 4096, 5, 1, 1, false, false, false, true},
+    };
+
+    for (const auto& c : configs) {
+      Test<float>(c);
+      Test<MLAS_FP16>(c);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <numeric>
+
+class MlasLogSoftmaxTopKTest : public MlasTestBase {
+ private:
+  void Test(size_t Rows, size_t N, size_t K, float scale, bool with_addends, bool selection_only, bool with_ties) {
+    std::default_random_engine generator(static_cast<unsigned>(Rows * 131 + N * 17 + K));
+    std::uniform_real_distribution<float> distribution(-8.0f, 8.0f);
+
+    std::vector<float> input(Rows * N);
+    for (auto& value : input) {
+      value = distribution(generator);
+      if (with_ties) {
+        value = std::round(value);
+      }
+    }
+    // Masked entries, as set by vocabulary masks.
+    for (size_t r = 0; r < Rows; r++) {
+      input[r * N + (r * 7) % N] = std::numeric_limits<float>::lowest();
+    }
+
+    std::vector<float> addends(Rows);
+    for (auto& value : addends) {
+      value = distribution(generator);
+    }
+
+    std::vector<float> values(Rows * K, -1.0f);
+    std::vector<int32_t> indices(Rows * K, -1);
+    std::vector<float> log_sum_exp(Rows, -1.0f);
+
+    MLAS_LOG_SOFTMAX_TOPK_PARAMS params;
+    params.Input = input.data();
+    params.Rows = Rows;
+    params.N = N;
+    params.K = K;
+    params.Scale = scale;
+    params.Addends = with_addends ? addends.data() : nullptr;
+    params.Values = selection_only ? nullptr : values.data();
+    params.Indices = indices.data();
+    params.LogSumExp = selection_only ? nullptr : log_sum_exp.data();
+
+    MlasLogSoftmaxTopK(params, threadpool_);
+
+    std::vector<int32_t> order(N);
+    for (size_t r = 0; r < Rows; r++) {
+      const float* row = input.data() + r * N;
+
+      double maximum = row[0];
+      for (size_t n = 1; n < N; n++) {
+        maximum = std::max(maximum, double(row[n]));
+      }
+      double sum = 0.0;
+      for (size_t n = 0; n < N; n++) {
+        sum += std::exp(double(row[n]) - maximum);
+      }
+      const double expected_lse = maximum + std::log(sum);
+
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [row](int32_t a, int32_t b) { return row[a] > row[b]; });
+
+      for (size_t k = 0; k < K; k++) {
+        ASSERT_EQ(indices[r * K + k], order[k])
+            << "@[" << r << "," << k << "], Rows=" << Rows << " N=" << N << " K=" << K;
+        if (!selection_only) {
+          const double expected = scale * (double(row[order[k]]) - expected_lse) + (with_addends ? addends[r] : 0.0f);
+          ASSERT_NEAR(values[r * K + k], expected, 1e-4 + std::fabs(expected) * 1e-5)
+              << "@[" << r << "," << k << "], Rows=" << Rows << " N=" << N << " K=" << K;
+        }
+      }
+
+      if (!selection_only) {
+        ASSERT_NEAR(log_sum_exp[r], expected_lse, 1e-4 + std::fabs(expected_lse) * 1e-5)
+            << "@[" << r << "], Rows=" << Rows << " N=" << N << " K=" << K;
+      }
+    }
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasLogSoftmaxTopKTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LogSoftmaxTopK");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // Rows, N, K, scale, addends, selection only, ties
+    Test(1, 1, 1, 1.0f, false, false, false);
+    Test(3, 7, 7, 1.0f, true, false, false);
+    Test(2, 1000, 1, 1.0f, false, false, false);
+    Test(4, 1000, 8, 0.5f, true, false, true);
+    Test(1, 32000, 8, 1.0f, true, false, false);
+    Test(1, 50257, 1, 1.0f, false, true, false);
+    Test(2, 50257, 10, 1.0f / 0.7f, true, false, true);
+    Test(3, 65536, 200, 1.0f, true, false, false);
+    Test(8, 4099, 16, 1.0f, false, true, true);
+    Test(1, 256000, 4, 1.0f, true, false, false);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLogSoftmaxTopKTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  struct Config {
+    size_t m;
+    size_t n;
+    size_t k;
+    bool trans_a;
+    bool trans_b;
+    bool pack_b;
+    float beta;
+    bool has_scale;
+    bool has_bias;
+    bool has_addend;
+    MLAS_ACTIVATION_KIND activation_kind;
+  };
+
+  static double ApplyActivation(const MLAS_ACTIVATION& activation, double x) {
+    switch (activation.ActivationKind) {
+      case MlasReluActivation:
+        return std::max(x, 0.0);
+      case MlasLeakyReluActivation:
+        return x >= 0.0 ? x : x * activation.Parameters.LeakyRelu.alpha;
+      case MlasTanhActivation:
+        return std::tanh(x);
+      case MlasLogisticActivation:
+        return 1.0 / (1.0 + std::exp(-x));
+      case MlasClipActivation:
+        return std::min(std::max(x, double(activation.Parameters.Clip.minimum)),
+                        double(activation.Parameters.Clip.maximum));
+      case MlasHardSigmoidActivation:
+        return std::min(std::max(x * activation.Parameters.HardSigmoid.alpha + activation.Parameters.HardSigmoid.beta,
+                                 0.0),
+                        1.0);
+      case MlasGeluActivation:
+        return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0)));
+      case MlasSiluActivation:
+        return x / (1.0 + std::exp(-x));
+      default:
+        return x;
+    }
+  }
+
+  void Test(const Config& c) {
+    std::default_random_engine generator(static_cast<unsigned>(c.m * 131 + c.n * 17 + c.k));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto generate = [&](size_t count) {
+      std::vector<float> values(count);
+      for (auto& value : values) {
+        value = distribution(generator);
+      }
+      return values;
+    };
+
+    const std::vector<float> a = generate(c.m * c.k);
+    const std::vector<float> b = generate(c.k * c.n);
+    const std::vector<float> c_init = generate(c.m * c.n);
+    const std::vector<float> scale = generate(c.has_scale ? c.n : 0);
+    const std::vector<float> bias = generate(c.has_bias ? c.n : 0);
+    const std::vector<float> addend = generate(c.has_addend ? c.m * c.n : 0);
+    std::vector<float> output(c_init);
+
+    MLAS_SGEMM_EPILOGUE epilogue;
+    epilogue.Scale = c.has_scale ? scale.data() : nullptr;
+    epilogue.Bias = c.has_bias ? bias.data() : nullptr;
+    epilogue.Addend = c.has_addend ? addend.data() : nullptr;
+    epilogue.ldAddend = c.n;
+    epilogue.Activation.ActivationKind = c.activation_kind;
+    if (c.activation_kind == MlasLeakyReluActivation) {
+      epilogue.Activation.Parameters.LeakyRelu.alpha = 0.1f;
+    } else if (c.activation_kind == MlasClipActivation) {
+      epilogue.Activation.Parameters.Clip.minimum = -0.5f;
+      epilogue.Activation.Parameters.Clip.maximum = 0.5f;
+    } else if (c.activation_kind == MlasHardSigmoidActivation) {
+      epilogue.Activation.Parameters.HardSigmoid.alpha = 0.2f;
+      epilogue.Activation.Parameters.HardSigmoid.beta = 0.5f;
+    }
+
+    const CBLAS_TRANSPOSE trans_a = c.trans_a ? CblasTrans : CblasNoTrans;
+    const CBLAS_TRANSPOSE trans_b = c.trans_b ? CblasTrans : CblasNoTrans;
+
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = a.data();
+    data.lda = c.trans_a ? c.m : c.k;
+    data.B = b.data();
+    data.ldb = c.trans_b ? c.k : c.n;
+    data.C = output.data();
+    data.ldc = c.n;
+    data.beta = c.beta;
+    data.Epilogue = &epilogue;
+
+    if (c.pack_b) {
+      void* packed_b = buffer_packed_b_.GetBuffer(MlasGemmPackBSize(c.n, c.k), true);
+      MlasGemmPackB(trans_b, c.n, c.k, b.data(), data.ldb, packed_b);
+      data.B = reinterpret_cast<const float*>(packed_b);
+      data.BIsPacked = true;
+    }
+
+    MlasGemmBatch(trans_a, trans_b, c.m, c.n, c.k, &data, 1, threadpool_);
+
+    for (size_t m = 0; m < c.m; m++) {
+      for (size_t n = 0; n < c.n; n++) {
+        double expected = 0.0;
+        for (size_t k = 0; k < c.k; k++) {
+          const double a_value = c.trans_a ? a[k * c.m + m] : a[m * c.k + k];
+          const double b_value = c.trans_b ? b[n * c.k + k] : b[k * c.n + n];
+          expected += a_value * b_value;
+        }
+        expected += double(c.beta) * c_init[m * c.n + n];
+        if (c.has_scale) {
+          expected *= scale[n];
+        }
+        if (c.has_bias) {
+          expected += bias[n];
+        }
+        if (c.has_addend) {
+          expected += addend[m * c.n + n];
+        }
+        expected = ApplyActivation(epilogue.Activation, expected);
+
+        ASSERT_NEAR(output[m * c.n + n], expected, 1e-4 + std::fabs(expected) * 1e-4)
+            << "@[" << m << "," << n << "], M=" << c.m << " N=" << c.n << " K=" << c.k
+            << " trans_a=" << c.trans_a << " trans_b=" << c.trans_b << " pack_b=" << c.pack_b
+            << " activation=" << int(c.activation_kind);
+      }
+    }
+  }
+
+  MatrixGuardBuffer<uint8_t> buffer_packed_b_;
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmEpilogue");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    const Config configs[] = {
+        // M, N, K, trans_a, trans_b, pack_b, beta, scale, bias, addend, activation
+        {1, 1, 1, false, false, false, 0.0f, false, true, false, MlasReluActivation},
+        {1, 37, 16, false, false, false, 0.0f, false, true, false, MlasGeluActivation},
+        {1, 37, 16, false, true, false, 1.0f, true, true, true, MlasSiluActivation},
+        {29, 1, 23, false, false, false, 0.0f, false, true, true, MlasTanhActivation},
+        {4, 8, 0, false, false, false, 0.5f, true, true, true, MlasClipActivation},
+        {7, 15, 9, false, false, false, 0.0f, true, false, false, MlasIdentityActivation},
+        {16, 16, 16, true, false, false, 0.0f, false, true, true, MlasLeakyReluActivation},
+        {33, 65, 300, false, true, false, 0.5f, true, true, true, MlasGeluActivation},
+        {33, 65, 300, true, true, false, 0.0f, false, true, false, MlasLogisticActivation},
+        {17, 300, 65, false, false, true, 0.0f, false, true, false, MlasHardSigmoidActivation},
+        {17, 300, 65, true, false, true, 1.0f, true, true, true, MlasSiluActivation},
+        {64, 257, 513, false, false, true, 0.0f, false, true, true, MlasReluActivation},
+        {160, 96, 1024, false, true, false, 0.0f, false, false, true, MlasGeluActivation},
+    };
+
+    for (const auto& c : configs) {
+      Test(c);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasSgemmTuningTest : public MlasTestBase {
+ private:
+  void Test(size_t M, size_t N, size_t K, bool trans_a, bool trans_b, bool pack_b, float beta,
+            const MLAS_SGEMM_TUNING_PARAMS& tuning) {
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N * 17 + K));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto generate = [&](size_t count) {
+      std::vector<float> values(count);
+      for (auto& value : values) {
+        value = distribution(generator);
+      }
+      return values;
+    };
+
+    const std::vector<float> a = generate(M * K);
+    const std::vector<float> b = generate(K * N);
+    const std::vector<float> c_init = generate(M * N);
+    std::vector<float> output(c_init);
+
+    const CBLAS_TRANSPOSE trans_a_type = trans_a ? CblasTrans : CblasNoTrans;
+    const CBLAS_TRANSPOSE trans_b_type = trans_b ? CblasTrans : CblasNoTrans;
+
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = a.data();
+    data.lda = trans_a ? M : K;
+    data.B = b.data();
+    data.ldb = trans_b ? K : N;
+    data.C = output.data();
+    data.ldc = N;
+    data.beta = beta;
+    data.Tuning = &tuning;
+
+    if (pack_b) {
+      void* packed_b = buffer_packed_b_.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(trans_b_type, N, K, b.data(), data.ldb, packed_b);
+      data.B = reinterpret_cast<const float*>(packed_b);
+      data.BIsPacked = true;
+    }
+
+    MlasGemmBatch(trans_a_type, trans_b_type, M, N, K, &data, 1, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double expected = double(beta) * c_init[m * N + n];
+        for (size_t k = 0; k < K; k++) {
+          const double a_value = trans_a ? a[k * M + m] : a[m * K + k];
+          const double b_value = trans_b ? b[n * K + k] : b[k * N + n];
+          expected += a_value * b_value;
+        }
+
+        ASSERT_NEAR(output[m * N + n], expected, 1e-4 + std::fabs(expected) * 1e-4)
+            << "@[" << m << "," << n << "], M=" << M << " N=" << N << " K=" << K << " trans_a=" << trans_a
+            << " trans_b=" << trans_b << " pack_b=" << pack_b << " StrideN=" << tuning.StrideN
+            << " ThreadComplexity=" << tuning.ThreadComplexity;
+      }
+    }
+  }
+
+  MatrixGuardBuffer<uint8_t> buffer_packed_b_;
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSgemmTuningTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmTuning");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    const size_t shapes[][3] = {
+        {1, 96, 40},
+        {7, 33, 300},
+        {33, 257, 65},
+        {64, 100, 513},
+    };
+    const size_t strides_n[] = {0, 16, 40, 64, 256, 1024, 4096};
+    const size_t thread_complexities[] = {0, 4096, size_t(1) << 20};
+
+    for (const auto& shape : shapes) {
+      for (size_t stride_n : strides_n) {
+        for (size_t thread_complexity : thread_complexities) {
+          MLAS_SGEMM_TUNING_PARAMS tuning;
+          tuning.StrideN = stride_n;
+          tuning.ThreadComplexity = thread_complexity;
+          for (int trans = 0; trans < 4; trans++) {
+            for (bool pack_b : {false, true}) {
+              Test(shape[0], shape[1], shape[2], (trans & 1) != 0, (trans & 2) != 0, pack_b,
+                   pack_b ? 0.0f : 0.5f, tuning);
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmTuningTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -167,6 +167,60 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     }
   }
 
+  // MlasQuantizeBlockwise does not pack 3-bit values, so 3-bit B is generated directly
+  // as bit streams of random values per column.
+  void GenerateQuantB3Bit(size_t N, size_t K, uint8_t* QuantBData, float* QuantBScale, uint8_t* QuantBZeroPoint) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointStride = (BlockCountK * BlkBitWidth + 7) / 8;
+
+    std::default_random_engine generator(static_cast<unsigned>(N * K));
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+    // Powers of two keep the products with the integer valued A exact, so the result does not
+    // depend on the order of the summation.
+    std::uniform_int_distribution<int> scale_exponent_distribution(3, 6);
+
+    for (size_t i = 0; i < N * BlockCountK * BlkDataSize; i++) {
+      QuantBData[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      QuantBScale[i] = std::ldexp(1.0f, -scale_exponent_distribution(generator));
+    }
+    if (QuantBZeroPoint != nullptr) {
+      for (size_t i = 0; i < N * ZeroPointStride; i++) {
+        QuantBZeroPoint[i] = static_cast<uint8_t>(byte_distribution(generator));
+      }
+    }
+  }
+
+  static uint32_t ExtractBits(const uint8_t* Data, size_t Index) {
+    uint32_t value = 0;
+    for (size_t b = 0; b < BlkBitWidth; b++) {
+      const size_t bit = Index * BlkBitWidth + b;
+      value |= ((Data[bit / 8] >> (bit % 8)) & 1u) << b;
+    }
+    return value;
+  }
+
+  void DequantizeB3Bit(size_t N, size_t K, const uint8_t* QuantBData, const float* QuantBScale,
+                       const uint8_t* QuantBZeroPoint, float* DequantizedBData) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointStride = (BlockCountK * BlkBitWidth + 7) / 8;
+
+    for (size_t n = 0; n < N; n++) {
+      for (size_t k = 0; k < K; k++) {
+        const size_t k_blk = k / BlkLen;
+        const uint32_t zp = QuantBZeroPoint == nullptr
+                                ? (1u << (BlkBitWidth - 1))
+                                : ExtractBits(QuantBZeroPoint + n * ZeroPointStride, k_blk);
+        const uint32_t q = ExtractBits(QuantBData + n * BlockCountK * BlkDataSize, k);
+        DequantizedBData[n * K + k] =
+            (static_cast<float>(q) - static_cast<float>(zp)) * QuantBScale[n * BlockCountK + k_blk];
+      }
+    }
+  }
+
   void CallReferenceGemm_CompFp32(size_t M,
                                   size_t N,
                                   size_t K,
@@ -177,9 +231,13 @@ class MlasSQNBitGemmTest : public MlasTestBase {
                                   const float* Bias,
                                   float* C) {
     float* DequantizedBData = BufferDequantizedB.GetBuffer(K * N);
-    MlasDequantizeBlockwise<float, BlkBitWidth>(
-        DequantizedBData, QuantBData, QuantBScale, QuantBZeroPoint, BlkLen, /* columnwise */ true,
-        static_cast<int>(K), static_cast<int>(N), GetMlasThreadPool());
+    if constexpr (BlkBitWidth == 3) {
+      DequantizeB3Bit(N, K, QuantBData, QuantBScale, QuantBZeroPoint, DequantizedBData);
+    } else {
+      MlasDequantizeBlockwise<float, BlkBitWidth>(
+          DequantizedBData, QuantBData, QuantBScale, QuantBZeroPoint, BlkLen, /* columnwise */ true,
+          static_cast<int>(K), static_cast<int>(N), GetMlasThreadPool());
+    }
     // Note: DequantizedBData is in column major layout.
 
     for (size_t m = 0; m < M; m++) {
@@ -244,7 +302,16 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     uint8_t* QuantBData = nullptr;
     float* QuantBScale = nullptr;
     uint8_t* QuantBZeroPoint = nullptr;
-    {
+    if constexpr (BlkBitWidth == 3) {
+      const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+      QuantBData = BufferQuantBData.GetBuffer(N * BlockCountK * BlkLen * BlkBitWidth / 8);
+      QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+      if (!Symmetric) {
+        QuantBZeroPoint = BufferQuantBZeroPoint.GetBuffer(N * ((BlockCountK * BlkBitWidth + 7) / 8));
+      }
+
+      GenerateQuantB3Bit(N, K, QuantBData, QuantBScale, QuantBZeroPoint);
+    } else {
       size_t QuantBDataSizeInBytes, QuantBScaleSize, QuantBZeroPointSizeInBytes;
       MlasBlockwiseQuantizedBufferSizes<BlkBitWidth>(BlkLen, /* columnwise */ true,
                                                      static_cast<int>(K), static_cast<int>(N),
@@ -291,8 +358,10 @@ class MlasSQNBitGemmTest : public MlasTestBase {
 
     if (ComputeType == SQNBIT_CompFp32) {
       CallReferenceGemm_CompFp32(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
-    } else if (ComputeType == SQNBIT_CompInt8) {
-      CallReferenceGemm_CompInt8(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
+    } else if (ComputeType == SQNBIT_CompInt8 && BlkBitWidth == 4) {
+      if constexpr (BlkBitWidth == 4) {
+        CallReferenceGemm_CompInt8(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
+      }
     } else {
       FAIL() << "Test is not implemented for compute type "
              << ComputeType << " (" << ComputeTypeName(ComputeType) << ")";
@@ -428,6 +497,13 @@ static size_t SQNBitGemmRegisterAllShortExecuteTests() {
   count += SQNBitGemmShortExecuteTest<4, 64>::RegisterShortExecuteTests();
   count += SQNBitGemmShortExecuteTest<4, 128>::RegisterShortExecuteTests();
   count += SQNBitGemmShortExecuteTest<4, 256>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 16>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 32>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 128>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 16>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 32>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 64>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 256>::RegisterShortExecuteTests();
 
   return count;
 }
@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_session_options_config_keys.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// X[batch, dim] goes through 'num_layers' MatMul + Relu pairs with dim x dim weights, so the weights span many
+// pages and the run time is dominated by GEMM.
+static std::string CreateMatMulChainModel(int64_t num_layers, int64_t batch, int64_t dim) {
+  auto logger = env->GetLoggingManager()->CreateLogger("arena_pages");
+  onnxruntime::Model model("matmul_chain", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, *logger);
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(batch);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-0.05f, 0.05f);
+
+  NodeArg* prev = &graph.GetOrCreateNodeArg("X", &x_type);
+  for (int64_t l = 0; l < num_layers; ++l) {
+    const std::string suffix = std::to_string(l);
+
+    ONNX_NAMESPACE::TensorProto weight;
+    weight.set_name("W_" + suffix);
+    weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    weight.add_dims(dim);
+    weight.add_dims(dim);
+    for (int64_t i = 0; i < dim * dim; ++i) {
+      weight.add_float_data(dist(gen));
+    }
+    graph.AddInitializedTensor(weight);
+
+    auto& w_arg = graph.GetOrCreateNodeArg("W_" + suffix, nullptr);
+    auto& matmul_out = graph.GetOrCreateNodeArg("matmul_" + suffix, &x_type);
+    graph.AddNode("matmul_" + suffix, "MatMul", "", {prev, &w_arg}, {&matmul_out});
+    auto& relu_out = graph.GetOrCreateNodeArg(l + 1 == num_layers ? std::string("Y") : "relu_" + suffix, &x_type);
+    graph.AddNode("relu_" + suffix, "Relu", "", {&matmul_out}, {&relu_out});
+    prev = &relu_out;
+  }
+
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+// Arguments: batch, arena.huge_pages (-1: regular device allocator, 1: transparent, 2: reserved),
+// arena.numa_node (-1: no binding).
+// The arena is registered with the environment so that the initializers and the activations are both placed in it.
+static void BM_MatMulChainArenaPages(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t huge_pages = state.range(1);
+  const int64_t numa_node = state.range(2);
+  constexpr int64_t num_layers = 16;
+  constexpr int64_t dim = 1024;
+
+  const std::string model_data = CreateMatMulChainModel(num_layers, batch, dim);
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+
+  std::vector<const char*> cfg_keys;
+  std::vector<size_t> cfg_values;
+  if (huge_pages >= 0) {
+    cfg_keys.push_back("huge_pages");
+    cfg_values.push_back(static_cast<size_t>(huge_pages));
+  }
+  if (numa_node >= 0) {
+    cfg_keys.push_back("numa_node");
+    cfg_values.push_back(static_cast<size_t>(numa_node));
+  }
+
+  OrtArenaCfg* arena_cfg;
+  ORT_BREAK_ON_ERROR(g_ort->CreateArenaCfgV2(cfg_keys.data(), cfg_values.data(), cfg_keys.size(), &arena_cfg));
+  ORT_BREAK_ON_ERROR(g_ort->CreateAndRegisterAllocator(env, memory_info, arena_cfg));
+  g_ort->ReleaseArenaCfg(arena_cfg);
+
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->AddSessionConfigEntry(session_options, kOrtSessionOptionsConfigUseEnvAllocators, "1"));
+
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options,
+                                                   &session));
+
+  std::vector<float> x_data(batch * dim, 1.0f);
+  const int64_t x_shape[] = {batch, dim};
+  OrtValue* x = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, x_data.data(), x_data.size() * sizeof(float),
+                                                           x_shape, 2, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &x));
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  for (auto _ : state) {
+    OrtValue* y = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &x, 1, output_names, 1, &y));
+    g_ort->ReleaseValue(y);
+  }
+
+  g_ort->ReleaseValue(x);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+  ORT_BREAK_ON_ERROR(g_ort->UnregisterAllocator(env, memory_info));
+  g_ort->ReleaseMemoryInfo(memory_info);
+}
+
+BENCHMARK(BM_MatMulChainArenaPages)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{1, 32}, {-1, 1, 2}, {-1, 0}});
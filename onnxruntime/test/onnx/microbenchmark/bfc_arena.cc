@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/framework/bfc_arena.h>
+
+#include <iterator>
+#include <memory>
+
+using namespace onnxruntime;
+
+// Shared by all benchmark threads. Created by thread 0 before the threads start iterating.
+static std::unique_ptr<BFCArena> g_arena;
+
+// Every iteration allocates and frees a set of small buffers, as a kernel does with its outputs and scratch buffers.
+// Arguments: thread cache max chunk bytes (0 disables the thread caches).
+static void BM_BFCArenaConcurrentAllocFree(benchmark::State& state) {
+  const size_t thread_cache_max_chunk_bytes = static_cast<size_t>(state.range(0));
+  if (state.thread_index() == 0) {
+    g_arena = std::make_unique<BFCArena>(std::make_unique<CPUAllocator>(), BFCArena::DEFAULT_MAX_MEM,
+                                         BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+                                         BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+                                         BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+                                         BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+                                         BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+                                         thread_cache_max_chunk_bytes);
+  }
+
+  const size_t sizes[] = {256, 1024, 4096, 16 * 1024, 64 * 1024, 512, 2048, 8192};
+  void* ptrs[std::size(sizes)];
+  for (auto _ : state) {
+    for (size_t i = 0; i < std::size(sizes); ++i) {
+      ptrs[i] = g_arena->Alloc(sizes[i]);
+      benchmark::DoNotOptimize(ptrs[i]);
+    }
+
+    for (size_t i = 0; i < std::size(sizes); ++i) {
+      g_arena->Free(ptrs[i]);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(sizes)));
+  if (state.thread_index() == 0) {
+    AllocatorStats stats;
+    g_arena->GetStats(&stats);
+    state.counters["cache_hit_rate"] =
+        stats.num_allocs == 0 ? 0.0 : static_cast<double>(stats.num_thread_cache_hits) / stats.num_allocs;
+  }
+}
+
+BENCHMARK(BM_BFCArenaConcurrentAllocFree)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Arg(0)
+    ->Arg(64 * 1024)
+    ->ThreadRange(1, 32);
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_session_options_config_keys.h>
+#include <core/session/ort_env.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// Synthetic multi-tower model: X[batch, dim] feeds 'num_branches' independent chains of
+// 'chain_length' MatMul + Relu pairs, and the tower outputs are summed up.
+static std::string CreateManyBranchModel(int64_t num_branches, int64_t chain_length, int64_t batch, int64_t dim) {
+  auto logger = env->GetLoggingManager()->CreateLogger("parallel_executor");
+  onnxruntime::Model model("many_branches", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, *logger);
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(batch);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-0.1f, 0.1f);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &x_type);
+  std::vector<NodeArg*> sum_inputs;
+  for (int64_t b = 0; b < num_branches; ++b) {
+    NodeArg* prev = &x_arg;
+    for (int64_t c = 0; c < chain_length; ++c) {
+      const std::string suffix = std::to_string(b) + "_" + std::to_string(c);
+
+      ONNX_NAMESPACE::TensorProto weight;
+      weight.set_name("W_" + suffix);
+      weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      weight.add_dims(dim);
+      weight.add_dims(dim);
+      for (int64_t i = 0; i < dim * dim; ++i) {
+        weight.add_float_data(dist(gen));
+      }
+      graph.AddInitializedTensor(weight);
+
+      auto& w_arg = graph.GetOrCreateNodeArg("W_" + suffix, nullptr);
+      auto& matmul_out = graph.GetOrCreateNodeArg("matmul_" + suffix, &x_type);
+      graph.AddNode("matmul_" + suffix, "MatMul", "", {prev, &w_arg}, {&matmul_out});
+      auto& relu_out = graph.GetOrCreateNodeArg("relu_" + suffix, &x_type);
+      graph.AddNode("relu_" + suffix, "Relu", "", {&matmul_out}, {&relu_out});
+      prev = &relu_out;
+    }
+    sum_inputs.push_back(prev);
+  }
+
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &x_type);
+  graph.AddNode("sum", "Sum", "", sum_inputs, {&y_arg});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+// Arguments: number of branches, executor (0: sequential, 1: parallel stream plan, 2: dependency driven).
+static void BM_ManyBranchModel(benchmark::State& state) {
+  const int64_t num_branches = state.range(0);
+  const int64_t executor = state.range(1);
+  constexpr int64_t chain_length = 8;
+  constexpr int64_t batch = 16;
+  constexpr int64_t dim = 256;
+
+  const std::string model_data = CreateManyBranchModel(num_branches, chain_length, batch, dim);
+
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+  if (executor != 0) {
+    ORT_BREAK_ON_ERROR(g_ort->SetSessionExecutionMode(session_options, ORT_PARALLEL));
+  }
+  if (executor == 2) {
+    ORT_BREAK_ON_ERROR(g_ort->AddSessionConfigEntry(session_options, kOrtSessionOptionsConfigDependencyDrivenExecution,
+                                                    "1"));
+  }
+
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options,
+                                                   &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  std::vector<float> x_data(batch * dim, 1.0f);
+  const int64_t x_shape[] = {batch, dim};
+  OrtValue* x = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, x_data.data(), x_data.size() * sizeof(float),
+                                                           x_shape, 2, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &x));
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  for (auto _ : state) {
+    OrtValue* y = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &x, 1, output_names, 1, &y));
+    g_ort->ReleaseValue(y);
+  }
+
+  g_ort->ReleaseValue(x);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+BENCHMARK(BM_ManyBranchModel)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{4, 16, 64}, {0, 1, 2}});
@@ -81,3 +81,108 @@ BENCHMARK_TEMPLATE(BM_NhwcUpsampleBilinear, float)
     ->Args({128, 128})
     ->Args({160, 160})
     ->Args({1, 1000000});
+
+// The interpolation tables are built once outside of the timed loop, the same as the Resize kernel reusing its
+// cached tables for repeated input and output shapes.
+static const GetOriginalCoordinateFunc& HalfPixelCoordinate() {
+  static const GetOriginalCoordinateFunc get_original_coordinate =
+      [](float x_resized, float x_scale, float, float, float, float) {
+        return ((x_resized + 0.5f) / x_scale) - 0.5f;
+      };
+  return get_original_coordinate;
+}
+
+static std::unique_ptr<concurrency::ThreadPool> CreateResizeThreadPool() {
+  OrtThreadPoolParams tpo;
+  tpo.auto_set_affinity = true;
+  return concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+}
+
+static void BM_UpsampleBilinearImage(benchmark::State& state) {
+  const int32_t input_height = static_cast<int32_t>(state.range(0));
+  const int32_t input_width = static_cast<int32_t>(state.range(1));
+  const int32_t output_height = static_cast<int32_t>(state.range(2));
+  const int32_t output_width = static_cast<int32_t>(state.range(3));
+  const bool is_nchw = state.range(4) != 0;
+  constexpr int32_t batch_size = 1;
+  constexpr int32_t num_channels = 3;
+  const float height_scale = static_cast<float>(output_height) / input_height;
+  const float width_scale = static_cast<float>(output_width) / input_width;
+  const std::vector<float> roi{0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+  const std::vector<float> X(static_cast<size_t>(batch_size) * num_channels * input_height * input_width, 1.0f);
+  std::vector<float> Y(static_cast<size_t>(batch_size) * num_channels * output_height * output_width);
+  AllocatorPtr alloc = CPUAllocator::DefaultInstance();
+  auto tp = CreateResizeThreadPool();
+
+  const BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                                 height_scale, width_scale, roi, alloc, HalfPixelCoordinate(),
+                                                 is_nchw);
+
+  for (auto _ : state) {
+    if (is_nchw) {
+      UpsampleBilinear<float>(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                              false, 0.0f, X.data(), Y.data(), tp.get());
+    } else {
+      NhwcUpsampleBilinear<float, false>(batch_size, num_channels, input_height, input_width, output_height,
+                                         output_width, p, 0.0f, X.data(), Y.data(), tp.get());
+    }
+  }
+}
+
+static void BM_ResizeBiCubicImage(benchmark::State& state) {
+  const int64_t input_height = state.range(0);
+  const int64_t input_width = state.range(1);
+  const int64_t output_height = state.range(2);
+  const int64_t output_width = state.range(3);
+  constexpr int64_t batch_size = 1;
+  constexpr int64_t num_channels = 3;
+  const float height_scale = static_cast<float>(output_height) / input_height;
+  const float width_scale = static_cast<float>(output_width) / input_width;
+  const std::vector<float> roi{0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+  const std::vector<float> X(static_cast<size_t>(batch_size * num_channels * input_height * input_width), 1.0f);
+  std::vector<float> Y(static_cast<size_t>(batch_size * num_channels * output_height * output_width));
+  auto tp = CreateResizeThreadPool();
+
+  const BicubicParams p = SetupUpsampleBiCubic(input_height, input_width, output_height, output_width,
+                                               height_scale, width_scale, -0.75f, false, roi, HalfPixelCoordinate());
+
+  for (auto _ : state) {
+    ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                  false, 0.0f, X.data(), Y.data(), tp.get());
+  }
+}
+
+// Input height and width, output height and width.
+static void ResizeImageSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"IH", "IW", "OH", "OW"});
+  b->Args({224, 224, 448, 448});
+  b->Args({256, 256, 224, 224});
+  b->Args({480, 640, 720, 1280});
+  b->Args({720, 1280, 480, 640});
+  b->Args({1080, 1920, 540, 960});
+  b->Args({1080, 1920, 2160, 3840});
+}
+
+static void ResizeImageSizesAndLayouts(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"IH", "IW", "OH", "OW", "NCHW"});
+  for (int64_t is_nchw : {1, 0}) {
+    b->Args({224, 224, 448, 448, is_nchw});
+    b->Args({256, 256, 224, 224, is_nchw});
+    b->Args({480, 640, 720, 1280, is_nchw});
+    b->Args({720, 1280, 480, 640, is_nchw});
+    b->Args({1080, 1920, 540, 960, is_nchw});
+    b->Args({1080, 1920, 2160, 3840, is_nchw});
+  }
+}
+
+BENCHMARK(BM_UpsampleBilinearImage)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Apply(ResizeImageSizesAndLayouts);
+
+BENCHMARK(BM_ResizeBiCubicImage)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Apply(ResizeImageSizes);
@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Op level benchmarks of the data movement kernels Pad, Tile, ScatterElements and ScatterND. Each benchmark runs a
+// single node model through a session, with the number of intra-op threads as the argument (0 uses the default).
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <onnx/defs/attr_proto_util.h>
+
+#include "core/graph/onnx_protobuf.h"
+#include "core/session/onnxruntime_cxx_api.h"
+
+namespace {
+
+struct BenchmarkInput {
+  std::string name;
+  std::vector<int64_t> dims;
+  std::vector<float> float_data;
+  std::vector<int64_t> int64_data;
+};
+
+BenchmarkInput FloatInput(const std::string& name, std::vector<int64_t> dims) {
+  size_t size = 1;
+  for (int64_t dim : dims) {
+    size *= static_cast<size_t>(dim);
+  }
+  std::mt19937 generator(static_cast<unsigned>(size));
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  BenchmarkInput input{name, std::move(dims), std::vector<float>(size), {}};
+  for (auto& value : input.float_data) {
+    value = distribution(generator);
+  }
+  return input;
+}
+
+BenchmarkInput IndexInput(const std::string& name, std::vector<int64_t> dims, int64_t limit) {
+  size_t size = 1;
+  for (int64_t dim : dims) {
+    size *= static_cast<size_t>(dim);
+  }
+  std::mt19937 generator(static_cast<unsigned>(size + limit));
+  std::uniform_int_distribution<int64_t> distribution(0, limit - 1);
+  BenchmarkInput input{name, std::move(dims), {}, std::vector<int64_t>(size)};
+  for (auto& value : input.int64_data) {
+    value = distribution(generator);
+  }
+  return input;
+}
+
+BenchmarkInput ValuesInput(const std::string& name, std::vector<int64_t> values) {
+  const auto size = static_cast<int64_t>(values.size());
+  return BenchmarkInput{name, {size}, {}, std::move(values)};
+}
+
+std::string MakeSingleNodeModel(const std::string& op_type, int opset, const std::vector<BenchmarkInput>& inputs,
+                                const std::vector<ONNX_NAMESPACE::AttributeProto>& attributes) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(8);
+  auto* opset_import = model.add_opset_import();
+  opset_import->set_domain("");
+  opset_import->set_version(opset);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name(op_type);
+  auto* node = graph->add_node();
+  node->set_op_type(op_type);
+  for (const auto& attribute : attributes) {
+    *node->add_attribute() = attribute;
+  }
+
+  for (const auto& input : inputs) {
+    node->add_input(input.name);
+    auto* value_info = graph->add_input();
+    value_info->set_name(input.name);
+    value_info->mutable_type()->mutable_tensor_type()->set_elem_type(
+        input.float_data.empty() ? ONNX_NAMESPACE::TensorProto_DataType_INT64 : ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  }
+
+  node->add_output("Y");
+  auto* output = graph->add_output();
+  output->set_name("Y");
+  output->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  return model.SerializeAsString();
+}
+
+void RunSingleNodeModel(benchmark::State& state, const std::string& op_type, int opset,
+                        std::vector<BenchmarkInput>& inputs,
+                        const std::vector<ONNX_NAMESPACE::AttributeProto>& attributes = {}) {
+  const std::string model = MakeSingleNodeModel(op_type, opset, inputs, attributes);
+
+  Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "tensor_ops");
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(static_cast<int>(state.range(0)));
+  session_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+  Ort::Session session(env, model.data(), model.size(), session_options);
+
+  const auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<const char*> input_names;
+  std::vector<Ort::Value> input_values;
+  for (auto& input : inputs) {
+    input_names.push_back(input.name.c_str());
+    if (input.float_data.empty()) {
+      input_values.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, input.int64_data.data(),
+                                                               input.int64_data.size(), input.dims.data(),
+                                                               input.dims.size()));
+    } else {
+      input_values.push_back(Ort::Value::CreateTensor<float>(memory_info, input.float_data.data(),
+                                                             input.float_data.size(), input.dims.data(),
+                                                             input.dims.size()));
+    }
+  }
+  const char* output_name = "Y";
+
+  for (auto _ : state) {
+    auto outputs = session.Run(Ort::RunOptions{nullptr}, input_names.data(), input_values.data(), input_values.size(),
+                               &output_name, 1);
+    benchmark::DoNotOptimize(outputs);
+  }
+}
+
+}  // namespace
+
+static void BM_PadConstant(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{FloatInput("data", {1, 64, 160, 160}),
+                                     ValuesInput("pads", {0, 0, 1, 1, 0, 0, 1, 1})};
+  RunSingleNodeModel(state, "Pad", 18, inputs);
+}
+
+BENCHMARK(BM_PadConstant)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(0);
+
+static void BM_PadReflect(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{FloatInput("data", {1, 64, 160, 160}),
+                                     ValuesInput("pads", {0, 0, 3, 3, 0, 0, 3, 3})};
+  RunSingleNodeModel(state, "Pad", 18, inputs, {ONNX_NAMESPACE::MakeAttribute("mode", std::string("reflect"))});
+}
+
+BENCHMARK(BM_PadReflect)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(0);
+
+static void BM_Tile(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{FloatInput("input", {32, 1, 96}), ValuesInput("repeats", {1, 256, 2})};
+  RunSingleNodeModel(state, "Tile", 13, inputs);
+}
+
+BENCHMARK(BM_Tile)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(0);
+
+static void BM_ScatterElementsAdd(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{FloatInput("data", {64, 4096}), IndexInput("indices", {1024, 4096}, 64),
+                                     FloatInput("updates", {1024, 4096})};
+  RunSingleNodeModel(state, "ScatterElements", 18, inputs,
+                     {ONNX_NAMESPACE::MakeAttribute("axis", int64_t{0}),
+                      ONNX_NAMESPACE::MakeAttribute("reduction", std::string("add"))});
+}
+
+BENCHMARK(BM_ScatterElementsAdd)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(0);
+
+// Message passing in a graph neural network: the features of 16384 edges are summed into 2048 nodes.
+static void BM_ScatterNDAdd(benchmark::State& state) {
+  std::vector<BenchmarkInput> inputs{FloatInput("data", {2048, 256}), IndexInput("indices", {16384, 1}, 2048),
+                                     FloatInput("updates", {16384, 256})};
+  RunSingleNodeModel(state, "ScatterND", 18, inputs,
+                     {ONNX_NAMESPACE::MakeAttribute("reduction", std::string("add"))});
+}
+
+BENCHMARK(BM_ScatterNDAdd)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(0);
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void EnableElementwiseFusion(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseFusion, "1"));
+}
+
+TEST(ElementwiseFusionTests, BiasTanhMulWithBroadcast) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4, 40}, -3.f, 3.f);
+    auto* bias_arg = builder.MakeInitializer<float>({40}, -1.f, 1.f);
+    auto* residual_arg = builder.MakeInput<float>({4, 1}, -2.f, 2.f);
+    auto* add_out_arg = builder.MakeIntermediate();
+    auto* tanh_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out_arg});
+    builder.AddNode("Tanh", {add_out_arg}, {tanh_out_arg});
+    builder.AddNode("Mul", {tanh_out_arg, residual_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13, 1e-5, 1e-5,
+                    nullptr, EnableElementwiseFusion);
+}
+
+// An intermediate result with several consumers becomes an input of the fused node.
+TEST(ElementwiseFusionTests, SharedIntermediate) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({3, 17}, -3.f, 3.f);
+    auto* bias_arg = builder.MakeInitializer<float>({17}, -1.f, 1.f);
+    auto* add_out_arg = builder.MakeIntermediate();
+    auto* sigmoid_out_arg = builder.MakeIntermediate();
+    auto* neg_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out_arg});
+    builder.AddNode("Sigmoid", {add_out_arg}, {sigmoid_out_arg});
+    builder.AddNode("Neg", {add_out_arg}, {neg_out_arg});
+    builder.AddNode("Mul", {sigmoid_out_arg, neg_out_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+    EXPECT_EQ(op_to_count["Neg"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13, 1e-5, 1e-5,
+                    nullptr, EnableElementwiseFusion);
+}
+
+// The pattern fusions of the earlier levels take precedence: x * Sigmoid(x) becomes QuickGelu, and only the chain
+// producing x is left to ElementwiseFusion.
+TEST(ElementwiseFusionTests, AfterQuickGeluFusion) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 64}, -3.f, 3.f);
+    auto* bias_arg = builder.MakeInitializer<float>({64}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeInitializer<float>({}, {0.5f});
+    auto* add_out_arg = builder.MakeIntermediate();
+    auto* scale_out_arg = builder.MakeIntermediate();
+    auto* sigmoid_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out_arg});
+    builder.AddNode("Mul", {add_out_arg, scale_arg}, {scale_out_arg});
+    builder.AddNode("Sigmoid", {scale_out_arg}, {sigmoid_out_arg});
+    builder.AddNode("Mul", {sigmoid_out_arg, scale_out_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.QuickGelu"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13, 1e-5, 1e-5,
+                    nullptr, EnableElementwiseFusion);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -408,6 +408,58 @@ TEST(NchwcOptimizerTests, ConvPointwise) {
   }
 }
 
+TEST(NchwcOptimizerTests, ConvTranspose) {
+  auto test_case = [&](int64_t input_channels, int64_t output_channels, const std::vector<int64_t>& kernel_shape,
+                       const std::vector<int64_t>& strides, const std::vector<int64_t>& pads,
+                       const std::vector<int64_t>& output_padding, const std::vector<int64_t>& dilations,
+                       const std::string& auto_pad) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({2, input_channels, 11, 14});
+      auto* conv_transpose_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      auto* weights_arg = helper.MakeInitializer({input_channels, output_channels, kernel_shape[0], kernel_shape[1]});
+      auto* biases_arg = helper.MakeInitializer({output_channels});
+      auto& conv_transpose_node = helper.AddNode("ConvTranspose", {input_arg, weights_arg, biases_arg},
+                                                 {conv_transpose_output_arg});
+      conv_transpose_node.AddAttribute("strides", strides);
+      conv_transpose_node.AddAttribute("dilations", dilations);
+      conv_transpose_node.AddAttribute("output_padding", output_padding);
+      if (auto_pad.empty()) {
+        conv_transpose_node.AddAttribute("pads", pads);
+      } else {
+        conv_transpose_node.AddAttribute("auto_pad", auto_pad);
+      }
+
+      helper.AddNode("Relu", {conv_transpose_output_arg}, {output_arg});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ConvTranspose"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+      EXPECT_EQ(op_to_count["ConvTranspose"], 0);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Upsampling layers of decoders.
+  test_case(32, 16, {4, 4}, {2, 2}, {1, 1, 1, 1}, {0, 0}, {1, 1}, "");
+  test_case(16, 20, {3, 3}, {2, 2}, {1, 1, 1, 1}, {1, 1}, {1, 1}, "");
+  test_case(24, 48, {2, 2}, {2, 2}, {0, 0, 0, 0}, {0, 0}, {1, 1}, "");
+  test_case(16, 8, {3, 3}, {2, 2}, {0, 0, 0, 0}, {1, 1}, {1, 1}, "SAME_UPPER");
+  // A single phase computed in place.
+  test_case(16, 16, {3, 3}, {1, 1}, {1, 1, 1, 1}, {0, 0}, {1, 1}, "");
+  // Phases with different filter shapes along each axis and dilated filter taps.
+  test_case(8, 12, {3, 5}, {3, 2}, {0, 2, 1, 0}, {2, 1}, {2, 1}, "");
+  // Phases without filter taps, which produce the bias.
+  test_case(4, 8, {1, 2}, {3, 3}, {0, 0, 0, 0}, {0, 0}, {1, 1}, "");
+  // Padding beyond the extent of the filter.
+  test_case(16, 16, {2, 3}, {2, 2}, {3, 2, 2, 4}, {1, 0}, {1, 1}, "");
+}
+
 TEST(NchwcOptimizerTests, ConvMaxPool) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto* input_arg = helper.MakeInput<float>({1, 48, 34, 34});
@@ -161,6 +161,9 @@ namespace perftest {
       "\t-D [Disable thread spinning]: disable spinning entirely for thread owned by onnxruntime intra-op thread pool.\n"
       "\t-Z [Force thread to stop spinning between runs]: disallow thread from spinning during runs to reduce cpu usage.\n"
       "\t-n [Exit after session creation]: allow user to measure session creation time to measure impact of enabling any initialization optimizations.\n"
+      "\t-j [startup_iterations]: Startup benchmark: creates the session [startup_iterations] times with profiling enabled, "
+      "reports the average time of each initialization phase (model loading, graph transformation, initializers, "
+      "kernel creation, pre-packing) and exits. The profiles are only kept if -p is given.\n"
       "\t-l Provide file as binary in memory by using fopen before session creation.\n"
       "\t-R [Register custom op]: allow user to register custom op by .so or .dll file.\n"
       "\t-X [Enable onnxruntime-extensions custom ops]: Registers custom ops from onnxruntime-extensions. "
@@ -195,7 +198,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlgR:X"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlgR:Xj:"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -392,6 +395,14 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'n':
         test_config.run_config.exit_after_session_creation = true;
         break;
+      case 'j': {
+        long iterations = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (iterations <= 0) {
+          return false;
+        }
+        test_config.run_config.startup_benchmark_iterations = static_cast<size_t>(iterations);
+        break;
+      }
       case 'l':
         test_config.model_info.load_via_path = true;
         break;
@@ -42,6 +42,17 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
+
+  // Exit after the startup benchmark if user enabled -j option
+  if (test_config.run_config.startup_benchmark_iterations > 0) {
+    auto status = perftest::RunStartupBenchmark(env, test_config, rd);
+    if (!status.IsOK()) {
+      printf("Startup benchmark failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+    return 0;
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
 
   // Exit if user enabled -n option so that user can measure session creation time
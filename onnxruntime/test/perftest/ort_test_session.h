@@ -31,6 +31,11 @@ class OnnxRuntimeTestSession : public TestSession {
 
   std::chrono::duration<double> Run() override;
 
+  // Ends the profiling of the session and returns the path of the profile file.
+  std::string EndProfiling() {
+    return session_.EndProfilingAllocated(allocator_).get();
+  }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
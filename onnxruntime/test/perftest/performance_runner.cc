@@ -7,11 +7,13 @@
 #endif
 
 #include "performance_runner.h"
+#include <cstdio>
 #include <iostream>
 
 #include "TestCase.h"
 #include "utils.h"
 #include "ort_test_session.h"
+#include "nlohmann/json.hpp"
 using onnxruntime::Status;
 
 // TODO: Temporary, while we bring up the threadpool impl...
@@ -113,7 +115,8 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 
 void PerformanceRunner::LogSessionCreationTime() {
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
-  std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n";
+  std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n"
+            << "Session creation peak working set size: " << session_create_peak_workingset_size_ << " bytes\n";
 }
 
 Status PerformanceRunner::Run() {
@@ -154,6 +157,7 @@ Status PerformanceRunner::Run() {
   std::chrono::duration<double> inference_duration = performance_result_.end - performance_result_.start;
 
   std::cout << "Session creation time cost: " << session_create_duration.count() << " s\n"
+            << "Session creation peak working set size: " << session_create_peak_workingset_size_ << " bytes\n"
             << "First inference time cost: " << first_inference_duration << " ms\n"
             << "Total inference time cost: " << performance_result_.total_time_cost << " s\n"  // sum of time taken by each request
             << "Total inference requests: " << performance_result_.time_costs.size() << "\n"
@@ -276,6 +280,7 @@ PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig&
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
+  session_create_peak_workingset_size_ = utils::GetPeakWorkingSetSize();
 }
 
 PerformanceRunner::~PerformanceRunner() = default;
@@ -330,6 +335,69 @@ bool PerformanceRunner::Initialize() {
   return true;
 }
 
+Status RunStartupBenchmark(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd) {
+  const size_t iterations = test_config.run_config.startup_benchmark_iterations;
+  const bool keep_profiles = !test_config.run_config.profile_file.empty();
+
+  PerformanceTestConfig config = test_config;
+  if (!keep_profiles) {
+    config.run_config.profile_file = ORT_TSTR("onnxruntime_perf_test_startup");
+  }
+  auto model_info = CreateModelInfo(config);
+
+  // total duration in microseconds of each session event, in the order the events are first recorded.
+  // the phases are nested, e.g. session_initialization contains the session_state_* phases.
+  std::vector<std::pair<std::string, int64_t>> phase_durations;
+  std::chrono::duration<double> total_session_create_duration{0};
+
+  for (size_t i = 0; i < iterations; ++i) {
+    std::string profile_file;
+    auto session_create_start = std::chrono::high_resolution_clock::now();
+    {
+      OnnxRuntimeTestSession session(env, rd, config, *model_info);
+      total_session_create_duration += std::chrono::high_resolution_clock::now() - session_create_start;
+      profile_file = session.EndProfiling();
+    }
+
+    std::ifstream profile_stream(profile_file);
+    auto events = nlohmann::json::parse(profile_stream, nullptr, /*allow_exceptions*/ false);
+    profile_stream.close();
+    if (!keep_profiles) {
+      std::remove(profile_file.c_str());
+    }
+
+    if (events.is_discarded() || !events.is_array()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to parse the profile ", profile_file);
+    }
+
+    for (const auto& event : events) {
+      if (event.value("cat", "") != "Session") {
+        continue;
+      }
+
+      const auto name = event.value("name", "");
+      const auto duration = event.value("dur", int64_t{0});
+      auto entry = std::find_if(phase_durations.begin(), phase_durations.end(),
+                                [&name](const auto& phase) { return phase.first == name; });
+      if (entry == phase_durations.end()) {
+        phase_durations.emplace_back(name, duration);
+      } else {
+        entry->second += duration;
+      }
+    }
+  }
+
+  std::cout << "\nStartup benchmark, average of " << iterations << " session creations:\n"
+            << "Session creation time cost: " << total_session_create_duration.count() / iterations << " s\n";
+  for (const auto& phase : phase_durations) {
+    std::cout << "  " << phase.first << ": "
+              << static_cast<double>(phase.second) / static_cast<double>(iterations) / 1000.0 << " ms\n";
+  }
+  std::cout << std::flush;
+
+  return Status::OK();
+}
+
 }  // namespace perftest
 
 }  // namespace onnxruntime
@@ -39,6 +39,10 @@ struct PerformanceResult {
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
 };
 
+// Creates the session run_config.startup_benchmark_iterations times with session profiling enabled and prints the
+// average duration of each initialization phase recorded by the profiler.
+Status RunStartupBenchmark(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
+
 class PerformanceRunner {
  public:
   PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
@@ -108,6 +112,8 @@ class PerformanceRunner {
  private:
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_start_;
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_end_;
+  // peak working set size of the process once the session is created, i.e. the peak while loading the model
+  size_t session_create_peak_workingset_size_{0};
   PerformanceResult initial_inference_result_;
   PerformanceResult performance_result_;
   PerformanceTestConfig performance_test_config_;
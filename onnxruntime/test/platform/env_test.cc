@@ -53,5 +53,25 @@ TEST(PlatformEnvTest, GetErrnoInfo) {
 #pragma warning(pop)
 #endif
 }
+
+TEST(PlatformEnvTest, AllocatePages) {
+  const auto& env = Env::Default();
+  constexpr size_t size = 3 * 1024 * 1024 + 123;
+  for (auto huge_pages : {Env::HugePages::kNone, Env::HugePages::kTransparent, Env::HugePages::kExplicit}) {
+    // huge pages and the NUMA node are best effort, so the allocation must succeed either way.
+    for (int numa_node : {-1, 0}) {
+      Env::MappedMemoryPtr memory;
+      ASSERT_STATUS_OK(env.AllocatePages(size, huge_pages, numa_node, memory));
+      ASSERT_NE(memory.get(), nullptr);
+      EXPECT_EQ(memory[0], 0);
+      EXPECT_EQ(memory[size - 1], 0);
+      memory[0] = 1;
+      memory[size - 1] = 1;
+    }
+  }
+
+  Env::MappedMemoryPtr memory;
+  ASSERT_FALSE(env.AllocatePages(0, Env::HugePages::kNone, -1, memory).IsOK());
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -12,8 +12,10 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -229,6 +231,30 @@ void TestStagedMultiLoopSections(const std::string& name, int num_threads, int n
   }
 }
 
+// Test a time based spin policy with bursts of loops separated by idle periods longer than the spin duration, so
+// that the workers both find work while spinning and have to be woken up.
+void TestSpinPolicy(int spin_duration_us, bool adaptive_spinning) {
+  constexpr int num_tasks = 1000;
+  constexpr int num_loops = 10;
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.spin_duration_us = spin_duration_us;
+  thread_options.adaptive_spinning = adaptive_spinning;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 4, true);
+  ThreadPool::StartProfiling(tp.get());
+  for (int burst = 0; burst < 10; burst++) {
+    auto test_data = CreateTestData(num_tasks);
+    for (int l = 0; l < num_loops; l++) {
+      ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    }
+    ValidateTestData(*test_data, num_loops);
+    std::this_thread::sleep_for(std::chrono::microseconds(std::max(spin_duration_us, 5000) * 2));
+  }
+  const std::string profile = ThreadPool::StopProfiling(tp.get());
+#ifndef ORT_MINIMAL_BUILD
+  ASSERT_NE(profile.find("\"spin_budget_us\""), std::string::npos);
+#endif
+}
+
 }  // namespace
 
 namespace onnxruntime {
@@ -510,6 +536,22 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestSpinPolicy_NoSpin) {
+  TestSpinPolicy(0, false);
+}
+
+TEST(ThreadPoolTest, TestSpinPolicy_FixedDuration) {
+  TestSpinPolicy(200, false);
+}
+
+TEST(ThreadPoolTest, TestSpinPolicy_Adaptive) {
+  TestSpinPolicy(-1, true);
+}
+
+TEST(ThreadPoolTest, TestSpinPolicy_AdaptiveWithMaxDuration) {
+  TestSpinPolicy(200, true);
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -757,6 +757,12 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
           std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
           if (provider_type == onnxruntime::kRocmExecutionProvider) {
             execution_providers.emplace_back(DefaultRocmExecutionProvider(/*test_tunable_op=*/true));
+          } else if (provider_type == onnxruntime::kCpuExecutionProvider) {
+            auto cpu_execution_provider = DefaultCpuExecutionProvider();
+            auto* tuning_ctx = cpu_execution_provider->GetTuningContext();
+            tuning_ctx->EnableTunableOpAndTuning();
+            tuning_ctx->SetMaxTuningDurationMs(1);
+            execution_providers.emplace_back(std::move(cpu_execution_provider));
           }
 
           if (!execution_providers.empty()) {
@@ -244,6 +244,125 @@ TEST(GemmOpTest, GemmTransB_f16) {
   }
 }
 
+// Covers transA, transB, alpha and a bias that is not a row vector, which the MLAS fp16 path applies around
+// the half precision GEMM, with B as a graph input and as an initializer that PrePack transposes.
+TEST(GemmOpTest, GemmTransATransBAlpha_f16) {
+#ifdef USE_CUDA
+  int min_cuda_architecture = 530;
+  if (!HasCudaEnvironment(min_cuda_architecture)) {
+    LOGS_DEFAULT(WARNING) << "Hardware NOT support FP16";
+    return;
+  }
+#endif
+
+  constexpr int64_t M = 3, N = 5, K = 4;
+  const float alpha = 0.5f;
+  const float beta = 2.0f;
+
+  // A is K x M and B is N x K, as both are transposed.
+  std::vector<float> A(K * M);
+  std::vector<float> B(N * K);
+  std::vector<float> C(M * N);
+  for (size_t i = 0; i < A.size(); i++) A[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+  for (size_t i = 0; i < C.size(); i++) C[i] = static_cast<float>(static_cast<int>(i % 3) - 1) * 0.125f;
+
+  std::vector<float> Y(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += A[k * M + m] * B[n * K + k];
+      }
+      Y[m * N + n] = alpha * sum + beta * C[m * N + n];
+    }
+  }
+
+  std::vector<MLFloat16> f_A(A.size());
+  std::vector<MLFloat16> f_B(B.size());
+  std::vector<MLFloat16> f_C(C.size());
+  std::vector<MLFloat16> f_Y(Y.size());
+  ConvertFloatToMLFloat16(A.data(), f_A.data(), A.size());
+  ConvertFloatToMLFloat16(B.data(), f_B.data(), B.size());
+  ConvertFloatToMLFloat16(C.data(), f_C.data(), C.size());
+  ConvertFloatToMLFloat16(Y.data(), f_Y.data(), Y.size());
+
+  for (bool b_is_initializer : {false, true}) {
+    OpTester test("Gemm", 13);
+
+    test.AddAttribute("transA", (int64_t)1);
+    test.AddAttribute("transB", (int64_t)1);
+    test.AddAttribute("alpha", alpha);
+    test.AddAttribute("beta", beta);
+    test.AddInput<MLFloat16>("A", {K, M}, f_A);
+    test.AddInput<MLFloat16>("B", {N, K}, f_B, b_is_initializer);
+    test.AddInput<MLFloat16>("C", {M, N}, f_C);
+    test.AddOutput<MLFloat16>("Y", {M, N}, f_Y);
+    test.SetOutputTolerance(0.005f);
+    test.ConfigExcludeEps({kTensorrtExecutionProvider})  // TensorRT: fp16 is not supported
+        .RunWithConfig();
+  }
+}
+
+// A constant B is pre-packed for the SBGEMM kernels where the CPU supports them, after the transpose. The values are
+// small integers and halves, so the results are exact in bf16.
+TEST(GemmOpTest, GemmTransAlphaBias_bfloat16_cpu) {
+  constexpr int64_t M = 5, N = 37, K = 8;
+  const float alpha = 0.5f;
+  const float beta = 2.0f;
+
+  std::vector<float> A(M * K);
+  std::vector<float> B(K * N);
+  std::vector<float> C(M * N);
+  for (size_t i = 0; i < A.size(); i++) A[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<float>(static_cast<int>(i % 3) - 1);
+  for (size_t i = 0; i < C.size(); i++) C[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.5f;
+
+  for (bool trans_a : {false, true}) {
+    for (bool trans_b : {false, true}) {
+      for (bool full_bias : {false, true}) {
+        // A is stored K x M when transposed, and B N x K.
+        std::vector<float> Y(M * N);
+        for (int64_t m = 0; m < M; m++) {
+          for (int64_t n = 0; n < N; n++) {
+            float sum = 0.0f;
+            for (int64_t k = 0; k < K; k++) {
+              sum += (trans_a ? A[k * M + m] : A[m * K + k]) * (trans_b ? B[n * K + k] : B[k * N + n]);
+            }
+            Y[m * N + n] = alpha * sum + beta * (full_bias ? C[m * N + n] : C[n]);
+          }
+        }
+
+        for (bool b_is_initializer : {false, true}) {
+          SCOPED_TRACE(MakeString("transA ", trans_a, " transB ", trans_b, " full bias ", full_bias,
+                                  " constant B ", b_is_initializer));
+
+          OpTester test("Gemm", 13);
+          test.AddAttribute("transA", static_cast<int64_t>(trans_a));
+          test.AddAttribute("transB", static_cast<int64_t>(trans_b));
+          test.AddAttribute("alpha", alpha);
+          test.AddAttribute("beta", beta);
+          test.AddInput<BFloat16>("A", trans_a ? std::vector<int64_t>{K, M} : std::vector<int64_t>{M, K},
+                                  FloatsToBFloat16s(A));
+          test.AddInput<BFloat16>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N},
+                                  FloatsToBFloat16s(B), b_is_initializer);
+          if (full_bias) {
+            test.AddInput<BFloat16>("C", {M, N}, FloatsToBFloat16s(C));
+          } else {
+            test.AddInput<BFloat16>("C", {N}, FloatsToBFloat16s(std::vector<float>(C.begin(), C.begin() + N)));
+          }
+          test.AddOutput<BFloat16>("Y", {M, N}, FloatsToBFloat16s(Y));
+
+          std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+          execution_providers.emplace_back(DefaultCpuExecutionProvider());
+          test.ConfigEps(std::move(execution_providers))
+              .RunWithConfig();
+        }
+      }
+    }
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DNNL)
 TEST(GemmOpTest, GemmNoTrans_bfloat16) {
 #ifdef USE_CUDA
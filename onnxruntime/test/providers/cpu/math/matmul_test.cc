@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 
+#include "core/mlas/inc/mlas.h"
+
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -522,6 +524,82 @@ TEST(MathOpTest, MatMul_bfloat16) {
 }
 #endif
 
+// A constant B is pre-packed for the SBGEMM kernels where the CPU supports them. The values are small integers, so
+// the results are exact in bf16.
+TEST(MathOpTest, MatMul_bfloat16_cpu) {
+  constexpr int64_t M = 5, K = 40, N = 37;
+
+  std::vector<float> a_vals(M * K);
+  std::vector<float> b_vals(K * N);
+  for (size_t i = 0; i < a_vals.size(); i++) {
+    a_vals[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+  for (size_t i = 0; i < b_vals.size(); i++) {
+    b_vals[i] = static_cast<float>(static_cast<int>(i % 3) - 1);
+  }
+
+  std::vector<float> expected_vals(M * N, 0.0f);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        expected_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  for (bool is_b_constant : {false, true}) {
+    SCOPED_TRACE(is_b_constant ? "constant B" : "non-constant B");
+
+    OpTester test("MatMul", 13);
+    test.AddInput<BFloat16>("A", {M, K}, FloatsToBFloat16s(a_vals));
+    test.AddInput<BFloat16>("B", {K, N}, FloatsToBFloat16s(b_vals), is_b_constant);
+    test.AddOutput<BFloat16>("Y", {M, N}, FloatsToBFloat16s(expected_vals));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.emplace_back(DefaultCpuExecutionProvider());
+    test.ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+// The fp16 kernel is registered only when MLAS has half precision GEMM kernels for the CPU. The values are small
+// integers, so the results are exact in fp16.
+TEST(MathOpTest, MatMul_float16_cpu) {
+  if (!MlasHalfGemmAccelerationSupported()) {
+    GTEST_SKIP() << "Half precision GEMM is not supported on this CPU.";
+  }
+
+  constexpr int64_t Batch = 2, M = 5, K = 41, N = 37;
+
+  std::vector<float> a_vals(Batch * M * K);
+  std::vector<float> b_vals(K * N);
+  for (size_t i = 0; i < a_vals.size(); i++) {
+    a_vals[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+  for (size_t i = 0; i < b_vals.size(); i++) {
+    b_vals[i] = static_cast<float>(static_cast<int>(i % 3) - 1);
+  }
+
+  std::vector<float> expected_vals(Batch * M * N, 0.0f);
+  for (int64_t m = 0; m < Batch * M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        expected_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<MLFloat16>("A", {Batch, M, K}, FloatsToMLFloat16s(a_vals));
+  test.AddInput<MLFloat16>("B", {K, N}, FloatsToMLFloat16s(b_vals), true);
+  test.AddOutput<MLFloat16>("Y", {Batch, M, N}, FloatsToMLFloat16s(expected_vals));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 #include "core/graph/constants.h"
 #include "gtest/gtest.h"
+#include "test/common/random_generator.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -1046,5 +1048,55 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// A 3x3 convolution with unit strides and enough channels for the CPU EP to compute it with the Winograd algorithm,
+// which pre-packs the transformed filter when the weight is an initializer.
+TEST(ConvTest, Conv2D_Winograd) {
+  constexpr int64_t C = 64, M = 72, H = 9, W = 10;
+
+  RandomValueGenerator random{};
+  const vector<int64_t> X_shape = {2, C, H, W};
+  const vector<int64_t> W_shape = {M, C, 3, 3};
+  const vector<int64_t> B_shape = {M};
+  const vector<int64_t> Y_shape = {2, M, H, W};
+  const vector<float> X_data = random.Uniform<float>(X_shape, -1.0f, 1.0f);
+  const vector<float> W_data = random.Uniform<float>(W_shape, -1.0f, 1.0f);
+  const vector<float> B_data = random.Uniform<float>(B_shape, -1.0f, 1.0f);
+
+  vector<float> expected(2 * M * H * W);
+  for (int64_t n = 0; n < 2; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t oh = 0; oh < H; oh++) {
+        for (int64_t ow = 0; ow < W; ow++) {
+          double sum = B_data[m];
+          for (int64_t c = 0; c < C; c++) {
+            for (int64_t ky = 0; ky < 3; ky++) {
+              for (int64_t kx = 0; kx < 3; kx++) {
+                const int64_t ih = oh + ky - 1;
+                const int64_t iw = ow + kx - 1;
+                if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                  sum += double(X_data[((n * C + c) * H + ih) * W + iw]) * W_data[((m * C + c) * 3 + ky) * 3 + kx];
+                }
+              }
+            }
+          }
+          expected[((n * M + m) * H + oh) * W + ow] = static_cast<float>(sum);
+        }
+      }
+    }
+  }
+
+  for (bool weight_is_initializer : {false, true}) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", X_shape, X_data);
+    test.AddInput<float>("W", W_shape, W_data, weight_is_initializer);
+    test.AddInput<float>("B", B_shape, B_data, weight_is_initializer);
+    test.AddOutput<float>("Y", Y_shape, expected);
+    test.SetOutputTolerance(1e-3f);
+    test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
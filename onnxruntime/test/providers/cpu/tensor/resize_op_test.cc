@@ -1,11 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <exception>
 #include "gtest/gtest.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "test/common/trt_op_test_utils.h"
+#include "test/framework/test_utils.h"
 
 namespace onnxruntime {
 namespace test {
@@ -837,6 +841,180 @@ TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_2DBilinear_align_corners) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+// Large enough for the rows of the output to be split across threads. Bilinear interpolation with align_corners
+// reproduces a linear ramp exactly, so the expected output can be computed directly.
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_align_corners_large_image) {
+  auto run_test = [](bool is_nchw) {
+    OpTester test("Resize", 13);
+    std::vector<float> roi{};
+    std::vector<float> scales{};
+
+    test.AddAttribute("mode", "linear");
+    test.AddAttribute("coordinate_transformation_mode", "align_corners");
+
+    constexpr int64_t N = 2, C = 3, H = 37, W = 53;
+    constexpr int64_t OH = 64, OW = 96;
+    auto ramp = [](int64_t c, float h, float w) { return 100.0f * c + 2.0f * h + 0.5f * w; };
+
+    std::vector<float> X;
+    std::vector<float> Y;
+    for (int64_t n = 0; n < N; n++) {
+      if (is_nchw) {
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t h = 0; h < H; h++) {
+            for (int64_t w = 0; w < W; w++) {
+              X.push_back(ramp(c, static_cast<float>(h), static_cast<float>(w)));
+            }
+          }
+          for (int64_t h = 0; h < OH; h++) {
+            for (int64_t w = 0; w < OW; w++) {
+              Y.push_back(ramp(c, h * (H - 1) / static_cast<float>(OH - 1), w * (W - 1) / static_cast<float>(OW - 1)));
+            }
+          }
+        }
+      } else {
+        for (int64_t h = 0; h < H; h++) {
+          for (int64_t w = 0; w < W; w++) {
+            for (int64_t c = 0; c < C; c++) {
+              X.push_back(ramp(c, static_cast<float>(h), static_cast<float>(w)));
+            }
+          }
+        }
+        for (int64_t h = 0; h < OH; h++) {
+          for (int64_t w = 0; w < OW; w++) {
+            for (int64_t c = 0; c < C; c++) {
+              Y.push_back(ramp(c, h * (H - 1) / static_cast<float>(OH - 1), w * (W - 1) / static_cast<float>(OW - 1)));
+            }
+          }
+        }
+      }
+    }
+
+    std::vector<int64_t> X_shape = is_nchw ? std::vector<int64_t>{N, C, H, W} : std::vector<int64_t>{N, H, W, C};
+    std::vector<int64_t> sizes = is_nchw ? std::vector<int64_t>{N, C, OH, OW} : std::vector<int64_t>{N, OH, OW, C};
+
+    test.AddInput<float>("X", X_shape, X);
+    test.AddInput<float>("roi", {0}, roi);
+    test.AddInput<float>("", {0}, scales);
+    test.AddInput<int64_t>("sizes", {4}, sizes);
+    test.AddOutput<float>("Y", sizes, Y);
+
+    // CUDA | WEBGPU: result mismatch due to not implementing NHWC support
+    // ROCm: results mismatch
+    std::unordered_set<std::string> excluded_providers;
+    if (!is_nchw) {
+      excluded_providers = {kCudaExecutionProvider, kCudaNHWCExecutionProvider, kRocmExecutionProvider,
+                            kWebGpuExecutionProvider};
+    }
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100(excluded_providers));
+  };
+
+  run_test(true);
+  run_test(false);
+}
+
+// OpTester creates a new session for every Run, so it never calls a Resize kernel a second time. The CPU kernel
+// keeps the interpolation tables of its last call, so run one session with changing input shapes and scales and
+// compare each output with the output of a new session.
+TEST(ResizeOpTest, ResizeOpSameSessionDifferentShapesAndScales) {
+  auto create_model = [](const std::string& mode, int64_t antialias, std::string& model_data) {
+    Model model("resize", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 18}}, {}, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    ONNX_NAMESPACE::TypeProto float_4d;
+    float_4d.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (int i = 0; i < 4; ++i) {
+      float_4d.mutable_tensor_type()->mutable_shape()->add_dim();
+    }
+    ONNX_NAMESPACE::TypeProto float_1d;
+    float_1d.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    float_1d.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+    auto& x = graph.GetOrCreateNodeArg("X", &float_4d);
+    auto& roi = graph.GetOrCreateNodeArg("", nullptr);
+    auto& scales = graph.GetOrCreateNodeArg("scales", &float_1d);
+    auto& y = graph.GetOrCreateNodeArg("Y", &float_4d);
+    auto& node = graph.AddNode("resize", "Resize", "Resize with changing shapes", {&x, &roi, &scales}, {&y});
+    node.AddAttribute("mode", mode);
+    node.AddAttribute("antialias", antialias);
+
+    ASSERT_STATUS_OK(graph.Resolve());
+    ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+  };
+
+  auto run_model = [](InferenceSession& session, const std::vector<int64_t>& x_dims, const std::vector<float>& x,
+                      const std::vector<float>& scales, std::vector<OrtValue>& fetches) {
+    auto alloc = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+    NameMLValMap feeds;
+    OrtValue ml_value;
+    CreateMLValue<float>(alloc, x_dims, x, &ml_value);
+    feeds.insert(std::make_pair("X", ml_value));
+    CreateMLValue<float>(alloc, std::vector<int64_t>{4}, scales, &ml_value);
+    feeds.insert(std::make_pair("scales", ml_value));
+    std::vector<std::string> output_names{"Y"};
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+  };
+
+  struct Case {
+    std::vector<int64_t> x_dims;
+    std::vector<float> scales;
+  };
+  // the same input with other scales, another input with the same scales, the NHWC layout, and the first case again
+  const std::vector<Case> cases{
+      {{1, 3, 16, 16}, {1.0f, 1.0f, 2.0f, 2.0f}},
+      {{1, 3, 16, 16}, {1.0f, 1.0f, 0.5f, 0.75f}},
+      {{2, 3, 11, 13}, {1.0f, 1.0f, 2.0f, 2.0f}},
+      {{1, 11, 13, 3}, {1.0f, 1.5f, 1.5f, 1.0f}},
+      {{1, 3, 16, 16}, {1.0f, 1.0f, 2.0f, 2.0f}},
+  };
+
+  for (const std::string mode : {"linear", "cubic"}) {
+    for (int64_t antialias : {0, 1}) {
+      SCOPED_TRACE(MakeString("mode: ", mode, ", antialias: ", antialias));
+      std::string model_data;
+      create_model(mode, antialias, model_data);
+
+      SessionOptions so;
+      so.session_logid = "ResizeOpSameSessionDifferentShapesAndScales";
+      InferenceSession session{so, GetEnvironment()};
+      ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+      ASSERT_STATUS_OK(session.Initialize());
+
+      for (const auto& c : cases) {
+        SCOPED_TRACE(MakeString("X: ", TensorShape(c.x_dims), ", scales: ", c.scales[1], ",", c.scales[2]));
+        // cubic mode is bicubic only, so it doesn't support the NHWC case
+        if (mode == "cubic" && c.scales[1] != 1.0f) {
+          continue;
+        }
+
+        std::vector<float> x(static_cast<size_t>(TensorShape(c.x_dims).Size()));
+        for (size_t i = 0; i < x.size(); ++i) {
+          x[i] = std::sin(0.37f * static_cast<float>(i));
+        }
+
+        std::vector<OrtValue> fetches;
+        run_model(session, c.x_dims, x, c.scales, fetches);
+
+        InferenceSession new_session{so, GetEnvironment()};
+        ASSERT_STATUS_OK(new_session.Load(model_data.data(), static_cast<int>(model_data.size())));
+        ASSERT_STATUS_OK(new_session.Initialize());
+        std::vector<OrtValue> expected_fetches;
+        run_model(new_session, c.x_dims, x, c.scales, expected_fetches);
+
+        const auto& y = fetches[0].Get<Tensor>();
+        const auto& expected_y = expected_fetches[0].Get<Tensor>();
+        ASSERT_EQ(y.Shape(), expected_y.Shape());
+        const auto y_data = y.DataAsSpan<float>();
+        const auto expected_y_data = expected_y.DataAsSpan<float>();
+        for (size_t i = 0; i < y_data.size(); ++i) {
+          ASSERT_NEAR(y_data[i], expected_y_data[i], 1e-5f) << "i: " << i;
+        }
+      }
+    }
+  }
+}
+
 TEST(ResizeOpTest, ResizeOpLinearDownSampleTest_3DTrilinear_pytorch_half_pixel) {
   // TODO: Unskip when fixed #41968513
   if (DefaultDmlExecutionProvider().get() != nullptr) {
@@ -235,5 +235,29 @@ TEST(ScatterNDOpTest, ScatterND_18_max) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// Many update slices share a destination, so they are grouped by destination before being split across threads.
+TEST(ScatterNDOpTest, ScatterND_18_add_duplicate_indices_large) {
+  constexpr int64_t data_rows = 16, update_rows = 300, cols = 257;
+  std::vector<int64_t> data(data_rows * cols, 1);
+  std::vector<int64_t> indices(update_rows);
+  std::vector<int64_t> updates(update_rows * cols);
+  std::vector<int64_t> expected = data;
+  for (int64_t i = 0; i < update_rows; ++i) {
+    indices[i] = (i * 7) % data_rows - (i % 2 == 0 ? 0 : data_rows);
+    for (int64_t j = 0; j < cols; ++j) {
+      updates[i * cols + j] = i - j;
+      expected[((i * 7) % data_rows) * cols + j] += i - j;
+    }
+  }
+
+  OpTester test("ScatterND", 18);
+  test.AddAttribute("reduction", "add");
+  test.AddInput<int64_t>("data", {data_rows, cols}, data);
+  test.AddInput<int64_t>("indices", {update_rows, 1}, indices);
+  test.AddInput<int64_t>("updates", {update_rows, cols}, updates);
+  test.AddOutput<int64_t>("output", {data_rows, cols}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
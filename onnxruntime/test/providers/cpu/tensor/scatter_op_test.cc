@@ -452,5 +452,33 @@ TEST(ScatterElements, MinReduction_Double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// Many updates share a destination, so the columns of updates along axis are split across threads.
+TEST(ScatterElements, AddReduction_DuplicateIndices_Large) {
+  constexpr int64_t data_rows = 16, update_rows = 300, cols = 257;
+  std::vector<int64_t> data(data_rows * cols, 1);
+  std::vector<int64_t> indices(update_rows * cols);
+  std::vector<int64_t> updates(update_rows * cols);
+  std::vector<int64_t> expected = data;
+  for (int64_t i = 0; i < update_rows; ++i) {
+    for (int64_t j = 0; j < cols; ++j) {
+      const int64_t index = (i * 7 + j) % data_rows;
+      indices[i * cols + j] = index;
+      updates[i * cols + j] = i - j;
+      expected[index * cols + j] += i - j;
+    }
+  }
+
+  OpTester test("ScatterElements", 18);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<std::string>("reduction", "add");
+
+  test.AddInput<int64_t>("data", {data_rows, cols}, data);
+  test.AddInput<int64_t>("indices", {update_rows, cols}, indices);
+  test.AddInput<int64_t>("updates", {update_rows, cols}, updates);
+  test.AddOutput<int64_t>("y", {data_rows, cols}, expected);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -142,6 +142,10 @@ void RunTestWrapper() {
   RunTest<T>({2, 1, 3}, {2, 2, 1});
   RunTest<T>({2, 1, 3}, {2, 2, 1}, true);
 
+  // Tile with enough output rows to be split across threads
+  RunTest<T>({3, 64, 1, 17}, {2, 1, 24, 1});
+  RunTest<T>({5, 7, 33}, {3, 2, 4});
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_WEBGPU)
   // _TileMemcpyKernelFromInput, vectorized 4
   RunTest<T>({256, 512}, {3, 1});
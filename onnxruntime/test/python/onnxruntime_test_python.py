@@ -672,6 +672,8 @@ class TestInferenceSession(unittest.TestCase):
             sess.set_tuning_results([loadable], error_on_invalid=True)
             assert_tuning_results_loaded(sess, ep)
 
+        do_test_get_and_set_tuning_results("CPUExecutionProvider")
+
         if "CUDAExecutionProvider" in onnxrt.get_available_providers():
             do_test_get_and_set_tuning_results("CUDAExecutionProvider")
 
@@ -2312,6 +2312,63 @@ class TestGQA(unittest.TestCase):
             additional_params={"softcap": 0.0, "use_smooth_softmax": False},
         )
 
+    def test_gqa_fused_flash_attention(self):
+        print("-------- TEST GQA FUSED FLASH ATTENTION ---------")
+        # Without attention bias, softcap and smooth softmax the CPU kernel takes the fused flash attention path,
+        # which splits Q, K and V, applies the rotary embedding and appends K and V to the present state in one
+        # pass. run_test_config covers packed QKV, rotary (interleaved or not), local window and fp16 for it.
+        fused_params = {"softcap": 0.0, "use_smooth_softmax": False}
+        batches = [3]
+        pos_ids_attn_bias = [(False, False), (True, False)]
+        num_h = [(6, 3)]
+        h_sizes = [64]
+
+        # First prompt
+        prompt_seqs = [(35, 35)]
+        self.run_test_config(
+            parity_check_gqa_prompt,
+            PromptConfig,
+            batches,
+            prompt_seqs,
+            num_h,
+            h_sizes,
+            pos_ids_attn_bias,
+            additional_params=fused_params,
+        )
+        self.run_test_config(
+            parity_check_gqa_prompt_no_buff,
+            PromptConfig,
+            batches,
+            prompt_seqs,
+            num_h,
+            h_sizes,
+            pos_ids_attn_bias,
+            additional_params=fused_params,
+        )
+
+        # Decode with past
+        past_seqs = [(1, 128)]
+        self.run_test_config(
+            parity_check_gqa_past,
+            Config,
+            batches,
+            past_seqs,
+            num_h,
+            h_sizes,
+            pos_ids_attn_bias,
+            additional_params=fused_params,
+        )
+        self.run_test_config(
+            parity_check_gqa_past_no_buff,
+            Config,
+            batches,
+            past_seqs,
+            num_h,
+            h_sizes,
+            pos_ids_attn_bias,
+            additional_params=fused_params,
+        )
+
 
 if __name__ == "__main__":
     unittest.main()